@@ -46,6 +46,7 @@ vsedit::Job::Job(const JobProperties & a_properties,
 	, m_framesInQueue(0)
 	, m_framesInProcess(0)
 	, m_maxThreads(0)
+	, m_inFlightLimit(0)
 	, m_memorizedEncodingTime(0.0)
 {
 	fillVariables();
@@ -528,8 +529,10 @@ bool vsedit::Job::initialize()
 			SIGNAL(signalWriteLogMessage(int, const QString &)),
 			this, SLOT(slotWriteLogMessage(int, const QString &)));
 		connect(m_pVapourSynthScriptProcessor,
-			SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, double)),
-			this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, double)));
+			SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+				double)),
+			this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+				double)));
 		connect(m_pVapourSynthScriptProcessor, SIGNAL(signalFinalized()),
 			this, SLOT(slotScriptProcessorFinalized()));
 		connect(m_pVapourSynthScriptProcessor,
@@ -541,8 +544,10 @@ bool vsedit::Job::initialize()
 			SIGNAL(signalFrameRequestDiscarded(int, int, const QString &)),
 			this, SLOT(slotFrameRequestDiscarded(int, int, const QString &)));
 		connect(m_pVapourSynthScriptProcessor,
-			SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, double)),
-			this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, double)));
+			SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+				double)),
+			this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+				double)));
 	}
 
 	if((!m_pVapourSynthScriptProcessor->isInitialized()) ||
@@ -582,6 +587,9 @@ bool vsedit::Job::initialize()
 		m_properties.lastFrameReal = m_cpVideoInfo->numFrames - 1;
 	m_lastFrameRequested = m_properties.firstFrameReal - 1;
 	m_lastFrameProcessed = m_lastFrameRequested;
+	clearFramesCache();
+	m_framesCache.reset(FrameReorderBuffer::capacityFor(m_cachedFramesLimit,
+		m_cpVideoInfo, false), m_properties.firstFrameReal);
 	m_encodingState = EncodingState::Idle;
 	m_bytesToWrite = 0u;
 	m_bytesWritten = 0u;
@@ -1019,14 +1027,13 @@ void vsedit::Job::slotProcessBytesWritten(qint64 a_bytes)
 	}
 	else if(m_encodingState == EncodingState::WritingFrame)
 	{
-		Frame referenceFrame(m_lastFrameProcessed + 1, 0, nullptr);
-		std::list<Frame>::iterator it =
-			std::find(m_framesCache.begin(), m_framesCache.end(),
-			referenceFrame);
-		Q_ASSERT(it != m_framesCache.end());
-
-		m_cpVSAPI->freeFrame(it->cpOutputFrame);
-		m_framesCache.erase(it);
+		Frame frame(-1, -1, nullptr);
+		bool taken = m_framesCache.takeFront(frame);
+		Q_ASSERT(taken);
+		Q_ASSERT(frame.number == m_lastFrameProcessed + 1);
+		(void)taken;
+
+		m_cpVSAPI->freeFrame(frame.cpOutputFrame);
 		m_lastFrameProcessed++;
 		m_properties.framesProcessed++;
 		updateFPS();
@@ -1072,15 +1079,18 @@ void vsedit::Job::slotWriteLogMessage(int a_messageType,
 //==============================================================================
 
 void vsedit::Job::slotFrameQueueStateChanged(size_t a_inQueue,
-	size_t a_inProcess, size_t a_maxThreads, double a_usedCacheRatio)
+	size_t a_inProcess, size_t a_maxThreads, size_t a_inFlightLimit,
+	double a_usedCacheRatio)
 {
 	m_framesInQueue = a_inQueue;
 	m_framesInProcess = a_inProcess;
 	m_maxThreads = a_maxThreads;
+	m_inFlightLimit = a_inFlightLimit;
 }
 
 // END OF void vsedit::Job::slotFrameQueueStateChanged(size_t a_inQueue,
-//		size_t a_inProcess, size_t a_maxThreads, double a_usedCacheRatio)
+//		size_t a_inProcess, size_t a_maxThreads, size_t a_inFlightLimit,
+//		double a_usedCacheRatio)
 //==============================================================================
 
 void vsedit::Job::slotScriptProcessorFinalized()
@@ -1111,7 +1121,11 @@ void vsedit::Job::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 	const VSFrame * cpFrameRef =
 		m_cpVSAPI->addFrameRef(a_cpOutputFrame);
 	Frame newFrame(a_frameNumber, a_outputIndex, cpFrameRef);
-	m_framesCache.push_back(newFrame);
+	if(!m_framesCache.put(newFrame))
+	{
+		m_cpVSAPI->freeFrame(cpFrameRef);
+		return;
+	}
 
 	if(m_encodingState == EncodingState::WaitingForFrames)
 		processFramesQueue();
@@ -1421,16 +1435,7 @@ QString vsedit::Job::decodeArguments(const QString & a_arguments) const
 
 void vsedit::Job::clearFramesCache()
 {
-	if(m_framesCache.empty())
-		return;
-
-	Q_ASSERT(m_cpVSAPI);
-	for(Frame & frame : m_framesCache)
-	{
-		m_cpVSAPI->freeFrame(frame.cpOutputFrame);
-		m_cpVSAPI->freeFrame(frame.cpPreviewFrame);
-	}
-	m_framesCache.clear();
+	m_framesCache.clear(m_cpVSAPI);
 }
 
 // END OF void vsedit::Job::clearFramesCache()
@@ -1453,22 +1458,20 @@ void vsedit::Job::processFramesQueue()
 	}
 
 	while((m_lastFrameRequested < m_properties.lastFrameReal) &&
-		(m_framesInProcess < m_maxThreads) &&
-		(m_framesCache.size() < m_cachedFramesLimit) &&
+		(m_framesInProcess < m_inFlightLimit) &&
+		m_framesCache.canReserve() &&
 		(m_properties.jobState == JobState::Running))
 	{
+		m_lastFrameRequested = m_framesCache.reserveNext();
 		m_pVapourSynthScriptProcessor->requestFrameAsync(
-			m_lastFrameRequested + 1);
-		m_lastFrameRequested++;
+			m_lastFrameRequested, 0, false, FramePriority::Background);
 	}
 
-	Frame frame(m_lastFrameProcessed + 1, 0, nullptr);
-	std::list<Frame>::iterator it = std::find(m_framesCache.begin(),
-		m_framesCache.end(), frame);
-	if(it == m_framesCache.end())
+	const Frame * cpNextFrame = m_framesCache.front();
+	if(!cpNextFrame)
 		return;
 
-	frame.cpOutputFrame = it->cpOutputFrame;
+	Frame frame = *cpNextFrame;
 
 	// VapourSynth frames are padded so every line has aligned address.
 	// But encoder expects frames tightly packed. We pack frame lines
@@ -7,6 +7,7 @@
 #include "../../../common-src/log/styled_log_view_core.h"
 #include "../../../common-src/log/vs_editor_log_definitions.h"
 #include "../../../common-src/vapoursynth/vs_script_processor_structures.h"
+#include "../../../common-src/vapoursynth/vs_frame_reorder_buffer.h"
 #include "../../../common-src/jobs/job_variables.h"
 
 #include <QObject>
@@ -136,7 +137,8 @@ protected slots:
 	virtual void slotWriteLogMessage(int a_messageType,
 		const QString & a_message);
 	virtual void slotFrameQueueStateChanged(size_t a_inQueue,
-		size_t a_inProcess, size_t a_maxThreads, double a_usedCacheRatio);
+		size_t a_inProcess, size_t a_maxThreads, size_t a_inFlightLimit,
+		double a_usedCacheRatio);
 	virtual void slotScriptProcessorFinalized();
 	virtual void slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 		const VSFrame * a_cpOutputFrame,
@@ -194,12 +196,13 @@ protected:
 
 	FrameHeaderWriter * m_pFrameHeaderWriter;
 
-	std::list<Frame> m_framesCache;
+	FrameReorderBuffer m_framesCache;
 	size_t m_cachedFramesLimit;
 
 	size_t m_framesInQueue;
 	size_t m_framesInProcess;
 	size_t m_maxThreads;
+	size_t m_inFlightLimit;
 
 	hr_time_point m_encodeRangeStartTime;
 	double m_memorizedEncodingTime;
@@ -23,6 +23,10 @@ const bool DEFAULT_COLOR_PICKER_VISIBLE = false;
 const PlayFPSLimitMode DEFAULT_PLAY_FPS_LIMIT_MODE =
 	PlayFPSLimitMode::FromVideo;
 const double DEFAULT_PLAY_FPS_LIMIT = 23.976;
+const bool DEFAULT_PLAY_REAL_TIME = false;
+const bool DEFAULT_SHOW_PLAYBACK_STATISTICS = false;
+const CompareMode DEFAULT_COMPARE_MODE = CompareMode::Off;
+const QString DEFAULT_COMPARE_OUTPUTS = "0, 1";
 const bool DEFAULT_USE_SPACES_AS_TAB = true;
 const int DEFAULT_SPACES_IN_TAB = 4;
 const bool DEFAULT_REMEMBER_LAST_PREVIEW_FRAME = false;
@@ -33,6 +37,7 @@ const SyncOutputNodesMode DEFAULT_SYNC_OUTPUT_MODE =
 const bool DEFAULT_HIGHLIGHT_SELECTION_MATCHES = true;
 const int DEFAULT_HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH = 3;
 const bool DEFAULT_TIMELINE_PANEL_VISIBLE = true;
+const bool DEFAULT_THUMBNAIL_STRIP_VISIBLE = false;
 const bool DEFAULT_ALWAYS_KEEP_CURRENT_FRAME = true;
 const QString DEFAULT_LAST_SNAPSHOT_EXTENSION = "png";
 const int DEFAULT_FPS_DISPLAY_PRECISION = 3;
@@ -45,6 +50,9 @@ const bool DEFAULT_DEBUG_MESSAGES = false;
 const bool DEFAULT_DARK_MODE = false;
 const bool DEFAULT_SILENT_SNAPSHOT = false;
 const QString DEFAULT_SNAPSHOT_TEMPLATE = "{f}-{i}-{o}.png";
+const bool DEFAULT_PREVIEW_AT_DISPLAY_SIZE = true;
+const int DEFAULT_PREVIEW_FRAME_CACHE_SIZE = 512;
+const int DEFAULT_PREVIEW_PREFETCH_FRAMES = 4;
 
 //==============================================================================
 
@@ -55,6 +63,7 @@ const char ACTION_ID_SAVE_SCRIPT_AS[] = "save_script_as";
 const char ACTION_ID_TEMPLATES[] = "templates";
 const char ACTION_ID_SETTINGS[] = "settings";
 const char ACTION_ID_PREVIEW[] = "preview";
+const char ACTION_ID_RELOAD_AND_PREVIEW[] = "reload_and_preview";
 const char ACTION_ID_CHECK_SCRIPT[] = "check_script";
 const char ACTION_ID_BENCHMARK[] = "benchmark";
 const char ACTION_ID_CLI_ENCODE[] = "cli_encode";
@@ -65,6 +74,7 @@ const char ACTION_ID_EXIT[] = "exit";
 const char ACTION_ID_ABOUT[] = "about";
 const char ACTION_ID_AUTOCOMPLETE[] = "autocomplete";
 const char ACTION_ID_SAVE_SNAPSHOT[] = "save_snapshot";
+const char ACTION_ID_BATCH_SNAPSHOT_EXPORT[] = "batch_snapshot_export";
 const char ACTION_ID_TOGGLE_ZOOM_PANEL[] = "toggle_zoom_panel";
 const char ACTION_ID_SET_ZOOM_MODE_NO_ZOOM[] = "set_zoom_mode_no_zoom";
 const char ACTION_ID_SET_ZOOM_MODE_FIXED_RATIO[] = "set_zoom_mode_fixed_ratio";
@@ -85,7 +95,14 @@ const char ACTION_ID_TIME_STEP_FORWARD[] = "time_step_forward";
 const char ACTION_ID_TIME_STEP_BACK[] = "time_step_back";
 const char ACTION_ID_ADVANCED_PREVIEW_SETTINGS[] = "advanced_preview_settings";
 const char ACTION_ID_TOGGLE_COLOR_PICKER[] = "toggle_color_picker";
+const char ACTION_ID_TOGGLE_REGION_STATISTICS[] = "toggle_region_statistics";
+const char ACTION_ID_SHOW_NODE_TIMING[] = "show_node_timing";
 const char ACTION_ID_PLAY[] = "play";
+const char ACTION_ID_TOGGLE_REAL_TIME_PLAY[] = "toggle_real_time_play";
+const char ACTION_ID_TOGGLE_PLAYBACK_STATISTICS[] =
+	"toggle_playback_statistics";
+const char ACTION_ID_COMPARE_FLIP[] = "compare_flip";
+const char ACTION_ID_EXPORT_COMPARE_METRICS[] = "export_compare_metrics";
 const char ACTION_ID_DUPLICATE_SELECTION[] = "duplicate_selection";
 const char ACTION_ID_COMMENT_SELECTION[] = "comment_selection";
 const char ACTION_ID_UNCOMMENT_SELECTION[] = "uncomment_selection";
@@ -100,6 +117,12 @@ const char ACTION_ID_TIMELINE_GO_TO_PREVIOUS_BOOKMARK[] =
 	"timeline_go_to_previous_bookmark";
 const char ACTION_ID_TIMELINE_GO_TO_NEXT_BOOKMARK[] =
 	"timeline_go_to_next_bookmark";
+const char ACTION_ID_TIMELINE_SCAN_MARKERS[] = "timeline_scan_markers";
+const char ACTION_ID_TIMELINE_CLEAR_MARKERS[] = "timeline_clear_markers";
+const char ACTION_ID_TIMELINE_GO_TO_PREVIOUS_MARKER[] =
+	"timeline_go_to_previous_marker";
+const char ACTION_ID_TIMELINE_GO_TO_NEXT_MARKER[] =
+	"timeline_go_to_next_marker";
 const char ACTION_ID_PASTE_SHOWN_FRAME_NUMBER_INTO_SCRIPT[] =
 	"paste_shown_frame_number_into_script";
 const char ACTION_ID_MOVE_TEXT_BLOCK_UP[] = "move_text_block_up";
@@ -110,6 +133,8 @@ const char ACTION_ID_SET_TRUSTED_CLIENTS_ADDRESSES[] =
 	"set_trusted_clients_addresses";
 const char ACTION_ID_JUMP_TO_FRAME[] = "jump_to_frame";
 const char ACTION_ID_TOGGLE_FRAME_PROPS[] = "toggle_frame_props_panel";
+const char ACTION_ID_TOGGLE_SCOPES[] = "toggle_scopes_panel";
+const char ACTION_ID_TOGGLE_THUMBNAIL_STRIP[] = "toggle_thumbnail_strip";
 const char ACTION_ID_SET_OUTPUT_INDEX_0[] = "switch_to_output_index_0";
 const char ACTION_ID_SET_OUTPUT_INDEX_1[] = "switch_to_output_index_1";
 const char ACTION_ID_SET_OUTPUT_INDEX_2[] = "switch_to_output_index_2";
@@ -149,6 +174,7 @@ const char COLOR_ID_TEXT_BACKGROUND[] = "text_background_color";
 const char COLOR_ID_ACTIVE_LINE[] = "active_line_color";
 const char COLOR_ID_SELECTION_MATCHES[] = "selection_matches";
 const char COLOR_ID_TIMELINE_BOOKMARKS[] = "timeline_bookmarks";
+const char COLOR_ID_TIMELINE_MARKERS[] = "timeline_markers";
 
 //==============================================================================
 
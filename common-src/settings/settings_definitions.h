@@ -33,6 +33,14 @@ enum class PlayFPSLimitMode
 	Custom,
 };
 
+enum class CompareMode
+{
+	Off,
+	SideBySide,
+	Wipe,
+	Flip,
+};
+
 enum class SyncOutputNodesMode
 {
 	Frame,
@@ -92,6 +100,10 @@ extern const TimeLineSlider::DisplayMode DEFAULT_TIMELINE_MODE;
 extern const bool DEFAULT_COLOR_PICKER_VISIBLE;
 extern const PlayFPSLimitMode DEFAULT_PLAY_FPS_LIMIT_MODE;
 extern const double DEFAULT_PLAY_FPS_LIMIT;
+extern const bool DEFAULT_PLAY_REAL_TIME;
+extern const bool DEFAULT_SHOW_PLAYBACK_STATISTICS;
+extern const CompareMode DEFAULT_COMPARE_MODE;
+extern const QString DEFAULT_COMPARE_OUTPUTS;
 extern const bool DEFAULT_USE_SPACES_AS_TAB;
 extern const int DEFAULT_SPACES_IN_TAB;
 extern const bool DEFAULT_REMEMBER_LAST_PREVIEW_FRAME;
@@ -101,6 +113,7 @@ extern const SyncOutputNodesMode DEFAULT_SYNC_OUTPUT_MODE;
 extern const bool DEFAULT_HIGHLIGHT_SELECTION_MATCHES;
 extern const int DEFAULT_HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH;
 extern const bool DEFAULT_TIMELINE_PANEL_VISIBLE;
+extern const bool DEFAULT_THUMBNAIL_STRIP_VISIBLE;
 extern const bool DEFAULT_ALWAYS_KEEP_CURRENT_FRAME;
 extern const QString DEFAULT_LAST_SNAPSHOT_EXTENSION;
 extern const int DEFAULT_FPS_DISPLAY_PRECISION;
@@ -113,6 +126,9 @@ extern const bool DEFAULT_DEBUG_MESSAGES;
 extern const bool DEFAULT_DARK_MODE;
 extern const bool DEFAULT_SILENT_SNAPSHOT;
 extern const QString DEFAULT_SNAPSHOT_TEMPLATE;
+extern const bool DEFAULT_PREVIEW_AT_DISPLAY_SIZE;
+extern const int DEFAULT_PREVIEW_FRAME_CACHE_SIZE;
+extern const int DEFAULT_PREVIEW_PREFETCH_FRAMES;
 
 //==============================================================================
 
@@ -123,6 +139,7 @@ extern const char ACTION_ID_SAVE_SCRIPT_AS[];
 extern const char ACTION_ID_TEMPLATES[];
 extern const char ACTION_ID_SETTINGS[];
 extern const char ACTION_ID_PREVIEW[];
+extern const char ACTION_ID_RELOAD_AND_PREVIEW[];
 extern const char ACTION_ID_CHECK_SCRIPT[];
 extern const char ACTION_ID_BENCHMARK[];
 extern const char ACTION_ID_CLI_ENCODE[];
@@ -133,6 +150,7 @@ extern const char ACTION_ID_EXIT[];
 extern const char ACTION_ID_ABOUT[];
 extern const char ACTION_ID_AUTOCOMPLETE[];
 extern const char ACTION_ID_SAVE_SNAPSHOT[];
+extern const char ACTION_ID_BATCH_SNAPSHOT_EXPORT[];
 extern const char ACTION_ID_TOGGLE_ZOOM_PANEL[];
 extern const char ACTION_ID_SET_ZOOM_MODE_NO_ZOOM[];
 extern const char ACTION_ID_SET_ZOOM_MODE_FIXED_RATIO[];
@@ -149,7 +167,13 @@ extern const char ACTION_ID_TIME_STEP_FORWARD[];
 extern const char ACTION_ID_TIME_STEP_BACK[];
 extern const char ACTION_ID_ADVANCED_PREVIEW_SETTINGS[];
 extern const char ACTION_ID_TOGGLE_COLOR_PICKER[];
+extern const char ACTION_ID_TOGGLE_REGION_STATISTICS[];
+extern const char ACTION_ID_SHOW_NODE_TIMING[];
 extern const char ACTION_ID_PLAY[];
+extern const char ACTION_ID_TOGGLE_REAL_TIME_PLAY[];
+extern const char ACTION_ID_TOGGLE_PLAYBACK_STATISTICS[];
+extern const char ACTION_ID_COMPARE_FLIP[];
+extern const char ACTION_ID_EXPORT_COMPARE_METRICS[];
 extern const char ACTION_ID_DUPLICATE_SELECTION[];
 extern const char ACTION_ID_COMMENT_SELECTION[];
 extern const char ACTION_ID_UNCOMMENT_SELECTION[];
@@ -160,6 +184,10 @@ extern const char ACTION_ID_TIMELINE_BOOKMARK_CURRENT_FRAME[];
 extern const char ACTION_ID_TIMELINE_UNBOOKMARK_CURRENT_FRAME[];
 extern const char ACTION_ID_TIMELINE_GO_TO_PREVIOUS_BOOKMARK[];
 extern const char ACTION_ID_TIMELINE_GO_TO_NEXT_BOOKMARK[];
+extern const char ACTION_ID_TIMELINE_SCAN_MARKERS[];
+extern const char ACTION_ID_TIMELINE_CLEAR_MARKERS[];
+extern const char ACTION_ID_TIMELINE_GO_TO_PREVIOUS_MARKER[];
+extern const char ACTION_ID_TIMELINE_GO_TO_NEXT_MARKER[];
 extern const char ACTION_ID_PASTE_SHOWN_FRAME_NUMBER_INTO_SCRIPT[];
 extern const char ACTION_ID_MOVE_TEXT_BLOCK_UP[];
 extern const char ACTION_ID_MOVE_TEXT_BLOCK_DOWN[];
@@ -168,6 +196,8 @@ extern const char ACTION_ID_SHUTDOWN_SERVER_AND_EXIT[];
 extern const char ACTION_ID_SET_TRUSTED_CLIENTS_ADDRESSES[];
 extern const char ACTION_ID_JUMP_TO_FRAME[];
 extern const char ACTION_ID_TOGGLE_FRAME_PROPS[];
+extern const char ACTION_ID_TOGGLE_SCOPES[];
+extern const char ACTION_ID_TOGGLE_THUMBNAIL_STRIP[];
 extern const char ACTION_ID_SET_OUTPUT_INDEX_0[];
 extern const char ACTION_ID_SET_OUTPUT_INDEX_1[];
 extern const char ACTION_ID_SET_OUTPUT_INDEX_2[];
@@ -207,6 +237,7 @@ extern const char COLOR_ID_TEXT_BACKGROUND[];
 extern const char COLOR_ID_ACTIVE_LINE[];
 extern const char COLOR_ID_SELECTION_MATCHES[];
 extern const char COLOR_ID_TIMELINE_BOOKMARKS[];
+extern const char COLOR_ID_TIMELINE_MARKERS[];
 
 //==============================================================================
 
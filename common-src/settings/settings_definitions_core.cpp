@@ -8,6 +8,10 @@
 //==============================================================================
 
 const bool DEFAULT_PREFER_VS_LIBRARIES_FROM_LIST = false;
+const int DEFAULT_WARM_CORE_POOL_SIZE = 1;
+const int DEFAULT_CORE_CACHE_SIZE = 0;
+const CacheSizeUnit DEFAULT_CORE_CACHE_SIZE_UNIT = CacheSizeUnit::Megabytes;
+const int DEFAULT_CORE_THREADS = 0;
 const ResamplingFilter DEFAULT_CHROMA_RESAMPLING_FILTER =
 	ResamplingFilter::Bicubic;
 const YuvMatrixCoefficients DEFAULT_YUV_MATRIX_COEFFICIENTS =
@@ -17,6 +21,8 @@ const double DEFAULT_BICUBIC_FILTER_PARAMETER_B = 0.0;
 const double DEFAULT_BICUBIC_FILTER_PARAMETER_C = 0.5;
 const int DEFAULT_LANCZOS_FILTER_TAPS = 3;
 const DitherType DEFAULT_DITHER_TYPE = DitherType::ERROR_DIFFUSION;
+const int DEFAULT_FRAME_REQUESTS_LIMIT = 0;
+const bool DEFAULT_FAST_YUV_TO_RGB = true;
 const EncodingType DEFAULT_ENCODING_TYPE = EncodingType::CLI;
 const EncodingHeaderType DEFAULT_ENCODING_HEADER_TYPE =
 	EncodingHeaderType::NoHeader;
@@ -219,6 +225,15 @@ JobProperties JobProperties::fromJson(const QJsonObject & a_object)
 
 //==============================================================================
 
+CoreResourceSettings::CoreResourceSettings():
+	  cacheSize(DEFAULT_CORE_CACHE_SIZE)
+	, cacheSizeUnit(DEFAULT_CORE_CACHE_SIZE_UNIT)
+	, threads(DEFAULT_CORE_THREADS)
+{
+}
+
+//==============================================================================
+
 EncodingPreset::EncodingPreset(const QString & a_name):
 	  name(a_name)
 	, type(DEFAULT_ENCODING_TYPE)
@@ -137,6 +137,23 @@ struct JobProperties
 	static JobProperties fromJson(const QJsonObject & a_object);
 };
 
+enum class CacheSizeUnit : int
+{
+	Megabytes,
+	PercentOfRAM,
+};
+
+// Core resources for one kind of processing.
+// Zero cache size or thread count means picking the value automatically.
+struct CoreResourceSettings
+{
+	int cacheSize;
+	CacheSizeUnit cacheSizeUnit;
+	int threads;
+
+	CoreResourceSettings();
+};
+
 struct EncodingPreset
 {
 	QString name;
@@ -154,6 +171,10 @@ struct EncodingPreset
 //==============================================================================
 
 extern const bool DEFAULT_PREFER_VS_LIBRARIES_FROM_LIST;
+extern const int DEFAULT_WARM_CORE_POOL_SIZE;
+extern const int DEFAULT_CORE_CACHE_SIZE;
+extern const CacheSizeUnit DEFAULT_CORE_CACHE_SIZE_UNIT;
+extern const int DEFAULT_CORE_THREADS;
 extern const ResamplingFilter DEFAULT_CHROMA_RESAMPLING_FILTER;
 extern const YuvMatrixCoefficients DEFAULT_YUV_MATRIX_COEFFICIENTS;
 extern const ChromaPlacement DEFAULT_CHROMA_PLACEMENT;
@@ -161,6 +182,8 @@ extern const double DEFAULT_BICUBIC_FILTER_PARAMETER_B;
 extern const double DEFAULT_BICUBIC_FILTER_PARAMETER_C;
 extern const int DEFAULT_LANCZOS_FILTER_TAPS;
 extern const DitherType DEFAULT_DITHER_TYPE;
+extern const int DEFAULT_FRAME_REQUESTS_LIMIT;
+extern const bool DEFAULT_FAST_YUV_TO_RGB;
 extern const EncodingType DEFAULT_ENCODING_TYPE;
 extern const EncodingHeaderType DEFAULT_ENCODING_HEADER_TYPE;
 extern const JobType DEFAULT_JOB_TYPE;
@@ -37,6 +37,10 @@ const char TIME_STEP_KEY[] = "time_step_mode";
 const char COLOR_PICKER_VISIBLE_KEY[] = "color_picker_visible";
 const char PLAY_FPS_LIMIT_MODE_KEY[] = "play_fps_limit_mode";
 const char PLAY_FPS_LIMIT_KEY[] = "play_fps_limit";
+const char PLAY_REAL_TIME_KEY[] = "play_real_time";
+const char SHOW_PLAYBACK_STATISTICS_KEY[] = "show_playback_statistics";
+const char COMPARE_MODE_KEY[] = "compare_mode";
+const char COMPARE_OUTPUTS_KEY[] = "compare_outputs";
 const char USE_SPACES_AS_TAB_KEY[] = "use_spaces_as_tab";
 const char SPACES_IN_TAB_KEY[] = "spaces_in_tab";
 const char REMEMBER_LAST_PREVIEW_FRAME_KEY[] = "remember_last_preview_frame";
@@ -48,6 +52,7 @@ const char HIGHLIGHT_SELECTION_MATCHES_KEY[] = "highlight_selection_matches";
 const char HIGHLIGHT_SELECTION_MATCHES_MIN_LENGTH_KEY[] =
 	"highlight_selection_matches_min_length";
 const char TIMELINE_PANEL_VISIBLE_KEY[] = "timeline_panel_visible";
+const char THUMBNAIL_STRIP_VISIBLE_KEY[] = "thumbnail_strip_visible";
 const char ALWAYS_KEEP_CURRENT_FRAME_KEY[] = "always_keep_current_frame";
 const char LAST_SNAPSHOT_EXTENSION_KEY[] = "last_snapshot_extension";
 const char PNG_COMPRESSION_LEVEL_KEY[] = "png_compression_level";
@@ -55,6 +60,9 @@ const char DEBUG_MESSAGES_KEY[] = "show_debug_messages";
 const char DARK_MODE_KEY[] = "dark_mode";
 const char SILENT_SNAPSHOT_KEY[] = "silent_snapshot";
 const char SNAPSHOT_TEMPLATE_KEY[] = "snapshot_template";
+const char PREVIEW_AT_DISPLAY_SIZE_KEY[] = "preview_at_display_size";
+const char PREVIEW_FRAME_CACHE_SIZE_KEY[] = "preview_frame_cache_size";
+const char PREVIEW_PREFETCH_FRAMES_KEY[] = "preview_prefetch_frames";
 
 //==============================================================================
 
@@ -139,6 +147,8 @@ void SettingsManager::initializeStandardActions()
 			QKeySequence()},
 		{ACTION_ID_PREVIEW, tr("Preview"), QIcon(":preview.png"),
 			QKeySequence(Qt::Key_F5)},
+		{ACTION_ID_RELOAD_AND_PREVIEW, tr("Reload and preview"),
+			QIcon(":preview.png"), QKeySequence(Qt::CTRL | Qt::Key_F5)},
 		{ACTION_ID_CHECK_SCRIPT, tr("Check script"), QIcon(":check.png"),
 			QKeySequence(Qt::Key_F6)},
 		{ACTION_ID_BENCHMARK, tr("Benchmark"), QIcon(":benchmark.png"),
@@ -160,6 +170,8 @@ void SettingsManager::initializeStandardActions()
 			QIcon(":image_to_clipboard.png"), QKeySequence(Qt::Key_X)},
 		{ACTION_ID_SAVE_SNAPSHOT, tr("Save snapshot"),
 			QIcon(":snapshot.png"), QKeySequence(Qt::Key_S)},
+		{ACTION_ID_BATCH_SNAPSHOT_EXPORT, tr("Batch snapshot export"),
+			QIcon(":snapshot.png"), QKeySequence()},
 		{ACTION_ID_TOGGLE_ZOOM_PANEL, tr("Show zoom panel"),
 			QIcon(":zoom.png"), QKeySequence(Qt::Key_Z)},
 		{ACTION_ID_SET_ZOOM_MODE_NO_ZOOM, tr("Zoom: No zoom"),
@@ -197,7 +209,19 @@ void SettingsManager::initializeStandardActions()
 			QKeySequence()},
 		{ACTION_ID_TOGGLE_COLOR_PICKER, tr("Color panel"),
 			QIcon(":color_picker.png"), QKeySequence()},
+		{ACTION_ID_TOGGLE_REGION_STATISTICS, tr("Region statistics"),
+			QIcon(), QKeySequence(Qt::Key_R)},
+		{ACTION_ID_SHOW_NODE_TIMING, tr("Filter timing"),
+			QIcon(":benchmark.png"), QKeySequence()},
 		{ACTION_ID_PLAY, tr("Play"), QIcon(":play.png"), QKeySequence()},
+		{ACTION_ID_TOGGLE_REAL_TIME_PLAY, tr("Real time"), QIcon(),
+			QKeySequence()},
+		{ACTION_ID_TOGGLE_PLAYBACK_STATISTICS, tr("Stats"), QIcon(),
+			QKeySequence()},
+		{ACTION_ID_COMPARE_FLIP, tr("Flip compared outputs"), QIcon(),
+			QKeySequence(Qt::Key_F)},
+		{ACTION_ID_EXPORT_COMPARE_METRICS, tr("Export compare metrics"),
+			QIcon(), QKeySequence()},
 		{ACTION_ID_TIMELINE_LOAD_CHAPTERS, tr("Load chapters"),
 			QIcon(":load.png"), QKeySequence()},
 		{ACTION_ID_TIMELINE_CLEAR_BOOKMARKS, tr("Clear bookmarks"),
@@ -218,6 +242,16 @@ void SettingsManager::initializeStandardActions()
 			tr("Go to next bookmark"),
 			QIcon(":timeline_bookmark_next.png"),
 			QKeySequence(Qt::CTRL | Qt::Key_Right)},
+		{ACTION_ID_TIMELINE_SCAN_MARKERS, tr("Scan frames for markers..."),
+			QIcon(), QKeySequence()},
+		{ACTION_ID_TIMELINE_CLEAR_MARKERS, tr("Clear markers"),
+			QIcon(), QKeySequence()},
+		{ACTION_ID_TIMELINE_GO_TO_PREVIOUS_MARKER,
+			tr("Go to previous marker"), QIcon(),
+			QKeySequence(Qt::ALT | Qt::Key_Left)},
+		{ACTION_ID_TIMELINE_GO_TO_NEXT_MARKER,
+			tr("Go to next marker"), QIcon(),
+			QKeySequence(Qt::ALT | Qt::Key_Right)},
 		{ACTION_ID_PASTE_SHOWN_FRAME_NUMBER_INTO_SCRIPT,
 			tr("Paste shown frame number into script"), QIcon(),
 			QKeySequence()},
@@ -235,6 +269,10 @@ void SettingsManager::initializeStandardActions()
 			QIcon(), QKeySequence(Qt::Key_J)},
 		{ACTION_ID_TOGGLE_FRAME_PROPS, tr("Toggle frame properties panel"),
 			QIcon(), QKeySequence(Qt::Key_P)},
+		{ACTION_ID_TOGGLE_SCOPES, tr("Toggle scopes panel"),
+			QIcon(), QKeySequence(Qt::Key_H)},
+		{ACTION_ID_TOGGLE_THUMBNAIL_STRIP, tr("Show thumbnail strip"),
+			QIcon(), QKeySequence(Qt::Key_M)},
 		{ACTION_ID_SET_OUTPUT_INDEX_0, tr("Switch to output index 0"),
 			QIcon(), QKeySequence(Qt::Key_0)},
 		{ACTION_ID_SET_OUTPUT_INDEX_1, tr("Switch to output index 1"),
@@ -481,6 +519,9 @@ QColor SettingsManager::getDefaultColor(const QString & a_colorID) const
 	if(a_colorID == COLOR_ID_TIMELINE_BOOKMARKS)
 		return Qt::magenta;
 
+	if(a_colorID == COLOR_ID_TIMELINE_MARKERS)
+		return QColor(255, 140, 0);
+
 	return defaultColor;
 }
 
@@ -848,6 +889,56 @@ bool SettingsManager::setPlayFPSLimit(double a_limit)
 
 //==============================================================================
 
+bool SettingsManager::getPlayRealTime() const
+{
+	return value(PLAY_REAL_TIME_KEY, DEFAULT_PLAY_REAL_TIME).toBool();
+}
+
+bool SettingsManager::setPlayRealTime(bool a_realTime)
+{
+	return setValue(PLAY_REAL_TIME_KEY, a_realTime);
+}
+
+//==============================================================================
+
+bool SettingsManager::getShowPlaybackStatistics() const
+{
+	return value(SHOW_PLAYBACK_STATISTICS_KEY,
+		DEFAULT_SHOW_PLAYBACK_STATISTICS).toBool();
+}
+
+bool SettingsManager::setShowPlaybackStatistics(bool a_show)
+{
+	return setValue(SHOW_PLAYBACK_STATISTICS_KEY, a_show);
+}
+
+//==============================================================================
+
+CompareMode SettingsManager::getCompareMode() const
+{
+	return (CompareMode)value(COMPARE_MODE_KEY,
+		(int)DEFAULT_COMPARE_MODE).toInt();
+}
+
+bool SettingsManager::setCompareMode(CompareMode a_mode)
+{
+	return setValue(COMPARE_MODE_KEY, (int)a_mode);
+}
+
+//==============================================================================
+
+QString SettingsManager::getCompareOutputs() const
+{
+	return value(COMPARE_OUTPUTS_KEY, DEFAULT_COMPARE_OUTPUTS).toString();
+}
+
+bool SettingsManager::setCompareOutputs(const QString & a_outputs)
+{
+	return setValue(COMPARE_OUTPUTS_KEY, a_outputs);
+}
+
+//==============================================================================
+
 bool SettingsManager::getUseSpacesAsTab() const
 {
 	return value(USE_SPACES_AS_TAB_KEY, DEFAULT_USE_SPACES_AS_TAB).toBool();
@@ -1128,6 +1219,19 @@ bool SettingsManager::setTimeLinePanelVisible(bool a_visible)
 
 //==============================================================================
 
+bool SettingsManager::getThumbnailStripVisible() const
+{
+	return value(THUMBNAIL_STRIP_VISIBLE_KEY,
+		DEFAULT_THUMBNAIL_STRIP_VISIBLE).toBool();
+}
+
+bool SettingsManager::setThumbnailStripVisible(bool a_visible)
+{
+	return setValue(THUMBNAIL_STRIP_VISIBLE_KEY, a_visible);
+}
+
+//==============================================================================
+
 bool SettingsManager::getAlwaysKeepCurrentFrame() const
 {
 	return value(ALWAYS_KEEP_CURRENT_FRAME_KEY,
@@ -1279,4 +1383,37 @@ bool SettingsManager::setSnapshotTemplate(const QString & a_template)
 	return setValue(SNAPSHOT_TEMPLATE_KEY, a_template);
 }
 
+bool SettingsManager::getPreviewAtDisplaySize() const
+{
+	return value(PREVIEW_AT_DISPLAY_SIZE_KEY,
+		DEFAULT_PREVIEW_AT_DISPLAY_SIZE).toBool();
+}
+
+bool SettingsManager::setPreviewAtDisplaySize(bool a_set)
+{
+	return setValue(PREVIEW_AT_DISPLAY_SIZE_KEY, a_set);
+}
+
+int SettingsManager::getPreviewFrameCacheSize() const
+{
+	return value(PREVIEW_FRAME_CACHE_SIZE_KEY,
+		DEFAULT_PREVIEW_FRAME_CACHE_SIZE).toInt();
+}
+
+bool SettingsManager::setPreviewFrameCacheSize(int a_megabytes)
+{
+	return setValue(PREVIEW_FRAME_CACHE_SIZE_KEY, a_megabytes);
+}
+
+int SettingsManager::getPreviewPrefetchFrames() const
+{
+	return value(PREVIEW_PREFETCH_FRAMES_KEY,
+		DEFAULT_PREVIEW_PREFETCH_FRAMES).toInt();
+}
+
+bool SettingsManager::setPreviewPrefetchFrames(int a_frames)
+{
+	return setValue(PREVIEW_PREFETCH_FRAMES_KEY, a_frames);
+}
+
 //==============================================================================
@@ -156,6 +156,22 @@ public:
 
 	bool setPlayFPSLimit(double a_limit);
 
+	bool getPlayRealTime() const;
+
+	bool setPlayRealTime(bool a_realTime);
+
+	bool getShowPlaybackStatistics() const;
+
+	bool setShowPlaybackStatistics(bool a_show);
+
+	CompareMode getCompareMode() const;
+
+	bool setCompareMode(CompareMode a_mode);
+
+	QString getCompareOutputs() const;
+
+	bool setCompareOutputs(const QString & a_outputs);
+
 	bool getUseSpacesAsTab() const;
 
 	bool setUseSpacesAsTab(bool a_value);
@@ -216,6 +232,10 @@ public:
 
 	bool setTimeLinePanelVisible(bool a_visible);
 
+	bool getThumbnailStripVisible() const;
+
+	bool setThumbnailStripVisible(bool a_visible);
+
 	bool getAlwaysKeepCurrentFrame() const;
 
 	bool setAlwaysKeepCurrentFrame(bool a_keep);
@@ -251,6 +271,20 @@ public:
 
 	bool setSnapshotTemplate(const QString & a_template);
 
+	bool getPreviewAtDisplaySize() const;
+
+	bool setPreviewAtDisplaySize(bool a_set);
+
+	/// Megabytes of recently shown frames the preview keeps.
+	int getPreviewFrameCacheSize() const;
+
+	bool setPreviewFrameCacheSize(int a_megabytes);
+
+	/// Frames ahead of the navigation the preview requests in advance.
+	int getPreviewPrefetchFrames() const;
+
+	bool setPreviewPrefetchFrames(int a_frames);
+
 private:
 
 	void initializeStandardActions();
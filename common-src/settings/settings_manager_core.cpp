@@ -1,5 +1,7 @@
 #include "settings_manager_core.h"
 
+#include "../helpers_vs.h"
+
 #include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
@@ -16,6 +18,7 @@ const char COMMON_GROUP[] = "common";
 
 const char VAPOURSYNTH_LIBRARY_PATHS_KEY[] = "vapoursynth_library_paths";
 const char PREFER_VS_LIBRARIES_FROM_LIST_KEY[] = "prefer_vs_libs_from_list";
+const char WARM_CORE_POOL_SIZE_KEY[] = "warm_core_pool_size";
 const char CHROMA_RESAMPLING_FILTER_KEY[] = "chroma_resampling_filter";
 const char YUV_MATRIX_COEFFICIENTS_KEY[] = "yuv_matrix_coefficients";
 const char CHROMA_PLACEMENT_KEY[] = "chroma_placement";
@@ -23,11 +26,21 @@ const char BICUBIC_FILTER_PARAMETER_B_KEY[] = "bicubic_filter_parameter_b";
 const char BICUBIC_FILTER_PARAMETER_C_KEY[] = "bicubic_filter_parameter_c";
 const char LANCZOS_FILTER_TAPS_KEY[] = "lanczos_filter_taps";
 const char DITHER_TYPE_KEY[] = "dither_type";
+const char FRAME_REQUESTS_LIMIT_KEY[] = "frame_requests_limit";
+const char FAST_YUV_TO_RGB_KEY[] = "fast_yuv_to_rgb";
 const char RECENT_JOB_SERVERS_KEY[] = "recent_job_servers";
 const char TRUSTED_CLIENTS_ADDRESSES_KEY[] = "trusted_clients_addresses";
 
 //==============================================================================
 
+const char CORE_RESOURCES_GROUP[] = "core_resources";
+
+const char CORE_CACHE_SIZE_KEY[] = "cache_size";
+const char CORE_CACHE_SIZE_UNIT_KEY[] = "cache_size_unit";
+const char CORE_THREADS_KEY[] = "threads";
+
+//==============================================================================
+
 const char ENCODING_PRESETS_GROUP[] = "encoding_presets";
 
 const char ENCODING_PRESET_ENCODING_TYPE_KEY[] = "encoding_type";
@@ -166,6 +179,17 @@ bool SettingsManagerCore::setPreferVSLibrariesFromList(bool a_prior)
 	return setValue(PREFER_VS_LIBRARIES_FROM_LIST_KEY, a_prior);
 }
 
+int SettingsManagerCore::getWarmCorePoolSize() const
+{
+	return value(WARM_CORE_POOL_SIZE_KEY,
+		DEFAULT_WARM_CORE_POOL_SIZE).toInt();
+}
+
+bool SettingsManagerCore::setWarmCorePoolSize(int a_size)
+{
+	return setValue(WARM_CORE_POOL_SIZE_KEY, a_size);
+}
+
 
 //==============================================================================
 
@@ -317,6 +341,75 @@ bool SettingsManagerCore::setDitherType(DitherType a_dither)
     return setValue(DITHER_TYPE_KEY, (int)a_dither);
 }
 
+int SettingsManagerCore::getFrameRequestsLimit() const
+{
+	return value(FRAME_REQUESTS_LIMIT_KEY,
+		DEFAULT_FRAME_REQUESTS_LIMIT).toInt();
+}
+
+bool SettingsManagerCore::setFrameRequestsLimit(int a_limit)
+{
+	return setValue(FRAME_REQUESTS_LIMIT_KEY, a_limit);
+}
+
+bool SettingsManagerCore::getFastYuvToRgb() const
+{
+	return value(FAST_YUV_TO_RGB_KEY, DEFAULT_FAST_YUV_TO_RGB).toBool();
+}
+
+bool SettingsManagerCore::setFastYuvToRgb(bool a_fast)
+{
+	return setValue(FAST_YUV_TO_RGB_KEY, a_fast);
+}
+
+CoreResourceSettings SettingsManagerCore::getCoreResourceSettings(
+	ProcessReason a_reason) const
+{
+	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
+	settings.beginGroup(CORE_RESOURCES_GROUP);
+	settings.beginGroup(coreResourcesSubgroup(a_reason));
+
+	CoreResourceSettings resources;
+	resources.cacheSize = settings.value(CORE_CACHE_SIZE_KEY,
+		DEFAULT_CORE_CACHE_SIZE).toInt();
+	resources.cacheSizeUnit = (CacheSizeUnit)settings.value(
+		CORE_CACHE_SIZE_UNIT_KEY, (int)DEFAULT_CORE_CACHE_SIZE_UNIT).toInt();
+	resources.threads = settings.value(CORE_THREADS_KEY,
+		DEFAULT_CORE_THREADS).toInt();
+
+	return resources;
+}
+
+bool SettingsManagerCore::setCoreResourceSettings(ProcessReason a_reason,
+	const CoreResourceSettings & a_resources)
+{
+	QSettings settings(m_settingsFilePath, QSettings::IniFormat);
+	settings.beginGroup(CORE_RESOURCES_GROUP);
+	settings.beginGroup(coreResourcesSubgroup(a_reason));
+
+	settings.setValue(CORE_CACHE_SIZE_KEY, a_resources.cacheSize);
+	settings.setValue(CORE_CACHE_SIZE_UNIT_KEY,
+		(int)a_resources.cacheSizeUnit);
+	settings.setValue(CORE_THREADS_KEY, a_resources.threads);
+
+	settings.sync();
+	bool success = (QSettings::NoError == settings.status());
+	return success;
+}
+
+QString SettingsManagerCore::coreResourcesSubgroup(ProcessReason a_reason)
+{
+	switch(a_reason)
+	{
+	case ProcessReason::Benchmark:
+		return "benchmark";
+	case ProcessReason::Encode:
+		return "encode";
+	default:
+		return "preview";
+	}
+}
+
 //==============================================================================
 
 std::vector<EncodingPreset> SettingsManagerCore::getAllEncodingPresets() const
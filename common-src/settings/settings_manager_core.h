@@ -7,6 +7,8 @@
 #include <QVariant>
 #include <vector>
 
+enum class ProcessReason;
+
 /// Base class that manages non-GUI related settings
 class SettingsManagerCore : public QObject
 {
@@ -31,6 +33,10 @@ public:
 
 	bool setPreferVSLibrariesFromList(bool a_prior);
 
+	int getWarmCorePoolSize() const;
+
+	bool setWarmCorePoolSize(int a_size);
+
 	ResamplingFilter getChromaResamplingFilter() const;
 
 	bool setChromaResamplingFilter(ResamplingFilter a_filter);
@@ -59,6 +65,21 @@ public:
 
 	bool setDitherType(DitherType a_dither);
 
+	int getFrameRequestsLimit() const;
+
+	bool setFrameRequestsLimit(int a_limit);
+
+	bool getFastYuvToRgb() const;
+
+	bool setFastYuvToRgb(bool a_fast);
+
+	/// Check shares the preview resources.
+	CoreResourceSettings getCoreResourceSettings(
+		ProcessReason a_reason) const;
+
+	bool setCoreResourceSettings(ProcessReason a_reason,
+		const CoreResourceSettings & a_resources);
+
 	std::vector<EncodingPreset> getAllEncodingPresets() const;
 
 	EncodingPreset getEncodingPreset(const QString & a_name) const;
@@ -94,6 +115,8 @@ protected:
 
 	bool setValue(const QString & a_key, const QVariant & a_value);
 
+	static QString coreResourcesSubgroup(ProcessReason a_reason);
+
 	QString m_settingsFilePath;
 };
 
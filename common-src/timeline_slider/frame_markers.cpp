@@ -0,0 +1,359 @@
+#include "frame_markers.h"
+
+#include <QStringList>
+#include <algorithm>
+
+//==============================================================================
+
+namespace
+{
+
+const int BITS_IN_WORD = 64;
+
+int popCount(uint64_t a_word)
+{
+	a_word = a_word - ((a_word >> 1) & 0x5555555555555555ULL);
+	a_word = (a_word & 0x3333333333333333ULL) +
+		((a_word >> 2) & 0x3333333333333333ULL);
+	a_word = (a_word + (a_word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (int)((a_word * 0x0101010101010101ULL) >> 56);
+}
+
+// Bits from a_first to a_last of a word, both included.
+uint64_t wordMask(int a_first, int a_last)
+{
+	uint64_t high = (a_last == BITS_IN_WORD - 1) ? ~0ULL :
+		((1ULL << (a_last + 1)) - 1);
+	uint64_t low = (1ULL << a_first) - 1;
+	return high & ~low;
+}
+
+}
+
+//==============================================================================
+
+FrameMarkers::FrameMarkers():
+	  m_framesNumber(0)
+	, m_scanned()
+	, m_marked()
+	, m_scannedCount(0)
+	, m_markedCount(0)
+{
+}
+
+// END OF FrameMarkers::FrameMarkers()
+//==============================================================================
+
+FrameMarkers::~FrameMarkers()
+{
+}
+
+// END OF FrameMarkers::~FrameMarkers()
+//==============================================================================
+
+void FrameMarkers::reset(int a_framesNumber)
+{
+	m_framesNumber = std::max(a_framesNumber, 0);
+	size_t words = (size_t)(m_framesNumber + BITS_IN_WORD - 1) / BITS_IN_WORD;
+	m_scanned.assign(words, 0);
+	m_marked.assign(words, 0);
+	m_scannedCount = 0;
+	m_markedCount = 0;
+}
+
+// END OF void FrameMarkers::reset(int a_framesNumber)
+//==============================================================================
+
+int FrameMarkers::framesNumber() const
+{
+	return m_framesNumber;
+}
+
+// END OF int FrameMarkers::framesNumber() const
+//==============================================================================
+
+void FrameMarkers::setScanned(int a_frame, bool a_marked)
+{
+	if((a_frame < 0) || (a_frame >= m_framesNumber))
+		return;
+
+	size_t word = (size_t)a_frame / BITS_IN_WORD;
+	uint64_t mask = 1ULL << (a_frame % BITS_IN_WORD);
+
+	if(!(m_scanned[word] & mask))
+	{
+		m_scanned[word] |= mask;
+		m_scannedCount++;
+	}
+
+	bool wasMarked = (m_marked[word] & mask);
+	if(a_marked && (!wasMarked))
+	{
+		m_marked[word] |= mask;
+		m_markedCount++;
+	}
+	else if((!a_marked) && wasMarked)
+	{
+		m_marked[word] &= ~mask;
+		m_markedCount--;
+	}
+}
+
+// END OF void FrameMarkers::setScanned(int a_frame, bool a_marked)
+//==============================================================================
+
+bool FrameMarkers::isScanned(int a_frame) const
+{
+	if((a_frame < 0) || (a_frame >= m_framesNumber))
+		return false;
+	return bit(m_scanned, a_frame);
+}
+
+// END OF bool FrameMarkers::isScanned(int a_frame) const
+//==============================================================================
+
+bool FrameMarkers::isMarked(int a_frame) const
+{
+	if((a_frame < 0) || (a_frame >= m_framesNumber))
+		return false;
+	return bit(m_marked, a_frame);
+}
+
+// END OF bool FrameMarkers::isMarked(int a_frame) const
+//==============================================================================
+
+int FrameMarkers::scannedCount() const
+{
+	return m_scannedCount;
+}
+
+// END OF int FrameMarkers::scannedCount() const
+//==============================================================================
+
+int FrameMarkers::markedCount() const
+{
+	return m_markedCount;
+}
+
+// END OF int FrameMarkers::markedCount() const
+//==============================================================================
+
+bool FrameMarkers::complete() const
+{
+	return (m_scannedCount == m_framesNumber);
+}
+
+// END OF bool FrameMarkers::complete() const
+//==============================================================================
+
+int FrameMarkers::nextUnscanned(int a_frame) const
+{
+	for(int frame = std::max(a_frame, 0); frame < m_framesNumber; ++frame)
+	{
+		// Skip the words scanned through.
+		if((frame % BITS_IN_WORD == 0) &&
+			(m_scanned[(size_t)frame / BITS_IN_WORD] == ~0ULL))
+		{
+			frame += BITS_IN_WORD - 1;
+			continue;
+		}
+		if(!bit(m_scanned, frame))
+			return frame;
+	}
+	return -1;
+}
+
+// END OF int FrameMarkers::nextUnscanned(int a_frame) const
+//==============================================================================
+
+int FrameMarkers::previousMarked(int a_frame) const
+{
+	for(int frame = std::min(a_frame, m_framesNumber) - 1; frame >= 0;
+		--frame)
+	{
+		if((frame % BITS_IN_WORD == BITS_IN_WORD - 1) &&
+			(m_marked[(size_t)frame / BITS_IN_WORD] == 0))
+		{
+			frame -= BITS_IN_WORD - 1;
+			continue;
+		}
+		if(bit(m_marked, frame))
+			return frame;
+	}
+	return -1;
+}
+
+// END OF int FrameMarkers::previousMarked(int a_frame) const
+//==============================================================================
+
+int FrameMarkers::nextMarked(int a_frame) const
+{
+	for(int frame = std::max(a_frame + 1, 0); frame < m_framesNumber;
+		++frame)
+	{
+		if((frame % BITS_IN_WORD == 0) &&
+			(m_marked[(size_t)frame / BITS_IN_WORD] == 0))
+		{
+			frame += BITS_IN_WORD - 1;
+			continue;
+		}
+		if(bit(m_marked, frame))
+			return frame;
+	}
+	return -1;
+}
+
+// END OF int FrameMarkers::nextMarked(int a_frame) const
+//==============================================================================
+
+void FrameMarkers::countInRange(int a_first, int a_last, int & a_scanned,
+	int & a_marked) const
+{
+	a_first = std::max(a_first, 0);
+	a_last = std::min(a_last, m_framesNumber - 1);
+	a_scanned = countBits(m_scanned, a_first, a_last);
+	a_marked = countBits(m_marked, a_first, a_last);
+}
+
+// END OF void FrameMarkers::countInRange(int a_first, int a_last,
+//		int & a_scanned, int & a_marked) const
+//==============================================================================
+
+QString FrameMarkers::scannedRuns() const
+{
+	return runs(m_scanned);
+}
+
+// END OF QString FrameMarkers::scannedRuns() const
+//==============================================================================
+
+QString FrameMarkers::markedRuns() const
+{
+	return runs(m_marked);
+}
+
+// END OF QString FrameMarkers::markedRuns() const
+//==============================================================================
+
+bool FrameMarkers::setScannedRuns(const QString & a_runs)
+{
+	return setRuns(m_scanned, m_scannedCount, a_runs);
+}
+
+// END OF bool FrameMarkers::setScannedRuns(const QString & a_runs)
+//==============================================================================
+
+bool FrameMarkers::setMarkedRuns(const QString & a_runs)
+{
+	return setRuns(m_marked, m_markedCount, a_runs);
+}
+
+// END OF bool FrameMarkers::setMarkedRuns(const QString & a_runs)
+//==============================================================================
+
+bool FrameMarkers::bit(const std::vector<uint64_t> & a_bits, int a_frame)
+{
+	return (a_bits[(size_t)a_frame / BITS_IN_WORD] &
+		(1ULL << (a_frame % BITS_IN_WORD))) != 0;
+}
+
+// END OF bool FrameMarkers::bit(const std::vector<uint64_t> & a_bits,
+//		int a_frame)
+//==============================================================================
+
+int FrameMarkers::countBits(const std::vector<uint64_t> & a_bits,
+	int a_first, int a_last)
+{
+	if(a_first > a_last)
+		return 0;
+
+	size_t firstWord = (size_t)a_first / BITS_IN_WORD;
+	size_t lastWord = (size_t)a_last / BITS_IN_WORD;
+	int firstBit = a_first % BITS_IN_WORD;
+	int lastBit = a_last % BITS_IN_WORD;
+
+	if(firstWord == lastWord)
+		return popCount(a_bits[firstWord] & wordMask(firstBit, lastBit));
+
+	int count = popCount(a_bits[firstWord] &
+		wordMask(firstBit, BITS_IN_WORD - 1));
+	for(size_t i = firstWord + 1; i < lastWord; ++i)
+		count += popCount(a_bits[i]);
+	count += popCount(a_bits[lastWord] & wordMask(0, lastBit));
+	return count;
+}
+
+// END OF int FrameMarkers::countBits(const std::vector<uint64_t> & a_bits,
+//		int a_first, int a_last)
+//==============================================================================
+
+QString FrameMarkers::runs(const std::vector<uint64_t> & a_bits) const
+{
+	QStringList runsList;
+	int frame = 0;
+	while(frame < m_framesNumber)
+	{
+		if(!bit(a_bits, frame))
+		{
+			frame++;
+			continue;
+		}
+		int first = frame;
+		while((frame < m_framesNumber) && bit(a_bits, frame))
+			frame++;
+		int last = frame - 1;
+		if(first == last)
+			runsList += QString::number(first);
+		else
+			runsList += QString("%1-%2").arg(first).arg(last);
+	}
+	return runsList.join(",");
+}
+
+// END OF QString FrameMarkers::runs(const std::vector<uint64_t> & a_bits)
+//		const
+//==============================================================================
+
+bool FrameMarkers::setRuns(std::vector<uint64_t> & a_bits, int & a_count,
+	const QString & a_runs)
+{
+	std::fill(a_bits.begin(), a_bits.end(), 0);
+	a_count = 0;
+
+	QStringList runsList = a_runs.split(",", Qt::SkipEmptyParts);
+	for(const QString & run : runsList)
+	{
+		QStringList ends = run.simplified().split("-");
+		if(ends.size() > 2)
+			return false;
+		bool converted = false;
+		int first = ends[0].toInt(&converted);
+		if(!converted)
+			return false;
+		int last = first;
+		if(ends.size() == 2)
+		{
+			last = ends[1].toInt(&converted);
+			if(!converted)
+				return false;
+		}
+		if((first < 0) || (last < first) || (last >= m_framesNumber))
+			return false;
+
+		for(int frame = first; frame <= last; ++frame)
+		{
+			uint64_t mask = 1ULL << (frame % BITS_IN_WORD);
+			uint64_t & word = a_bits[(size_t)frame / BITS_IN_WORD];
+			if(!(word & mask))
+			{
+				word |= mask;
+				a_count++;
+			}
+		}
+	}
+	return true;
+}
+
+// END OF bool FrameMarkers::setRuns(std::vector<uint64_t> & a_bits,
+//		int & a_count, const QString & a_runs)
+//==============================================================================
@@ -0,0 +1,79 @@
+#ifndef FRAME_MARKERS_H_INCLUDED
+#define FRAME_MARKERS_H_INCLUDED
+
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+
+// Which frames of a clip were scanned and which of them were marked,
+// one bit per frame each.
+class FrameMarkers
+{
+public:
+
+	FrameMarkers();
+
+	virtual ~FrameMarkers();
+
+	// Drops all the marks.
+	void reset(int a_framesNumber);
+
+	int framesNumber() const;
+
+	void setScanned(int a_frame, bool a_marked);
+
+	bool isScanned(int a_frame) const;
+
+	bool isMarked(int a_frame) const;
+
+	int scannedCount() const;
+
+	int markedCount() const;
+
+	bool complete() const;
+
+	// The first frame from the given one that was not scanned,
+	// or -1 if there is none.
+	int nextUnscanned(int a_frame) const;
+
+	// Closest marked frames before and after the given one,
+	// or -1 if there is none.
+	int previousMarked(int a_frame) const;
+	int nextMarked(int a_frame) const;
+
+	// Counts the frames in the range including both ends.
+	void countInRange(int a_first, int a_last, int & a_scanned,
+		int & a_marked) const;
+
+	// Frame ranges as in "0-99,150,200-210".
+	QString scannedRuns() const;
+	QString markedRuns() const;
+	bool setScannedRuns(const QString & a_runs);
+	bool setMarkedRuns(const QString & a_runs);
+
+private:
+
+	static bool bit(const std::vector<uint64_t> & a_bits, int a_frame);
+
+	static int countBits(const std::vector<uint64_t> & a_bits, int a_first,
+		int a_last);
+
+	QString runs(const std::vector<uint64_t> & a_bits) const;
+
+	bool setRuns(std::vector<uint64_t> & a_bits, int & a_count,
+		const QString & a_runs);
+
+	int m_framesNumber;
+
+	std::vector<uint64_t> m_scanned;
+	std::vector<uint64_t> m_marked;
+
+	int m_scannedCount;
+	int m_markedCount;
+};
+
+//==============================================================================
+
+#endif // FRAME_MARKERS_H_INCLUDED
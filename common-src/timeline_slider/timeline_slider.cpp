@@ -1,6 +1,7 @@
 #include "timeline_slider.h"
 
 #include "../helpers.h"
+#include "frame_markers.h"
 
 #include <QKeyEvent>
 #include <QMouseEvent>
@@ -11,6 +12,7 @@
 #include <QMargins>
 #include <QToolTip>
 #include <QFontMetricsF>
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <cstdlib>
@@ -39,6 +41,7 @@ TimeLineSlider::TimeLineSlider(QWidget * a_pParent) : QWidget(a_pParent)
 	, m_minimumTicksSpacing(4)
 	, m_sliderPressed(false)
 	, m_labelsFont("Digital Mini")
+	, m_cpMarkers(nullptr)
 {
 	Q_ASSERT(m_bigStep > 0);
 
@@ -57,6 +60,7 @@ TimeLineSlider::TimeLineSlider(QWidget * a_pParent) : QWidget(a_pParent)
 	m_currentFramePointerColor = palette().color(QPalette::Dark);
 	m_slidingPointerColor = palette().color(QPalette::Text);
 	m_bookmarkColor = Qt::magenta;
+	m_markerColor = QColor(255, 140, 0);
 
 	m_colorRoleMap = {
 		{SlideLine, &m_slideLineColor},
@@ -65,6 +69,7 @@ TimeLineSlider::TimeLineSlider(QWidget * a_pParent) : QWidget(a_pParent)
 		{CurrentFramePointer, &m_currentFramePointerColor},
 		{SlidingPointer, &m_slidingPointerColor},
 		{Bookmark, &m_bookmarkColor},
+		{Marker, &m_markerColor},
 	};
 
 	setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Minimum);
@@ -272,6 +277,15 @@ int TimeLineSlider::getClosestBookmark(int a_frame) const
 // END OF int TimeLineSlider::getClosestBookmark(int a_frame) const
 //==============================================================================
 
+void TimeLineSlider::setMarkers(const FrameMarkers * a_cpMarkers)
+{
+	m_cpMarkers = a_cpMarkers;
+	update();
+}
+
+// END OF void TimeLineSlider::setMarkers(const FrameMarkers * a_cpMarkers)
+//==============================================================================
+
 void TimeLineSlider::slotStepUp()
 {
 	if(m_currentFrame < m_maxFrame)
@@ -404,6 +418,36 @@ void TimeLineSlider::slotGoToNextBookmark()
 // END OF void TimeLineSlider::slotGoToNextBookmark()
 //==============================================================================
 
+void TimeLineSlider::slotGoToPreviousMarker()
+{
+	if(!m_cpMarkers)
+		return;
+
+	int marker = m_cpMarkers->previousMarked(m_currentFrame);
+	if((marker < 0) || (marker > m_maxFrame))
+		return;
+
+	setFrame(marker, false);
+}
+
+// END OF void TimeLineSlider::slotGoToPreviousMarker()
+//==============================================================================
+
+void TimeLineSlider::slotGoToNextMarker()
+{
+	if(!m_cpMarkers)
+		return;
+
+	int marker = m_cpMarkers->nextMarked(m_currentFrame);
+	if((marker < 0) || (marker > m_maxFrame))
+		return;
+
+	setFrame(marker, false);
+}
+
+// END OF void TimeLineSlider::slotGoToNextMarker()
+//==============================================================================
+
 void TimeLineSlider::keyPressEvent(QKeyEvent * a_pEvent)
 {
 	if(a_pEvent->modifiers() != Qt::NoModifier)
@@ -540,12 +584,44 @@ void TimeLineSlider::paintEvent(QPaintEvent * a_pEvent)
 		m_slideLineFrameWidth);
 	painter.drawRect(l_slideLineRect.marginsRemoved(slideLineMargins));
 
+	int pointerTop = l_slideLineRect.top() + m_slideLineFrameWidth;
+	int pointerBottom = l_slideLineRect.bottom() - m_slideLineFrameWidth;
+
+	// Markers density along the lower half of the slide line.
+	// The more of the scanned frames under a pixel are marked,
+	// the more opaque the pixel is.
+	if(m_cpMarkers && (m_cpMarkers->markedCount() > 0) && (m_maxFrame > 0))
+	{
+		int trackTop = (pointerTop + pointerBottom + 1) / 2;
+		int startPos = m_sideMargin + m_slideLineFrameWidth;
+		int columns = slideLineInnerWidth();
+		double framesInPixel = (double)m_maxFrame / (double)(columns - 1);
+		QColor markerColor = m_markerColor;
+		pen.setWidth(1);
+		for(int column = 0; column < columns; ++column)
+		{
+			int first = (int)std::ceil(framesInPixel * column);
+			int last = (int)std::ceil(framesInPixel * (column + 1)) - 1;
+			last = std::min(last, m_maxFrame);
+			if(first > last)
+				continue;
+			int scanned = 0;
+			int marked = 0;
+			m_cpMarkers->countInRange(first, last, scanned, marked);
+			if(marked == 0)
+				continue;
+			markerColor.setAlpha(80 + 175 * marked / scanned);
+			pen.setColor(markerColor);
+			painter.setPen(pen);
+			painter.drawLine(startPos + column, trackTop,
+				startPos + column, pointerBottom);
+		}
+	}
+
 	// Bookmarks
 	pen.setColor(m_bookmarkColor);
 	pen.setWidth(1);
 	painter.setPen(pen);
-	int pointerTop = l_slideLineRect.top() + m_slideLineFrameWidth;
-	int pointerBottom = l_slideLineRect.bottom() - m_slideLineFrameWidth;
 	for(int i : m_bookmarks)
 	{
 		if(i > m_maxFrame)
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <set>
 
+class FrameMarkers;
 class QKeyEvent;
 class QMouseEvent;
 class QPaintEvent;
@@ -33,6 +34,7 @@ public:
 		CurrentFramePointer,
 		SlidingPointer,
 		Bookmark,
+		Marker,
 	};
 
 	int frame() const;
@@ -59,6 +61,10 @@ public:
 	void clearBookmarks();
 	int getClosestBookmark(int a_frame) const;
 
+	// The markers are drawn as a density track. The slider does not take
+	// ownership. Call update() when they change.
+	void setMarkers(const FrameMarkers * a_cpMarkers);
+
 public slots:
 
 	void slotStepUp();
@@ -73,6 +79,9 @@ public slots:
 	void slotGoToPreviousBookmark();
 	void slotGoToNextBookmark();
 
+	void slotGoToPreviousMarker();
+	void slotGoToNextMarker();
+
 signals:
 
 	void signalSliderMoved(int a_frame);
@@ -144,10 +153,13 @@ private:
 	QColor m_currentFramePointerColor;
 	QColor m_slidingPointerColor;
 	QColor m_bookmarkColor;
+	QColor m_markerColor;
 
 	std::map<ColorRole, QColor *> m_colorRoleMap;
 
 	std::set<int> m_bookmarks;
+
+	const FrameMarkers * m_cpMarkers;
 };
 
 #endif // TIMELINESLIDER_H
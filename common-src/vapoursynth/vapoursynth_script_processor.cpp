@@ -2,13 +2,18 @@
 
 #include "../helpers.h"
 #include "vs_script_library.h"
+#include "vs_script_evaluation.h"
+#include "vs_core_resources.h"
 #include "vs_pack_rgb.h"
+#include "vs_yuv_to_rgb.h"
+#include "vs_frame_metrics.h"
 #include "vs_set_matrix.h"
 
 #include <vapoursynth/VSHelper4.h>
 #include <vapoursynth/VSConstants4.h>
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <memory>
@@ -18,6 +23,19 @@
 
 //==============================================================================
 
+// More than the number of frames that can be requested at once,
+// so the fallback path in frameReady() is rarely taken.
+const size_t FRAME_COMPLETION_QUEUE_CAPACITY = 1024;
+
+// Luma kernel for the downscaled preview. The chroma resampling filter
+// from the settings is kept for chroma alone, as it may well be Point.
+// Catmull-Rom keeps the downscaled picture sharp without much ringing.
+const char PREVIEW_DOWNSCALE_FILTER[] = "Bicubic";
+const double PREVIEW_DOWNSCALE_FILTER_PARAM_A = 0.0;
+const double PREVIEW_DOWNSCALE_FILTER_PARAM_B = 0.5;
+
+//==============================================================================
+
 void VS_CC frameReady(void * a_pUserData,
 	const VSFrame * a_cpFrame, int a_frameNumber,
 	VSNode * a_pNode, const char * a_errorMessage)
@@ -25,7 +43,25 @@ void VS_CC frameReady(void * a_pUserData,
 	VapourSynthScriptProcessor * pScriptProcessor =
 		static_cast<VapourSynthScriptProcessor *>(a_pUserData);
 	Q_ASSERT(pScriptProcessor);
-	QString errorMessage(a_errorMessage);
+
+	FrameCompletionQueue & queue = pScriptProcessor->m_frameCompletionQueue;
+	bool pushed = queue.push(a_cpFrame, a_frameNumber, a_pNode,
+		a_errorMessage);
+	if(pushed)
+	{
+		// One wakeup drains every completion queued until then.
+		if(queue.requestWakeup())
+		{
+			QMetaObject::invokeMethod(pScriptProcessor,
+				"slotProcessFrameCompletions", Qt::QueuedConnection);
+		}
+		return;
+	}
+
+	// The queue is full - fall back to the per-frame event.
+	QString errorMessage;
+	if(a_errorMessage)
+		errorMessage = QString::fromUtf8(a_errorMessage);
 	QMetaObject::invokeMethod(pScriptProcessor,
 		"slotReceiveFrameAndProcessQueue",
 		Qt::QueuedConnection,
@@ -54,12 +90,35 @@ VapourSynthScriptProcessor::VapourSynthScriptProcessor(
 	, m_cpVSAPI(nullptr)
 	, m_pVSScript(nullptr)
 	, m_pCore(nullptr)
+	, m_scriptOrigin(ScriptOrigin::Evaluated)
+	, m_reason(ProcessReason::Preview)
+	, m_coreUserRegistered(false)
+	, m_pScriptEvaluation(nullptr)
+	, m_pendingOutputIndex(0)
+	, m_pendingReason(ProcessReason::Preview)
 	, m_nodeInfo()
+	, m_metricsNodes()
+	, m_fullSizePreviewNodes()
+	, m_thumbnailNodes()
+	, m_thumbnailSize()
+	, m_frameCompletionQueue(FRAME_COMPLETION_QUEUE_CAPACITY)
+	, m_inFlightWindow()
+	, m_frameRequestsLimit(0)
+	, m_nodeTimingEnabled(false)
+	, m_nodeTimingBaseline()
+	, m_nodeTimingFrames(0)
+	, m_previewWidth(0)
+	, m_previewHeight(0)
+	, m_previewCrop()
+	, m_previewCropZoom(1)
 	, m_finalizing(false)
 {
 	Q_ASSERT(m_pSettingsManager);
 	Q_ASSERT(m_pVSScriptLibrary);
 
+	connect(m_pVSScriptLibrary, SIGNAL(signalCoreUsersChanged()),
+		this, SLOT(slotCoreUsersChanged()));
+
 	slotResetSettings();
 }
 
@@ -79,26 +138,53 @@ VapourSynthScriptProcessor::~VapourSynthScriptProcessor()
 bool VapourSynthScriptProcessor::initialize(const QString& a_script,
 	const QString& a_scriptName, int a_outputIndex, ProcessReason a_reason)
 {
-	if(m_initialized || m_finalizing)
+	if(m_initialized || m_finalizing || m_pScriptEvaluation)
 	{
 		m_error = tr("Script processor is already in use.");
 		emit signalWriteLogMessage(mtCritical, m_error);
 		return false;
 	}
 
-	if(!m_pVSScript || !m_pCore)
+	// The evaluated script may be shared with other processors
+	// running the same script for the same reason.
+	ScriptOrigin origin = ScriptOrigin::Evaluated;
+	VSScript * pScript = m_pVSScriptLibrary->acquireScript(a_script,
+		a_scriptName, a_reason, &m_error, &origin);
+	if(!pScript)
 	{
-		m_pCore = m_pVSScriptLibrary->createCore();
-		m_pVSScript = m_pVSScriptLibrary->createScript(m_pCore);
+		emit signalWriteLogMessage(mtCritical, m_error);
+		finalize();
+		return false;
 	}
-	if(!m_pVSScript)
+
+	bool initialized = initialize(pScript, a_script, a_scriptName,
+		a_outputIndex, a_reason);
+	if(initialized)
+		m_scriptOrigin = origin;
+	return initialized;
+}
+
+// END OF bool VapourSynthScriptProcessor::initialize(const QString& a_script,
+//		const QString& a_scriptName, int a_outputIndex, ProcessReason a_reason)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::initialize(VSScript * a_pScript,
+	const QString& a_script, const QString& a_scriptName, int a_outputIndex,
+	ProcessReason a_reason)
+{
+	Q_ASSERT(a_pScript);
+
+	if(m_initialized || m_finalizing || m_pScriptEvaluation || m_pVSScript)
 	{
-		m_error = tr("Failed to create VSScript handle!");
+		m_pVSScriptLibrary->releaseScript(a_pScript);
+		m_error = tr("Script processor is already in use.");
 		emit signalWriteLogMessage(mtCritical, m_error);
-		finalize();
 		return false;
 	}
 
+	m_pVSScript = a_pScript;
+	m_scriptOrigin = ScriptOrigin::Cached;
+
 	m_cpVSAPI = m_pVSScriptLibrary->getVSAPI();
 	if(!m_cpVSAPI)
 	{
@@ -106,24 +192,19 @@ bool VapourSynthScriptProcessor::initialize(const QString& a_script,
 		return false;
 	}
 
-	m_cpVSAPI->getCoreInfo(m_pCore, &m_cpCoreInfo);
-
-	int opresult = m_pVSScriptLibrary->evaluateScript(m_pVSScript,
-		a_script.toUtf8().constData(), a_scriptName.toUtf8().constData());
-
-	if(opresult)
+	m_pCore = m_pVSScriptLibrary->getCore(m_pVSScript);
+	if(a_reason != ProcessReason::Check)
 	{
-		m_error = tr("Failed to evaluate the script");
-		const char * vsError = m_pVSScriptLibrary->getError(m_pVSScript);
-		if(vsError)
-			m_error += QString(":\n") + vsError;
-		else
-			m_error += '.';
-
-		emit signalWriteLogMessage(mtCritical, m_error);
-		finalize();
-		return false;
+		// Registering rebalances the cores of all registered processors,
+		// this one included.
+		m_reason = a_reason;
+		m_coreUserRegistered = true;
+		m_pVSScriptLibrary->registerCoreUser(m_pCore, m_reason);
 	}
+	m_cpVSAPI->getCoreInfo(m_pCore, &m_cpCoreInfo);
+	m_inFlightWindow.reset(m_cpCoreInfo.numThreads, m_frameRequestsLimit);
+	if(m_nodeTimingEnabled)
+		m_pVSScriptLibrary->setCoreNodeTiming(m_pCore, true);
 
 	VSNode * pOutputNode = m_pVSScriptLibrary->getOutput(
 		m_pVSScript, a_outputIndex);
@@ -180,17 +261,82 @@ bool VapourSynthScriptProcessor::initialize(const QString& a_script,
 	return true;
 }
 
-// END OF bool VapourSynthScriptProcessor::initialize(const QString& a_script,
-//		const QString& a_scriptName, int a_outputIndex, ProcessReason a_reason)
+// END OF bool VapourSynthScriptProcessor::initialize(VSScript * a_pScript,
+//		const QString& a_script, const QString& a_scriptName,
+//		int a_outputIndex, ProcessReason a_reason)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::initializeAsync(const QString& a_script,
+	const QString& a_scriptName, int a_outputIndex, ProcessReason a_reason)
+{
+	if(m_initialized || m_finalizing || m_pScriptEvaluation)
+	{
+		m_error = tr("Script processor is already in use.");
+		emit signalWriteLogMessage(mtCritical, m_error);
+		return false;
+	}
+
+	m_pendingOutputIndex = a_outputIndex;
+	m_pendingReason = a_reason;
+
+	m_pScriptEvaluation = new ScriptEvaluation(m_pVSScriptLibrary,
+		a_script, a_scriptName, a_reason);
+	connect(m_pScriptEvaluation, &ScriptEvaluation::signalProgress,
+		this, &VapourSynthScriptProcessor::signalInitializationProgress);
+	connect(m_pScriptEvaluation, &ScriptEvaluation::signalFinished,
+		this, &VapourSynthScriptProcessor::slotScriptEvaluated);
+	m_pScriptEvaluation->start();
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::initializeAsync(
+//		const QString& a_script, const QString& a_scriptName,
+//		int a_outputIndex, ProcessReason a_reason)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::isInitializing() const
+{
+	return (m_pScriptEvaluation != nullptr);
+}
+
+// END OF bool VapourSynthScriptProcessor::isInitializing() const
+//==============================================================================
+
+void VapourSynthScriptProcessor::cancelInitialization()
+{
+	if(!m_pScriptEvaluation)
+		return;
+
+	abandonScriptEvaluation();
+	m_error = tr("Script evaluation was cancelled.");
+	emit signalWriteLogMessage(mtWarning, m_error);
+}
+
+// END OF void VapourSynthScriptProcessor::cancelInitialization()
 //==============================================================================
 
 bool VapourSynthScriptProcessor::finalize()
 {
+	abandonScriptEvaluation();
+
 	m_finalizing = true;
 	bool noFrameTicketsInProcess = flushFrameTicketsQueue();
 	if(!noFrameTicketsInProcess)
 		return false;
 
+	freeFullSizePreviewNodes();
+	freeThumbnailNodes();
+
+	// Metrics nodes use the output nodes.
+	for(std::pair<const std::pair<int, int>, VSNode *> & mapItem :
+		m_metricsNodes)
+	{
+		if(mapItem.second)
+			m_cpVSAPI->freeNode(mapItem.second);
+	}
+	m_metricsNodes.clear();
+
 	for(std::pair<const int, NodePair> & mapItem : m_nodePairForOutputIndex)
 	{
 		NodePair & nodePair = mapItem.second;
@@ -200,12 +346,21 @@ bool VapourSynthScriptProcessor::finalize()
 			m_cpVSAPI->freeNode(nodePair.pPreviewNode);
 	}
 	m_nodePairForOutputIndex.clear();
+	m_nodeTimingBaseline.clear();
+	m_nodeTimingFrames = 0;
+
+	if(m_coreUserRegistered)
+	{
+		m_coreUserRegistered = false;
+		m_pVSScriptLibrary->unregisterCoreUser(m_pCore);
+	}
 
 	if(m_pVSScript)
 	{
-		m_pVSScriptLibrary->freeScript(m_pVSScript);
+		m_pVSScriptLibrary->releaseScript(m_pVSScript);
 		m_pVSScript = nullptr;
 	}
+	m_pCore = nullptr;
 
 	m_cpVSAPI = nullptr;
 
@@ -231,6 +386,94 @@ bool VapourSynthScriptProcessor::isInitialized() const
 // END OF bool VapourSynthScriptProcessor::isInitialized() const
 //==============================================================================
 
+ScriptOrigin VapourSynthScriptProcessor::scriptOrigin() const
+{
+	return m_scriptOrigin;
+}
+
+// END OF ScriptOrigin VapourSynthScriptProcessor::scriptOrigin() const
+//==============================================================================
+
+void VapourSynthScriptProcessor::slotScriptEvaluated(VSScript * a_pScript,
+	ScriptOrigin a_origin, const QString & a_error)
+{
+	QString script = m_pScriptEvaluation->script();
+	QString scriptName = m_pScriptEvaluation->scriptName();
+	m_pScriptEvaluation = nullptr;
+
+	if(!a_pScript)
+	{
+		m_error = a_error;
+		emit signalWriteLogMessage(mtCritical, m_error);
+		emit signalInitialized(false);
+		return;
+	}
+
+	// Use the handed over evaluation even if the cache entry has been
+	// invalidated since, rather than evaluating again right here.
+	bool initialized = initialize(a_pScript, script, scriptName,
+		m_pendingOutputIndex, m_pendingReason);
+	if(initialized)
+		m_scriptOrigin = a_origin;
+
+	emit signalInitialized(initialized);
+}
+
+// END OF void VapourSynthScriptProcessor::slotScriptEvaluated(
+//		VSScript * a_pScript, ScriptOrigin a_origin, const QString & a_error)
+//==============================================================================
+
+void VapourSynthScriptProcessor::abandonScriptEvaluation()
+{
+	if(!m_pScriptEvaluation)
+		return;
+
+	m_pScriptEvaluation->disconnect(this);
+	m_pScriptEvaluation->cancel();
+	m_pScriptEvaluation = nullptr;
+}
+
+// END OF void VapourSynthScriptProcessor::abandonScriptEvaluation()
+//==============================================================================
+
+void VapourSynthScriptProcessor::slotCoreUsersChanged()
+{
+	applyCoreResources();
+}
+
+// END OF void VapourSynthScriptProcessor::slotCoreUsersChanged()
+//==============================================================================
+
+void VapourSynthScriptProcessor::applyCoreResources()
+{
+	if((!m_coreUserRegistered) || (!m_pCore))
+		return;
+
+	Q_ASSERT(m_cpVSAPI);
+
+	CoreResourceSettings settings =
+		m_pSettingsManager->getCoreResourceSettings(m_reason);
+	CoreResources resources = pickCoreResources(settings, m_reason,
+		m_pVSScriptLibrary->coreUsers(m_reason),
+		m_pVSScriptLibrary->coreUsers());
+
+	m_cpVSAPI->setMaxCacheSize(resources.maxCacheSize, m_pCore);
+	m_cpVSAPI->setThreadCount(resources.threads, m_pCore);
+
+	int previousThreads = m_cpCoreInfo.numThreads;
+	m_cpVSAPI->getCoreInfo(m_pCore, &m_cpCoreInfo);
+	if(m_initialized && (m_cpCoreInfo.numThreads != previousThreads))
+		m_inFlightWindow.reset(m_cpCoreInfo.numThreads, m_frameRequestsLimit);
+
+	emit signalWriteLogMessage(mtDebug,
+		tr("Core resources: %1 MB frame cache, %2 threads.")
+		.arg(m_cpCoreInfo.maxFramebufferSize / (1024 * 1024))
+		.arg(m_cpCoreInfo.numThreads));
+}
+
+// END OF void VapourSynthScriptProcessor::applyCoreResources()
+//==============================================================================
+
 QString VapourSynthScriptProcessor::error() const
 {
 	return m_error;
@@ -277,7 +520,7 @@ VSNodeInfo VapourSynthScriptProcessor::nodeInfo(int a_outputIndex)
 //==============================================================================
 
 bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
-	int a_outputIndex, bool a_needPreview)
+	int a_outputIndex, bool a_needPreview, FramePriority a_priority)
 {
 	if(!m_initialized)
 		return false;
@@ -322,10 +565,21 @@ bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
 	if(a_needPreview && (!nodePair.pPreviewNode))
 		return false;
 
+	if(coalesceFrameRequest(a_frameNumber, a_outputIndex, a_needPreview,
+		a_priority, nodePair))
+	{
+		// A promoted ticket may be dispatched now.
+		processFrameTicketsQueue();
+		return true;
+	}
+
 	FrameTicket newFrameTicket(a_frameNumber, a_outputIndex,
-		nodePair.pOutputNode, a_needPreview, nodePair.pPreviewNode);
+		nodePair.pOutputNode, a_needPreview, nodePair.pPreviewNode,
+		a_priority);
 
-	m_frameTicketsQueue.push_back(newFrameTicket);
+	FrameTicketList & queue = m_frameTicketsQueue[(size_t)a_priority];
+	FrameTicketList::iterator it = queue.insert(queue.end(), newFrameTicket);
+	indexFrameTicket(m_queuedFrameTicketsIndex, nodePair.pOutputNode, it);
 	sendFrameQueueChangeSignal();
 	processFrameTicketsQueue();
 
@@ -333,18 +587,43 @@ bool VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
 }
 
 // END OF void VapourSynthScriptProcessor::requestFrameAsync(int a_frameNumber,
-//		int a_outputIndex, bool a_needPreview)
+//		int a_outputIndex, bool a_needPreview, FramePriority a_priority)
 //==============================================================================
 
 bool VapourSynthScriptProcessor::flushFrameTicketsQueue()
 {
+	// Full size frames and metrics are waited for by their own
+	// requesters, so they are only dropped on finalization.
+	FrameTicketPredicate flushed = [&](const FrameTicket & a_ticket)
+		{
+			return m_finalizing ||
+				((a_ticket.kind != FrameTicketKind::FullSizePreview) &&
+				(a_ticket.kind != FrameTicketKind::Metrics));
+		};
+
 	// Check the processing queue.
 	for(FrameTicket & ticket : m_frameTicketsInProcess)
-		ticket.discard = true;
+	{
+		if(flushed(ticket))
+			ticket.discard = true;
+	}
 
-	size_t queueSize = m_frameTicketsQueue.size();
-	m_frameTicketsQueue.clear();
-	if(queueSize)
+	size_t queueSize = framesInQueue();
+	for(FrameTicketList & queue : m_frameTicketsQueue)
+	{
+		FrameTicketList::iterator it = queue.begin();
+		while(it != queue.end())
+		{
+			if(!flushed(*it))
+			{
+				++it;
+				continue;
+			}
+			unindexQueuedFrameTicket(it);
+			it = queue.erase(it);
+		}
+	}
+	if(framesInQueue() != queueSize)
 		sendFrameQueueChangeSignal();
 
 	return m_frameTicketsInProcess.empty();
@@ -353,6 +632,76 @@ bool VapourSynthScriptProcessor::flushFrameTicketsQueue()
 // END OF bool VapourSynthScriptProcessor::flushFrameTicketsQueue()
 //==============================================================================
 
+size_t VapourSynthScriptProcessor::cancelFrameTickets(
+	const FrameTicketPredicate & a_predicate)
+{
+	std::vector<FrameTicket> cancelledTickets;
+
+	for(FrameTicket & ticket : m_frameTicketsInProcess)
+	{
+		if(ticket.discard || !a_predicate(ticket))
+			continue;
+		ticket.discard = true;
+		cancelledTickets.push_back(ticket);
+	}
+	size_t cancelledInProcess = cancelledTickets.size();
+
+	for(FrameTicketList & queue : m_frameTicketsQueue)
+	{
+		FrameTicketList::iterator it = queue.begin();
+		while(it != queue.end())
+		{
+			if(!a_predicate(*it))
+			{
+				++it;
+				continue;
+			}
+			cancelledTickets.push_back(*it);
+			unindexQueuedFrameTicket(it);
+			it = queue.erase(it);
+		}
+	}
+	if(cancelledTickets.size() > cancelledInProcess)
+		sendFrameQueueChangeSignal();
+
+	// Every request gets its answer, so the subscribers are told
+	// once the queue is consistent again.
+	QString reason = tr("The frame request was cancelled.");
+	for(const FrameTicket & ticket : cancelledTickets)
+	{
+		if(ticket.kind == FrameTicketKind::Thumbnail)
+		{
+			emit signalThumbnailReady(ticket.frameNumber, ticket.outputIndex,
+				nullptr);
+			continue;
+		}
+		else if(ticket.kind == FrameTicketKind::FullSizePreview)
+		{
+			emit signalFullSizePreviewFrameReady(ticket.frameNumber,
+				ticket.outputIndex, nullptr);
+			continue;
+		}
+		else if(ticket.kind == FrameTicketKind::Metrics)
+		{
+			emit signalFrameMetricsReady(FrameMetrics(ticket.frameNumber,
+				ticket.outputIndex, ticket.comparedIndex));
+			continue;
+		}
+
+		for(int i = 0; i < ticket.subscribers; ++i)
+		{
+			emit signalFrameRequestDiscarded(ticket.frameNumber,
+				ticket.outputIndex, reason);
+		}
+	}
+
+	return cancelledTickets.size();
+}
+
+// END OF size_t VapourSynthScriptProcessor::cancelFrameTickets(
+//		const FrameTicketPredicate & a_predicate)
+//==============================================================================
+
 const QString & VapourSynthScriptProcessor::script() const
 {
 	return m_script;
@@ -391,6 +740,23 @@ void VapourSynthScriptProcessor::slotReceiveFrameAndProcessQueue(
 //		VSNode * a_pNode, QString a_errorMessage)
 //==============================================================================
 
+void VapourSynthScriptProcessor::slotProcessFrameCompletions()
+{
+	m_frameCompletionQueue.clearWakeup();
+
+	FrameCompletion completion;
+	while(m_frameCompletionQueue.pop(completion))
+	{
+		receiveFrame(completion.cpFrame, completion.frameNumber,
+			completion.pNode, completion.errorMessage);
+	}
+
+	processFrameTicketsQueue();
+}
+
+// END OF void VapourSynthScriptProcessor::slotProcessFrameCompletions()
+//==============================================================================
+
 void VapourSynthScriptProcessor::slotResetSettings()
 {
 	m_yuvMatrix = m_pSettingsManager->getYuvMatrixCoefficients();
@@ -415,12 +781,27 @@ void VapourSynthScriptProcessor::slotResetSettings()
 
 	m_ditherType = m_pSettingsManager->getDitherType();
 
+	m_fastYuvToRgb = m_pSettingsManager->getFastYuvToRgb();
+
+	int frameRequestsLimit =
+		std::max(m_pSettingsManager->getFrameRequestsLimit(), 0);
+	if(m_initialized && (frameRequestsLimit != m_frameRequestsLimit))
+		m_inFlightWindow.reset(m_cpCoreInfo.numThreads, frameRequestsLimit);
+	m_frameRequestsLimit = frameRequestsLimit;
+
 	for(std::pair<const int, NodePair> & mapItem : m_nodePairForOutputIndex)
 	{
 		NodePair & nodePair = mapItem.second;
 		if(nodePair.pPreviewNode)
 			recreatePreviewNode(nodePair);
 	}
+
+	// Rebuilt with the new settings on the next dispatch.
+	// Tickets in process keep their own references.
+	freeFullSizePreviewNodes();
+	freeThumbnailNodes();
+
+	applyCoreResources();
 }
 
 // END OF void VapourSynthScriptProcessor::slotResetSettings()
@@ -441,16 +822,9 @@ void VapourSynthScriptProcessor::receiveFrame(
 
 	FrameTicket ticket(a_frameNumber, -1, nullptr);
 
-	std::vector<FrameTicket>::iterator it = std::find_if(
-		m_frameTicketsInProcess.begin(), m_frameTicketsInProcess.end(),
-		[&](const FrameTicket & a_ticket)
-		{
-			return ((a_ticket.frameNumber == a_frameNumber) &&
-				((a_ticket.pOutputNode == a_pNode) ||
-				(a_ticket.pPreviewNode == a_pNode)));
-		});
-
-	if(it != m_frameTicketsInProcess.end())
+	FrameTicketList::iterator it = m_frameTicketsInProcess.end();
+	if(takeIndexedFrameTicket(m_frameTicketsIndex, a_pNode, a_frameNumber,
+		it))
 	{
 		// Save frame references and free node references in ticket at once.
 		if(it->pOutputNode == a_pNode)
@@ -464,6 +838,8 @@ void VapourSynthScriptProcessor::receiveFrame(
 				Q_ASSERT(it->pPreviewNode);
 				if(a_cpFrame)
 				{
+					indexFrameTicket(m_frameTicketsIndex, it->pPreviewNode,
+						it);
 					m_cpVSAPI->getFrameAsync(it->frameNumber, it->pPreviewNode,
 						frameReady, this);
 				}
@@ -489,6 +865,9 @@ void VapourSynthScriptProcessor::receiveFrame(
 
 		ticket = *it;
 		m_frameTicketsInProcess.erase(it);
+		m_inFlightWindow.frameCompleted(duration_to_double(
+			hr_clock::now() - ticket.dispatchTime));
+		m_nodeTimingFrames++;
 		sendFrameQueueChangeSignal();
 	}
 	else
@@ -500,17 +879,34 @@ void VapourSynthScriptProcessor::receiveFrame(
 		m_cpVSAPI->freeFrame(a_cpFrame);
 	}
 
-	if(!ticket.discard)
+	if((!ticket.discard) && (ticket.kind == FrameTicketKind::Thumbnail))
 	{
-		if(ticket.isComplete())
-		{
-			emit signalDistributeFrame(ticket.frameNumber, ticket.outputIndex,
-				ticket.cpOutputFrame, ticket.cpPreviewFrame);
-		}
-		else
+		emit signalThumbnailReady(ticket.frameNumber, ticket.outputIndex,
+			ticket.cpOutputFrame);
+	}
+	else if((!ticket.discard) &&
+		(ticket.kind == FrameTicketKind::FullSizePreview))
+	{
+		emit signalFullSizePreviewFrameReady(ticket.frameNumber,
+			ticket.outputIndex, ticket.cpOutputFrame);
+	}
+	else if((!ticket.discard) && (ticket.kind == FrameTicketKind::Metrics))
+		emit signalFrameMetricsReady(frameMetrics(ticket));
+	else if(!ticket.discard)
+	{
+		for(int i = 0; i < ticket.subscribers; ++i)
 		{
-			emit signalFrameRequestDiscarded(ticket.frameNumber,
-				ticket.outputIndex, QString());
+			if(ticket.isComplete())
+			{
+				emit signalDistributeFrame(ticket.frameNumber,
+					ticket.outputIndex, ticket.cpOutputFrame,
+					ticket.cpPreviewFrame);
+			}
+			else
+			{
+				emit signalFrameRequestDiscarded(ticket.frameNumber,
+					ticket.outputIndex, QString());
+			}
 		}
 	}
 
@@ -526,45 +922,100 @@ void VapourSynthScriptProcessor::processFrameTicketsQueue()
 {
 	Q_ASSERT(m_cpVSAPI);
 
-	size_t oldInQueue = m_frameTicketsQueue.size();
+	size_t oldInQueue = framesInQueue();
 	size_t oldInProcess = m_frameTicketsInProcess.size();
 
-	while(((int)m_frameTicketsInProcess.size() < m_cpCoreInfo.numThreads) &&
-		(!m_frameTicketsQueue.empty()))
+	while(m_frameTicketsInProcess.size() < m_inFlightWindow.limit())
 	{
-		FrameTicket ticket = std::move(m_frameTicketsQueue.front());
-		m_frameTicketsQueue.pop_front();
+		size_t priorityClass = 0;
+		while((priorityClass < FRAME_PRIORITY_CLASSES) &&
+			m_frameTicketsQueue[priorityClass].empty())
+			priorityClass++;
+		if(priorityClass == FRAME_PRIORITY_CLASSES)
+			break;
 
-		// In case preview node was hot-swapped.
-		NodePair & nodePair =
-			getNodePair(ticket.outputIndex, ticket.needPreview);
+		FrameTicketList & queue = m_frameTicketsQueue[priorityClass];
+		unindexQueuedFrameTicket(queue.begin());
+		FrameTicket ticket = std::move(queue.front());
+		queue.pop_front();
 
-		bool validPair = (nodePair.pOutputNode != nullptr);
-		if(ticket.needPreview)
-			validPair = validPair && (nodePair.pPreviewNode != nullptr);
-		if(!validPair)
+		if(ticket.kind == FrameTicketKind::Thumbnail)
 		{
-			QString reason = tr("No nodes to produce the frame "
-				"%1 at output #%2.").arg(ticket.frameNumber)
-				.arg(ticket.outputIndex);
-			emit signalFrameRequestDiscarded(ticket.frameNumber,
-				ticket.outputIndex, reason);
-			continue;
+			VSNode * pThumbnailNode = getThumbnailNode(ticket.outputIndex);
+			if(!pThumbnailNode)
+			{
+				emit signalThumbnailReady(ticket.frameNumber,
+					ticket.outputIndex, nullptr);
+				continue;
+			}
+			ticket.pOutputNode = m_cpVSAPI->addNodeRef(pThumbnailNode);
+		}
+		else if(ticket.kind == FrameTicketKind::FullSizePreview)
+		{
+			// Built with the settings at the time of dispatch.
+			VSNode * pPreviewNode =
+				getFullSizePreviewNode(ticket.outputIndex);
+			if(!pPreviewNode)
+			{
+				emit signalFullSizePreviewFrameReady(ticket.frameNumber,
+					ticket.outputIndex, nullptr);
+				continue;
+			}
+			ticket.pOutputNode = m_cpVSAPI->addNodeRef(pPreviewNode);
+		}
+		else if(ticket.kind == FrameTicketKind::Metrics)
+		{
+			VSNode * pMetricsNode = getMetricsNode(ticket.outputIndex,
+				ticket.comparedIndex);
+			if(!pMetricsNode)
+			{
+				emit signalFrameMetricsReady(FrameMetrics(ticket.frameNumber,
+					ticket.outputIndex, ticket.comparedIndex));
+				continue;
+			}
+			ticket.pOutputNode = m_cpVSAPI->addNodeRef(pMetricsNode);
+		}
+		else
+		{
+			// In case preview node was hot-swapped.
+			NodePair & nodePair =
+				getNodePair(ticket.outputIndex, ticket.needPreview);
+
+			bool validPair = (nodePair.pOutputNode != nullptr);
+			if(ticket.needPreview)
+				validPair = validPair && (nodePair.pPreviewNode != nullptr);
+			if(!validPair)
+			{
+				QString reason = tr("No nodes to produce the frame "
+					"%1 at output #%2.").arg(ticket.frameNumber)
+					.arg(ticket.outputIndex);
+				for(int i = 0; i < ticket.subscribers; ++i)
+				{
+					emit signalFrameRequestDiscarded(ticket.frameNumber,
+						ticket.outputIndex, reason);
+				}
+				continue;
+			}
+
+			ticket.pOutputNode = m_cpVSAPI->addNodeRef(nodePair.pOutputNode);
+			if(ticket.needPreview)
+				ticket.pPreviewNode =
+					m_cpVSAPI->addNodeRef(nodePair.pPreviewNode);
 		}
 
-		ticket.pOutputNode = m_cpVSAPI->addNodeRef(nodePair.pOutputNode);
-		if(ticket.needPreview)
-			ticket.pPreviewNode =
-				m_cpVSAPI->addNodeRef(nodePair.pPreviewNode);
+		ticket.dispatchTime = hr_clock::now();
+		FrameTicketList::iterator it = m_frameTicketsInProcess.insert(
+			m_frameTicketsInProcess.end(), ticket);
+		indexFrameTicket(m_frameTicketsIndex, ticket.pOutputNode, it);
 
 		m_cpVSAPI->getFrameAsync(ticket.frameNumber, ticket.pOutputNode,
 			frameReady, this);
-
-		m_frameTicketsInProcess.push_back(ticket);
 	}
 
-	size_t inQueue = m_frameTicketsQueue.size();
+	size_t inQueue = framesInQueue();
 	size_t inProcess = m_frameTicketsInProcess.size();
+	if(inProcess >= m_inFlightWindow.limit())
+		m_inFlightWindow.setSaturated();
 	if((inQueue != oldInQueue) || (oldInProcess != inProcess))
 		sendFrameQueueChangeSignal();
 
@@ -575,50 +1026,172 @@ void VapourSynthScriptProcessor::processFrameTicketsQueue()
 // END OF void VapourSynthScriptProcessor::processFrameTicketsQueue()
 //==============================================================================
 
-void VapourSynthScriptProcessor::sendFrameQueueChangeSignal()
+bool VapourSynthScriptProcessor::coalesceFrameRequest(int a_frameNumber,
+	int a_outputIndex, bool a_needPreview, FramePriority a_priority,
+	const NodePair & a_nodePair)
 {
-	size_t inQueue = m_frameTicketsQueue.size();
-	size_t inProcess = m_frameTicketsInProcess.size();
+	// The ticket in process is found by the node its frame is requested
+	// from: the output node, or the preview node once the output frame
+	// has arrived. A ticket waiting for a preview from a node rebuilt
+	// since then is not reused.
+	FrameTicketList::iterator inProcessIt = m_frameTicketsInProcess.end();
+	bool inProcess = findIndexedFrameTicket(m_frameTicketsIndex,
+		a_nodePair.pOutputNode, a_frameNumber, a_outputIndex, inProcessIt);
+	if((!inProcess) && a_nodePair.pPreviewNode)
+	{
+		inProcess = findIndexedFrameTicket(m_frameTicketsIndex,
+			a_nodePair.pPreviewNode, a_frameNumber, a_outputIndex,
+			inProcessIt);
+	}
 
-	m_cpVSAPI->getCoreInfo(m_pCore, &m_cpCoreInfo);
+	if(inProcess)
+	{
+		FrameTicket & ticket = *inProcessIt;
 
-	size_t maxThreads = m_cpCoreInfo.numThreads;
-	double usedCacheRatio = (double)m_cpCoreInfo.usedFramebufferSize
-		/ (double)m_cpCoreInfo.maxFramebufferSize;
-	emit signalFrameQueueStateChanged(inQueue, inProcess, maxThreads,
-		usedCacheRatio);
-}
+		if(a_needPreview && ticket.needPreview &&
+			(ticket.pPreviewNode != a_nodePair.pPreviewNode))
+		{
+			// The preview node was rebuilt since the ticket was dispatched.
+			// The output frame is still on its way, so the preview is
+			// requested from the new node once it arrives.
+			Q_ASSERT(ticket.pOutputNode);
+			m_cpVSAPI->freeNode(ticket.pPreviewNode);
+			ticket.pPreviewNode =
+				m_cpVSAPI->addNodeRef(a_nodePair.pPreviewNode);
+		}
 
-// END OF void VapourSynthScriptProcessor::sendFrameQueueChangeSignal()
-//==============================================================================
+		if(ticket.discard)
+		{
+			// Cancelled earlier but still computed - take it back
+			// unless the processor is shutting down.
+			if(m_finalizing)
+				return false;
+			ticket.discard = false;
+			ticket.subscribers = 1;
+			// Those who cancelled it have been answered already.
+			ticket.priority = a_priority;
+		}
+		else
+		{
+			ticket.subscribers++;
+			ticket.priority = std::min(ticket.priority, a_priority);
+		}
 
-bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
-{
-	if(!a_nodePair.pOutputNode)
-		return false;
+		if(a_needPreview && (!ticket.needPreview))
+		{
+			// The ticket is removed from processing as soon as the output
+			// frame arrives, so the preview can still be requested.
+			Q_ASSERT(ticket.pOutputNode);
+			ticket.needPreview = true;
+			ticket.pPreviewNode =
+				m_cpVSAPI->addNodeRef(a_nodePair.pPreviewNode);
+		}
 
-	if(!m_cpVSAPI)
+		return true;
+	}
+
+	FrameTicketList::iterator it;
+	if(!findIndexedFrameTicket(m_queuedFrameTicketsIndex,
+		a_nodePair.pOutputNode, a_frameNumber, a_outputIndex, it))
 		return false;
 
-	if(a_nodePair.pPreviewNode)
+	it->subscribers++;
+	if(a_needPreview)
 	{
-		m_cpVSAPI->freeNode(a_nodePair.pPreviewNode);
-		a_nodePair.pPreviewNode = nullptr;
+		it->needPreview = true;
+		it->pPreviewNode = a_nodePair.pPreviewNode;
 	}
 
-	int outputMediaType = m_cpVSAPI->getNodeType(a_nodePair.pOutputNode);
-	if(outputMediaType == mtAudio)
+	if(a_priority < it->priority)
 	{
-#ifdef Q_OS_WIN // AUDIO
-		return recreateAudioPreviewNode(a_nodePair);
-#else
-		m_error = tr("Audio playback is supported on Windows only.");
-		emit signalWriteLogMessage(mtCritical, m_error);
-		return false;
-#endif
+		// Moving the ticket between the lists keeps the index valid.
+		m_frameTicketsQueue[(size_t)a_priority].splice(
+			m_frameTicketsQueue[(size_t)a_priority].end(),
+			m_frameTicketsQueue[(size_t)it->priority], it);
+		it->priority = a_priority;
 	}
 
-	const VSVideoInfo * cpVideoInfo =
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::coalesceFrameRequest(
+//		int a_frameNumber, int a_outputIndex, bool a_needPreview,
+//		FramePriority a_priority, const NodePair & a_nodePair)
+//==============================================================================
+
+void VapourSynthScriptProcessor::unindexQueuedFrameTicket(
+	FrameTicketList::iterator a_it)
+{
+	if(a_it->kind != FrameTicketKind::Frame)
+		return;
+
+	bool unindexed = unindexFrameTicket(m_queuedFrameTicketsIndex,
+		a_it->pOutputNode, a_it);
+	Q_ASSERT(unindexed);
+	(void)unindexed;
+}
+
+// END OF void VapourSynthScriptProcessor::unindexQueuedFrameTicket(
+//		FrameTicketList::iterator a_it)
+//==============================================================================
+
+size_t VapourSynthScriptProcessor::framesInQueue() const
+{
+	size_t inQueue = 0;
+	for(const FrameTicketList & queue : m_frameTicketsQueue)
+		inQueue += queue.size();
+	return inQueue;
+}
+
+// END OF size_t VapourSynthScriptProcessor::framesInQueue() const
+//==============================================================================
+
+void VapourSynthScriptProcessor::sendFrameQueueChangeSignal()
+{
+	size_t inQueue = framesInQueue();
+	size_t inProcess = m_frameTicketsInProcess.size();
+
+	m_cpVSAPI->getCoreInfo(m_pCore, &m_cpCoreInfo);
+
+	size_t maxThreads = m_cpCoreInfo.numThreads;
+	double usedCacheRatio = (double)m_cpCoreInfo.usedFramebufferSize
+		/ (double)m_cpCoreInfo.maxFramebufferSize;
+	m_inFlightWindow.update(usedCacheRatio);
+	emit signalFrameQueueStateChanged(inQueue, inProcess, maxThreads,
+		m_inFlightWindow.limit(), usedCacheRatio);
+}
+
+// END OF void VapourSynthScriptProcessor::sendFrameQueueChangeSignal()
+//==============================================================================
+
+bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair,
+	bool a_fullSize, const QSize & a_fitSize)
+{
+	if(!a_nodePair.pOutputNode)
+		return false;
+
+	if(!m_cpVSAPI)
+		return false;
+
+	if(a_nodePair.pPreviewNode)
+	{
+		m_cpVSAPI->freeNode(a_nodePair.pPreviewNode);
+		a_nodePair.pPreviewNode = nullptr;
+	}
+
+	int outputMediaType = m_cpVSAPI->getNodeType(a_nodePair.pOutputNode);
+	if(outputMediaType == mtAudio)
+	{
+#ifdef Q_OS_WIN // AUDIO
+		return recreateAudioPreviewNode(a_nodePair);
+#else
+		m_error = tr("Audio playback is supported on Windows only.");
+		emit signalWriteLogMessage(mtCritical, m_error);
+		return false;
+#endif
+	}
+
+	const VSVideoInfo * cpVideoInfo =
 		m_cpVSAPI->getVideoInfo(a_nodePair.pOutputNode);
 	if(!cpVideoInfo)
 		return false;
@@ -626,22 +1199,82 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 
 	bool to_10_bit = (QColormap::instance().depth() == 30);
 
+	QRect crop;
+	bool cropped = (!a_fullSize) && (!a_fitSize.isValid()) &&
+		previewCropFor(cpVideoInfo, crop);
+	int cropZoom = cropped ? m_previewCropZoom : 1;
+
+	int fitWidth = a_fitSize.isValid() ? a_fitSize.width() : m_previewWidth;
+	int fitHeight = a_fitSize.isValid() ? a_fitSize.height() :
+		m_previewHeight;
+	int previewWidth = 0;
+	int previewHeight = 0;
+	bool scaled = (!a_fullSize) && (!cropped) && previewSizeFor(cpVideoInfo,
+		fitWidth, fitHeight, previewWidth, previewHeight);
+	// Cropping and scaling both take the resizer.
+	bool resized = scaled || cropped;
+
+	// Matrix and chromaloc used when the frames do not tell
+
+	int64_t matrixIn;
+	switch(m_yuvMatrix)
+	{
+	case YuvMatrixCoefficients::m709:
+		matrixIn = VSC_MATRIX_BT709;
+		break;
+	case YuvMatrixCoefficients::m470BG:
+		matrixIn = VSC_MATRIX_BT470_BG;
+		break;
+	case YuvMatrixCoefficients::m170M:
+		matrixIn = VSC_MATRIX_ST170_M;
+		break;
+	case YuvMatrixCoefficients::m2020_NCL:
+		matrixIn = VSC_MATRIX_BT2020_NCL;
+		break;
+	default:
+		Q_ASSERT(false);
+	}
+
+	int64_t chromaLoc;
+	switch(m_chromaPlacement)
+	{
+	case ChromaPlacement::LEFT:
+		chromaLoc = VSC_CHROMA_LEFT;
+		break;
+	case ChromaPlacement::CENTER:
+		chromaLoc = VSC_CHROMA_CENTER;
+		break;
+	case ChromaPlacement::TOP_LEFT:
+		chromaLoc = VSC_CHROMA_TOP_LEFT;
+		break;
+	default:
+		Q_ASSERT(false);
+	}
+
 	VSMap * pResultMap = nullptr;
 
-	if(vsh::isSameVideoPresetFormat(pfRGB24, cpFormat, m_pCore, m_cpVSAPI))
+	if((!resized) &&
+		vsh::isSameVideoPresetFormat(pfRGB24, cpFormat, m_pCore, m_cpVSAPI))
 	{
 		to_10_bit = false;
 		pResultMap = m_cpVSAPI->createMap();
 		m_cpVSAPI->mapSetNode(pResultMap, "clip", a_nodePair.pOutputNode,
 			maReplace);
 	}
-	else if(to_10_bit &&
+	else if(to_10_bit && (!resized) &&
 		vsh::isSameVideoPresetFormat(pfRGB30, cpFormat, m_pCore, m_cpVSAPI))
 	{
 		pResultMap = m_cpVSAPI->createMap();
 		m_cpVSAPI->mapSetNode(pResultMap, "clip", a_nodePair.pOutputNode,
 			maReplace);
 	}
+	else if(m_fastYuvToRgb && (!resized) && yuvToRGBSupported(cpVideoInfo))
+	{
+		a_nodePair.pPreviewNode = yuvToRGBFilter(a_nodePair.pOutputNode,
+			matrixIn, chromaLoc, to_10_bit, m_pCore, m_cpVSAPI);
+		Q_ASSERT(a_nodePair.pPreviewNode);
+		return true;
+	}
 	else
 	{
 		bool isVF = isVariableFormat(cpVideoInfo);
@@ -650,6 +1283,8 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 		VSPlugin * pResizePlugin = m_cpVSAPI->getPluginByID(
 			"com.vapoursynth.resize", m_pCore);
 		const char * resizeName = "Point";
+		// The same kernel by its name for resample_filter_uv.
+		const char * chromaFilterName = "point";
 
 		VSMap * pArgumentMap = m_cpVSAPI->createMap();
 
@@ -658,44 +1293,8 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 		if(coreInfo.core < 58)
 			m_cpVSAPI->mapSetInt(pArgumentMap, "prefer_props", 1, maReplace);
 
-		// Set matrix and chromaloc
-
-		int64_t matrixIn;
-		switch(m_yuvMatrix)
-		{
-		case YuvMatrixCoefficients::m709:
-			matrixIn = VSC_MATRIX_BT709;
-			break;
-		case YuvMatrixCoefficients::m470BG:
-			matrixIn = VSC_MATRIX_BT470_BG;
-			break;
-		case YuvMatrixCoefficients::m170M:
-			matrixIn = VSC_MATRIX_ST170_M;
-			break;
-		case YuvMatrixCoefficients::m2020_NCL:
-			matrixIn = VSC_MATRIX_BT2020_NCL;
-			break;
-		default:
-			Q_ASSERT(false);
-		}
-
 		m_cpVSAPI->mapSetInt(pArgumentMap, "matrix_in", matrixIn, maReplace);
 
-		int64_t chromaLoc;
-		switch(m_chromaPlacement)
-		{
-		case ChromaPlacement::LEFT:
-			chromaLoc = VSC_CHROMA_LEFT;
-			break;
-		case ChromaPlacement::CENTER:
-			chromaLoc = VSC_CHROMA_CENTER;
-			break;
-		case ChromaPlacement::TOP_LEFT:
-			chromaLoc = VSC_CHROMA_TOP_LEFT;
-			break;
-		default:
-			Q_ASSERT(false);
-		}
 		m_cpVSAPI->mapSetInt(pArgumentMap, "chromaloc_in", chromaLoc, maReplace);
 
 		QString ditherType;
@@ -730,18 +1329,49 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 		m_cpVSAPI->mapSetInt(pArgumentMap, "format", (to_10_bit ?
 			pfRGB30 : pfRGB24), maReplace);
 
-		if(isYUV || isVF)
+		// Scale in the same pass as the conversion
+		if(scaled)
+		{
+			m_cpVSAPI->mapSetInt(pArgumentMap, "width", previewWidth,
+				maReplace);
+			m_cpVSAPI->mapSetInt(pArgumentMap, "height", previewHeight,
+				maReplace);
+		}
+
+		// Crop in the same pass too, so only the cropped part is converted.
+		// The resizer takes care of the chroma of subsampled formats at
+		// any offset.
+		if(cropped)
+		{
+			m_cpVSAPI->mapSetInt(pArgumentMap, "width", crop.width(),
+				maReplace);
+			m_cpVSAPI->mapSetInt(pArgumentMap, "height", crop.height(),
+				maReplace);
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "src_left", crop.x(),
+				maReplace);
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "src_top", crop.y(),
+				maReplace);
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "src_width", crop.width(),
+				maReplace);
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "src_height", crop.height(),
+				maReplace);
+		}
+
+		if(isYUV || isVF || resized)
 		{
 			switch(m_chromaResamplingFilter)
 			{
 			case ResamplingFilter::Point:
 				resizeName = "Point";
+				chromaFilterName = "point";
 				break;
 			case ResamplingFilter::Bilinear:
 				resizeName = "Bilinear";
+				chromaFilterName = "bilinear";
 				break;
 			case ResamplingFilter::Bicubic:
 				resizeName = "Bicubic";
+				chromaFilterName = "bicubic";
 				m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_a_uv",
 					m_resamplingFilterParameterA, maReplace);
 				m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_b_uv",
@@ -749,22 +1379,48 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 				break;
 			case ResamplingFilter::Lanczos:
 				resizeName = "Lanczos";
+				chromaFilterName = "lanczos";
 				m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_a_uv",
 					m_resamplingFilterParameterA, maReplace);
 				break;
 			case ResamplingFilter::Spline16:
 				resizeName = "Spline16";
+				chromaFilterName = "spline16";
 				break;
 			case ResamplingFilter::Spline36:
 				resizeName = "Spline36";
+				chromaFilterName = "spline36";
 				break;
 			case ResamplingFilter::Spline64:
 				resizeName = "Spline64";
+				chromaFilterName = "spline64";
+				break;
 			default:
 				Q_ASSERT(false);
 			}
 		}
 
+		// The function picks the luma kernel, which only matters when
+		// the picture is scaled or cropped. Chroma keeps its own.
+		if(scaled)
+		{
+			resizeName = PREVIEW_DOWNSCALE_FILTER;
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_a",
+				PREVIEW_DOWNSCALE_FILTER_PARAM_A, maReplace);
+			m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_b",
+				PREVIEW_DOWNSCALE_FILTER_PARAM_B, maReplace);
+			m_cpVSAPI->mapSetData(pArgumentMap, "resample_filter_uv",
+				chromaFilterName, -1, dtUtf8, maReplace);
+		}
+		else if(cropped)
+		{
+			// The crop is on whole pixels, so luma is copied exactly
+			// as it was from the cropped pixmap.
+			resizeName = "Point";
+			m_cpVSAPI->mapSetData(pArgumentMap, "resample_filter_uv",
+				chromaFilterName, -1, dtUtf8, maReplace);
+		}
+
 		pResultMap = m_cpVSAPI->invoke(pResizePlugin, resizeName, pArgumentMap);
 
 		m_cpVSAPI->freeMap(pArgumentMap);
@@ -785,6 +1441,34 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 	VSNode * pRGBNode = m_cpVSAPI->mapGetNode(pResultMap, "clip", 0, nullptr);
 	m_cpVSAPI->freeMap(pResultMap);
 
+	// Enlarge the crop by pixel repetition after the conversion.
+	if(cropZoom > 1)
+	{
+		VSPlugin * pResizePlugin = m_cpVSAPI->getPluginByID(
+			"com.vapoursynth.resize", m_pCore);
+		VSMap * pArgumentMap = m_cpVSAPI->createMap();
+		m_cpVSAPI->mapConsumeNode(pArgumentMap, "clip", pRGBNode, maReplace);
+		m_cpVSAPI->mapSetInt(pArgumentMap, "width", crop.width() * cropZoom,
+			maReplace);
+		m_cpVSAPI->mapSetInt(pArgumentMap, "height",
+			crop.height() * cropZoom, maReplace);
+		pResultMap = m_cpVSAPI->invoke(pResizePlugin, "Point", pArgumentMap);
+		m_cpVSAPI->freeMap(pArgumentMap);
+
+		cpResultError = m_cpVSAPI->mapGetError(pResultMap);
+		if(cpResultError)
+		{
+			m_error = tr("Failed to zoom the preview crop:\n");
+			m_error += cpResultError;
+			emit signalWriteLogMessage(mtCritical, m_error);
+			m_cpVSAPI->freeMap(pResultMap);
+			return false;
+		}
+
+		pRGBNode = m_cpVSAPI->mapGetNode(pResultMap, "clip", 0, nullptr);
+		m_cpVSAPI->freeMap(pResultMap);
+	}
+
 	VSNode * pPreviewNode = packRGBFilter(pRGBNode, a_nodePair.pOutputNode,
 		to_10_bit, m_pCore, m_cpVSAPI);
 
@@ -795,7 +1479,57 @@ bool VapourSynthScriptProcessor::recreatePreviewNode(NodePair & a_nodePair)
 }
 
 // END OF bool VapourSynthScriptProcessor::recreatePreviewNode(
-//		NodePair & a_nodePair)
+//		NodePair & a_nodePair, bool a_fullSize, const QSize & a_fitSize)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::previewSizeFor(
+	const VSVideoInfo * a_cpVideoInfo, int a_maxWidth, int a_maxHeight,
+	int & a_width, int & a_height) const
+{
+	if(!a_cpVideoInfo)
+		return false;
+
+	a_width = a_cpVideoInfo->width;
+	a_height = a_cpVideoInfo->height;
+
+	if((a_maxWidth == 0) || (a_width == 0) || (a_height == 0))
+		return false;
+
+	if((a_width <= a_maxWidth) && (a_height <= a_maxHeight))
+		return false;
+
+	double scale = std::min((double)a_maxWidth / (double)a_width,
+		(double)a_maxHeight / (double)a_height);
+	a_width = std::max((int)std::lround((double)a_width * scale), 1);
+	a_height = std::max((int)std::lround((double)a_height * scale), 1);
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::previewSizeFor(
+//		const VSVideoInfo * a_cpVideoInfo, int a_maxWidth, int a_maxHeight,
+//		int & a_width, int & a_height) const
+//==============================================================================
+
+bool VapourSynthScriptProcessor::previewCropFor(
+	const VSVideoInfo * a_cpVideoInfo, QRect & a_crop) const
+{
+	if((!a_cpVideoInfo) || m_previewCrop.isEmpty())
+		return false;
+
+	// Variable size clips are not cropped.
+	QRect frameRect(0, 0, a_cpVideoInfo->width, a_cpVideoInfo->height);
+	if(frameRect.isEmpty())
+		return false;
+
+	a_crop = m_previewCrop.intersected(frameRect);
+	if(a_crop.isEmpty())
+		return false;
+
+	return (a_crop != frameRect) || (m_previewCropZoom > 1);
+}
+
+// END OF bool VapourSynthScriptProcessor::previewCropFor(
+//		const VSVideoInfo * a_cpVideoInfo, QRect & a_crop) const
 //==============================================================================
 
 bool VapourSynthScriptProcessor::recreateAudioPreviewNode(NodePair &a_nodePair)
@@ -907,6 +1641,158 @@ NodePair & VapourSynthScriptProcessor::getNodePair(int a_outputIndex,
 //		bool a_needPreview)
 //==============================================================================
 
+VSNode * VapourSynthScriptProcessor::getMetricsNode(int a_referenceIndex,
+	int a_comparedIndex)
+{
+	std::pair<int, int> key(a_referenceIndex, a_comparedIndex);
+	std::map<std::pair<int, int>, VSNode *>::iterator it =
+		m_metricsNodes.find(key);
+	if(it != m_metricsNodes.end())
+		return it->second;
+
+	// Failures are remembered, so they are reported once.
+	VSNode *& pMetricsNode = m_metricsNodes[key];
+
+	VSNode * pReferenceNode =
+		getNodePair(a_referenceIndex, false).pOutputNode;
+	VSNode * pComparedNode = getNodePair(a_comparedIndex, false).pOutputNode;
+	if((!pReferenceNode) || (!pComparedNode))
+		return nullptr;
+
+	bool supported =
+		(m_cpVSAPI->getNodeType(pReferenceNode) == mtVideo) &&
+		(m_cpVSAPI->getNodeType(pComparedNode) == mtVideo) &&
+		frameMetricsSupported(m_cpVSAPI->getVideoInfo(pReferenceNode),
+			m_cpVSAPI->getVideoInfo(pComparedNode));
+	if(!supported)
+	{
+		m_error = tr("Can not measure output #%1 against output #%2. "
+			"Both must be video of the same constant format and size "
+			"with integer or 32 bit float samples.")
+			.arg(a_comparedIndex).arg(a_referenceIndex);
+		emit signalWriteLogMessage(mtWarning, m_error);
+		return nullptr;
+	}
+
+	pMetricsNode = frameMetricsFilter(pReferenceNode, pComparedNode, m_pCore,
+		m_cpVSAPI);
+	return pMetricsNode;
+}
+
+// END OF VSNode * VapourSynthScriptProcessor::getMetricsNode(
+//		int a_referenceIndex, int a_comparedIndex)
+//==============================================================================
+
+FrameMetrics VapourSynthScriptProcessor::frameMetrics(
+	const FrameTicket & a_ticket) const
+{
+	FrameMetrics metrics(a_ticket.frameNumber, a_ticket.outputIndex,
+		a_ticket.comparedIndex);
+	if(!a_ticket.cpOutputFrame)
+		return metrics;
+
+	const VSMap * cpProps =
+		m_cpVSAPI->getFramePropertiesRO(a_ticket.cpOutputFrame);
+	std::pair<const char *, std::vector<double> *> values[] =
+	{
+		{"MetricsPSNR", &metrics.psnr},
+		{"MetricsSSIM", &metrics.ssim},
+		{"MetricsMaxAbsDiff", &metrics.maxAbsDiff},
+	};
+	for(std::pair<const char *, std::vector<double> *> & value : values)
+	{
+		int error = 0;
+		int planes = m_cpVSAPI->mapNumElements(cpProps, value.first);
+		for(int i = 0; i < planes; ++i)
+		{
+			value.second->push_back(m_cpVSAPI->mapGetFloat(cpProps,
+				value.first, i, &error));
+		}
+	}
+	return metrics;
+}
+
+// END OF FrameMetrics VapourSynthScriptProcessor::frameMetrics(
+//		const FrameTicket & a_ticket) const
+//==============================================================================
+
+VSNode * VapourSynthScriptProcessor::getFullSizePreviewNode(
+	int a_outputIndex)
+{
+	std::map<int, VSNode *>::iterator it =
+		m_fullSizePreviewNodes.find(a_outputIndex);
+	if(it != m_fullSizePreviewNodes.end())
+		return it->second;
+
+	NodePair & nodePair = getNodePair(a_outputIndex, false);
+	if((!nodePair.pOutputNode) ||
+		(m_cpVSAPI->getNodeType(nodePair.pOutputNode) != mtVideo))
+		return nullptr;
+
+	NodePair fullSizePair(a_outputIndex, nodePair.pOutputNode, nullptr);
+	if(!recreatePreviewNode(fullSizePair, true))
+		return nullptr;
+
+	m_fullSizePreviewNodes[a_outputIndex] = fullSizePair.pPreviewNode;
+	return fullSizePair.pPreviewNode;
+}
+
+// END OF VSNode * VapourSynthScriptProcessor::getFullSizePreviewNode(
+//		int a_outputIndex)
+//==============================================================================
+
+void VapourSynthScriptProcessor::freeFullSizePreviewNodes()
+{
+	for(std::pair<const int, VSNode *> & mapItem : m_fullSizePreviewNodes)
+		m_cpVSAPI->freeNode(mapItem.second);
+	m_fullSizePreviewNodes.clear();
+}
+
+// END OF void VapourSynthScriptProcessor::freeFullSizePreviewNodes()
+//==============================================================================
+
+VSNode * VapourSynthScriptProcessor::getThumbnailNode(int a_outputIndex)
+{
+	if(!m_thumbnailSize.isValid())
+		return nullptr;
+
+	std::map<int, VSNode *>::iterator it = m_thumbnailNodes.find(a_outputIndex);
+	if(it != m_thumbnailNodes.end())
+		return it->second;
+
+	// Failures are remembered, so they are reported once.
+	VSNode *& pThumbnailNode = m_thumbnailNodes[a_outputIndex];
+
+	NodePair & nodePair = getNodePair(a_outputIndex, false);
+	if((!nodePair.pOutputNode) ||
+		(m_cpVSAPI->getNodeType(nodePair.pOutputNode) != mtVideo))
+		return nullptr;
+
+	NodePair thumbnailPair(a_outputIndex, nodePair.pOutputNode, nullptr);
+	if(!recreatePreviewNode(thumbnailPair, false, m_thumbnailSize))
+		return nullptr;
+
+	pThumbnailNode = thumbnailPair.pPreviewNode;
+	return pThumbnailNode;
+}
+
+// END OF VSNode * VapourSynthScriptProcessor::getThumbnailNode(
+//		int a_outputIndex)
+//==============================================================================
+
+void VapourSynthScriptProcessor::freeThumbnailNodes()
+{
+	for(std::pair<const int, VSNode *> & mapItem : m_thumbnailNodes)
+	{
+		if(mapItem.second)
+			m_cpVSAPI->freeNode(mapItem.second);
+	}
+	m_thumbnailNodes.clear();
+}
+
+// END OF void VapourSynthScriptProcessor::freeThumbnailNodes()
+//==============================================================================
+
 QString VapourSynthScriptProcessor::framePropsString(
 	const VSFrame * a_cpFrame) const
 {
@@ -1176,3 +2062,300 @@ bool VapourSynthScriptProcessor::clearCoreCaches()
 {
 	return m_pVSScriptLibrary->clearCoreCaches(m_pCore);
 }
+
+// END OF bool VapourSynthScriptProcessor::clearCoreCaches()
+//==============================================================================
+
+bool VapourSynthScriptProcessor::setPreviewSize(int a_width, int a_height)
+{
+	if((a_width <= 0) || (a_height <= 0))
+	{
+		a_width = 0;
+		a_height = 0;
+	}
+
+	if((a_width == m_previewWidth) && (a_height == m_previewHeight))
+		return false;
+
+	m_previewWidth = a_width;
+	m_previewHeight = a_height;
+
+	for(std::pair<const int, NodePair> & mapItem : m_nodePairForOutputIndex)
+	{
+		NodePair & nodePair = mapItem.second;
+		if(nodePair.pPreviewNode)
+			recreatePreviewNode(nodePair);
+	}
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::setPreviewSize(int a_width,
+//		int a_height)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::setPreviewCrop(const QRect & a_crop,
+	int a_zoom)
+{
+	QRect crop = a_crop.isEmpty() ? QRect() : a_crop;
+	int zoom = crop.isEmpty() ? 1 : std::max(a_zoom, 1);
+
+	if((crop == m_previewCrop) && (zoom == m_previewCropZoom))
+		return false;
+
+	m_previewCrop = crop;
+	m_previewCropZoom = zoom;
+
+	for(std::pair<const int, NodePair> & mapItem : m_nodePairForOutputIndex)
+	{
+		NodePair & nodePair = mapItem.second;
+		if(nodePair.pPreviewNode)
+			recreatePreviewNode(nodePair);
+	}
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::setPreviewCrop(const QRect & a_crop,
+//		int a_zoom)
+//==============================================================================
+
+QRect VapourSynthScriptProcessor::previewCrop() const
+{
+	return m_previewCrop;
+}
+
+// END OF QRect VapourSynthScriptProcessor::previewCrop() const
+//==============================================================================
+
+int VapourSynthScriptProcessor::previewCropZoom() const
+{
+	return m_previewCropZoom;
+}
+
+// END OF int VapourSynthScriptProcessor::previewCropZoom() const
+//==============================================================================
+
+bool VapourSynthScriptProcessor::requestFullSizePreviewFrameAsync(
+	int a_frameNumber, int a_outputIndex, FramePriority a_priority)
+{
+	if((!m_initialized) || m_finalizing)
+		return false;
+
+	VSNode * pPreviewNode = getFullSizePreviewNode(a_outputIndex);
+	if(!pPreviewNode)
+		return false;
+
+	const VSVideoInfo * cpVideoInfo = m_cpVSAPI->getVideoInfo(pPreviewNode);
+	if((a_frameNumber < 0) || (a_frameNumber >= cpVideoInfo->numFrames))
+		return false;
+
+	FrameTicket newFrameTicket(a_frameNumber, a_outputIndex, nullptr, false,
+		nullptr, a_priority);
+	newFrameTicket.kind = FrameTicketKind::FullSizePreview;
+
+	m_frameTicketsQueue[(size_t)a_priority].push_back(newFrameTicket);
+	sendFrameQueueChangeSignal();
+	processFrameTicketsQueue();
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::requestFullSizePreviewFrameAsync(
+//		int a_frameNumber, int a_outputIndex, FramePriority a_priority)
+//==============================================================================
+
+void VapourSynthScriptProcessor::setThumbnailSize(const QSize & a_size)
+{
+	if(a_size == m_thumbnailSize)
+		return;
+
+	m_thumbnailSize = a_size;
+	// Tickets in process keep their own references.
+	freeThumbnailNodes();
+}
+
+// END OF void VapourSynthScriptProcessor::setThumbnailSize(
+//		const QSize & a_size)
+//==============================================================================
+
+QByteArray VapourSynthScriptProcessor::previewConversionKey() const
+{
+	ResamplingFilter chromaFilter =
+		m_pSettingsManager->getChromaResamplingFilter();
+	QStringList parameters;
+	parameters << QString::number((int)chromaFilter);
+	if(chromaFilter == ResamplingFilter::Bicubic)
+	{
+		parameters << QString::number(
+			m_pSettingsManager->getBicubicFilterParameterB());
+		parameters << QString::number(
+			m_pSettingsManager->getBicubicFilterParameterC());
+	}
+	else if(chromaFilter == ResamplingFilter::Lanczos)
+		parameters << QString::number(m_pSettingsManager->getLanczosFilterTaps());
+	parameters << QString::number(
+		(int)m_pSettingsManager->getYuvMatrixCoefficients());
+	parameters << QString::number((int)m_pSettingsManager->getChromaPlacement());
+	parameters << QString::number((int)m_pSettingsManager->getDitherType());
+	parameters << QString::number((int)m_pSettingsManager->getFastYuvToRgb());
+	return parameters.join(',').toLatin1();
+}
+
+// END OF QByteArray VapourSynthScriptProcessor::previewConversionKey() const
+//==============================================================================
+
+bool VapourSynthScriptProcessor::requestThumbnailAsync(int a_frameNumber,
+	int a_outputIndex)
+{
+	if((!m_initialized) || m_finalizing)
+		return false;
+
+	VSNode * pThumbnailNode = getThumbnailNode(a_outputIndex);
+	if(!pThumbnailNode)
+		return false;
+
+	const VSVideoInfo * cpVideoInfo = m_cpVSAPI->getVideoInfo(pThumbnailNode);
+	if((a_frameNumber < 0) || (a_frameNumber >= cpVideoInfo->numFrames))
+		return false;
+
+	FrameTicketPredicate sameThumbnail = [&](const FrameTicket & a_ticket)
+		{
+			return (a_ticket.kind == FrameTicketKind::Thumbnail) &&
+				(!a_ticket.discard) &&
+				(a_ticket.frameNumber == a_frameNumber) &&
+				(a_ticket.outputIndex == a_outputIndex);
+		};
+
+	// The thumbnail is delivered once however many times it is requested.
+	FrameTicketList & queue =
+		m_frameTicketsQueue[(size_t)FramePriority::Background];
+	if(std::any_of(m_frameTicketsInProcess.cbegin(),
+		m_frameTicketsInProcess.cend(), sameThumbnail) ||
+		std::any_of(queue.cbegin(), queue.cend(), sameThumbnail))
+		return true;
+
+	FrameTicket newFrameTicket(a_frameNumber, a_outputIndex, nullptr, false,
+		nullptr, FramePriority::Background);
+	newFrameTicket.kind = FrameTicketKind::Thumbnail;
+
+	queue.push_back(newFrameTicket);
+	sendFrameQueueChangeSignal();
+	processFrameTicketsQueue();
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::requestThumbnailAsync(
+//		int a_frameNumber, int a_outputIndex)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::requestFrameMetricsAsync(int a_frameNumber,
+	int a_referenceIndex, int a_comparedIndex, FramePriority a_priority)
+{
+	if((!m_initialized) || m_finalizing)
+		return false;
+
+	VSNode * pMetricsNode = getMetricsNode(a_referenceIndex,
+		a_comparedIndex);
+	if(!pMetricsNode)
+		return false;
+
+	const VSVideoInfo * cpVideoInfo = m_cpVSAPI->getVideoInfo(pMetricsNode);
+	if((a_frameNumber < 0) || (a_frameNumber >= cpVideoInfo->numFrames))
+		return false;
+
+	FrameTicket newFrameTicket(a_frameNumber, a_referenceIndex, nullptr,
+		false, nullptr, a_priority);
+	newFrameTicket.kind = FrameTicketKind::Metrics;
+	newFrameTicket.comparedIndex = a_comparedIndex;
+
+	m_frameTicketsQueue[(size_t)a_priority].push_back(newFrameTicket);
+	sendFrameQueueChangeSignal();
+	processFrameTicketsQueue();
+
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::requestFrameMetricsAsync(
+//		int a_frameNumber, int a_referenceIndex, int a_comparedIndex,
+//		FramePriority a_priority)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::setNodeTimingEnabled(bool a_enabled)
+{
+	// The setting is applied to the core on initialization otherwise.
+	if(m_initialized &&
+		!m_pVSScriptLibrary->setCoreNodeTiming(m_pCore, a_enabled))
+		return false;
+
+	if(a_enabled && !m_nodeTimingEnabled)
+		resetNodeTimings();
+	m_nodeTimingEnabled = a_enabled;
+	return true;
+}
+
+// END OF bool VapourSynthScriptProcessor::setNodeTimingEnabled(
+//		bool a_enabled)
+//==============================================================================
+
+bool VapourSynthScriptProcessor::nodeTimingEnabled() const
+{
+	return m_nodeTimingEnabled;
+}
+
+// END OF bool VapourSynthScriptProcessor::nodeTimingEnabled() const
+//==============================================================================
+
+void VapourSynthScriptProcessor::resetNodeTimings()
+{
+	m_nodeTimingBaseline.clear();
+	m_nodeTimingFrames = 0;
+
+	for(std::pair<const int, NodePair> & mapItem : m_nodePairForOutputIndex)
+	{
+		std::vector<NodeTiming> timings = m_pVSScriptLibrary->getNodeTimings(
+			mapItem.second.pOutputNode);
+		for(const NodeTiming & timing : timings)
+			m_nodeTimingBaseline[timing.pNode] = timing.time;
+	}
+}
+
+// END OF void VapourSynthScriptProcessor::resetNodeTimings()
+//==============================================================================
+
+std::vector<NodeTiming> VapourSynthScriptProcessor::nodeTimings(
+	int a_outputIndex)
+{
+	if(!m_initialized)
+		return std::vector<NodeTiming>();
+
+	std::map<int, NodePair>::iterator it =
+		m_nodePairForOutputIndex.find(a_outputIndex);
+	if(it == m_nodePairForOutputIndex.end())
+		return std::vector<NodeTiming>();
+
+	std::vector<NodeTiming> timings =
+		m_pVSScriptLibrary->getNodeTimings(it->second.pOutputNode);
+	for(NodeTiming & timing : timings)
+	{
+		std::unordered_map<const VSNode *, int64_t>::const_iterator
+			baselineIt = m_nodeTimingBaseline.find(timing.pNode);
+		if(baselineIt != m_nodeTimingBaseline.end())
+			timing.time = std::max<int64_t>(timing.time - baselineIt->second, 0);
+	}
+
+	return timings;
+}
+
+// END OF std::vector<NodeTiming> VapourSynthScriptProcessor::nodeTimings(
+//		int a_outputIndex)
+//==============================================================================
+
+size_t VapourSynthScriptProcessor::nodeTimingFrames() const
+{
+	return m_nodeTimingFrames;
+}
+
+// END OF size_t VapourSynthScriptProcessor::nodeTimingFrames() const
+//==============================================================================
@@ -2,17 +2,28 @@
 #define VAPOURSYNTHSCRIPTPROCESSOR_H
 
 #include "vs_script_processor_structures.h"
+#include "vs_frame_completion_queue.h"
+#include "vs_in_flight_window.h"
 #include "../settings/settings_manager_core.h"
 #include "../helpers_vs.h"
 
 #include <vapoursynth/VSScript4.h>
 
 #include <QObject>
-#include <deque>
+#include <QByteArray>
+#include <QRect>
+#include <QSize>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <utility>
 
 class VSScriptLibrary;
+class ScriptEvaluation;
+
+typedef std::function<bool(const FrameTicket &)> FrameTicketPredicate;
 
 //==============================================================================
 
@@ -20,6 +31,10 @@ class VapourSynthScriptProcessor : public QObject
 {
 	Q_OBJECT
 
+	friend void VS_CC frameReady(void * a_pUserData,
+		const VSFrame * a_cpFrame, int a_frameNumber,
+		VSNode * a_pNode, const char * a_errorMessage);
+
 public:
 
 	VapourSynthScriptProcessor(SettingsManagerCore * a_pSettingsManager,
@@ -30,10 +45,28 @@ public:
 	bool initialize(const QString& a_script, const QString& a_scriptName,
 		int a_outputIndex, ProcessReason a_reason);
 
+	// Initializes with the script acquired from the library for the
+	// reason, taking over the reference even if it fails.
+	bool initialize(VSScript * a_pScript, const QString& a_script,
+		const QString& a_scriptName, int a_outputIndex,
+		ProcessReason a_reason);
+
+	// Evaluates the script on a worker thread and initializes the
+	// processor when it is done. Emits signalInitialized() unless
+	// the initialization is cancelled.
+	bool initializeAsync(const QString& a_script, const QString& a_scriptName,
+		int a_outputIndex, ProcessReason a_reason);
+
+	bool isInitializing() const;
+
+	void cancelInitialization();
+
 	bool finalize();
 
 	bool isInitialized() const;
 
+	ScriptOrigin scriptOrigin() const;
+
 	QString error() const;
 
 	std::vector<int> getOutputIndices() const;
@@ -41,10 +74,17 @@ public:
 	VSNodeInfo nodeInfo(int a_outputIndex = 0);
 
 	bool requestFrameAsync(int a_frameNumber, int a_outputIndex = 0,
-		bool a_needPreview = false);
+		bool a_needPreview = false,
+		FramePriority a_priority = FramePriority::Interactive);
 
 	bool flushFrameTicketsQueue();
 
+	// Drops queued tickets and discards results of tickets in process
+	// that match the predicate. Each of their requests is answered with
+	// signalFrameRequestDiscarded(), or signalThumbnailReady() without
+	// a frame, before it returns. Returns the number of affected tickets.
+	size_t cancelFrameTickets(const FrameTicketPredicate & a_predicate);
+
 	const QString & script() const;
 
 	const QString & scriptName() const;
@@ -55,6 +95,61 @@ public:
 
 	bool clearCoreCaches();
 
+	// Preview frames of larger clips are scaled down to fit the size.
+	// Zero width or height means the full resolution. Returns true if the
+	// preview nodes were rebuilt.
+	bool setPreviewSize(int a_width, int a_height);
+
+	// Preview frames of video clips are cropped to the rectangle before
+	// the conversion to RGB and enlarged by the integer zoom after it.
+	// The crop takes priority over the preview size. An empty rectangle
+	// means whole frames. Returns true if the preview nodes were rebuilt.
+	bool setPreviewCrop(const QRect & a_crop, int a_zoom);
+
+	QRect previewCrop() const;
+
+	int previewCropZoom() const;
+
+	// Converts the frame at the full resolution on the worker threads.
+	// The request is ticketed at the priority, so batches wait for the
+	// interactive requests. The frame comes with
+	// signalFullSizePreviewFrameReady().
+	bool requestFullSizePreviewFrameAsync(int a_frameNumber,
+		int a_outputIndex,
+		FramePriority a_priority = FramePriority::Background);
+
+	// Thumbnails are scaled down to fit the size. An invalid size turns
+	// them off.
+	void setThumbnailSize(const QSize & a_size);
+
+	// Identifies the settings the preview frames are converted with, as
+	// the settings manager has them, for the images kept on disk.
+	QByteArray previewConversionKey() const;
+
+	// Converts the thumbnail at the lowest priority, so it never delays
+	// other frame requests. The frame comes with signalThumbnailReady().
+	bool requestThumbnailAsync(int a_frameNumber, int a_outputIndex);
+
+	// Measures on the worker threads how the frame of the compared output
+	// differs from the reference one. The request is ticketed at the
+	// priority, so range exports wait for the interactive requests.
+	// The result comes with signalFrameMetricsReady().
+	bool requestFrameMetricsAsync(int a_frameNumber, int a_referenceIndex,
+		int a_comparedIndex,
+		FramePriority a_priority = FramePriority::Background);
+
+	bool setNodeTimingEnabled(bool a_enabled);
+
+	bool nodeTimingEnabled() const;
+
+	// Makes node timings count from now on.
+	void resetNodeTimings();
+
+	std::vector<NodeTiming> nodeTimings(int a_outputIndex);
+
+	// Number of frames produced since the node timings were reset.
+	size_t nodeTimingFrames() const;
+
 public slots:
 
 	void slotResetSettings();
@@ -71,26 +166,74 @@ signals:
 		const QString & a_reason);
 
 	void signalFrameQueueStateChanged(size_t a_inQueue, size_t a_inProcess,
-		size_t a_maxThreads, double a_usedCacheRatio);
+		size_t a_maxThreads, size_t a_inFlightLimit, double a_usedCacheRatio);
+
+	void signalFrameMetricsReady(const FrameMetrics & a_metrics);
+
+	// The frame is nullptr on error. It is freed after the signal,
+	// receivers take their own reference to keep it.
+	void signalFullSizePreviewFrameReady(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpPreviewFrame);
+
+	// The frame is nullptr on error. It is freed after the signal.
+	void signalThumbnailReady(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpThumbnailFrame);
 
 	void signalFinalized();
 
+	void signalInitializationProgress(const QString & a_message);
+
+	void signalInitialized(bool a_success);
+
 private slots:
 
 	void slotReceiveFrameAndProcessQueue(
 		const VSFrame * a_cpFrame, int a_frameNumber,
 		VSNode * a_pNode, QString a_errorMessage);
 
+	void slotProcessFrameCompletions();
+
+	void slotScriptEvaluated(VSScript * a_pScript, ScriptOrigin a_origin,
+		const QString & a_error);
+
+	void slotCoreUsersChanged();
+
 private:
 
+	void abandonScriptEvaluation();
+
+	void applyCoreResources();
+
 	void receiveFrame(const VSFrame * a_cpFrame, int a_frameNumber,
 		VSNode * a_pNode, const QString & a_errorMessage);
 
 	void processFrameTicketsQueue();
 
+	// Merges the request into a ticket for the same frame that is already
+	// queued or in process. Returns false if there is no such ticket.
+	bool coalesceFrameRequest(int a_frameNumber, int a_outputIndex,
+		bool a_needPreview, FramePriority a_priority,
+		const NodePair & a_nodePair);
+
+	// Call before the queued ticket is taken from its queue.
+	void unindexQueuedFrameTicket(FrameTicketList::iterator a_it);
+
+	size_t framesInQueue() const;
+
 	void sendFrameQueueChangeSignal();
 
-	bool recreatePreviewNode(NodePair & a_nodePair);
+	// Frames are scaled down to fit a valid size instead of the preview
+	// size and are not cropped then.
+	bool recreatePreviewNode(NodePair & a_nodePair, bool a_fullSize = false,
+		const QSize & a_fitSize = QSize());
+
+	bool previewSizeFor(const VSVideoInfo * a_cpVideoInfo, int a_maxWidth,
+		int a_maxHeight, int & a_width, int & a_height) const;
+
+	// The part of the clip frames to convert. Returns false if the whole
+	// frames are converted.
+	bool previewCropFor(const VSVideoInfo * a_cpVideoInfo,
+		QRect & a_crop) const;
 
 	bool recreateAudioPreviewNode(NodePair & a_nodePair);
 
@@ -98,6 +241,20 @@ private:
 
 	NodePair & getNodePair(int a_outputIndex, bool a_needPreview);
 
+	// Returns nullptr if the outputs can not be measured against each other.
+	VSNode * getMetricsNode(int a_referenceIndex, int a_comparedIndex);
+
+	// Reads the metrics from the frame of the completed metrics ticket.
+	FrameMetrics frameMetrics(const FrameTicket & a_ticket) const;
+
+	VSNode * getFullSizePreviewNode(int a_outputIndex);
+
+	void freeFullSizePreviewNodes();
+
+	VSNode * getThumbnailNode(int a_outputIndex);
+
+	void freeThumbnailNodes();
+
 	SettingsManagerCore * m_pSettingsManager;
 
 	VSScriptLibrary * m_pVSScriptLibrary;
@@ -114,20 +271,57 @@ private:
 
 	VSScript * m_pVSScript;
 	VSCore * m_pCore;
+	ScriptOrigin m_scriptOrigin;
+	ProcessReason m_reason;
+	bool m_coreUserRegistered;
+
+	ScriptEvaluation * m_pScriptEvaluation;
+	int m_pendingOutputIndex;
+	ProcessReason m_pendingReason;
 
 	VSNodeInfo m_nodeInfo;
 	VSCoreInfo m_cpCoreInfo;
 
-	std::deque<FrameTicket> m_frameTicketsQueue;
-	std::vector<FrameTicket> m_frameTicketsInProcess;
+	FrameTicketList m_frameTicketsQueue[FRAME_PRIORITY_CLASSES];
+	// Maps the output node and the frame number of the queued frame
+	// tickets to the ticket.
+	FrameTicketIndex m_queuedFrameTicketsIndex;
+	FrameTicketList m_frameTicketsInProcess;
+	// Maps the node the frame is currently requested from to the ticket.
+	FrameTicketIndex m_frameTicketsIndex;
 	std::map<int, NodePair> m_nodePairForOutputIndex;
 
+	// Metrics nodes by the reference and the compared output index.
+	std::map<std::pair<int, int>, VSNode *> m_metricsNodes;
+
+	// Full size preview nodes are kept for batch requests, which are
+	// ticketed like thumbnails.
+	std::map<int, VSNode *> m_fullSizePreviewNodes;
+
+	// Thumbnail requests are ticketed at the background priority.
+	std::map<int, VSNode *> m_thumbnailNodes;
+	QSize m_thumbnailSize;
+
+	FrameCompletionQueue m_frameCompletionQueue;
+
+	InFlightWindowController m_inFlightWindow;
+	int m_frameRequestsLimit;
+
+	bool m_nodeTimingEnabled;
+	std::unordered_map<const VSNode *, int64_t> m_nodeTimingBaseline;
+	size_t m_nodeTimingFrames;
+
 	ResamplingFilter m_chromaResamplingFilter;
 	ChromaPlacement m_chromaPlacement;
 	double m_resamplingFilterParameterA;
 	double m_resamplingFilterParameterB;
 	YuvMatrixCoefficients m_yuvMatrix;
 	DitherType m_ditherType;
+	bool m_fastYuvToRgb;
+	int m_previewWidth;
+	int m_previewHeight;
+	QRect m_previewCrop;
+	int m_previewCropZoom;
 
 	bool m_finalizing;
 };
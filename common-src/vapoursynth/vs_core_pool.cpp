@@ -0,0 +1,116 @@
+#include "vs_core_pool.h"
+
+//==============================================================================
+
+VSCorePool::VSCorePool():
+	  m_cpVSAPI(nullptr)
+	, m_size(0)
+	, m_coreFlags(0)
+	, m_cores()
+	, m_stopRequested(false)
+{
+}
+
+// END OF VSCorePool::VSCorePool()
+//==============================================================================
+
+VSCorePool::~VSCorePool()
+{
+	stop();
+}
+
+// END OF VSCorePool::~VSCorePool()
+//==============================================================================
+
+void VSCorePool::start(const VSAPI * a_cpVSAPI, size_t a_size,
+	int a_coreFlags)
+{
+	stop();
+
+	if(!a_cpVSAPI || (a_size == 0))
+		return;
+
+	m_cpVSAPI = a_cpVSAPI;
+	m_size = a_size;
+	m_coreFlags = a_coreFlags;
+	m_thread = std::thread(&VSCorePool::run, this);
+}
+
+// END OF void VSCorePool::start(const VSAPI * a_cpVSAPI, size_t a_size,
+//		int a_coreFlags)
+//==============================================================================
+
+void VSCorePool::stop()
+{
+	if(m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopRequested = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	for(VSCore * pCore : m_cores)
+		m_cpVSAPI->freeCore(pCore);
+	m_cores.clear();
+
+	m_stopRequested = false;
+	m_size = 0;
+}
+
+// END OF void VSCorePool::stop()
+//==============================================================================
+
+size_t VSCorePool::size() const
+{
+	return m_size;
+}
+
+// END OF size_t VSCorePool::size() const
+//==============================================================================
+
+VSCore * VSCorePool::takeCore()
+{
+	VSCore * pCore = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_cores.empty())
+			return nullptr;
+		pCore = m_cores.back();
+		m_cores.pop_back();
+	}
+	m_condition.notify_all();
+	return pCore;
+}
+
+// END OF VSCore * VSCorePool::takeCore()
+//==============================================================================
+
+void VSCorePool::run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		m_condition.wait(lock, [this]()
+			{
+				return m_stopRequested || (m_cores.size() < m_size);
+			});
+		if(m_stopRequested)
+			break;
+
+		lock.unlock();
+		VSCore * pCore = m_cpVSAPI->createCore(m_coreFlags);
+		lock.lock();
+
+		// Do not retry endlessly if cores can not be created at all.
+		if(!pCore)
+			break;
+
+		m_cores.push_back(pCore);
+	}
+}
+
+// END OF void VSCorePool::run()
+//==============================================================================
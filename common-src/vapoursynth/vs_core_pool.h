@@ -0,0 +1,55 @@
+#ifndef VS_CORE_POOL_H_INCLUDED
+#define VS_CORE_POOL_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+//==============================================================================
+
+// Keeps a few VapourSynth cores created ahead of time. Creating a core
+// loads every plugin, so it is done on a worker thread and a taken core
+// is replaced in the background.
+class VSCorePool
+{
+public:
+
+	VSCorePool();
+
+	virtual ~VSCorePool();
+
+	// Restarts the pool. Zero size leaves it stopped.
+	void start(const VSAPI * a_cpVSAPI, size_t a_size, int a_coreFlags = 0);
+
+	// Frees the cores that were not taken.
+	// Must be called before the API is unloaded.
+	void stop();
+
+	size_t size() const;
+
+	// Thread-safe. Returns nullptr if no core is ready yet.
+	VSCore * takeCore();
+
+private:
+
+	void run();
+
+	const VSAPI * m_cpVSAPI;
+	size_t m_size;
+	int m_coreFlags;
+
+	std::vector<VSCore *> m_cores;
+	bool m_stopRequested;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+};
+
+//==============================================================================
+
+#endif // VS_CORE_POOL_H_INCLUDED
@@ -0,0 +1,130 @@
+#include "vs_core_resources.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <thread>
+
+#if defined(Q_OS_WIN)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined(Q_OS_MACOS)
+	#include <sys/types.h>
+	#include <sys/sysctl.h>
+#else
+	#include <unistd.h>
+#endif
+
+//==============================================================================
+
+const int64_t MEGABYTE = 1024 * 1024;
+
+// Assumed when the physical memory size is unknown.
+const int64_t FALLBACK_PHYSICAL_MEMORY = 4096 * MEGABYTE;
+
+// Share of physical memory given to the cores by default.
+// Preview leaves more room for the editor and the frames it shows.
+const double AUTO_PREVIEW_CACHE_SHARE = 0.25;
+const double AUTO_PROCESSING_CACHE_SHARE = 0.5;
+
+// Even a fixed budget does not let the caches of all cores exceed this.
+const double MAX_CACHE_SHARE = 0.9;
+
+// Lower bound for the automatic cache size.
+const int64_t MIN_CACHE_SIZE = 256 * MEGABYTE;
+
+//==============================================================================
+
+CoreResources::CoreResources():
+	  maxCacheSize(0)
+	, threads(0)
+{
+}
+
+//==============================================================================
+
+CoreResources pickCoreResources(const CoreResourceSettings & a_settings,
+	ProcessReason a_reason, size_t a_reasonUsers, size_t a_allUsers)
+{
+	size_t reasonUsers = std::max<size_t>(a_reasonUsers, 1);
+	size_t allUsers = std::max<size_t>(a_allUsers, reasonUsers);
+
+	int64_t memory = physicalMemorySize();
+	if(memory <= 0)
+		memory = FALLBACK_PHYSICAL_MEMORY;
+
+	CoreResources resources;
+
+	int64_t cacheBudget = 0;
+	if(a_settings.cacheSize <= 0)
+	{
+		double share = (a_reason == ProcessReason::Preview) ?
+			AUTO_PREVIEW_CACHE_SHARE : AUTO_PROCESSING_CACHE_SHARE;
+		cacheBudget = (int64_t)((double)memory * share) / (int64_t)allUsers;
+		cacheBudget = std::max(cacheBudget, MIN_CACHE_SIZE);
+	}
+	else if(a_settings.cacheSizeUnit == CacheSizeUnit::PercentOfRAM)
+	{
+		int percent = std::min(a_settings.cacheSize, 100);
+		cacheBudget = memory / 100 * percent / (int64_t)reasonUsers;
+	}
+	else
+	{
+		cacheBudget = (int64_t)a_settings.cacheSize * MEGABYTE /
+			(int64_t)reasonUsers;
+	}
+
+	int64_t maxCacheSize = (int64_t)((double)memory * MAX_CACHE_SHARE) /
+		(int64_t)allUsers;
+	// The cap wins over the floor of the automatic budget, so many users
+	// on a small machine do not take more memory than it has.
+	resources.maxCacheSize = std::min(cacheBudget, maxCacheSize);
+
+	if(a_settings.threads > 0)
+		resources.threads = a_settings.threads;
+	else
+	{
+		int hardwareThreads = (int)std::thread::hardware_concurrency();
+		if(hardwareThreads <= 0)
+			resources.threads = 0; // Let the core decide.
+		else
+		{
+			resources.threads = std::max(
+				(int)((hardwareThreads + allUsers / 2) / allUsers), 1);
+		}
+	}
+
+	return resources;
+}
+
+// END OF CoreResources pickCoreResources(
+//		const CoreResourceSettings & a_settings, ProcessReason a_reason,
+//		size_t a_reasonUsers, size_t a_allUsers)
+//==============================================================================
+
+int64_t physicalMemorySize()
+{
+#if defined(Q_OS_WIN)
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if(!GlobalMemoryStatusEx(&status))
+		return 0;
+	return (int64_t)status.ullTotalPhys;
+#elif defined(Q_OS_MACOS)
+	int64_t memory = 0;
+	size_t length = sizeof(memory);
+	if(sysctlbyname("hw.memsize", &memory, &length, nullptr, 0) != 0)
+		return 0;
+	return memory;
+#else
+	long pages = sysconf(_SC_PHYS_PAGES);
+	long pageSize = sysconf(_SC_PAGE_SIZE);
+	if((pages <= 0) || (pageSize <= 0))
+		return 0;
+	return (int64_t)pages * (int64_t)pageSize;
+#endif
+}
+
+// END OF int64_t physicalMemorySize()
+//==============================================================================
@@ -0,0 +1,34 @@
+#ifndef VS_CORE_RESOURCES_H_INCLUDED
+#define VS_CORE_RESOURCES_H_INCLUDED
+
+#include "../settings/settings_definitions_core.h"
+#include "../helpers_vs.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//==============================================================================
+
+struct CoreResources
+{
+	int64_t maxCacheSize;
+	int threads;
+
+	CoreResources();
+};
+
+// Picks the framebuffer cache size and thread count for the core of a
+// processor. a_reasonUsers is the number of processors running for the
+// same reason and a_allUsers is the number of all processors in the
+// application, both including the one the resources are picked for.
+// A fixed budget for a reason is split between its processors, while
+// automatic values share the machine between all of them.
+CoreResources pickCoreResources(const CoreResourceSettings & a_settings,
+	ProcessReason a_reason, size_t a_reasonUsers, size_t a_allUsers);
+
+// Returns 0 if the size can not be determined.
+int64_t physicalMemorySize();
+
+//==============================================================================
+
+#endif // VS_CORE_RESOURCES_H_INCLUDED
@@ -0,0 +1,120 @@
+#include "vs_frame_completion_queue.h"
+
+#include <utility>
+#include <cstdint>
+
+//==============================================================================
+
+FrameCompletion::FrameCompletion():
+	  cpFrame(nullptr)
+	, frameNumber(-1)
+	, pNode(nullptr)
+	, errorMessage()
+{
+}
+
+//==============================================================================
+
+FrameCompletionQueue::FrameCompletionQueue(size_t a_capacity):
+	  m_cells()
+	, m_mask(0)
+	, m_enqueuePosition(0)
+	, m_dequeuePosition(0)
+	, m_wakeupPending(false)
+{
+	size_t capacity = 2;
+	while(capacity < a_capacity)
+		capacity <<= 1;
+
+	m_cells.reset(new Cell[capacity]);
+	m_mask = capacity - 1;
+	for(size_t i = 0; i < capacity; ++i)
+		m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// END OF FrameCompletionQueue::FrameCompletionQueue(size_t a_capacity)
+//==============================================================================
+
+FrameCompletionQueue::~FrameCompletionQueue()
+{
+}
+
+// END OF FrameCompletionQueue::~FrameCompletionQueue()
+//==============================================================================
+
+bool FrameCompletionQueue::push(const VSFrame * a_cpFrame, int a_frameNumber,
+	VSNode * a_pNode, const char * a_errorMessage)
+{
+	Cell * pCell = nullptr;
+	size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+	for(;;)
+	{
+		pCell = &m_cells[position & m_mask];
+		size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+		if(difference == 0)
+		{
+			if(m_enqueuePosition.compare_exchange_weak(position, position + 1,
+				std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+			return false;
+		else
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+	}
+
+	pCell->completion.cpFrame = a_cpFrame;
+	pCell->completion.frameNumber = a_frameNumber;
+	pCell->completion.pNode = a_pNode;
+	if(a_errorMessage)
+		pCell->completion.errorMessage = QString::fromUtf8(a_errorMessage);
+
+	pCell->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+// END OF bool FrameCompletionQueue::push(const VSFrame * a_cpFrame,
+//		int a_frameNumber, VSNode * a_pNode, const char * a_errorMessage)
+//==============================================================================
+
+bool FrameCompletionQueue::pop(FrameCompletion & a_completion)
+{
+	Cell & cell = m_cells[m_dequeuePosition & m_mask];
+	size_t sequence = cell.sequence.load(std::memory_order_acquire);
+	if(sequence != m_dequeuePosition + 1)
+		return false;
+
+	a_completion.cpFrame = cell.completion.cpFrame;
+	a_completion.frameNumber = cell.completion.frameNumber;
+	a_completion.pNode = cell.completion.pNode;
+	a_completion.errorMessage.clear();
+	std::swap(a_completion.errorMessage, cell.completion.errorMessage);
+
+	cell.sequence.store(m_dequeuePosition + m_mask + 1,
+		std::memory_order_release);
+	++m_dequeuePosition;
+	return true;
+}
+
+// END OF bool FrameCompletionQueue::pop(FrameCompletion & a_completion)
+//==============================================================================
+
+bool FrameCompletionQueue::requestWakeup()
+{
+	return !m_wakeupPending.exchange(true);
+}
+
+// END OF bool FrameCompletionQueue::requestWakeup()
+//==============================================================================
+
+void FrameCompletionQueue::clearWakeup()
+{
+	// Exchange rather than store so that the completions pushed before
+	// the last wakeup request become visible to the consumer.
+	m_wakeupPending.exchange(false);
+}
+
+// END OF void FrameCompletionQueue::clearWakeup()
+//==============================================================================
@@ -0,0 +1,70 @@
+#ifndef VS_FRAME_COMPLETION_QUEUE_H_INCLUDED
+#define VS_FRAME_COMPLETION_QUEUE_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+//==============================================================================
+
+struct FrameCompletion
+{
+	const VSFrame * cpFrame;
+	int frameNumber;
+	VSNode * pNode;
+	QString errorMessage;
+
+	FrameCompletion();
+};
+
+//==============================================================================
+
+// Bounded lock-free queue passing completed frame requests from VapourSynth
+// worker threads (many producers) to the thread that owns the script
+// processor (single consumer). Cells are preallocated, so pushing a
+// completion does not allocate unless it carries an error message.
+class FrameCompletionQueue
+{
+public:
+
+	FrameCompletionQueue(size_t a_capacity);
+
+	virtual ~FrameCompletionQueue();
+
+	// Thread-safe. Returns false when the queue is full.
+	bool push(const VSFrame * a_cpFrame, int a_frameNumber,
+		VSNode * a_pNode, const char * a_errorMessage);
+
+	// Consumer thread only.
+	bool pop(FrameCompletion & a_completion);
+
+	// Returns true if the caller is the first to request the consumer
+	// wakeup since the last drain and has to post it.
+	bool requestWakeup();
+
+	// Called by the consumer before draining the queue.
+	void clearWakeup();
+
+private:
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		FrameCompletion completion;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	size_t m_mask;
+
+	std::atomic<size_t> m_enqueuePosition;
+	size_t m_dequeuePosition;
+
+	std::atomic<bool> m_wakeupPending;
+};
+
+//==============================================================================
+
+#endif // VS_FRAME_COMPLETION_QUEUE_H_INCLUDED
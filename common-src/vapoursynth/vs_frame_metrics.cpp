@@ -0,0 +1,265 @@
+#include "vs_frame_metrics.h"
+#include "vs_frame_metrics_kernel.h"
+#include "vs_simd.h"
+
+#include <vapoursynth/VSHelper4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+template <typename T>
+void diffRowC(const void *a, const void *b, unsigned width, double &sse, double &maxDiff)
+{
+    const T *srcA = static_cast<const T *>(a);
+    const T *srcB = static_cast<const T *>(b);
+    double rowSse = 0.0;
+    for (unsigned x = 0; x < width; ++x)
+    {
+        // Float samples are subtracted in single precision like the SIMD rows do.
+        double diff = static_cast<double>(srcA[x] - srcB[x]);
+        rowSse += diff * diff;
+        maxDiff = std::max(maxDiff, std::abs(diff));
+    }
+    sse += rowSse;
+}
+
+template void diffRowC<uint8_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowC<uint16_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowC<float>(const void *, const void *, unsigned, double &, double &);
+
+template <typename T>
+void ssimSumsC(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums)
+{
+    const uint8_t *rowsA = static_cast<const uint8_t *>(a);
+    const uint8_t *rowsB = static_cast<const uint8_t *>(b);
+    for (unsigned block = 0; block < blocks; ++block)
+    {
+        float s1 = 0.0f;
+        float s2 = 0.0f;
+        float ss = 0.0f;
+        float s12 = 0.0f;
+        for (int y = 0; y < 4; ++y)
+        {
+            const T *srcA = reinterpret_cast<const T *>(rowsA + y * strideA) + 4 * block;
+            const T *srcB = reinterpret_cast<const T *>(rowsB + y * strideB) + 4 * block;
+            for (int x = 0; x < 4; ++x)
+            {
+                float va = srcA[x] * scale;
+                float vb = srcB[x] * scale;
+                s1 += va;
+                s2 += vb;
+                ss += va * va + vb * vb;
+                s12 += va * vb;
+            }
+        }
+        sums[4 * block] = s1;
+        sums[4 * block + 1] = s2;
+        sums[4 * block + 2] = ss;
+        sums[4 * block + 3] = s12;
+    }
+}
+
+template void ssimSumsC<uint8_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsC<uint16_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsC<float>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+
+template <typename T>
+diff_row_func selectDiffRowFunc()
+{
+#ifdef FRAME_METRICS_X86
+    SimdLevel level = simdLevel();
+    if (level == SimdLevel::AVX2)
+        return diffRowAVX2<T>;
+    if (level == SimdLevel::SSE41)
+        return diffRowSSE41<T>;
+#endif
+    return diffRowC<T>;
+}
+
+template <typename T>
+ssim_sums_func selectSsimSumsFunc()
+{
+#ifdef FRAME_METRICS_X86
+    SimdLevel level = simdLevel();
+    if (level == SimdLevel::AVX2)
+        return ssimSumsAVX2<T>;
+    if (level == SimdLevel::SSE41)
+        return ssimSumsSSE41<T>;
+#endif
+    return ssimSumsC<T>;
+}
+
+// The 64 samples of the window are taken as the whole population for the
+// means and as a sample for the variances. Samples are in peak units.
+static double windowSSIM(double s1, double s2, double ss, double s12)
+{
+    const double n = 64.0;
+    const double c1 = 0.01 * 0.01;
+    const double c2 = 0.03 * 0.03;
+    double mean1 = s1 / n;
+    double mean2 = s2 / n;
+    double variances = (ss - (s1 * s1 + s2 * s2) / n) / (n - 1.0);
+    double covariance = (s12 - s1 * s2 / n) / (n - 1.0);
+    return (2.0 * mean1 * mean2 + c1) * (2.0 * covariance + c2)
+        / ((mean1 * mean1 + mean2 * mean2 + c1) * (variances + c2));
+}
+
+// Windows of 2x2 blocks, so each row of blocks is summed once and
+// shared by two rows of windows.
+static double planeSSIM(const uint8_t *a, ptrdiff_t strideA, const uint8_t *b, ptrdiff_t strideB, int width, int height, float scale, ssim_sums_func ssimSums)
+{
+    unsigned blocksX = static_cast<unsigned>(width / 4);
+    unsigned blocksY = static_cast<unsigned>(height / 4);
+    if (blocksX < 2 || blocksY < 2)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<float> buffer(8 * static_cast<size_t>(blocksX));
+    float *upper = buffer.data();
+    float *lower = upper + 4 * blocksX;
+    ssimSums(a, strideA, b, strideB, blocksX, scale, upper);
+
+    double total = 0.0;
+    for (unsigned by = 1; by < blocksY; ++by)
+    {
+        ssimSums(a + 4 * by * strideA, strideA, b + 4 * by * strideB, strideB, blocksX, scale, lower);
+        for (unsigned bx = 0; bx + 1 < blocksX; ++bx)
+        {
+            double window[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                window[k] = static_cast<double>(upper[4 * bx + k]) + upper[4 * bx + 4 + k]
+                    + lower[4 * bx + k] + lower[4 * bx + 4 + k];
+            }
+            total += windowSSIM(window[0], window[1], window[2], window[3]);
+        }
+        std::swap(upper, lower);
+    }
+    return total / (static_cast<double>(blocksX - 1) * (blocksY - 1));
+}
+
+struct FrameMetricsData
+{
+    VSNode *referenceNode;
+    VSNode *comparedNode;
+    diff_row_func diffRow;
+    ssim_sums_func ssimSums;
+    double peak;
+};
+
+static void VS_CC frameMetricsFree(void *instanceData, [[maybe_unused]] VSCore *core, [[maybe_unused]] const VSAPI *vsapi)
+{
+    FrameMetricsData *d = reinterpret_cast<FrameMetricsData *>(instanceData);
+    // The nodes are freed somewhere else
+    delete d;
+}
+
+static const VSFrame *VS_CC frameMetricsGetFrame(int n, int activationReason, void *instanceData, [[maybe_unused]] void **frameData, VSFrameContext *frameCtx, VSCore *core, const VSAPI *vsapi)
+{
+    FrameMetricsData *d = reinterpret_cast<FrameMetricsData *>(instanceData);
+    if (activationReason == arInitial)
+    {
+        vsapi->requestFrameFilter(n, d->referenceNode, frameCtx);
+        vsapi->requestFrameFilter(n, d->comparedNode, frameCtx);
+    }
+    else if (activationReason == arAllFramesReady)
+    {
+        const VSFrame *referenceFrame = vsapi->getFrameFilter(n, d->referenceNode, frameCtx);
+        const VSFrame *comparedFrame = vsapi->getFrameFilter(n, d->comparedNode, frameCtx);
+        const VSVideoFormat *format = vsapi->getVideoFrameFormat(referenceFrame);
+        float scale = static_cast<float>(1.0 / d->peak);
+
+        double psnr[3];
+        double ssim[3];
+        double maxDiff[3];
+        for (int plane = 0; plane < format->numPlanes; ++plane)
+        {
+            int width = vsapi->getFrameWidth(referenceFrame, plane);
+            int height = vsapi->getFrameHeight(referenceFrame, plane);
+            const uint8_t *srcA = vsapi->getReadPtr(referenceFrame, plane);
+            const uint8_t *srcB = vsapi->getReadPtr(comparedFrame, plane);
+            ptrdiff_t strideA = vsapi->getStride(referenceFrame, plane);
+            ptrdiff_t strideB = vsapi->getStride(comparedFrame, plane);
+
+            double sse = 0.0;
+            maxDiff[plane] = 0.0;
+            for (int y = 0; y < height; ++y)
+                d->diffRow(srcA + y * strideA, srcB + y * strideB, width, sse, maxDiff[plane]);
+
+            double mse = sse / (static_cast<double>(width) * height);
+            if (mse > 0.0)
+                psnr[plane] = 10.0 * std::log10(d->peak * d->peak / mse);
+            else
+                psnr[plane] = std::numeric_limits<double>::infinity();
+
+            ssim[plane] = planeSSIM(srcA, strideA, srcB, strideB, width, height, scale, d->ssimSums);
+        }
+
+        VSVideoFormat frameFormat;
+        vsapi->getVideoFormatByID(&frameFormat, pfGray8, core);
+        VSFrame *dstFrame = vsapi->newVideoFrame(&frameFormat, 1, 1, nullptr, core);
+        *vsapi->getWritePtr(dstFrame, 0) = 0;
+
+        VSMap *props = vsapi->getFramePropertiesRW(dstFrame);
+        vsapi->mapSetFloatArray(props, "MetricsPSNR", psnr, format->numPlanes);
+        vsapi->mapSetFloatArray(props, "MetricsSSIM", ssim, format->numPlanes);
+        vsapi->mapSetFloatArray(props, "MetricsMaxAbsDiff", maxDiff, format->numPlanes);
+
+        vsapi->freeFrame(referenceFrame);
+        vsapi->freeFrame(comparedFrame);
+        return dstFrame;
+    }
+    return nullptr;
+}
+
+bool frameMetricsSupported(const VSVideoInfo *referenceVi, const VSVideoInfo *comparedVi)
+{
+    const VSVideoFormat &format = referenceVi->format;
+    bool integer = (format.sampleType == stInteger && format.bytesPerSample <= 2);
+    bool single = (format.sampleType == stFloat && format.bitsPerSample == 32);
+    return vsh::isConstantVideoFormat(referenceVi)
+        && vsh::isSameVideoInfo(referenceVi, comparedVi)
+        && (integer || single);
+}
+
+VSNode *frameMetricsFilter(VSNode *referenceNode, VSNode *comparedNode, VSCore *core, const VSAPI *vsapi)
+{
+    const VSVideoInfo *referenceVi = vsapi->getVideoInfo(referenceNode);
+    const VSVideoInfo *comparedVi = vsapi->getVideoInfo(comparedNode);
+    const VSVideoFormat &format = referenceVi->format;
+
+    VSVideoInfo vi = *referenceVi;
+    vi.width = 1;
+    vi.height = 1;
+    vi.numFrames = std::min(referenceVi->numFrames, comparedVi->numFrames);
+    vsapi->getVideoFormatByID(&vi.format, pfGray8, core);
+
+    FrameMetricsData *d = new FrameMetricsData{referenceNode, comparedNode, nullptr, nullptr, 1.0};
+    if (format.sampleType == stFloat)
+    {
+        d->diffRow = selectDiffRowFunc<float>();
+        d->ssimSums = selectSsimSumsFunc<float>();
+    }
+    else
+    {
+        d->peak = static_cast<double>((1 << format.bitsPerSample) - 1);
+        if (format.bytesPerSample == 1)
+        {
+            d->diffRow = selectDiffRowFunc<uint8_t>();
+            d->ssimSums = selectSsimSumsFunc<uint8_t>();
+        }
+        else
+        {
+            d->diffRow = selectDiffRowFunc<uint16_t>();
+            d->ssimSums = selectSsimSumsFunc<uint16_t>();
+        }
+    }
+
+    // Strict spatial dependencies must be as long as the filter.
+    std::vector<VSFilterDependency> deps = {
+        {referenceNode, (referenceVi->numFrames == vi.numFrames) ? rpStrictSpatial : rpGeneral},
+        {comparedNode, (comparedVi->numFrames == vi.numFrames) ? rpStrictSpatial : rpGeneral}};
+
+    return vsapi->createVideoFilter2("FrameMetrics", &vi, frameMetricsGetFrame, frameMetricsFree, fmParallel, deps.data(), deps.size(), d, core);
+}
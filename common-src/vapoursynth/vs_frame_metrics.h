@@ -0,0 +1,16 @@
+#ifndef VS_FRAME_METRICS_H_INCLUDED
+#define VS_FRAME_METRICS_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+// Constant and identical formats and dimensions of 8 to 16 bit integer
+// or 32 bit float samples.
+bool frameMetricsSupported(const VSVideoInfo *referenceVi, const VSVideoInfo *comparedVi);
+
+// Produces 1x1 Gray8 frames with per plane float arrays in the properties:
+// MetricsPSNR, MetricsSSIM and MetricsMaxAbsDiff. The peak is the largest
+// integer sample value or 1.0 for float. SSIM is the mean over 8x8 windows
+// on a 4 sample grid, NaN for planes smaller than the window.
+VSNode *frameMetricsFilter(VSNode *referenceNode, VSNode *comparedNode, VSCore *core, const VSAPI *vsapi);
+
+#endif
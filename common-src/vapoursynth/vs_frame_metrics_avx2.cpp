@@ -0,0 +1,175 @@
+#include "vs_frame_metrics_kernel.h"
+
+#ifdef FRAME_METRICS_X86
+
+#include <immintrin.h>
+
+// Not std::max: an inline function from a standard header built with the
+// SIMD flags may be the copy the linker keeps for the baseline code too.
+static inline double maxOf(double a, double b)
+{
+    return (a < b) ? b : a;
+}
+
+static inline uint64_t sumLanes(__m256i sum)
+{
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+}
+
+static unsigned diffVectors(const uint8_t *a, const uint8_t *b, unsigned width, double &sse, double &maxDiff)
+{
+    __m256i sum = _mm256_setzero_si256();
+    __m256i maximum = _mm256_setzero_si256();
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i va = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x)));
+        __m256i vb = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x)));
+        __m256i diff = _mm256_sub_epi16(va, vb);
+        __m256i squares = _mm256_madd_epi16(diff, diff);
+        sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+        maximum = _mm256_max_epi16(maximum, _mm256_abs_epi16(diff));
+    }
+
+    int16_t lanes[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), maximum);
+    for (int16_t lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    sse += static_cast<double>(sumLanes(sum));
+    return x;
+}
+
+static inline __m256i squaresEpu32(__m256i diff)
+{
+    __m256i even = _mm256_mul_epu32(diff, diff);
+    __m256i odd = _mm256_srli_epi64(diff, 32);
+    return _mm256_add_epi64(even, _mm256_mul_epu32(odd, odd));
+}
+
+static unsigned diffVectors(const uint16_t *a, const uint16_t *b, unsigned width, double &sse, double &maxDiff)
+{
+    __m256i sum = _mm256_setzero_si256();
+    __m256i maximum = _mm256_setzero_si256();
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256i va = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x)));
+        __m256i vb = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x)));
+        __m256i diff = _mm256_abs_epi32(_mm256_sub_epi32(va, vb));
+        sum = _mm256_add_epi64(sum, squaresEpu32(diff));
+        maximum = _mm256_max_epi32(maximum, diff);
+    }
+
+    int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), maximum);
+    for (int32_t lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    sse += static_cast<double>(sumLanes(sum));
+    return x;
+}
+
+static unsigned diffVectors(const float *a, const float *b, unsigned width, double &sse, double &maxDiff)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256d sum = _mm256_setzero_pd();
+    __m256 maximum = _mm256_setzero_ps();
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + x), _mm256_loadu_ps(b + x));
+        __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(diff));
+        __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(diff, 1));
+        sum = _mm256_add_pd(sum, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+        maximum = _mm256_max_ps(maximum, _mm256_andnot_ps(signMask, diff));
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, maximum);
+    for (float lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    double sums[4];
+    _mm256_storeu_pd(sums, sum);
+    sse += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    return x;
+}
+
+template <typename T>
+void diffRowAVX2(const void *a, const void *b, unsigned width, double &sse, double &maxDiff)
+{
+    const T *srcA = static_cast<const T *>(a);
+    const T *srcB = static_cast<const T *>(b);
+
+    unsigned x = diffVectors(srcA, srcB, width, sse, maxDiff);
+
+    if (x < width)
+        diffRowC<T>(srcA + x, srcB + x, width - x, sse, maxDiff);
+}
+
+// Eight samples, four of each of two neighbouring blocks.
+static inline __m256 loadSamples(const uint8_t *src)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src))));
+}
+
+static inline __m256 loadSamples(const uint16_t *src)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))));
+}
+
+static inline __m256 loadSamples(const float *src)
+{
+    return _mm256_loadu_ps(src);
+}
+
+template <typename T>
+void ssimSumsAVX2(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums)
+{
+    const uint8_t *rowsA = static_cast<const uint8_t *>(a);
+    const uint8_t *rowsB = static_cast<const uint8_t *>(b);
+    const __m256 factor = _mm256_set1_ps(scale);
+
+    unsigned block = 0;
+    for (; block + 2 <= blocks; block += 2)
+    {
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 ss = _mm256_setzero_ps();
+        __m256 s12 = _mm256_setzero_ps();
+        for (int y = 0; y < 4; ++y)
+        {
+            const T *srcA = reinterpret_cast<const T *>(rowsA + y * strideA) + 4 * block;
+            const T *srcB = reinterpret_cast<const T *>(rowsB + y * strideB) + 4 * block;
+            __m256 va = _mm256_mul_ps(loadSamples(srcA), factor);
+            __m256 vb = _mm256_mul_ps(loadSamples(srcB), factor);
+            s1 = _mm256_add_ps(s1, va);
+            s2 = _mm256_add_ps(s2, vb);
+            ss = _mm256_add_ps(ss, _mm256_add_ps(_mm256_mul_ps(va, va), _mm256_mul_ps(vb, vb)));
+            s12 = _mm256_add_ps(s12, _mm256_mul_ps(va, vb));
+        }
+        // Adds within the 128 bit lanes, so each lane lands as
+        // s1, s2, ss, s12 of its block.
+        _mm256_storeu_ps(sums + 4 * block, _mm256_hadd_ps(_mm256_hadd_ps(s1, s2), _mm256_hadd_ps(ss, s12)));
+    }
+
+    if (block < blocks)
+    {
+        const T *srcA = static_cast<const T *>(a) + 4 * block;
+        const T *srcB = static_cast<const T *>(b) + 4 * block;
+        ssimSumsC<T>(srcA, strideA, srcB, strideB, blocks - block, scale, sums + 4 * block);
+    }
+}
+
+template void diffRowAVX2<uint8_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowAVX2<uint16_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowAVX2<float>(const void *, const void *, unsigned, double &, double &);
+
+template void ssimSumsAVX2<uint8_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsAVX2<uint16_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsAVX2<float>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+
+#endif // FRAME_METRICS_X86
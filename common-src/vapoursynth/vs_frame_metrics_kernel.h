@@ -0,0 +1,39 @@
+#ifndef VS_FRAME_METRICS_KERNEL_H_INCLUDED
+#define VS_FRAME_METRICS_KERNEL_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+// Adds the sum of squared differences of the row to sse and raises maxDiff
+// to the largest absolute difference.
+typedef void (*diff_row_func)(const void *a, const void *b, unsigned width, double &sse, double &maxDiff);
+
+// Sums of 4x4 blocks of the two planes, starting at the given rows.
+// Samples are multiplied by scale first. Every block stores four floats:
+// sum of a, sum of b, sum of a * a + b * b and sum of a * b.
+typedef void (*ssim_sums_func)(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums);
+
+// Defined in vs_frame_metrics.cpp. The SIMD versions use them for the remainder.
+template <typename T>
+void diffRowC(const void *a, const void *b, unsigned width, double &sse, double &maxDiff);
+
+template <typename T>
+void ssimSumsC(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums);
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FRAME_METRICS_X86
+
+template <typename T>
+void diffRowSSE41(const void *a, const void *b, unsigned width, double &sse, double &maxDiff);
+
+template <typename T>
+void ssimSumsSSE41(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums);
+
+template <typename T>
+void diffRowAVX2(const void *a, const void *b, unsigned width, double &sse, double &maxDiff);
+
+template <typename T>
+void ssimSumsAVX2(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums);
+#endif
+
+#endif
@@ -0,0 +1,172 @@
+#include "vs_frame_metrics_kernel.h"
+
+#ifdef FRAME_METRICS_X86
+
+#include <cstring>
+#include <smmintrin.h>
+
+// Not std::max: an inline function from a standard header built with the
+// SIMD flags may be the copy the linker keeps for the baseline code too.
+static inline double maxOf(double a, double b)
+{
+    return (a < b) ? b : a;
+}
+
+static inline uint64_t sumLanes(__m128i sum)
+{
+    return static_cast<uint64_t>(_mm_extract_epi64(sum, 0)) + static_cast<uint64_t>(_mm_extract_epi64(sum, 1));
+}
+
+static unsigned diffVectors(const uint8_t *a, const uint8_t *b, unsigned width, double &sse, double &maxDiff)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    __m128i maximum = zero;
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x));
+        __m128i diffLo = _mm_sub_epi16(_mm_cvtepu8_epi16(va), _mm_cvtepu8_epi16(vb));
+        __m128i diffHi = _mm_sub_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero));
+        // Four squares per lane still fit 32 bits.
+        __m128i squares = _mm_add_epi32(_mm_madd_epi16(diffLo, diffLo), _mm_madd_epi16(diffHi, diffHi));
+        sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(squares, zero));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(squares, zero));
+        maximum = _mm_max_epi16(maximum, _mm_max_epi16(_mm_abs_epi16(diffLo), _mm_abs_epi16(diffHi)));
+    }
+
+    int16_t lanes[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), maximum);
+    for (int16_t lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    sse += static_cast<double>(sumLanes(sum));
+    return x;
+}
+
+static inline __m128i squaresEpu32(__m128i diff)
+{
+    __m128i even = _mm_mul_epu32(diff, diff);
+    __m128i odd = _mm_srli_epi64(diff, 32);
+    return _mm_add_epi64(even, _mm_mul_epu32(odd, odd));
+}
+
+static unsigned diffVectors(const uint16_t *a, const uint16_t *b, unsigned width, double &sse, double &maxDiff)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    __m128i maximum = zero;
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x));
+        __m128i diffLo = _mm_abs_epi32(_mm_sub_epi32(_mm_cvtepu16_epi32(va), _mm_cvtepu16_epi32(vb)));
+        __m128i diffHi = _mm_abs_epi32(_mm_sub_epi32(_mm_unpackhi_epi16(va, zero), _mm_unpackhi_epi16(vb, zero)));
+        sum = _mm_add_epi64(sum, _mm_add_epi64(squaresEpu32(diffLo), squaresEpu32(diffHi)));
+        maximum = _mm_max_epi32(maximum, _mm_max_epi32(diffLo, diffHi));
+    }
+
+    int32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), maximum);
+    for (int32_t lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    sse += static_cast<double>(sumLanes(sum));
+    return x;
+}
+
+static unsigned diffVectors(const float *a, const float *b, unsigned width, double &sse, double &maxDiff)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128d sum = _mm_setzero_pd();
+    __m128 maximum = _mm_setzero_ps();
+
+    unsigned x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + x), _mm_loadu_ps(b + x));
+        __m128d lo = _mm_cvtps_pd(diff);
+        __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(diff, diff));
+        sum = _mm_add_pd(sum, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+        maximum = _mm_max_ps(maximum, _mm_andnot_ps(signMask, diff));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, maximum);
+    for (float lane : lanes)
+        maxDiff = maxOf(maxDiff, static_cast<double>(lane));
+    double sums[2];
+    _mm_storeu_pd(sums, sum);
+    sse += sums[0] + sums[1];
+    return x;
+}
+
+template <typename T>
+void diffRowSSE41(const void *a, const void *b, unsigned width, double &sse, double &maxDiff)
+{
+    const T *srcA = static_cast<const T *>(a);
+    const T *srcB = static_cast<const T *>(b);
+
+    unsigned x = diffVectors(srcA, srcB, width, sse, maxDiff);
+
+    if (x < width)
+        diffRowC<T>(srcA + x, srcB + x, width - x, sse, maxDiff);
+}
+
+static inline __m128 loadSamples(const uint8_t *src)
+{
+    int32_t packed;
+    memcpy(&packed, src, sizeof(packed));
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+}
+
+static inline __m128 loadSamples(const uint16_t *src)
+{
+    return _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src))));
+}
+
+static inline __m128 loadSamples(const float *src)
+{
+    return _mm_loadu_ps(src);
+}
+
+template <typename T>
+void ssimSumsSSE41(const void *a, ptrdiff_t strideA, const void *b, ptrdiff_t strideB, unsigned blocks, float scale, float *sums)
+{
+    const uint8_t *rowsA = static_cast<const uint8_t *>(a);
+    const uint8_t *rowsB = static_cast<const uint8_t *>(b);
+    const __m128 factor = _mm_set1_ps(scale);
+
+    for (unsigned block = 0; block < blocks; ++block)
+    {
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 ss = _mm_setzero_ps();
+        __m128 s12 = _mm_setzero_ps();
+        for (int y = 0; y < 4; ++y)
+        {
+            const T *srcA = reinterpret_cast<const T *>(rowsA + y * strideA) + 4 * block;
+            const T *srcB = reinterpret_cast<const T *>(rowsB + y * strideB) + 4 * block;
+            __m128 va = _mm_mul_ps(loadSamples(srcA), factor);
+            __m128 vb = _mm_mul_ps(loadSamples(srcB), factor);
+            s1 = _mm_add_ps(s1, va);
+            s2 = _mm_add_ps(s2, vb);
+            ss = _mm_add_ps(ss, _mm_add_ps(_mm_mul_ps(va, va), _mm_mul_ps(vb, vb)));
+            s12 = _mm_add_ps(s12, _mm_mul_ps(va, vb));
+        }
+        // Lands as s1, s2, ss, s12.
+        _mm_storeu_ps(sums + 4 * block, _mm_hadd_ps(_mm_hadd_ps(s1, s2), _mm_hadd_ps(ss, s12)));
+    }
+}
+
+template void diffRowSSE41<uint8_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowSSE41<uint16_t>(const void *, const void *, unsigned, double &, double &);
+template void diffRowSSE41<float>(const void *, const void *, unsigned, double &, double &);
+
+template void ssimSumsSSE41<uint8_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsSSE41<uint16_t>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+template void ssimSumsSSE41<float>(const void *, ptrdiff_t, const void *, ptrdiff_t, unsigned, float, float *);
+
+#endif // FRAME_METRICS_X86
@@ -0,0 +1,281 @@
+#include "vs_frame_reorder_buffer.h"
+
+#include <algorithm>
+
+//==============================================================================
+
+// Memory the frames waiting for their turn may take.
+const size_t REORDER_BUFFER_MAX_BYTES = 1024u * 1024u * 1024u;
+// The buffer has to hold a couple of frames however large they are.
+const size_t REORDER_BUFFER_MIN_CAPACITY = 2;
+
+//==============================================================================
+
+FrameReorderBuffer::FrameReorderBuffer():
+	  m_slots()
+	, m_head(0)
+	, m_size(0)
+	, m_reserved(0)
+	, m_nextFrame(0)
+	, m_numFrames(0)
+{
+}
+
+// END OF FrameReorderBuffer::FrameReorderBuffer()
+//==============================================================================
+
+FrameReorderBuffer::~FrameReorderBuffer()
+{
+}
+
+// END OF FrameReorderBuffer::~FrameReorderBuffer()
+//==============================================================================
+
+void FrameReorderBuffer::reset(size_t a_capacity, int a_firstFrame,
+	int a_numFrames)
+{
+	Q_ASSERT(m_size == 0);
+
+	size_t capacity = std::max<size_t>(a_capacity, 1);
+	// A frame can not be reserved twice.
+	if(a_numFrames > 0)
+		capacity = std::min(capacity, (size_t)a_numFrames);
+
+	m_slots.assign(capacity, Frame(-1, -1, nullptr));
+	m_head = 0;
+	m_size = 0;
+	m_reserved = 0;
+	m_nextFrame = a_firstFrame;
+	m_numFrames = a_numFrames;
+}
+
+// END OF void FrameReorderBuffer::reset(size_t a_capacity, int a_firstFrame,
+//		int a_numFrames)
+//==============================================================================
+
+size_t FrameReorderBuffer::capacity() const
+{
+	return m_slots.size();
+}
+
+// END OF size_t FrameReorderBuffer::capacity() const
+//==============================================================================
+
+size_t FrameReorderBuffer::size() const
+{
+	return m_size;
+}
+
+// END OF size_t FrameReorderBuffer::size() const
+//==============================================================================
+
+bool FrameReorderBuffer::empty() const
+{
+	return (m_size == 0);
+}
+
+// END OF bool FrameReorderBuffer::empty() const
+//==============================================================================
+
+int FrameReorderBuffer::nextFrame() const
+{
+	return m_nextFrame;
+}
+
+// END OF int FrameReorderBuffer::nextFrame() const
+//==============================================================================
+
+size_t FrameReorderBuffer::reserved() const
+{
+	return m_reserved;
+}
+
+// END OF size_t FrameReorderBuffer::reserved() const
+//==============================================================================
+
+bool FrameReorderBuffer::canReserve() const
+{
+	return (m_reserved < m_slots.size());
+}
+
+// END OF bool FrameReorderBuffer::canReserve() const
+//==============================================================================
+
+int FrameReorderBuffer::reserveNext()
+{
+	if(!canReserve())
+		return -1;
+
+	int frameNumber = m_nextFrame + (int)m_reserved;
+	if(m_numFrames > 0)
+		frameNumber %= m_numFrames;
+	m_reserved++;
+	return frameNumber;
+}
+
+// END OF int FrameReorderBuffer::reserveNext()
+//==============================================================================
+
+bool FrameReorderBuffer::fits(int a_frameNumber) const
+{
+	int offset = offsetOf(a_frameNumber);
+	if(offset < 0)
+		return false;
+
+	const Frame & slot = m_slots[(m_head + offset) % m_slots.size()];
+	return (slot.cpOutputFrame == nullptr);
+}
+
+// END OF bool FrameReorderBuffer::fits(int a_frameNumber) const
+//==============================================================================
+
+bool FrameReorderBuffer::put(const Frame & a_frame)
+{
+	if((!a_frame.cpOutputFrame) || (!fits(a_frame.number)))
+		return false;
+
+	size_t slot = (m_head + offsetOf(a_frame.number)) % m_slots.size();
+	m_slots[slot] = a_frame;
+	m_size++;
+	return true;
+}
+
+// END OF bool FrameReorderBuffer::put(const Frame & a_frame)
+//==============================================================================
+
+const Frame * FrameReorderBuffer::front() const
+{
+	if(m_slots.empty())
+		return nullptr;
+
+	const Frame & slot = m_slots[m_head];
+	if(!slot.cpOutputFrame)
+		return nullptr;
+	return &slot;
+}
+
+// END OF const Frame * FrameReorderBuffer::front() const
+//==============================================================================
+
+bool FrameReorderBuffer::takeFront(Frame & a_frame)
+{
+	if(!front())
+		return false;
+
+	Frame & slot = m_slots[m_head];
+	a_frame = slot;
+	slot = Frame(-1, -1, nullptr);
+	m_size--;
+	advance();
+
+	return true;
+}
+
+// END OF bool FrameReorderBuffer::takeFront(Frame & a_frame)
+//==============================================================================
+
+void FrameReorderBuffer::dropFront(const VSAPI * a_cpVSAPI)
+{
+	if(m_slots.empty())
+		return;
+
+	Frame & slot = m_slots[m_head];
+	if(slot.cpOutputFrame)
+	{
+		Q_ASSERT(a_cpVSAPI);
+		a_cpVSAPI->freeFrame(slot.cpOutputFrame);
+		a_cpVSAPI->freeFrame(slot.cpPreviewFrame);
+		slot = Frame(-1, -1, nullptr);
+		m_size--;
+	}
+	advance();
+}
+
+// END OF void FrameReorderBuffer::dropFront(const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+void FrameReorderBuffer::clear(const VSAPI * a_cpVSAPI)
+{
+	m_reserved = 0;
+	if(m_size == 0)
+		return;
+
+	Q_ASSERT(a_cpVSAPI);
+	for(Frame & slot : m_slots)
+	{
+		if(!slot.cpOutputFrame)
+			continue;
+		a_cpVSAPI->freeFrame(slot.cpOutputFrame);
+		a_cpVSAPI->freeFrame(slot.cpPreviewFrame);
+		slot = Frame(-1, -1, nullptr);
+	}
+	m_size = 0;
+}
+
+// END OF void FrameReorderBuffer::clear(const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+size_t FrameReorderBuffer::capacityFor(size_t a_framesLimit,
+	const VSVideoInfo * a_cpVideoInfo, bool a_withPreview)
+{
+	size_t framesLimit = std::max(a_framesLimit, REORDER_BUFFER_MIN_CAPACITY);
+	if(!a_cpVideoInfo)
+		return framesLimit;
+
+	const VSVideoFormat & format = a_cpVideoInfo->format;
+	size_t pixels = (size_t)a_cpVideoInfo->width * a_cpVideoInfo->height;
+	// Variable size or format clips are counted as one pixel per frame.
+	size_t frameSize = std::max<size_t>(pixels, 1) * format.bytesPerSample;
+	if(format.numPlanes > 1)
+	{
+		size_t chromaSize = frameSize >>
+			(format.subSamplingW + format.subSamplingH);
+		frameSize += chromaSize * (format.numPlanes - 1);
+	}
+	if(a_withPreview)
+		frameSize += pixels * 4;
+
+	size_t capacity = REORDER_BUFFER_MAX_BYTES / std::max<size_t>(frameSize, 1);
+	return std::min(std::max(capacity, REORDER_BUFFER_MIN_CAPACITY),
+		framesLimit);
+}
+
+// END OF size_t FrameReorderBuffer::capacityFor(size_t a_framesLimit,
+//		const VSVideoInfo * a_cpVideoInfo, bool a_withPreview)
+//==============================================================================
+
+int FrameReorderBuffer::offsetOf(int a_frameNumber) const
+{
+	if(m_slots.empty() || (a_frameNumber < 0))
+		return -1;
+
+	int offset = a_frameNumber - m_nextFrame;
+	if(m_numFrames > 0)
+	{
+		if(a_frameNumber >= m_numFrames)
+			return -1;
+		if(offset < 0)
+			offset += m_numFrames;
+	}
+
+	if((offset < 0) || ((size_t)offset >= m_reserved))
+		return -1;
+	return offset;
+}
+
+// END OF int FrameReorderBuffer::offsetOf(int a_frameNumber) const
+//==============================================================================
+
+void FrameReorderBuffer::advance()
+{
+	if(m_reserved > 0)
+		m_reserved--;
+
+	m_head = (m_head + 1) % m_slots.size();
+	m_nextFrame++;
+	if((m_numFrames > 0) && (m_nextFrame >= m_numFrames))
+		m_nextFrame = 0;
+}
+
+// END OF void FrameReorderBuffer::advance()
+//==============================================================================
@@ -0,0 +1,95 @@
+#ifndef VS_FRAME_REORDER_BUFFER_H_INCLUDED
+#define VS_FRAME_REORDER_BUFFER_H_INCLUDED
+
+#include "vs_script_processor_structures.h"
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <cstddef>
+#include <vector>
+
+//==============================================================================
+
+// Puts frames that complete out of order back in sequence for a consumer
+// that takes them one by one from the first frame on. The producer reserves
+// the frames to request in sequence, no more than the capacity ahead of the
+// next frame to take, and only the reserved frames are accepted.
+// A frame goes to the ring slot at its distance from the next frame, so
+// finding the next frame takes no search and storing takes no allocation.
+// With a non-zero frame count the sequence wraps to frame 0 after the last
+// frame, for looped playback.
+class FrameReorderBuffer
+{
+public:
+
+	FrameReorderBuffer();
+
+	virtual ~FrameReorderBuffer();
+
+	// Only an empty buffer can be reset.
+	void reset(size_t a_capacity, int a_firstFrame, int a_numFrames = 0);
+
+	size_t capacity() const;
+
+	size_t size() const;
+
+	bool empty() const;
+
+	// The number of the next frame to take.
+	int nextFrame() const;
+
+	// Frames reserved and not taken yet.
+	size_t reserved() const;
+
+	bool canReserve() const;
+
+	// Returns the number of the frame to request next or -1 if the window
+	// is full.
+	int reserveNext();
+
+	// True if the frame is reserved and has not arrived yet.
+	bool fits(int a_frameNumber) const;
+
+	// The buffer takes the frame references. Returns false if the frame
+	// does not fit, and the references stay with the caller.
+	bool put(const Frame & a_frame);
+
+	// The next frame or nullptr if it has not arrived yet.
+	const Frame * front() const;
+
+	// Removes the next frame and passes its references to the caller.
+	bool takeFront(Frame & a_frame);
+
+	// Skips the next frame whether it has arrived or not. If it is still
+	// in process it is not accepted when it arrives.
+	void dropFront(const VSAPI * a_cpVSAPI);
+
+	// Frees all stored frames. The window stays where it is, but frames
+	// still in process are not accepted any more.
+	void clear(const VSAPI * a_cpVSAPI);
+
+	// Frames per buffer that keep the frame memory under a common budget,
+	// but no more than a_framesLimit.
+	static size_t capacityFor(size_t a_framesLimit,
+		const VSVideoInfo * a_cpVideoInfo, bool a_withPreview);
+
+private:
+
+	// Distance from the next frame in the reserved part of the sequence
+	// or -1 outside of it.
+	int offsetOf(int a_frameNumber) const;
+
+	// Moves the window one frame on past an emptied head slot.
+	void advance();
+
+	std::vector<Frame> m_slots;
+	size_t m_head;
+	size_t m_size;
+	size_t m_reserved;
+	int m_nextFrame;
+	int m_numFrames;
+};
+
+//==============================================================================
+
+#endif // VS_FRAME_REORDER_BUFFER_H_INCLUDED
@@ -0,0 +1,203 @@
+#include "vs_in_flight_window.h"
+
+#include <algorithm>
+
+//==============================================================================
+
+// Shortest measurement period in seconds.
+const double MIN_PERIOD = 0.25;
+// Fewest completions a measurement period has to include.
+const size_t MIN_PERIOD_COMPLETIONS = 4;
+// Relative throughput change that is not considered noise.
+const double THROUGHPUT_TOLERANCE = 0.05;
+// Relative latency growth that makes a flat throughput a loss.
+const double LATENCY_TOLERANCE = 0.1;
+// Above this core cache usage the window does not grow.
+const double SOFT_CACHE_RATIO = 0.75;
+// Above this core cache usage the window shrinks.
+const double HARD_CACHE_RATIO = 0.9;
+// The window never grows above this many requests per core thread.
+const size_t MAX_REQUESTS_PER_THREAD = 4;
+// Measured periods of holding still before the window probes a step
+// again, so it follows the script when its cost changes.
+const size_t STABLE_PERIODS_BEFORE_PROBE = 8;
+
+//==============================================================================
+
+InFlightWindowController::InFlightWindowController():
+	  m_minLimit(1)
+	, m_maxLimit(1)
+	, m_limit(1)
+	, m_pinnedLimit(0)
+	, m_periodStart()
+	, m_periodCompletions(0)
+	, m_periodLatencySum(0.0)
+	, m_periodSaturated(false)
+	, m_lastThroughput(0.0)
+	, m_lastLatency(0.0)
+	, m_direction(1)
+	, m_stablePeriods(0)
+	, m_probeDirection(1)
+{
+	startPeriod(hr_clock::now());
+}
+
+// END OF InFlightWindowController::InFlightWindowController()
+//==============================================================================
+
+InFlightWindowController::~InFlightWindowController()
+{
+}
+
+// END OF InFlightWindowController::~InFlightWindowController()
+//==============================================================================
+
+void InFlightWindowController::reset(size_t a_numThreads,
+	size_t a_pinnedLimit)
+{
+	size_t numThreads = std::max<size_t>(a_numThreads, 1);
+	m_minLimit = 1;
+	m_maxLimit = std::max<size_t>(numThreads * MAX_REQUESTS_PER_THREAD, 8);
+	m_pinnedLimit = a_pinnedLimit;
+	m_limit = m_pinnedLimit ? m_pinnedLimit : numThreads;
+
+	m_lastThroughput = 0.0;
+	m_lastLatency = 0.0;
+	m_direction = 1;
+	m_stablePeriods = 0;
+	m_probeDirection = 1;
+	startPeriod(hr_clock::now());
+}
+
+// END OF void InFlightWindowController::reset(size_t a_numThreads,
+//		size_t a_pinnedLimit)
+//==============================================================================
+
+size_t InFlightWindowController::limit() const
+{
+	return m_limit;
+}
+
+// END OF size_t InFlightWindowController::limit() const
+//==============================================================================
+
+bool InFlightWindowController::pinned() const
+{
+	return (m_pinnedLimit != 0);
+}
+
+// END OF bool InFlightWindowController::pinned() const
+//==============================================================================
+
+void InFlightWindowController::setSaturated()
+{
+	m_periodSaturated = true;
+}
+
+// END OF void InFlightWindowController::setSaturated()
+//==============================================================================
+
+void InFlightWindowController::frameCompleted(double a_latency)
+{
+	m_periodCompletions++;
+	m_periodLatencySum += a_latency;
+}
+
+// END OF void InFlightWindowController::frameCompleted(double a_latency)
+//==============================================================================
+
+void InFlightWindowController::update(double a_usedCacheRatio)
+{
+	update(a_usedCacheRatio, hr_clock::now());
+}
+
+// END OF void InFlightWindowController::update(double a_usedCacheRatio)
+//==============================================================================
+
+void InFlightWindowController::update(double a_usedCacheRatio,
+	hr_time_point a_now)
+{
+	if(pinned())
+		return;
+
+	double elapsed = duration_to_double(a_now - m_periodStart);
+	if((elapsed < MIN_PERIOD) ||
+		(m_periodCompletions < MIN_PERIOD_COMPLETIONS))
+		return;
+
+	if(!m_periodSaturated && (a_usedCacheRatio <= HARD_CACHE_RATIO))
+	{
+		// The consumer did not ask for more - nothing to learn here.
+		startPeriod(a_now);
+		return;
+	}
+
+	double throughput = (double)m_periodCompletions / elapsed;
+	double latency = m_periodLatencySum / (double)m_periodCompletions;
+	size_t step = std::max<size_t>(m_limit / 8, 1);
+
+	if(a_usedCacheRatio > HARD_CACHE_RATIO)
+	{
+		m_direction = -1;
+		step = std::max<size_t>(m_limit / 4, 1);
+	}
+	else if(m_lastThroughput <= 0.0)
+		m_direction = 1;
+	else
+	{
+		double gain = throughput / m_lastThroughput - 1.0;
+		if(gain < -THROUGHPUT_TOLERANCE)
+			m_direction = (m_direction > 0) ? -1 : 1;
+		else if(gain <= THROUGHPUT_TOLERANCE)
+		{
+			// No gain from the last step. Prefer the shallower window
+			// if requests started waiting longer.
+			if(latency > m_lastLatency * (1.0 + LATENCY_TOLERANCE))
+				m_direction = -1;
+			else
+				m_direction = 0;
+		}
+		else if(m_direction == 0)
+			m_direction = 1;
+
+		if(m_direction == 0)
+		{
+			m_stablePeriods++;
+			if(m_stablePeriods >= STABLE_PERIODS_BEFORE_PROBE)
+			{
+				m_direction = m_probeDirection;
+				m_probeDirection = -m_probeDirection;
+			}
+		}
+	}
+
+	if(m_direction != 0)
+		m_stablePeriods = 0;
+
+	if((m_direction > 0) && (a_usedCacheRatio > SOFT_CACHE_RATIO))
+		m_direction = 0;
+
+	if(m_direction > 0)
+		m_limit = std::min(m_limit + step, m_maxLimit);
+	else if(m_direction < 0)
+		m_limit = std::max(m_limit - std::min(step, m_limit), m_minLimit);
+
+	m_lastThroughput = throughput;
+	m_lastLatency = latency;
+	startPeriod(a_now);
+}
+
+// END OF void InFlightWindowController::update(double a_usedCacheRatio,
+//		hr_time_point a_now)
+//==============================================================================
+
+void InFlightWindowController::startPeriod(hr_time_point a_now)
+{
+	m_periodStart = a_now;
+	m_periodCompletions = 0;
+	m_periodLatencySum = 0.0;
+	m_periodSaturated = false;
+}
+
+// END OF void InFlightWindowController::startPeriod(hr_time_point a_now)
+//==============================================================================
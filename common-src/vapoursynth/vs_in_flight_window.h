@@ -0,0 +1,65 @@
+#ifndef VS_IN_FLIGHT_WINDOW_H_INCLUDED
+#define VS_IN_FLIGHT_WINDOW_H_INCLUDED
+
+#include "../chrono.h"
+
+#include <cstddef>
+
+//==============================================================================
+
+// Chooses how many frame requests the script processor keeps in process
+// at once. Starts at the core thread count and climbs towards the depth
+// with the best measured throughput, backing off under cache pressure.
+class InFlightWindowController
+{
+public:
+
+	InFlightWindowController();
+
+	virtual ~InFlightWindowController();
+
+	// A non-zero a_pinnedLimit disables the adaptation.
+	void reset(size_t a_numThreads, size_t a_pinnedLimit);
+
+	size_t limit() const;
+
+	bool pinned() const;
+
+	// Report that the window was full after dispatching. Periods when
+	// the consumer requests less than the window are not measured.
+	void setSaturated();
+
+	void frameCompleted(double a_latency);
+
+	void update(double a_usedCacheRatio);
+
+	// Measures the period up to the given time instead of the clock.
+	void update(double a_usedCacheRatio, hr_time_point a_now);
+
+private:
+
+	void startPeriod(hr_time_point a_now);
+
+	size_t m_minLimit;
+	size_t m_maxLimit;
+	size_t m_limit;
+	size_t m_pinnedLimit;
+
+	hr_time_point m_periodStart;
+	size_t m_periodCompletions;
+	double m_periodLatencySum;
+	bool m_periodSaturated;
+
+	double m_lastThroughput;
+	double m_lastLatency;
+	int m_direction;
+
+	// Measured periods the window has been holding still for.
+	size_t m_stablePeriods;
+	// Direction of the next probe out of the hold, alternating.
+	int m_probeDirection;
+};
+
+//==============================================================================
+
+#endif // VS_IN_FLIGHT_WINDOW_H_INCLUDED
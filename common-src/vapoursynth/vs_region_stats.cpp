@@ -0,0 +1,189 @@
+#include "vs_region_stats.h"
+#include "vs_region_stats_kernel.h"
+#include "vs_simd.h"
+#include "../helpers.h"
+
+#include <vapoursynth/VSConstants4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+void regionStatsRowC(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const T *samples = static_cast<const T *>(src);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        double value = static_cast<double>(samples[x]);
+        // NaN fails every comparison and is left out of min and max.
+        if (value < sums.min)
+            sums.min = value;
+        if (value > sums.max)
+            sums.max = value;
+        if (std::is_integral<T>::value)
+        {
+            uint64_t sample = static_cast<uint64_t>(samples[x]);
+            sums.intSum += sample;
+            sums.intSumSquares += sample * sample;
+        }
+        else
+        {
+            sums.floatSum += value;
+            sums.floatSumSquares += value * value;
+        }
+        if (value <= limits.low)
+            sums.low++;
+        if (value >= limits.high)
+            sums.high++;
+    }
+}
+
+template void regionStatsRowC<uint8_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowC<uint16_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowC<float>(const void *, unsigned, const RegionLimits &, RegionSums &);
+
+static void regionStatsRowHalf(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const uint16_t *samples = static_cast<const uint16_t *>(src);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        vsedit::FP16 half;
+        half.u = samples[x];
+        float single = vsedit::halfToSingle(half).f;
+        regionStatsRowC<float>(&single, 1, limits, sums);
+    }
+}
+
+template <typename T>
+region_stats_row_func selectStatsRowFunc()
+{
+#ifdef REGION_STATS_X86
+    SimdLevel level = simdLevel();
+    if (level == SimdLevel::AVX2)
+        return regionStatsRowAVX2<T>;
+    if (level == SimdLevel::SSE41)
+        return regionStatsRowSSE41<T>;
+#endif
+    return regionStatsRowC<T>;
+}
+
+static region_stats_row_func statsRowFunc(const VSVideoFormat *format)
+{
+    if (format->sampleType == stInteger)
+    {
+        if (format->bytesPerSample == 1)
+            return selectStatsRowFunc<uint8_t>();
+        if (format->bytesPerSample == 2)
+            return selectStatsRowFunc<uint16_t>();
+    }
+    else if (format->sampleType == stFloat)
+    {
+        if (format->bytesPerSample == 2)
+            return regionStatsRowHalf;
+        if (format->bytesPerSample == 4)
+            return selectStatsRowFunc<float>();
+    }
+    return nullptr;
+}
+
+static RegionLimits planeLimits(const VSVideoFormat *format, int plane, bool limitedRange)
+{
+    RegionLimits limits;
+    bool chroma = (format->colorFamily == cfYUV) && (plane > 0);
+    if (format->sampleType == stFloat)
+    {
+        limits.low = chroma ? -0.5 : 0.0;
+        limits.high = chroma ? 0.5 : 1.0;
+    }
+    else if (limitedRange)
+    {
+        int shift = format->bitsPerSample - 8;
+        limits.low = static_cast<double>(16 << shift);
+        limits.high = static_cast<double>((chroma ? 240 : 235) << shift);
+    }
+    else
+    {
+        limits.low = 0.0;
+        limits.high = static_cast<double>((1 << format->bitsPerSample) - 1);
+    }
+    return limits;
+}
+
+RegionStats::RegionStats()
+    : colorFamily(cfUndefined)
+    , planes(0)
+    , stats()
+{
+}
+
+bool RegionStats::isEmpty() const
+{
+    return planes == 0;
+}
+
+RegionStats computeRegionStats(const VSFrame *frame, const VSAPI *vsapi, int left, int top, int width, int height)
+{
+    RegionStats regionStats;
+    const VSVideoFormat *format = vsapi->getVideoFrameFormat(frame);
+    if (!format)
+        return regionStats;
+    region_stats_row_func rowFunc = statsRowFunc(format);
+    if (!rowFunc)
+        return regionStats;
+
+    int right = std::min(left + width, vsapi->getFrameWidth(frame, 0));
+    int bottom = std::min(top + height, vsapi->getFrameHeight(frame, 0));
+    left = std::max(left, 0);
+    top = std::max(top, 0);
+    if ((left >= right) || (top >= bottom))
+        return regionStats;
+
+    // Clips without the property are taken the way VapourSynth resizers
+    // take them: YUV and gray as limited range and RGB as full range.
+    int error = 0;
+    int64_t colorRange = vsapi->mapGetInt(vsapi->getFramePropertiesRO(frame), "_ColorRange", 0, &error);
+    bool limitedRange = error ? (format->colorFamily != cfRGB) : (colorRange == VSC_RANGE_LIMITED);
+
+    regionStats.colorFamily = format->colorFamily;
+    regionStats.planes = format->numPlanes;
+
+    for (int plane = 0; plane < format->numPlanes; ++plane)
+    {
+        int shiftW = (plane > 0) ? format->subSamplingW : 0;
+        int shiftH = (plane > 0) ? format->subSamplingH : 0;
+        int planeLeft = left >> shiftW;
+        int planeTop = top >> shiftH;
+        int planeRight = (right + (1 << shiftW) - 1) >> shiftW;
+        int planeBottom = (bottom + (1 << shiftH) - 1) >> shiftH;
+
+        RegionLimits limits = planeLimits(format, plane, limitedRange);
+        RegionSums sums = {};
+        sums.min = std::numeric_limits<double>::infinity();
+        sums.max = -std::numeric_limits<double>::infinity();
+
+        const uint8_t *src = vsapi->getReadPtr(frame, plane) + static_cast<ptrdiff_t>(planeLeft) * format->bytesPerSample;
+        ptrdiff_t stride = vsapi->getStride(frame, plane);
+        unsigned rowWidth = static_cast<unsigned>(planeRight - planeLeft);
+        for (int y = planeTop; y < planeBottom; ++y)
+            rowFunc(src + y * stride, rowWidth, limits, sums);
+
+        PlaneRegionStats &stats = regionStats.stats[plane];
+        stats.count = static_cast<uint64_t>(rowWidth) * (planeBottom - planeTop);
+        stats.min = sums.min;
+        stats.max = sums.max;
+        double count = static_cast<double>(stats.count);
+        double sum = (format->sampleType == stInteger) ? static_cast<double>(sums.intSum) : sums.floatSum;
+        double sumSquares = (format->sampleType == stInteger) ? static_cast<double>(sums.intSumSquares) : sums.floatSumSquares;
+        stats.mean = sum / count;
+        stats.stddev = std::sqrt(std::max(sumSquares / count - stats.mean * stats.mean, 0.0));
+        stats.lowLimit = limits.low;
+        stats.highLimit = limits.high;
+        stats.low = sums.low;
+        stats.high = sums.high;
+    }
+
+    return regionStats;
+}
@@ -0,0 +1,41 @@
+#ifndef VS_REGION_STATS_H_INCLUDED
+#define VS_REGION_STATS_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <cstdint>
+
+struct PlaneRegionStats
+{
+    uint64_t count;
+    double min;
+    double max;
+    double mean;
+    double stddev;
+    // Samples at or below lowLimit and at or above highLimit. The limits
+    // are the legal range for limited range clips and the ends of the
+    // sample range otherwise.
+    double lowLimit;
+    double highLimit;
+    uint64_t low;
+    uint64_t high;
+};
+
+struct RegionStats
+{
+    int colorFamily;
+    int planes;
+    PlaneRegionStats stats[3];
+
+    RegionStats();
+
+    bool isEmpty() const;
+};
+
+// The rectangle is given in samples of the first plane and is clipped to
+// the frame; subsampled planes take every sample it touches. Integer
+// formats of up to 16 bits and half and single float are supported,
+// others give empty statistics.
+RegionStats computeRegionStats(const VSFrame *frame, const VSAPI *vsapi, int left, int top, int width, int height);
+
+#endif
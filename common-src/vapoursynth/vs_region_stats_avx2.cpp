@@ -0,0 +1,211 @@
+#include "vs_region_stats_kernel.h"
+
+#ifdef REGION_STATS_X86
+
+#include <immintrin.h>
+
+// Not std::min and std::max: an inline function from a standard header
+// built with the SIMD flags may be the copy the linker keeps for the
+// baseline code too.
+static inline double minOf(double a, double b)
+{
+    return (b < a) ? b : a;
+}
+
+static inline double maxOf(double a, double b)
+{
+    return (a < b) ? b : a;
+}
+
+static uint64_t sumLanes64(__m256i v)
+{
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static __m256i widenLanes32(__m256i v)
+{
+    return _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)),
+        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+static unsigned statsVectors(const uint8_t *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi8(1);
+    const __m256i low = _mm256_set1_epi8(static_cast<char>(static_cast<uint8_t>(limits.low)));
+    const __m256i high = _mm256_set1_epi8(static_cast<char>(static_cast<uint8_t>(limits.high)));
+
+    __m256i minValues = _mm256_set1_epi8(static_cast<char>(0xFF));
+    __m256i maxValues = zero;
+    __m256i sum = zero;
+    __m256i sumSquares = zero;
+    __m256i lowCount = zero;
+    __m256i highCount = zero;
+
+    unsigned x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x));
+        minValues = _mm256_min_epu8(minValues, v);
+        maxValues = _mm256_max_epu8(maxValues, v);
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(v, zero));
+
+        __m256i lo = _mm256_unpacklo_epi8(v, zero);
+        __m256i hi = _mm256_unpackhi_epi8(v, zero);
+        __m256i squares = _mm256_add_epi32(_mm256_madd_epi16(lo, lo), _mm256_madd_epi16(hi, hi));
+        sumSquares = _mm256_add_epi64(sumSquares, widenLanes32(squares));
+
+        __m256i isLow = _mm256_cmpeq_epi8(_mm256_min_epu8(v, low), v);
+        __m256i isHigh = _mm256_cmpeq_epi8(_mm256_max_epu8(v, high), v);
+        lowCount = _mm256_add_epi64(lowCount, _mm256_sad_epu8(_mm256_and_si256(isLow, ones), zero));
+        highCount = _mm256_add_epi64(highCount, _mm256_sad_epu8(_mm256_and_si256(isHigh, ones), zero));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(32) uint8_t minLanes[32];
+    alignas(32) uint8_t maxLanes[32];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(minLanes), minValues);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxLanes), maxValues);
+    for (int i = 0; i < 32; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+    }
+    sums.intSum += sumLanes64(sum);
+    sums.intSumSquares += sumLanes64(sumSquares);
+    sums.low += sumLanes64(lowCount);
+    sums.high += sumLanes64(highCount);
+    return x;
+}
+
+static unsigned statsVectors(const uint16_t *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+    const __m256i low = _mm256_set1_epi16(static_cast<short>(static_cast<uint16_t>(limits.low)));
+    const __m256i high = _mm256_set1_epi16(static_cast<short>(static_cast<uint16_t>(limits.high)));
+
+    __m256i minValues = _mm256_set1_epi16(static_cast<short>(0xFFFF));
+    __m256i maxValues = zero;
+    __m256i sum = zero;
+    __m256i sumSquares = zero;
+    __m256i lowCount = zero;
+    __m256i highCount = zero;
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x));
+        minValues = _mm256_min_epu16(minValues, v);
+        maxValues = _mm256_max_epu16(maxValues, v);
+
+        // Low and high bytes are summed apart, so the sums can not overflow.
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_and_si256(v, lowBytes), zero));
+        sum = _mm256_add_epi64(sum, _mm256_slli_epi64(_mm256_sad_epu8(_mm256_srli_epi16(v, 8), zero), 8));
+
+        __m256i lo = _mm256_unpacklo_epi16(v, zero);
+        __m256i hi = _mm256_unpackhi_epi16(v, zero);
+        sumSquares = _mm256_add_epi64(sumSquares, _mm256_mul_epu32(lo, lo));
+        sumSquares = _mm256_add_epi64(sumSquares, _mm256_mul_epu32(_mm256_srli_epi64(lo, 32), _mm256_srli_epi64(lo, 32)));
+        sumSquares = _mm256_add_epi64(sumSquares, _mm256_mul_epu32(hi, hi));
+        sumSquares = _mm256_add_epi64(sumSquares, _mm256_mul_epu32(_mm256_srli_epi64(hi, 32), _mm256_srli_epi64(hi, 32)));
+
+        __m256i isLow = _mm256_cmpeq_epi16(_mm256_min_epu16(v, low), v);
+        __m256i isHigh = _mm256_cmpeq_epi16(_mm256_max_epu16(v, high), v);
+        lowCount = _mm256_add_epi64(lowCount, _mm256_sad_epu8(_mm256_srli_epi16(isLow, 15), zero));
+        highCount = _mm256_add_epi64(highCount, _mm256_sad_epu8(_mm256_srli_epi16(isHigh, 15), zero));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(32) uint16_t minLanes[16];
+    alignas(32) uint16_t maxLanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(minLanes), minValues);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxLanes), maxValues);
+    for (int i = 0; i < 16; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+    }
+    sums.intSum += sumLanes64(sum);
+    sums.intSumSquares += sumLanes64(sumSquares);
+    sums.low += sumLanes64(lowCount);
+    sums.high += sumLanes64(highCount);
+    return x;
+}
+
+static unsigned statsVectors(const float *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m256 low = _mm256_set1_ps(static_cast<float>(limits.low));
+    const __m256 high = _mm256_set1_ps(static_cast<float>(limits.high));
+
+    __m256 minValues = _mm256_set1_ps(static_cast<float>(sums.min));
+    __m256 maxValues = _mm256_set1_ps(static_cast<float>(sums.max));
+    __m256d sum = _mm256_setzero_pd();
+    __m256d sumSquares = _mm256_setzero_pd();
+    __m256i lowCount = _mm256_setzero_si256();
+    __m256i highCount = _mm256_setzero_si256();
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 v = _mm256_loadu_ps(src + x);
+        // The second operand is kept for NaN, so NaN is skipped.
+        minValues = _mm256_min_ps(v, minValues);
+        maxValues = _mm256_max_ps(v, maxValues);
+
+        __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        sum = _mm256_add_pd(sum, _mm256_add_pd(lo, hi));
+        sumSquares = _mm256_add_pd(sumSquares, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+
+        // Masks are -1 where true.
+        lowCount = _mm256_sub_epi32(lowCount, _mm256_castps_si256(_mm256_cmp_ps(v, low, _CMP_LE_OQ)));
+        highCount = _mm256_sub_epi32(highCount, _mm256_castps_si256(_mm256_cmp_ps(v, high, _CMP_GE_OQ)));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(32) float minLanes[8];
+    alignas(32) float maxLanes[8];
+    alignas(32) double sumLanes[4];
+    alignas(32) double sumSquaresLanes[4];
+    alignas(32) uint32_t lowLanes[8];
+    alignas(32) uint32_t highLanes[8];
+    _mm256_store_ps(minLanes, minValues);
+    _mm256_store_ps(maxLanes, maxValues);
+    _mm256_store_pd(sumLanes, sum);
+    _mm256_store_pd(sumSquaresLanes, sumSquares);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lowLanes), lowCount);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(highLanes), highCount);
+    for (int i = 0; i < 8; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+        sums.low += lowLanes[i];
+        sums.high += highLanes[i];
+    }
+    sums.floatSum += sumLanes[0] + sumLanes[1] + sumLanes[2] + sumLanes[3];
+    sums.floatSumSquares += sumSquaresLanes[0] + sumSquaresLanes[1] + sumSquaresLanes[2] + sumSquaresLanes[3];
+    return x;
+}
+
+template <typename T>
+void regionStatsRowAVX2(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const T *samples = static_cast<const T *>(src);
+
+    unsigned x = statsVectors(samples, width, limits, sums);
+
+    if (x < width)
+        regionStatsRowC<T>(samples + x, width - x, limits, sums);
+}
+
+template void regionStatsRowAVX2<uint8_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowAVX2<uint16_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowAVX2<float>(const void *, unsigned, const RegionLimits &, RegionSums &);
+
+#endif // REGION_STATS_X86
@@ -0,0 +1,44 @@
+#ifndef VS_REGION_STATS_KERNEL_H_INCLUDED
+#define VS_REGION_STATS_KERNEL_H_INCLUDED
+
+#include <cstdint>
+
+struct RegionSums
+{
+    // Integer samples are summed exactly, float samples in double.
+    uint64_t intSum;
+    uint64_t intSumSquares;
+    double floatSum;
+    double floatSumSquares;
+    double min;
+    double max;
+    // Samples at or below the low limit and at or above the high limit.
+    uint64_t low;
+    uint64_t high;
+};
+
+// Integer kernels expect limits within the range of the sample type.
+struct RegionLimits
+{
+    double low;
+    double high;
+};
+
+// Adds the samples of the row to sums.
+typedef void (*region_stats_row_func)(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums);
+
+// Defined in vs_region_stats.cpp. The SIMD rows use it for the remainder.
+template <typename T>
+void regionStatsRowC(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums);
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define REGION_STATS_X86
+
+template <typename T>
+void regionStatsRowSSE41(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums);
+
+template <typename T>
+void regionStatsRowAVX2(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums);
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+#include "vs_region_stats_kernel.h"
+
+#ifdef REGION_STATS_X86
+
+#include <smmintrin.h>
+
+// Not std::min and std::max: an inline function from a standard header
+// built with the SIMD flags may be the copy the linker keeps for the
+// baseline code too.
+static inline double minOf(double a, double b)
+{
+    return (b < a) ? b : a;
+}
+
+static inline double maxOf(double a, double b)
+{
+    return (a < b) ? b : a;
+}
+
+static uint64_t sumLanes64(__m128i v)
+{
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), v);
+    return lanes[0] + lanes[1];
+}
+
+static unsigned statsVectors(const uint8_t *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i low = _mm_set1_epi8(static_cast<char>(static_cast<uint8_t>(limits.low)));
+    const __m128i high = _mm_set1_epi8(static_cast<char>(static_cast<uint8_t>(limits.high)));
+
+    __m128i minValues = _mm_set1_epi8(static_cast<char>(0xFF));
+    __m128i maxValues = zero;
+    __m128i sum = zero;
+    __m128i sumSquares = zero;
+    __m128i lowCount = zero;
+    __m128i highCount = zero;
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        minValues = _mm_min_epu8(minValues, v);
+        maxValues = _mm_max_epu8(maxValues, v);
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(v, zero));
+
+        __m128i lo = _mm_cvtepu8_epi16(v);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i squares = _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi));
+        sumSquares = _mm_add_epi64(sumSquares, _mm_cvtepu32_epi64(squares));
+        sumSquares = _mm_add_epi64(sumSquares, _mm_cvtepu32_epi64(_mm_srli_si128(squares, 8)));
+
+        __m128i isLow = _mm_cmpeq_epi8(_mm_min_epu8(v, low), v);
+        __m128i isHigh = _mm_cmpeq_epi8(_mm_max_epu8(v, high), v);
+        lowCount = _mm_add_epi64(lowCount, _mm_sad_epu8(_mm_and_si128(isLow, ones), zero));
+        highCount = _mm_add_epi64(highCount, _mm_sad_epu8(_mm_and_si128(isHigh, ones), zero));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(16) uint8_t minLanes[16];
+    alignas(16) uint8_t maxLanes[16];
+    _mm_store_si128(reinterpret_cast<__m128i *>(minLanes), minValues);
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxLanes), maxValues);
+    for (int i = 0; i < 16; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+    }
+    sums.intSum += sumLanes64(sum);
+    sums.intSumSquares += sumLanes64(sumSquares);
+    sums.low += sumLanes64(lowCount);
+    sums.high += sumLanes64(highCount);
+    return x;
+}
+
+static unsigned statsVectors(const uint16_t *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    const __m128i low = _mm_set1_epi16(static_cast<short>(static_cast<uint16_t>(limits.low)));
+    const __m128i high = _mm_set1_epi16(static_cast<short>(static_cast<uint16_t>(limits.high)));
+
+    __m128i minValues = _mm_set1_epi16(static_cast<short>(0xFFFF));
+    __m128i maxValues = zero;
+    __m128i sum = zero;
+    __m128i sumSquares = zero;
+    __m128i lowCount = zero;
+    __m128i highCount = zero;
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        minValues = _mm_min_epu16(minValues, v);
+        maxValues = _mm_max_epu16(maxValues, v);
+
+        // Low and high bytes are summed apart, so the sums can not overflow.
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_and_si128(v, lowBytes), zero));
+        sum = _mm_add_epi64(sum, _mm_slli_epi64(_mm_sad_epu8(_mm_srli_epi16(v, 8), zero), 8));
+
+        __m128i lo = _mm_cvtepu16_epi32(v);
+        __m128i hi = _mm_unpackhi_epi16(v, zero);
+        sumSquares = _mm_add_epi64(sumSquares, _mm_mul_epu32(lo, lo));
+        sumSquares = _mm_add_epi64(sumSquares, _mm_mul_epu32(_mm_srli_epi64(lo, 32), _mm_srli_epi64(lo, 32)));
+        sumSquares = _mm_add_epi64(sumSquares, _mm_mul_epu32(hi, hi));
+        sumSquares = _mm_add_epi64(sumSquares, _mm_mul_epu32(_mm_srli_epi64(hi, 32), _mm_srli_epi64(hi, 32)));
+
+        __m128i isLow = _mm_cmpeq_epi16(_mm_min_epu16(v, low), v);
+        __m128i isHigh = _mm_cmpeq_epi16(_mm_max_epu16(v, high), v);
+        lowCount = _mm_add_epi64(lowCount, _mm_sad_epu8(_mm_srli_epi16(isLow, 15), zero));
+        highCount = _mm_add_epi64(highCount, _mm_sad_epu8(_mm_srli_epi16(isHigh, 15), zero));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(16) uint16_t minLanes[8];
+    alignas(16) uint16_t maxLanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i *>(minLanes), minValues);
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxLanes), maxValues);
+    for (int i = 0; i < 8; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+    }
+    sums.intSum += sumLanes64(sum);
+    sums.intSumSquares += sumLanes64(sumSquares);
+    sums.low += sumLanes64(lowCount);
+    sums.high += sumLanes64(highCount);
+    return x;
+}
+
+static unsigned statsVectors(const float *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const __m128 low = _mm_set1_ps(static_cast<float>(limits.low));
+    const __m128 high = _mm_set1_ps(static_cast<float>(limits.high));
+
+    __m128 minValues = _mm_set1_ps(static_cast<float>(sums.min));
+    __m128 maxValues = _mm_set1_ps(static_cast<float>(sums.max));
+    __m128d sum = _mm_setzero_pd();
+    __m128d sumSquares = _mm_setzero_pd();
+    __m128i lowCount = _mm_setzero_si128();
+    __m128i highCount = _mm_setzero_si128();
+
+    unsigned x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 v = _mm_loadu_ps(src + x);
+        // The second operand is kept for NaN, so NaN is skipped.
+        minValues = _mm_min_ps(v, minValues);
+        maxValues = _mm_max_ps(v, maxValues);
+
+        __m128d lo = _mm_cvtps_pd(v);
+        __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        sum = _mm_add_pd(sum, _mm_add_pd(lo, hi));
+        sumSquares = _mm_add_pd(sumSquares, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+
+        // Masks are -1 where true.
+        lowCount = _mm_sub_epi32(lowCount, _mm_castps_si128(_mm_cmple_ps(v, low)));
+        highCount = _mm_sub_epi32(highCount, _mm_castps_si128(_mm_cmpge_ps(v, high)));
+    }
+    if (x == 0)
+        return 0;
+
+    alignas(16) float minLanes[4];
+    alignas(16) float maxLanes[4];
+    alignas(16) double sumLanes[2];
+    alignas(16) double sumSquaresLanes[2];
+    alignas(16) uint32_t lowLanes[4];
+    alignas(16) uint32_t highLanes[4];
+    _mm_store_ps(minLanes, minValues);
+    _mm_store_ps(maxLanes, maxValues);
+    _mm_store_pd(sumLanes, sum);
+    _mm_store_pd(sumSquaresLanes, sumSquares);
+    _mm_store_si128(reinterpret_cast<__m128i *>(lowLanes), lowCount);
+    _mm_store_si128(reinterpret_cast<__m128i *>(highLanes), highCount);
+    for (int i = 0; i < 4; ++i)
+    {
+        sums.min = minOf(sums.min, static_cast<double>(minLanes[i]));
+        sums.max = maxOf(sums.max, static_cast<double>(maxLanes[i]));
+        sums.low += lowLanes[i];
+        sums.high += highLanes[i];
+    }
+    sums.floatSum += sumLanes[0] + sumLanes[1];
+    sums.floatSumSquares += sumSquaresLanes[0] + sumSquaresLanes[1];
+    return x;
+}
+
+template <typename T>
+void regionStatsRowSSE41(const void *src, unsigned width, const RegionLimits &limits, RegionSums &sums)
+{
+    const T *samples = static_cast<const T *>(src);
+
+    unsigned x = statsVectors(samples, width, limits, sums);
+
+    if (x < width)
+        regionStatsRowC<T>(samples + x, width - x, limits, sums);
+}
+
+template void regionStatsRowSSE41<uint8_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowSSE41<uint16_t>(const void *, unsigned, const RegionLimits &, RegionSums &);
+template void regionStatsRowSSE41<float>(const void *, unsigned, const RegionLimits &, RegionSums &);
+
+#endif // REGION_STATS_X86
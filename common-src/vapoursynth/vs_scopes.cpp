@@ -0,0 +1,203 @@
+#include "vs_scopes.h"
+#include "vs_scopes_kernel.h"
+#include "vs_simd.h"
+#include "../helpers.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Samples are binned into this many columns at most.
+static const int SCOPE_MAX_WAVEFORM_WIDTH = 512;
+
+template <typename T>
+void scopeBinsRowC(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const T *samples = static_cast<const T *>(src);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        if (b.shift >= 0 && sizeof(T) < 4)
+        {
+            unsigned bin = static_cast<unsigned>(samples[x]) >> b.shift;
+            bins[x] = static_cast<uint16_t>(std::min(bin, static_cast<unsigned>(b.maxBin)));
+        }
+        else
+        {
+            float value = (static_cast<float>(samples[x]) + b.offset) * b.scale;
+            // NaN lands in the first bin.
+            value = (value > 0.0f) ? std::min(value, static_cast<float>(b.maxBin)) : 0.0f;
+            bins[x] = static_cast<uint16_t>(std::lrint(value));
+        }
+    }
+}
+
+template void scopeBinsRowC<uint8_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowC<uint16_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowC<float>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+
+static void scopeBinsRowHalf(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const uint16_t *samples = static_cast<const uint16_t *>(src);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        vsedit::FP16 half;
+        half.u = samples[x];
+        float single = vsedit::halfToSingle(half).f;
+        scopeBinsRowC<float>(&single, bins + x, 1, b);
+    }
+}
+
+template <typename T>
+scope_bins_row_func selectBinsRowFunc()
+{
+#ifdef SCOPES_X86
+    SimdLevel level = simdLevel();
+    if (level == SimdLevel::AVX2)
+        return scopeBinsRowAVX2<T>;
+    if (level == SimdLevel::SSE41)
+        return scopeBinsRowSSE41<T>;
+#endif
+    return scopeBinsRowC<T>;
+}
+
+static scope_bins_row_func binsRowFunc(const VSVideoFormat *format)
+{
+    if (format->sampleType == stInteger)
+    {
+        if (format->bytesPerSample == 1)
+            return selectBinsRowFunc<uint8_t>();
+        if (format->bytesPerSample == 2)
+            return selectBinsRowFunc<uint16_t>();
+    }
+    else if (format->sampleType == stFloat)
+    {
+        if (format->bytesPerSample == 2)
+            return scopeBinsRowHalf;
+        if (format->bytesPerSample == 4)
+            return selectBinsRowFunc<float>();
+    }
+    return nullptr;
+}
+
+// Four interleaved tables, so runs of equal samples do not wait on
+// the same counter.
+static void countBins(const uint16_t *bins, unsigned width, uint32_t *counts)
+{
+    for (unsigned x = 0; x < width; ++x)
+        counts[(static_cast<size_t>(bins[x]) << 2) | (x & 3)]++;
+}
+
+static void foldCounts(const std::vector<uint32_t> &counts, std::vector<uint32_t> &histogram)
+{
+    for (size_t i = 0; i < histogram.size(); ++i)
+        histogram[i] = counts[4 * i] + counts[4 * i + 1] + counts[4 * i + 2] + counts[4 * i + 3];
+}
+
+static void countWaveform(const uint16_t *bins, unsigned width, int levelShift, const std::vector<int> &columns, int waveformWidth, uint32_t *waveform)
+{
+    for (unsigned x = 0; x < width; ++x)
+    {
+        int level = SCOPE_LEVELS - 1 - (bins[x] >> levelShift);
+        waveform[static_cast<size_t>(level) * waveformWidth + columns[x]]++;
+    }
+}
+
+Scopes::Scopes()
+    : colorFamily(cfUndefined)
+    , planes(0)
+    , bins(0)
+    , waveformWidth(0)
+{
+}
+
+bool Scopes::isEmpty() const
+{
+    return planes == 0;
+}
+
+Scopes computeScopes(const VSFrame *frame, const VSAPI *vsapi)
+{
+    Scopes scopes;
+    const VSVideoFormat *format = vsapi->getVideoFrameFormat(frame);
+    if (!format)
+        return scopes;
+    scope_bins_row_func rowFunc = binsRowFunc(format);
+    if (!rowFunc)
+        return scopes;
+
+    bool integer = (format->sampleType == stInteger);
+    int binBits = integer ? std::min(format->bitsPerSample, 10) : 10;
+    int levelShift = binBits - 8;
+    bool yuv = (format->colorFamily == cfYUV && format->numPlanes == 3);
+    bool rgb = (format->colorFamily == cfRGB);
+
+    scopes.colorFamily = format->colorFamily;
+    scopes.planes = format->numPlanes;
+    scopes.bins = 1 << binBits;
+
+    int width = vsapi->getFrameWidth(frame, 0);
+    scopes.waveformWidth = std::min(width, SCOPE_MAX_WAVEFORM_WIDTH);
+    std::vector<int> columns(width);
+    for (int x = 0; x < width; ++x)
+        columns[x] = static_cast<int>(static_cast<int64_t>(x) * scopes.waveformWidth / width);
+
+    ScopeBinning binnings[3];
+    std::vector<uint32_t> counts[3];
+    for (int plane = 0; plane < scopes.planes; ++plane)
+    {
+        ScopeBinning &b = binnings[plane];
+        b.shift = integer ? format->bitsPerSample - binBits : -1;
+        b.offset = (yuv && plane > 0) ? 0.5f : 0.0f;
+        b.scale = static_cast<float>(scopes.bins - 1);
+        b.maxBin = static_cast<uint16_t>(scopes.bins - 1);
+        counts[plane].assign(4 * static_cast<size_t>(scopes.bins), 0);
+        scopes.histograms[plane].assign(scopes.bins, 0);
+        if (plane == 0 || rgb)
+            scopes.waveforms[plane].assign(static_cast<size_t>(SCOPE_LEVELS) * scopes.waveformWidth, 0);
+    }
+    if (yuv)
+        scopes.vectorscope.assign(static_cast<size_t>(SCOPE_LEVELS) * SCOPE_LEVELS, 0);
+
+    std::vector<uint16_t> buffer(2 * static_cast<size_t>(width));
+    uint16_t *binsA = buffer.data();
+    uint16_t *binsB = binsA + width;
+
+    for (int plane = 0; plane < scopes.planes; ++plane)
+    {
+        // The chroma planes of YUV are read together for the vectorscope.
+        if (yuv && plane == 2)
+            break;
+
+        int planeWidth = vsapi->getFrameWidth(frame, plane);
+        int planeHeight = vsapi->getFrameHeight(frame, plane);
+        const uint8_t *src = vsapi->getReadPtr(frame, plane);
+        ptrdiff_t stride = vsapi->getStride(frame, plane);
+        const uint8_t *srcV = yuv ? vsapi->getReadPtr(frame, 2) : nullptr;
+        ptrdiff_t strideV = yuv ? vsapi->getStride(frame, 2) : 0;
+        bool waveform = !scopes.waveforms[plane].empty();
+
+        for (int y = 0; y < planeHeight; ++y)
+        {
+            rowFunc(src + y * stride, binsA, planeWidth, binnings[plane]);
+            countBins(binsA, planeWidth, counts[plane].data());
+            if (waveform)
+                countWaveform(binsA, planeWidth, levelShift, columns, scopes.waveformWidth, scopes.waveforms[plane].data());
+
+            if (yuv && plane == 1)
+            {
+                rowFunc(srcV + y * strideV, binsB, planeWidth, binnings[2]);
+                countBins(binsB, planeWidth, counts[2].data());
+                for (int x = 0; x < planeWidth; ++x)
+                {
+                    int u = binsA[x] >> levelShift;
+                    int v = SCOPE_LEVELS - 1 - (binsB[x] >> levelShift);
+                    scopes.vectorscope[static_cast<size_t>(v) * SCOPE_LEVELS + u]++;
+                }
+            }
+        }
+    }
+
+    for (int plane = 0; plane < scopes.planes; ++plane)
+        foldCounts(counts[plane], scopes.histograms[plane]);
+
+    return scopes;
+}
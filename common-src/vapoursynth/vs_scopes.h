@@ -0,0 +1,39 @@
+#ifndef VS_SCOPES_H_INCLUDED
+#define VS_SCOPES_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <cstdint>
+#include <vector>
+
+// Levels of the waveform and of both vectorscope axes.
+const int SCOPE_LEVELS = 256;
+
+struct Scopes
+{
+    int colorFamily;
+    int planes;
+    // Up to 1024 bins per plane, one per sample value of clips up to 10
+    // bits. Float samples are binned over 0 to 1, or -0.5 to 0.5 for YUV
+    // chroma.
+    int bins;
+    std::vector<uint32_t> histograms[3];
+    // SCOPE_LEVELS rows of waveformWidth columns, the highest level on top.
+    // Only the first plane has one unless the clip is RGB.
+    int waveformWidth;
+    std::vector<uint32_t> waveforms[3];
+    // SCOPE_LEVELS rows of SCOPE_LEVELS columns, U to the right and V
+    // upwards. Empty unless the clip is YUV.
+    std::vector<uint32_t> vectorscope;
+
+    Scopes();
+
+    bool isEmpty() const;
+};
+
+// Reads the samples of the frame at their own bit depth. Integer formats
+// of up to 16 bits and half and single float are supported, others give
+// empty scopes.
+Scopes computeScopes(const VSFrame *frame, const VSAPI *vsapi);
+
+#endif
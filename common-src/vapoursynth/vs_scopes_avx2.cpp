@@ -0,0 +1,79 @@
+#include "vs_scopes_kernel.h"
+
+#ifdef SCOPES_X86
+
+#include <immintrin.h>
+
+static unsigned binVectors(const uint8_t *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m128i shift = _mm_cvtsi32_si128(b.shift);
+    const __m256i maxBin = _mm256_set1_epi16(static_cast<short>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i samples = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x)));
+        __m256i shifted = _mm256_srl_epi16(samples, shift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bins + x), _mm256_min_epu16(shifted, maxBin));
+    }
+    return x;
+}
+
+static unsigned binVectors(const uint16_t *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m128i shift = _mm_cvtsi32_si128(b.shift);
+    const __m256i maxBin = _mm256_set1_epi16(static_cast<short>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x));
+        __m256i shifted = _mm256_srl_epi16(samples, shift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bins + x), _mm256_min_epu16(shifted, maxBin));
+    }
+    return x;
+}
+
+static inline __m256i binFloats(__m256 samples, __m256 offset, __m256 scale, __m256 maxBin)
+{
+    __m256 value = _mm256_mul_ps(_mm256_add_ps(samples, offset), scale);
+    // NaN lands in the first bin.
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), maxBin);
+    return _mm256_cvtps_epi32(value);
+}
+
+static unsigned binVectors(const float *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m256 offset = _mm256_set1_ps(b.offset);
+    const __m256 scale = _mm256_set1_ps(b.scale);
+    const __m256 maxBin = _mm256_set1_ps(static_cast<float>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i lo = binFloats(_mm256_loadu_ps(src + x), offset, scale, maxBin);
+        __m256i hi = binFloats(_mm256_loadu_ps(src + x + 8), offset, scale, maxBin);
+        // Packing works within the 128 bit lanes, so the quarters are
+        // put back in order afterwards.
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bins + x), packed);
+    }
+    return x;
+}
+
+template <typename T>
+void scopeBinsRowAVX2(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const T *samples = static_cast<const T *>(src);
+
+    unsigned x = binVectors(samples, bins, width, b);
+
+    if (x < width)
+        scopeBinsRowC<T>(samples + x, bins + x, width - x, b);
+}
+
+template void scopeBinsRowAVX2<uint8_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowAVX2<uint16_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowAVX2<float>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+
+#endif // SCOPES_X86
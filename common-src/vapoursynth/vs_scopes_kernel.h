@@ -0,0 +1,32 @@
+#ifndef VS_SCOPES_KERNEL_H_INCLUDED
+#define VS_SCOPES_KERNEL_H_INCLUDED
+
+#include <cstdint>
+
+struct ScopeBinning
+{
+    // Integer samples are shifted right. Float samples are offset, scaled
+    // and rounded. Either way the bins are clamped to maxBin.
+    int shift;
+    float offset;
+    float scale;
+    uint16_t maxBin;
+};
+
+typedef void (*scope_bins_row_func)(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b);
+
+// Defined in vs_scopes.cpp. The SIMD rows use it for the remainder.
+template <typename T>
+void scopeBinsRowC(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b);
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SCOPES_X86
+
+template <typename T>
+void scopeBinsRowSSE41(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b);
+
+template <typename T>
+void scopeBinsRowAVX2(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b);
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+#include "vs_scopes_kernel.h"
+
+#ifdef SCOPES_X86
+
+#include <smmintrin.h>
+
+static unsigned binVectors(const uint8_t *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i shift = _mm_cvtsi32_si128(b.shift);
+    const __m128i maxBin = _mm_set1_epi16(static_cast<short>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        __m128i lo = _mm_srl_epi16(_mm_cvtepu8_epi16(samples), shift);
+        __m128i hi = _mm_srl_epi16(_mm_unpackhi_epi8(samples, zero), shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bins + x), _mm_min_epu16(lo, maxBin));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bins + x + 8), _mm_min_epu16(hi, maxBin));
+    }
+    return x;
+}
+
+static unsigned binVectors(const uint16_t *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m128i shift = _mm_cvtsi32_si128(b.shift);
+    const __m128i maxBin = _mm_set1_epi16(static_cast<short>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        __m128i shifted = _mm_srl_epi16(samples, shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bins + x), _mm_min_epu16(shifted, maxBin));
+    }
+    return x;
+}
+
+static inline __m128i binFloats(__m128 samples, __m128 offset, __m128 scale, __m128 maxBin)
+{
+    __m128 value = _mm_mul_ps(_mm_add_ps(samples, offset), scale);
+    // NaN lands in the first bin.
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), maxBin);
+    return _mm_cvtps_epi32(value);
+}
+
+static unsigned binVectors(const float *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const __m128 offset = _mm_set1_ps(b.offset);
+    const __m128 scale = _mm_set1_ps(b.scale);
+    const __m128 maxBin = _mm_set1_ps(static_cast<float>(b.maxBin));
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i lo = binFloats(_mm_loadu_ps(src + x), offset, scale, maxBin);
+        __m128i hi = binFloats(_mm_loadu_ps(src + x + 4), offset, scale, maxBin);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bins + x), _mm_packus_epi32(lo, hi));
+    }
+    return x;
+}
+
+template <typename T>
+void scopeBinsRowSSE41(const void *src, uint16_t *bins, unsigned width, const ScopeBinning &b)
+{
+    const T *samples = static_cast<const T *>(src);
+
+    unsigned x = binVectors(samples, bins, width, b);
+
+    if (x < width)
+        scopeBinsRowC<T>(samples + x, bins + x, width - x, b);
+}
+
+template void scopeBinsRowSSE41<uint8_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowSSE41<uint16_t>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+template void scopeBinsRowSSE41<float>(const void *, uint16_t *, unsigned, const ScopeBinning &);
+
+#endif // SCOPES_X86
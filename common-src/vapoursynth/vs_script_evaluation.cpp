@@ -0,0 +1,138 @@
+#include "vs_script_evaluation.h"
+
+#include "vs_script_library.h"
+
+#include <thread>
+
+//==============================================================================
+
+ScriptEvaluation::ScriptEvaluation(VSScriptLibrary * a_pVSScriptLibrary,
+	const QString & a_script, const QString & a_scriptName,
+	ProcessReason a_reason):
+	  QObject(nullptr)
+	, m_pVSScriptLibrary(a_pVSScriptLibrary)
+	, m_script(a_script)
+	, m_scriptName(a_scriptName)
+	, m_reason(a_reason)
+	, m_resources()
+	, m_pScript(nullptr)
+	, m_origin(ScriptOrigin::Evaluated)
+	, m_error()
+	, m_cancelled(false)
+{
+	Q_ASSERT(m_pVSScriptLibrary);
+}
+
+// END OF ScriptEvaluation::ScriptEvaluation(
+//		VSScriptLibrary * a_pVSScriptLibrary, const QString & a_script,
+//		const QString & a_scriptName, ProcessReason a_reason)
+//==============================================================================
+
+ScriptEvaluation::~ScriptEvaluation()
+{
+}
+
+// END OF ScriptEvaluation::~ScriptEvaluation()
+//==============================================================================
+
+void ScriptEvaluation::start()
+{
+	m_pScript = m_pVSScriptLibrary->acquireCachedScript(m_script,
+		m_scriptName, m_reason);
+	if(m_pScript)
+	{
+		m_origin = ScriptOrigin::Cached;
+		QMetaObject::invokeMethod(this, "slotEvaluated",
+			Qt::QueuedConnection);
+		return;
+	}
+
+	if(!m_pVSScriptLibrary->initialize())
+	{
+		m_error = tr("VapourSynth library is not initialized.");
+		QMetaObject::invokeMethod(this, "slotEvaluated",
+			Qt::QueuedConnection);
+		return;
+	}
+
+	// Picked here as the library is not thread-safe.
+	m_resources = m_pVSScriptLibrary->evaluationCoreResources(m_reason);
+	std::thread(&ScriptEvaluation::run, this).detach();
+}
+
+// END OF void ScriptEvaluation::start()
+//==============================================================================
+
+void ScriptEvaluation::cancel()
+{
+	m_cancelled = true;
+}
+
+// END OF void ScriptEvaluation::cancel()
+//==============================================================================
+
+const QString & ScriptEvaluation::script() const
+{
+	return m_script;
+}
+
+// END OF const QString & ScriptEvaluation::script() const
+//==============================================================================
+
+const QString & ScriptEvaluation::scriptName() const
+{
+	return m_scriptName;
+}
+
+// END OF const QString & ScriptEvaluation::scriptName() const
+//==============================================================================
+
+void ScriptEvaluation::slotProgress(const QString & a_message)
+{
+	if(!m_cancelled)
+		emit signalProgress(a_message);
+}
+
+// END OF void ScriptEvaluation::slotProgress(const QString & a_message)
+//==============================================================================
+
+void ScriptEvaluation::slotEvaluated()
+{
+	if(m_cancelled)
+	{
+		if(m_pScript && (m_origin == ScriptOrigin::Cached))
+			m_pVSScriptLibrary->releaseScript(m_pScript);
+		else if(m_pScript)
+			m_pVSScriptLibrary->freeScript(m_pScript);
+		deleteLater();
+		return;
+	}
+
+	if(m_pScript && (m_origin != ScriptOrigin::Cached))
+	{
+		m_pScript = m_pVSScriptLibrary->cacheScript(m_pScript, m_script,
+			m_scriptName, m_reason);
+	}
+
+	emit signalFinished(m_pScript, m_origin, m_error);
+	deleteLater();
+}
+
+// END OF void ScriptEvaluation::slotEvaluated()
+//==============================================================================
+
+void ScriptEvaluation::run()
+{
+	m_pScript = m_pVSScriptLibrary->evaluateScriptOnNewCore(m_script,
+		m_scriptName, m_resources, &m_error, &m_origin,
+		[this](const QString & a_message)
+		{
+			QMetaObject::invokeMethod(this, "slotProgress",
+				Qt::QueuedConnection, Q_ARG(QString, a_message));
+		});
+
+	QMetaObject::invokeMethod(this, "slotEvaluated", Qt::QueuedConnection);
+}
+
+// END OF void ScriptEvaluation::run()
+//==============================================================================
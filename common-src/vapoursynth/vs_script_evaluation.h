@@ -0,0 +1,78 @@
+#ifndef VS_SCRIPT_EVALUATION_H_INCLUDED
+#define VS_SCRIPT_EVALUATION_H_INCLUDED
+
+#include "../helpers_vs.h"
+#include "vs_script_processor_structures.h"
+#include "vs_core_resources.h"
+
+#include <vapoursynth/VSScript4.h>
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+
+class VSScriptLibrary;
+
+//==============================================================================
+
+// Evaluates a script on a worker thread and puts the result into the
+// library's script cache. A cached evaluation is handed out without
+// starting a thread. The object deletes itself when it is done.
+class ScriptEvaluation : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	ScriptEvaluation(VSScriptLibrary * a_pVSScriptLibrary,
+		const QString & a_script, const QString & a_scriptName,
+		ProcessReason a_reason);
+
+	virtual ~ScriptEvaluation();
+
+	void start();
+
+	// The evaluation itself can not be interrupted. When it completes
+	// its result is freed and signalFinished() is not emitted.
+	void cancel();
+
+	const QString & script() const;
+
+	const QString & scriptName() const;
+
+signals:
+
+	void signalProgress(const QString & a_message);
+
+	// The script is acquired on behalf of the receiver, who must release
+	// it. It is nullptr if the evaluation failed.
+	void signalFinished(VSScript * a_pScript, ScriptOrigin a_origin,
+		const QString & a_error);
+
+private slots:
+
+	void slotProgress(const QString & a_message);
+
+	void slotEvaluated();
+
+private:
+
+	void run();
+
+	VSScriptLibrary * m_pVSScriptLibrary;
+
+	QString m_script;
+	QString m_scriptName;
+	ProcessReason m_reason;
+	CoreResources m_resources;
+
+	VSScript * m_pScript;
+	ScriptOrigin m_origin;
+	QString m_error;
+
+	std::atomic<bool> m_cancelled;
+};
+
+//==============================================================================
+
+#endif // VS_SCRIPT_EVALUATION_H_INCLUDED
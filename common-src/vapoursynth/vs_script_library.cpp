@@ -2,9 +2,30 @@
 
 #include "../settings/settings_manager_core.h"
 #include "../helpers.h"
+#include "../chrono.h"
 
 #include <QSettings>
 #include <QProcessEnvironment>
+#include <QFileSystemWatcher>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QRegularExpression>
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+#include <utility>
+
+//==============================================================================
+
+// Evaluated scripts kept alive when nobody uses them.
+const size_t SCRIPT_CACHE_MAX_IDLE_ENTRIES = 2;
+
+// Modules followed from a script at most, so a large package imported
+// from the PYTHONPATH does not slow down every evaluation.
+const int SCRIPT_MAX_TRACKED_MODULES = 256;
 
 //==============================================================================
 
@@ -20,6 +41,157 @@ void VS_CC vsMessageHandler(int a_msgType, const char * a_message,
 //		void * a_pUserData)
 //==============================================================================
 
+QStringList importedModules(const QString & a_code)
+{
+	QRegularExpression importExpression(
+		"^[ \\t]*(?:from[ \\t]+([\\w.]+)[ \\t]+import|import[ \\t]+([^#\\n]+))",
+		QRegularExpression::MultilineOption);
+
+	QStringList modules;
+	QRegularExpressionMatchIterator it = importExpression.globalMatch(a_code);
+	while(it.hasNext())
+	{
+		QRegularExpressionMatch match = it.next();
+		if(match.capturedLength(1) > 0)
+		{
+			modules << match.captured(1);
+			continue;
+		}
+
+		for(const QString & item : match.captured(2).split(','))
+		{
+			QString module = item.trimmed().section(' ', 0, 0);
+			if(!module.isEmpty())
+				modules << module;
+		}
+	}
+
+	for(QString & module : modules)
+	{
+		while(module.startsWith('.'))
+			module.remove(0, 1);
+	}
+	modules.removeAll(QString());
+	modules.removeDuplicates();
+	return modules;
+}
+
+// END OF QStringList importedModules(const QString & a_code)
+//==============================================================================
+
+QStringList scriptModules(const QString & a_script,
+	const QString & a_scriptName)
+{
+	QStringList files;
+	if(a_scriptName.isEmpty())
+		return files;
+
+	QFileInfo scriptFileInfo(a_scriptName);
+	if(scriptFileInfo.exists())
+		files << scriptFileInfo.absoluteFilePath();
+
+	// Modules are looked up next to the script and in the PYTHONPATH.
+	// Installed packages are not expected to change while the editor
+	// is running.
+	QStringList searchPaths;
+	searchPaths << scriptFileInfo.absolutePath();
+	searchPaths << QProcessEnvironment::systemEnvironment()
+		.value("PYTHONPATH").split(QDir::listSeparator(),
+		Qt::SkipEmptyParts);
+
+	// The modules found are scanned for their own imports in turn.
+	std::deque<std::pair<QString, QString> > sources;
+	sources.push_back(std::make_pair(a_script,
+		scriptFileInfo.absolutePath()));
+	while((!sources.empty()) && (files.size() < SCRIPT_MAX_TRACKED_MODULES))
+	{
+		QString code = sources.front().first;
+		QStringList directories = searchPaths;
+		directories.prepend(sources.front().second);
+		directories.removeDuplicates();
+		sources.pop_front();
+
+		for(const QString & module : importedModules(code))
+		{
+			for(const QString & directory : directories)
+			{
+				QDir searchDir(directory);
+				QString modulePath;
+				for(const QString & part : module.split('.'))
+				{
+					modulePath += (modulePath.isEmpty() ? "" : "/") + part;
+					QString candidates[] = {modulePath + ".py",
+						modulePath + "/__init__.py"};
+					for(const QString & candidate : candidates)
+					{
+						QFileInfo fileInfo(searchDir.filePath(candidate));
+						QString filePath = fileInfo.absoluteFilePath();
+						if((!fileInfo.isFile()) || files.contains(filePath))
+							continue;
+						files << filePath;
+
+						QFile moduleFile(filePath);
+						if(moduleFile.open(QIODevice::ReadOnly))
+						{
+							sources.push_back(std::make_pair(
+								QString::fromUtf8(moduleFile.readAll()),
+								fileInfo.absolutePath()));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return files;
+}
+
+// END OF QStringList scriptModules(const QString & a_script,
+//		const QString & a_scriptName)
+//==============================================================================
+
+QStringList scriptSourceFiles(const QString & a_script,
+	const QString & a_scriptName)
+{
+	// Any string of the script that names an existing file is taken
+	// for a source, like the clips the script opens.
+	QRegularExpression stringExpression(
+		"([rR]?)([\"'])([^\"'\\n]+)\\2");
+	QDir scriptDir = a_scriptName.isEmpty() ? QDir::current() :
+		QFileInfo(a_scriptName).absoluteDir();
+
+	QStringList files;
+	QRegularExpressionMatchIterator it = stringExpression.globalMatch(a_script);
+	while(it.hasNext())
+	{
+		QRegularExpressionMatch match = it.next();
+		QString path = match.captured(3);
+		if(match.capturedLength(1) == 0)
+			path.replace("\\\\", "\\");
+		QFileInfo fileInfo(scriptDir.filePath(path));
+		if(fileInfo.isFile())
+			files << fileInfo.absoluteFilePath();
+	}
+
+	files.removeDuplicates();
+	return files;
+}
+
+// END OF QStringList scriptSourceFiles(const QString & a_script,
+//		const QString & a_scriptName)
+//==============================================================================
+
+ScriptCacheEntry::ScriptCacheEntry():
+	  key()
+	, pScript(nullptr)
+	, users(0)
+	, valid(true)
+	, files()
+{
+}
+
+//==============================================================================
+
 VSScriptLibrary::VSScriptLibrary(SettingsManagerCore * a_pSettingsManager,
 	QObject * a_pParent):
 	QObject(a_pParent)
@@ -32,8 +204,18 @@ VSScriptLibrary::VSScriptLibrary(SettingsManagerCore * a_pSettingsManager,
 	, m_VSAPIMinor(VSE_VS_API_VER_MINOR)
 	, m_VSSAPIMajor(VSE_VSS_API_VER_MAJOR)
 	, m_VSSAPIMinor(VSE_VSS_API_VER_MINOR)
+	, m_scriptCache()
+	, m_pScriptCacheWatcher(nullptr)
+	, m_corePool()
+	, m_warmCorePoolEnabled(false)
+	, m_coreUsers()
+	, m_evaluationsRunning(0)
 {
 	Q_ASSERT(m_pSettingsManager);
+
+	m_pScriptCacheWatcher = new QFileSystemWatcher(this);
+	connect(m_pScriptCacheWatcher, SIGNAL(fileChanged(const QString &)),
+		this, SLOT(slotScriptFileChanged(const QString &)));
 }
 
 // END OF VSScriptLibrary::VSScriptLibrary(
@@ -76,6 +258,8 @@ bool VSScriptLibrary::initialize()
 
 	m_initialized = true;
 
+	startCorePool();
+
 	return true;
 }
 
@@ -84,6 +268,20 @@ bool VSScriptLibrary::initialize()
 
 bool VSScriptLibrary::finalize()
 {
+	// Evaluation can not be interrupted, so wait for the scripts
+	// evaluated on worker threads before unloading the library.
+	{
+		std::unique_lock<std::mutex> lock(m_evaluationsMutex);
+		m_evaluationsCondition.wait(lock,
+			[this]()
+			{
+				return (m_evaluationsRunning == 0);
+			});
+	}
+
+	clearScriptCache();
+	m_corePool.stop();
+
 	m_cpVSAPI = nullptr;
 
 	freeLibrary();
@@ -103,6 +301,15 @@ bool VSScriptLibrary::isInitialized() const
 // END OF bool VSScriptLibrary::isInitialized() const
 //==============================================================================
 
+void VSScriptLibrary::setWarmCorePoolEnabled(bool a_enabled)
+{
+	m_warmCorePoolEnabled = a_enabled;
+	startCorePool();
+}
+
+// END OF void VSScriptLibrary::setWarmCorePoolEnabled(bool a_enabled)
+//==============================================================================
+
 const VSAPI * VSScriptLibrary::getVSAPI()
 {
 	if(!initialize())
@@ -169,13 +376,336 @@ VSCore *VSScriptLibrary::createCore(int a_flag)
 		return nullptr;
 	}
 
-	if(m_VSCoreLogHandles.find(pCore) == m_VSCoreLogHandles.end())
-		m_VSCoreLogHandles[pCore] = m_cpVSAPI->addLogHandler(
-			vsMessageHandler, nullptr, this, pCore);
+	addCoreLogHandler(pCore);
 
     return pCore;
 }
 
+// END OF VSCore * VSScriptLibrary::createCore(int a_flag)
+//==============================================================================
+
+VSCore * VSScriptLibrary::getCore(VSScript * a_pScript)
+{
+	if(!initialize())
+		return nullptr;
+
+	return m_cpVSSAPI->getCore(a_pScript);
+}
+
+// END OF VSCore * VSScriptLibrary::getCore(VSScript * a_pScript)
+//==============================================================================
+
+VSScript * VSScriptLibrary::acquireScript(const QString & a_script,
+	const QString & a_scriptName, ProcessReason a_reason,
+	QString * a_pError, ScriptOrigin * a_pOrigin)
+{
+	if(!initialize())
+	{
+		if(a_pError)
+			*a_pError = tr("VapourSynth library is not initialized.");
+		return nullptr;
+	}
+
+	VSScript * pScript = acquireCachedScript(a_script, a_scriptName,
+		a_reason);
+	if(pScript)
+	{
+		if(a_pOrigin)
+			*a_pOrigin = ScriptOrigin::Cached;
+		return pScript;
+	}
+
+	pScript = evaluateScriptOnNewCore(a_script, a_scriptName,
+		evaluationCoreResources(a_reason), a_pError, a_pOrigin);
+	if(!pScript)
+		return nullptr;
+
+	return cacheScript(pScript, a_script, a_scriptName, a_reason);
+}
+
+// END OF VSScript * VSScriptLibrary::acquireScript(const QString & a_script,
+//		const QString & a_scriptName, ProcessReason a_reason,
+//		QString * a_pError, ScriptOrigin * a_pOrigin)
+//==============================================================================
+
+VSScript * VSScriptLibrary::acquireCachedScript(const QString & a_script,
+	const QString & a_scriptName, ProcessReason a_reason)
+{
+	QByteArray key = scriptCacheKey(a_script, a_scriptName, a_reason);
+	for(std::list<ScriptCacheEntry>::iterator it = m_scriptCache.begin();
+		it != m_scriptCache.end(); ++it)
+	{
+		if((!it->valid) || (it->key != key))
+			continue;
+
+		it->users++;
+		// Keep the most recently used entries in front.
+		m_scriptCache.splice(m_scriptCache.begin(), m_scriptCache, it);
+		return m_scriptCache.front().pScript;
+	}
+
+	return nullptr;
+}
+
+// END OF VSScript * VSScriptLibrary::acquireCachedScript(
+//		const QString & a_script, const QString & a_scriptName,
+//		ProcessReason a_reason)
+//==============================================================================
+
+CoreResources VSScriptLibrary::evaluationCoreResources(
+	ProcessReason a_reason) const
+{
+	// Script check does not configure the core and uses the evaluations
+	// of preview.
+	if(a_reason == ProcessReason::Check)
+		a_reason = ProcessReason::Preview;
+
+	CoreResourceSettings settings =
+		m_pSettingsManager->getCoreResourceSettings(a_reason);
+	return pickCoreResources(settings, a_reason, coreUsers(a_reason) + 1,
+		coreUsers() + 1);
+}
+
+// END OF CoreResources VSScriptLibrary::evaluationCoreResources(
+//		ProcessReason a_reason) const
+//==============================================================================
+
+VSScript * VSScriptLibrary::evaluateScriptOnNewCore(const QString & a_script,
+	const QString & a_scriptName, const CoreResources & a_resources,
+	QString * a_pError, ScriptOrigin * a_pOrigin,
+	const ProgressCallback & a_progress)
+{
+	if(!m_initialized)
+	{
+		if(a_pError)
+			*a_pError = tr("VapourSynth library is not initialized.");
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_evaluationsMutex);
+		m_evaluationsRunning++;
+	}
+
+	hr_time_point startTime = hr_clock::now();
+
+	ScriptOrigin origin = ScriptOrigin::EvaluatedOnWarmCore;
+	VSCore * pCore = m_corePool.takeCore();
+	if(!pCore)
+	{
+		origin = ScriptOrigin::Evaluated;
+		if(a_progress)
+			a_progress(tr("Creating VapourSynth core..."));
+		pCore = m_cpVSAPI->createCore(0);
+	}
+
+	hr_time_point coreTime = hr_clock::now();
+
+	VSScript * pScript = nullptr;
+	if(pCore)
+	{
+		// Pooled cores are created before anyone knows what they are for.
+		// Configure the core before the script starts using it.
+		if(a_resources.maxCacheSize > 0)
+			m_cpVSAPI->setMaxCacheSize(a_resources.maxCacheSize, pCore);
+		if(a_resources.threads > 0)
+			m_cpVSAPI->setThreadCount(a_resources.threads, pCore);
+
+		addCoreLogHandler(pCore);
+		pScript = m_cpVSSAPI->createScript(pCore);
+	}
+
+	if(pScript)
+	{
+		m_cpVSSAPI->evalSetWorkingDir(pScript, 1);
+
+		if(a_progress)
+			a_progress(tr("Evaluating script..."));
+		int opresult = m_cpVSSAPI->evaluateBuffer(pScript,
+			a_script.toUtf8().constData(),
+			a_scriptName.toUtf8().constData());
+		if(opresult)
+		{
+			if(a_pError)
+			{
+				*a_pError = tr("Failed to evaluate the script");
+				const char * vsError = m_cpVSSAPI->getError(pScript);
+				if(vsError)
+					*a_pError += QString(":\n") + vsError;
+				else
+					*a_pError += '.';
+			}
+			freeScript(pScript);
+			pScript = nullptr;
+		}
+	}
+	else
+	{
+		if(pCore)
+		{
+			removeCoreLogHandler(pCore);
+			m_cpVSAPI->freeCore(pCore);
+		}
+		if(a_pError)
+			*a_pError = tr("Failed to create VSScript handle!");
+	}
+
+	if(pScript && a_pOrigin)
+		*a_pOrigin = origin;
+
+	if(pScript)
+	{
+		hr_time_point endTime = hr_clock::now();
+		double coreSeconds = duration_to_double(coreTime - startTime);
+		double evaluationSeconds = duration_to_double(endTime - coreTime);
+		QString message = (origin == ScriptOrigin::EvaluatedOnWarmCore) ?
+			tr("Script evaluated on a warm core in %1 s.")
+			.arg(evaluationSeconds, 0, 'f', 3) :
+			tr("Created a core in %1 s and evaluated the script in %2 s.")
+			.arg(coreSeconds, 0, 'f', 3).arg(evaluationSeconds, 0, 'f', 3);
+		// Queued to the receivers on their threads.
+		emit signalWriteLogMessage(mtDebug, message);
+	}
+
+	{
+		// Notify under the lock: finalize() may return and the library
+		// be destroyed as soon as the lock is released.
+		std::lock_guard<std::mutex> lock(m_evaluationsMutex);
+		m_evaluationsRunning--;
+		m_evaluationsCondition.notify_all();
+	}
+
+	return pScript;
+}
+
+// END OF VSScript * VSScriptLibrary::evaluateScriptOnNewCore(
+//		const QString & a_script, const QString & a_scriptName,
+//		const CoreResources & a_resources, QString * a_pError,
+//		ScriptOrigin * a_pOrigin, const ProgressCallback & a_progress)
+//==============================================================================
+
+VSScript * VSScriptLibrary::cacheScript(VSScript * a_pScript,
+	const QString & a_script, const QString & a_scriptName,
+	ProcessReason a_reason)
+{
+	// The same script might have been evaluated in the meantime.
+	VSScript * pCachedScript = acquireCachedScript(a_script, a_scriptName,
+		a_reason);
+	if(pCachedScript)
+	{
+		freeScript(a_pScript);
+		return pCachedScript;
+	}
+
+	ScriptCacheEntry entry;
+	entry.key = scriptCacheKey(a_script, a_scriptName, a_reason);
+	entry.pScript = a_pScript;
+	entry.users = 1;
+	entry.files = scriptModules(a_script, a_scriptName);
+	entry.files << scriptSourceFiles(a_script, a_scriptName);
+	entry.files.removeDuplicates();
+	m_scriptCache.push_front(entry);
+
+	trimScriptCache();
+
+	return a_pScript;
+}
+
+// END OF VSScript * VSScriptLibrary::cacheScript(VSScript * a_pScript,
+//		const QString & a_script, const QString & a_scriptName,
+//		ProcessReason a_reason)
+//==============================================================================
+
+void VSScriptLibrary::releaseScript(VSScript * a_pScript)
+{
+	if(!a_pScript)
+		return;
+
+	std::list<ScriptCacheEntry>::iterator it = std::find_if(
+		m_scriptCache.begin(), m_scriptCache.end(),
+		[&](const ScriptCacheEntry & a_entry)
+		{
+			return (a_entry.pScript == a_pScript);
+		});
+
+	if(it == m_scriptCache.end())
+	{
+		freeScript(a_pScript);
+		return;
+	}
+
+	Q_ASSERT(it->users > 0);
+	it->users--;
+	if((it->users == 0) && it->valid)
+	{
+		// Keep the evaluated graph but not the frames.
+		clearCoreCaches(getCore(a_pScript));
+	}
+
+	trimScriptCache();
+}
+
+// END OF void VSScriptLibrary::releaseScript(VSScript * a_pScript)
+//==============================================================================
+
+void VSScriptLibrary::invalidateScriptCache(const QString & a_filePath)
+{
+	QString filePath;
+	if(!a_filePath.isEmpty())
+		filePath = QFileInfo(a_filePath).absoluteFilePath();
+
+	for(ScriptCacheEntry & entry : m_scriptCache)
+	{
+		if(filePath.isEmpty() || entry.files.contains(filePath))
+			entry.valid = false;
+	}
+
+	trimScriptCache();
+}
+
+// END OF void VSScriptLibrary::invalidateScriptCache(
+//		const QString & a_filePath)
+//==============================================================================
+
+QByteArray VSScriptLibrary::scriptContentsHash(const QString & a_script,
+	const QString & a_scriptName)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(a_scriptName.toUtf8());
+	hash.addData(QByteArray(1, '\0'));
+	hash.addData(a_script.toUtf8());
+
+	// The script file itself is hashed as it is in the editor.
+	QString scriptPath = a_scriptName.isEmpty() ? QString() :
+		QFileInfo(a_scriptName).absoluteFilePath();
+	for(const QString & filePath : scriptModules(a_script, a_scriptName))
+	{
+		if(filePath == scriptPath)
+			continue;
+		hash.addData(QByteArray(1, '\0'));
+		hash.addData(filePath.toUtf8());
+		hash.addData(QByteArray(1, '\0'));
+		QFile file(filePath);
+		if(file.open(QIODevice::ReadOnly))
+			hash.addData(&file);
+	}
+
+	// Sources are too large to read, their size and time have to do.
+	for(const QString & filePath : scriptSourceFiles(a_script, a_scriptName))
+	{
+		QFileInfo fileInfo(filePath);
+		hash.addData(QByteArray(1, '\0'));
+		hash.addData(QString("%1:%2:%3").arg(filePath).arg(fileInfo.size())
+			.arg(fileInfo.lastModified().toMSecsSinceEpoch()).toUtf8());
+	}
+
+	return hash.result();
+}
+
+// END OF QByteArray VSScriptLibrary::scriptContentsHash(
+//		const QString & a_script, const QString & a_scriptName)
+//==============================================================================
+
 std::vector<int> VSScriptLibrary::getOutputIndices(VSScript *a_pScript) const
 {
 #if(VSSCRIPT_API_MAJOR == 4) && (VSSCRIPT_API_MINOR >= 2)
@@ -212,7 +742,10 @@ bool VSScriptLibrary::freeScript(VSScript * a_pScript)
 	if(!initialize())
 		return false;
 
+	// The core is owned by the script and its log handler goes with it.
+	VSCore * pCore = m_cpVSSAPI->getCore(a_pScript);
 	m_cpVSSAPI->freeScript(a_pScript);
+	removeCoreLogHandler(pCore);
 
 	return true;
 }
@@ -232,6 +765,131 @@ bool VSScriptLibrary::clearCoreCaches(VSCore * a_pCore)
     return false;
 }
 
+bool VSScriptLibrary::setCoreNodeTiming(VSCore * a_pCore, bool a_enable)
+{
+#if(VAPOURSYNTH_API_MAJOR == 4) && (VAPOURSYNTH_API_MINOR >= 1)
+	if(m_VSAPIMajor == 4 && m_VSAPIMinor >= 1)
+	{
+		if(!m_initialized || !a_pCore)
+			return false;
+
+		m_cpVSAPI->setCoreNodeTiming(a_pCore, a_enable ? 1 : 0);
+		return true;
+	}
+#endif
+	return false;
+}
+
+// END OF bool VSScriptLibrary::setCoreNodeTiming(VSCore * a_pCore,
+//		bool a_enable)
+//==============================================================================
+
+std::vector<NodeTiming> VSScriptLibrary::getNodeTimings(
+	VSNode * a_pNode) const
+{
+	std::vector<NodeTiming> timings;
+#if(VAPOURSYNTH_API_MAJOR == 4) && (VAPOURSYNTH_API_MINOR >= 1)
+	if(!m_initialized || !a_pNode || m_VSAPIMajor != 4 || m_VSAPIMinor < 1)
+		return timings;
+
+	std::unordered_set<VSNode *> visited;
+	std::deque<VSNode *> nodes;
+	nodes.push_back(a_pNode);
+	visited.insert(a_pNode);
+
+	while(!nodes.empty())
+	{
+		VSNode * pNode = nodes.front();
+		nodes.pop_front();
+
+		NodeTiming timing;
+		timing.pNode = pNode;
+		const char * cpName = m_cpVSAPI->getNodeName(pNode);
+		if(cpName)
+			timing.name = QString::fromUtf8(cpName);
+		timing.filterMode = m_cpVSAPI->getNodeFilterMode(pNode);
+		timing.time = m_cpVSAPI->getNodeFilterTime(pNode);
+		timings.push_back(timing);
+
+		int dependencies = m_cpVSAPI->getNumNodeDependencies(pNode);
+		const VSFilterDependency * cpDependencies =
+			m_cpVSAPI->getNodeDependencies(pNode);
+		for(int i = 0; i < dependencies; ++i)
+		{
+			VSNode * pSource = cpDependencies[i].source;
+			if(pSource && visited.insert(pSource).second)
+				nodes.push_back(pSource);
+		}
+	}
+#else
+	(void)a_pNode;
+#endif
+	return timings;
+}
+
+// END OF std::vector<NodeTiming> VSScriptLibrary::getNodeTimings(
+//		VSNode * a_pNode) const
+//==============================================================================
+
+void VSScriptLibrary::registerCoreUser(VSCore * a_pCore,
+	ProcessReason a_reason)
+{
+	Q_ASSERT(a_pCore);
+	std::pair<ProcessReason, size_t> & user = m_coreUsers[a_pCore];
+	Q_ASSERT((user.second == 0) || (user.first == a_reason));
+	user.first = a_reason;
+	user.second++;
+	// Processors joining a registered core configure it the same way,
+	// but they still need to apply the resources themselves.
+	emit signalCoreUsersChanged();
+}
+
+// END OF void VSScriptLibrary::registerCoreUser(VSCore * a_pCore,
+//		ProcessReason a_reason)
+//==============================================================================
+
+void VSScriptLibrary::unregisterCoreUser(VSCore * a_pCore)
+{
+	std::map<VSCore *, std::pair<ProcessReason, size_t> >::iterator it =
+		m_coreUsers.find(a_pCore);
+	Q_ASSERT((it != m_coreUsers.end()) && (it->second.second > 0));
+	if(it == m_coreUsers.end())
+		return;
+
+	it->second.second--;
+	if(it->second.second > 0)
+		return;
+
+	m_coreUsers.erase(it);
+	emit signalCoreUsersChanged();
+}
+
+// END OF void VSScriptLibrary::unregisterCoreUser(VSCore * a_pCore)
+//==============================================================================
+
+size_t VSScriptLibrary::coreUsers(ProcessReason a_reason) const
+{
+	size_t users = 0;
+	for(const std::pair<VSCore * const, std::pair<ProcessReason, size_t> > &
+		mapItem : m_coreUsers)
+	{
+		if(mapItem.second.first == a_reason)
+			users++;
+	}
+	return users;
+}
+
+// END OF size_t VSScriptLibrary::coreUsers(ProcessReason a_reason) const
+//==============================================================================
+
+size_t VSScriptLibrary::coreUsers() const
+{
+	return m_coreUsers.size();
+}
+
+// END OF size_t VSScriptLibrary::coreUsers() const
+//==============================================================================
+
 QString VSScriptLibrary::VSAPIInfo()
 {
 	if(!m_initialized)
@@ -425,3 +1083,163 @@ void VSScriptLibrary::handleVSMessage(int a_messageType,
 // END OF void VSScriptLibrary::handleVSMessage(int a_messageType,
 //		const QString & a_message)
 //==============================================================================
+
+void VSScriptLibrary::addCoreLogHandler(VSCore * a_pCore)
+{
+	std::lock_guard<std::mutex> lock(m_coreLogHandlesMutex);
+	if(m_VSCoreLogHandles.find(a_pCore) == m_VSCoreLogHandles.end())
+		m_VSCoreLogHandles[a_pCore] = m_cpVSAPI->addLogHandler(
+			vsMessageHandler, nullptr, this, a_pCore);
+}
+
+// END OF void VSScriptLibrary::addCoreLogHandler(VSCore * a_pCore)
+//==============================================================================
+
+void VSScriptLibrary::removeCoreLogHandler(VSCore * a_pCore)
+{
+	// The handler itself is freed together with the core.
+	std::lock_guard<std::mutex> lock(m_coreLogHandlesMutex);
+	m_VSCoreLogHandles.erase(a_pCore);
+}
+
+// END OF void VSScriptLibrary::removeCoreLogHandler(VSCore * a_pCore)
+//==============================================================================
+
+void VSScriptLibrary::slotResetSettings()
+{
+	startCorePool();
+}
+
+// END OF void VSScriptLibrary::slotResetSettings()
+//==============================================================================
+
+void VSScriptLibrary::slotScriptFileChanged(const QString & a_filePath)
+{
+	invalidateScriptCache(a_filePath);
+}
+
+// END OF void VSScriptLibrary::slotScriptFileChanged(
+//		const QString & a_filePath)
+//==============================================================================
+
+QByteArray VSScriptLibrary::scriptCacheKey(const QString & a_script,
+	const QString & a_scriptName, ProcessReason a_reason) const
+{
+	// Script check does not configure the core,
+	// so it can use the evaluations of preview.
+	if(a_reason == ProcessReason::Check)
+		a_reason = ProcessReason::Preview;
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(QByteArray(1, (char)a_reason));
+	hash.addData(a_script.toUtf8());
+	hash.addData(QByteArray(1, '\0'));
+	hash.addData(a_scriptName.toUtf8());
+	hash.addData(QByteArray(1, '\0'));
+	// Evaluation also depends on which VapourSynth is loaded. The library
+	// search paths of the settings only pick this file, and the plugins
+	// are autoloaded by VapourSynth from its own configuration, so there
+	// are no other settings to cover.
+	hash.addData(m_vsScriptLibrary.fileName().toUtf8());
+	return hash.result();
+}
+
+// END OF QByteArray VSScriptLibrary::scriptCacheKey(
+//		const QString & a_script, const QString & a_scriptName,
+//		ProcessReason a_reason) const
+//==============================================================================
+
+void VSScriptLibrary::trimScriptCache()
+{
+	size_t idleEntries = 0;
+	std::list<ScriptCacheEntry>::iterator it = m_scriptCache.begin();
+	while(it != m_scriptCache.end())
+	{
+		if(it->users > 0)
+		{
+			++it;
+			continue;
+		}
+
+		if(it->valid && (idleEntries < SCRIPT_CACHE_MAX_IDLE_ENTRIES))
+		{
+			idleEntries++;
+			++it;
+			continue;
+		}
+
+		freeScript(it->pScript);
+		it = m_scriptCache.erase(it);
+	}
+
+	updateScriptCacheWatcher();
+}
+
+// END OF void VSScriptLibrary::trimScriptCache()
+//==============================================================================
+
+void VSScriptLibrary::clearScriptCache()
+{
+	if(m_initialized)
+	{
+		for(ScriptCacheEntry & entry : m_scriptCache)
+			freeScript(entry.pScript);
+	}
+	m_scriptCache.clear();
+
+	updateScriptCacheWatcher();
+}
+
+// END OF void VSScriptLibrary::clearScriptCache()
+//==============================================================================
+
+void VSScriptLibrary::updateScriptCacheWatcher()
+{
+	QStringList files;
+	for(const ScriptCacheEntry & entry : m_scriptCache)
+	{
+		if(entry.valid)
+			files << entry.files;
+	}
+	files.removeDuplicates();
+
+	QStringList unwatchedFiles;
+	for(const QString & filePath : m_pScriptCacheWatcher->files())
+	{
+		if(!files.contains(filePath))
+			unwatchedFiles << filePath;
+	}
+	if(!unwatchedFiles.isEmpty())
+		m_pScriptCacheWatcher->removePaths(unwatchedFiles);
+
+	QStringList newFiles;
+	QStringList watchedFiles = m_pScriptCacheWatcher->files();
+	for(const QString & filePath : files)
+	{
+		if(!watchedFiles.contains(filePath))
+			newFiles << filePath;
+	}
+	if(!newFiles.isEmpty())
+		m_pScriptCacheWatcher->addPaths(newFiles);
+}
+
+// END OF void VSScriptLibrary::updateScriptCacheWatcher()
+//==============================================================================
+
+void VSScriptLibrary::startCorePool()
+{
+	if(!m_initialized)
+		return;
+
+	size_t poolSize = 0;
+	if(m_warmCorePoolEnabled)
+	{
+		poolSize =
+			(size_t)std::max(m_pSettingsManager->getWarmCorePoolSize(), 0);
+	}
+	if(poolSize != m_corePool.size())
+		m_corePool.start(m_cpVSAPI, poolSize);
+}
+
+// END OF void VSScriptLibrary::startCorePool()
+//==============================================================================
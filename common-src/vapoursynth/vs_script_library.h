@@ -2,19 +2,48 @@
 #define VS_SCRIPT_LIBRARY_H_INCLUDED
 
 #include "../version_info.h"
+#include "../helpers_vs.h"
+#include "vs_script_processor_structures.h"
+#include "vs_core_pool.h"
+#include "vs_core_resources.h"
 #include <vapoursynth/VSScript4.h>
 
 #include <QObject>
 #include <QLibrary>
+#include <QByteArray>
+#include <QStringList>
 #include <map>
+#include <list>
 #include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 class SettingsManagerCore;
+class QFileSystemWatcher;
 
 //==============================================================================
 
 typedef const VSSCRIPTAPI * (VS_CC * FNP_getVSSAPI)(int);
 
+typedef std::function<void(const QString &)> ProgressCallback;
+
+//==============================================================================
+
+struct ScriptCacheEntry
+{
+	QByteArray key;
+	VSScript * pScript;
+	// Number of acquired references.
+	int users;
+	// Invalid entries are freed when the last user releases them.
+	bool valid;
+	// Script file, the modules it imports and the sources it opens.
+	QStringList files;
+
+	ScriptCacheEntry();
+};
+
 //==============================================================================
 
 class VSScriptLibrary : public QObject
@@ -34,6 +63,10 @@ public:
 
 	bool isInitialized() const;
 
+	// Keeps cores created ahead of time for the evaluations. Only worth
+	// it in the interactive editor, so it is disabled by default.
+	void setWarmCorePoolEnabled(bool a_enabled);
+
 	const VSAPI * getVSAPI();
 
 	VSScript * createScript(VSCore * a_pCore = nullptr);
@@ -45,6 +78,58 @@ public:
 
 	VSCore * createCore(int a_flag = 0);
 
+	VSCore * getCore(VSScript * a_pScript);
+
+	// Returns evaluated script. The same evaluation is shared by everyone
+	// who acquires the same script text and name for the same reason
+	// until it is invalidated. Preview clears the caches of its core and
+	// toggles node timing on it, so benchmark and encode never share
+	// a core with it or with each other. Script check uses the evaluations
+	// of preview as it does not touch the core.
+	// Release with releaseScript() instead of freeing.
+	VSScript * acquireScript(const QString & a_script,
+		const QString & a_scriptName, ProcessReason a_reason,
+		QString * a_pError = nullptr, ScriptOrigin * a_pOrigin = nullptr);
+
+	// Returns nullptr if the script is not cached.
+	VSScript * acquireCachedScript(const QString & a_script,
+		const QString & a_scriptName, ProcessReason a_reason);
+
+	// Resources for the core of a new evaluation for the reason,
+	// as if its processor was already registered.
+	CoreResources evaluationCoreResources(ProcessReason a_reason) const;
+
+	// Thread-safe once the library is initialized. Evaluates the script
+	// bypassing the cache on a core configured with the resources.
+	// Pass the result to cacheScript() on the library's thread or free it.
+	VSScript * evaluateScriptOnNewCore(const QString & a_script,
+		const QString & a_scriptName, const CoreResources & a_resources,
+		QString * a_pError = nullptr, ScriptOrigin * a_pOrigin = nullptr,
+		const ProgressCallback & a_progress = nullptr);
+
+	// Puts the evaluated script into the cache and acquires it.
+	// Returns the script to use, which is the previously cached one
+	// if the same script got there first.
+	VSScript * cacheScript(VSScript * a_pScript, const QString & a_script,
+		const QString & a_scriptName, ProcessReason a_reason);
+
+	void releaseScript(VSScript * a_pScript);
+
+	// Invalidates cached evaluations that depend on the file,
+	// or all of them if the path is empty. Evaluations in use stay
+	// with their users until released, but are not handed out again.
+	// The files the evaluations depend on are watched, so this is only
+	// needed for changes the watcher can not see.
+	void invalidateScriptCache(const QString & a_filePath = QString());
+
+	// Fingerprint of the script text, its name and the contents of the
+	// local modules it imports, for the results kept on disk between
+	// sessions. The sources the script opens are taken by their size
+	// and time. Unlike the evaluation cache key it does not depend
+	// on the loaded library.
+	static QByteArray scriptContentsHash(const QString & a_script,
+		const QString & a_scriptName);
+
 	// Returns empty vector if not supported by API
 	std::vector<int> getOutputIndices(VSScript * a_pScript) const;
 
@@ -54,21 +139,68 @@ public:
 
 	bool clearCoreCaches(VSCore * a_pCore);
 
+	// Return false if not supported by API
+	bool setCoreNodeTiming(VSCore * a_pCore, bool a_enable);
+
+	// Walks the graph behind the node. Times are accumulated by the core
+	// while node timing is enabled. Returns empty vector if not supported.
+	std::vector<NodeTiming> getNodeTimings(VSNode * a_pNode) const;
+
+	// Processors that configure the resources of their cores register
+	// them here to share the machine with each other. Processors sharing
+	// an evaluation share its core, so the users are counted in distinct
+	// cores.
+	void registerCoreUser(VSCore * a_pCore, ProcessReason a_reason);
+
+	void unregisterCoreUser(VSCore * a_pCore);
+
+	// Number of cores configured for the reason.
+	size_t coreUsers(ProcessReason a_reason) const;
+
+	size_t coreUsers() const;
+
 	QString VSAPIInfo();
 	QString VSSAPIInfo();
 
+public slots:
+
+	void slotResetSettings();
+
 signals:
 
 	void signalWriteLogMessage(int a_messageType, const QString & a_message);
 
+	void signalCoreUsersChanged();
+
+private slots:
+
+	void slotScriptFileChanged(const QString & a_filePath);
+
 private:
 
+	QByteArray scriptCacheKey(const QString & a_script,
+		const QString & a_scriptName, ProcessReason a_reason) const;
+
+	// Frees invalid and surplus idle entries.
+	void trimScriptCache();
+
+	void clearScriptCache();
+
+	void updateScriptCacheWatcher();
+
+	// Starts or stops the warm core pool as the settings say.
+	void startCorePool();
+
 	bool initLibrary();
 
 	void freeLibrary();
 
 	void handleVSMessage(int a_messageType, const QString & a_message);
 
+	void addCoreLogHandler(VSCore * a_pCore);
+
+	void removeCoreLogHandler(VSCore * a_pCore);
+
 	friend void VS_CC vsMessageHandler(int a_msgType,
 		const char * a_message, void * a_pUserData);
 
@@ -85,6 +217,21 @@ private:
 	const VSAPI * m_cpVSAPI;
 
 	std::map<VSCore *, VSLogHandle *> m_VSCoreLogHandles;
+	std::mutex m_coreLogHandlesMutex;
+
+	std::list<ScriptCacheEntry> m_scriptCache;
+
+	QFileSystemWatcher * m_pScriptCacheWatcher;
+
+	VSCorePool m_corePool;
+	bool m_warmCorePoolEnabled;
+
+	// Registered cores with their reason and number of processors.
+	std::map<VSCore *, std::pair<ProcessReason, size_t> > m_coreUsers;
+
+	int m_evaluationsRunning;
+	std::mutex m_evaluationsMutex;
+	std::condition_variable m_evaluationsCondition;
 
 	int m_VSAPIMajor;
 	int m_VSAPIMinor;
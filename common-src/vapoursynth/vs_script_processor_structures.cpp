@@ -1,5 +1,7 @@
 #include "vs_script_processor_structures.h"
 
+#include <functional>
+
 //==============================================================================
 
 Frame::Frame(int a_number, int a_outputIndex,
@@ -21,7 +23,7 @@ bool Frame::operator==(const Frame & a_other) const
 
 FrameTicket::FrameTicket(int a_frameNumber, int a_outputIndex,
 		VSNode * a_pOutputNode, bool a_needPreview,
-		VSNode * a_pPreviewNode):
+		VSNode * a_pPreviewNode, FramePriority a_priority):
 	frameNumber(a_frameNumber)
 	, outputIndex(a_outputIndex)
 	, pOutputNode(a_pOutputNode)
@@ -30,6 +32,11 @@ FrameTicket::FrameTicket(int a_frameNumber, int a_outputIndex,
 	, cpOutputFrame(nullptr)
 	, cpPreviewFrame(nullptr)
 	, discard(false)
+	, priority(a_priority)
+	, dispatchTime()
+	, subscribers(1)
+	, kind(FrameTicketKind::Frame)
+	, comparedIndex(-1)
 {
 }
 
@@ -45,6 +52,93 @@ bool FrameTicket::isComplete() const
 
 //==============================================================================
 
+FrameTicketKey::FrameTicketKey(const VSNode * a_pNode, int a_frameNumber):
+	  pNode(a_pNode)
+	, frameNumber(a_frameNumber)
+{
+}
+
+bool FrameTicketKey::operator==(const FrameTicketKey & a_other) const
+{
+	return ((pNode == a_other.pNode) && (frameNumber == a_other.frameNumber));
+}
+
+//==============================================================================
+
+size_t FrameTicketKeyHash::operator()(const FrameTicketKey & a_key) const
+{
+	size_t seed = std::hash<const void *>()(a_key.pNode);
+	seed ^= std::hash<int>()(a_key.frameNumber) + 0x9e3779b9 +
+		(seed << 6) + (seed >> 2);
+	return seed;
+}
+
+//==============================================================================
+
+void indexFrameTicket(FrameTicketIndex & a_index, const VSNode * a_pNode,
+	FrameTicketList::iterator a_it)
+{
+	a_index.emplace(FrameTicketKey(a_pNode, a_it->frameNumber), a_it);
+}
+
+//==============================================================================
+
+bool takeIndexedFrameTicket(FrameTicketIndex & a_index,
+	const VSNode * a_pNode, int a_frameNumber,
+	FrameTicketList::iterator & a_it)
+{
+	FrameTicketIndex::iterator indexIt =
+		a_index.find(FrameTicketKey(a_pNode, a_frameNumber));
+	if(indexIt == a_index.end())
+		return false;
+
+	a_it = indexIt->second;
+	a_index.erase(indexIt);
+	return true;
+}
+
+//==============================================================================
+
+bool findIndexedFrameTicket(const FrameTicketIndex & a_index,
+	const VSNode * a_pNode, int a_frameNumber, int a_outputIndex,
+	FrameTicketList::iterator & a_it)
+{
+	std::pair<FrameTicketIndex::const_iterator,
+		FrameTicketIndex::const_iterator> range =
+		a_index.equal_range(FrameTicketKey(a_pNode, a_frameNumber));
+	for(FrameTicketIndex::const_iterator it = range.first;
+		it != range.second; ++it)
+	{
+		if((it->second->outputIndex == a_outputIndex) &&
+			(it->second->kind == FrameTicketKind::Frame))
+		{
+			a_it = it->second;
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================================================================
+
+bool unindexFrameTicket(FrameTicketIndex & a_index, const VSNode * a_pNode,
+	FrameTicketList::iterator a_it)
+{
+	std::pair<FrameTicketIndex::iterator, FrameTicketIndex::iterator> range =
+		a_index.equal_range(FrameTicketKey(a_pNode, a_it->frameNumber));
+	for(FrameTicketIndex::iterator it = range.first; it != range.second; ++it)
+	{
+		if(it->second == a_it)
+		{
+			a_index.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================================================================
+
 NodePair::NodePair():
 	  outputIndex(-1)
 	, pOutputNode(nullptr)
@@ -79,3 +173,33 @@ bool NodePair::isValid() const
 }
 
 //==============================================================================
+
+NodeTiming::NodeTiming():
+	  pNode(nullptr)
+	, name()
+	, filterMode(0)
+	, time(0)
+{
+}
+
+//==============================================================================
+
+FrameMetrics::FrameMetrics(int a_frameNumber, int a_referenceIndex,
+	int a_comparedIndex):
+	  frameNumber(a_frameNumber)
+	, referenceIndex(a_referenceIndex)
+	, comparedIndex(a_comparedIndex)
+	, psnr()
+	, ssim()
+	, maxAbsDiff()
+{
+}
+
+//==============================================================================
+
+bool FrameMetrics::isEmpty() const
+{
+	return psnr.empty();
+}
+
+//==============================================================================
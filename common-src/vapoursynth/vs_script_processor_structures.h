@@ -1,8 +1,57 @@
 #ifndef VS_SCRIPT_PROCESSOR_STRUCTURES_H_INCLUDED
 #define VS_SCRIPT_PROCESSOR_STRUCTURES_H_INCLUDED
 
+#include "../chrono.h"
+
 #include <vapoursynth/VapourSynth4.h>
 
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+//==============================================================================
+
+// Frame requests are dispatched in the order of these classes.
+// Requests of the same class are dispatched in the order they were made.
+enum class FramePriority
+{
+	Interactive,
+	Playback,
+	Prefetch,
+	Background,
+};
+
+const size_t FRAME_PRIORITY_CLASSES = 4;
+
+//==============================================================================
+
+// What the frame request is answered with.
+enum class FrameTicketKind
+{
+	// The frames of the output and its preview.
+	Frame,
+	// The frame of the thumbnail node of the output alone.
+	Thumbnail,
+	// The frame of the full size preview node of the output alone.
+	FullSizePreview,
+	// The frame of the metrics node measuring the compared output
+	// against the output of the ticket.
+	Metrics,
+};
+
+//==============================================================================
+
+// How the script processor got its evaluated script.
+enum class ScriptOrigin
+{
+	Evaluated,
+	EvaluatedOnWarmCore,
+	Cached,
+};
+
 //==============================================================================
 
 struct Frame
@@ -30,16 +79,71 @@ struct FrameTicket
 	const VSFrame * cpOutputFrame;
 	const VSFrame * cpPreviewFrame;
 	bool discard;
+	FramePriority priority;
+	hr_time_point dispatchTime;
+	// Number of requests merged into the ticket.
+	// Each of them gets its own answer.
+	int subscribers;
+	// Tickets of other kinds than frames get their node on dispatch
+	// and are never merged.
+	FrameTicketKind kind;
+	// The output measured by a metrics ticket.
+	int comparedIndex;
 
 	FrameTicket(int a_frameNumber, int a_outputIndex,
 		VSNode * a_pOutputNode, bool a_needPreview = false,
-		VSNode * a_pPreviewNode = nullptr);
+		VSNode * a_pPreviewNode = nullptr,
+		FramePriority a_priority = FramePriority::Interactive);
 
 	bool isComplete() const;
 };
 
 //==============================================================================
 
+// Identifies a frame request that is currently processed by the core.
+// VapourSynth passes back the node and the frame number, so the pair is
+// enough to find the ticket the frame belongs to.
+struct FrameTicketKey
+{
+	const VSNode * pNode;
+	int frameNumber;
+
+	FrameTicketKey(const VSNode * a_pNode, int a_frameNumber);
+	bool operator==(const FrameTicketKey & a_other) const;
+};
+
+struct FrameTicketKeyHash
+{
+	size_t operator()(const FrameTicketKey & a_key) const;
+};
+
+typedef std::list<FrameTicket> FrameTicketList;
+typedef std::unordered_multimap<FrameTicketKey, FrameTicketList::iterator,
+	FrameTicketKeyHash> FrameTicketIndex;
+
+// Tickets are indexed by the node their frame is requested from.
+void indexFrameTicket(FrameTicketIndex & a_index, const VSNode * a_pNode,
+	FrameTicketList::iterator a_it);
+
+// Takes the ticket the frame that arrived from the node was requested by
+// out of the index. Returns false if no ticket requested it.
+bool takeIndexedFrameTicket(FrameTicketIndex & a_index,
+	const VSNode * a_pNode, int a_frameNumber,
+	FrameTicketList::iterator & a_it);
+
+// Finds the ticket requesting the frame of the output from the node.
+// Tickets of other kinds than frames are not found.
+bool findIndexedFrameTicket(const FrameTicketIndex & a_index,
+	const VSNode * a_pNode, int a_frameNumber, int a_outputIndex,
+	FrameTicketList::iterator & a_it);
+
+// Drops the entry of the ticket indexed by the node.
+// Returns false if the ticket was not indexed by it.
+bool unindexFrameTicket(FrameTicketIndex & a_index, const VSNode * a_pNode,
+	FrameTicketList::iterator a_it);
+
+//==============================================================================
+
 struct NodePair
 {
 	int outputIndex;
@@ -56,4 +160,36 @@ struct NodePair
 
 //==============================================================================
 
+struct NodeTiming
+{
+	const VSNode * pNode;
+	QString name;
+	int filterMode;
+	// Nanoseconds spent in the filter.
+	int64_t time;
+
+	NodeTiming();
+};
+
+//==============================================================================
+
+// How the frame of one output differs from the frame of another one.
+struct FrameMetrics
+{
+	int frameNumber;
+	int referenceIndex;
+	int comparedIndex;
+	// Per plane. Empty if the frames could not be measured.
+	std::vector<double> psnr;
+	std::vector<double> ssim;
+	std::vector<double> maxAbsDiff;
+
+	FrameMetrics(int a_frameNumber = -1, int a_referenceIndex = -1,
+		int a_comparedIndex = -1);
+
+	bool isEmpty() const;
+};
+
+//==============================================================================
+
 #endif // VS_SCRIPT_PROCESSOR_STRUCTURES_H_INCLUDED
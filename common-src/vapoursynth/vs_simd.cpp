@@ -0,0 +1,43 @@
+#include "vs_simd.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+static SimdLevel querySimdLevel()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    bool sse41 = false;
+    bool avx2 = false;
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    int maxLeaf = regs[0];
+    __cpuid(regs, 1);
+    sse41 = (regs[2] & (1 << 19)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x06) == 0x06)
+    {
+        __cpuidex(regs, 7, 0);
+        avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return SimdLevel::AVX2;
+    if (sse41)
+        return SimdLevel::SSE41;
+#endif
+    return SimdLevel::None;
+}
+
+SimdLevel simdLevel()
+{
+    static const SimdLevel level = querySimdLevel();
+    return level;
+}
@@ -0,0 +1,15 @@
+#ifndef VS_SIMD_H_INCLUDED
+#define VS_SIMD_H_INCLUDED
+
+enum class SimdLevel
+{
+    None,
+    SSE41,
+    AVX2,
+};
+
+// The best instruction set the SIMD kernels can use on this CPU.
+// Always None outside of x86-64.
+SimdLevel simdLevel();
+
+#endif
@@ -0,0 +1,288 @@
+#include "vs_yuv_to_rgb.h"
+#include "vs_yuv_to_rgb_kernel.h"
+#include "vs_simd.h"
+#include "../libp2p/p2p_api.h"
+
+#include <vapoursynth/VSHelper4.h>
+#include <vapoursynth/VSConstants4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <typename T, bool rgb30>
+void yuvToRGBRowC(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c)
+{
+    const T *y = static_cast<const T *>(srcY);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        // Summed in the order of the SIMD rows, so all rows agree to the bit.
+        float luma = y[x] * c.yScale + c.yOffset;
+        float r = std::min(std::max(luma + (c.rU * u[x] + c.rV * v[x]), 0.0f), c.outMax);
+        float g = std::min(std::max(luma + (c.gU * u[x] + c.gV * v[x]), 0.0f), c.outMax);
+        float b = std::min(std::max(luma + (c.bU * u[x] + c.bV * v[x]), 0.0f), c.outMax);
+        uint32_t ri = static_cast<uint32_t>(std::lrint(r));
+        uint32_t gi = static_cast<uint32_t>(std::lrint(g));
+        uint32_t bi = static_cast<uint32_t>(std::lrint(b));
+        if (rgb30)
+            dst[x] = 0xC0000000 | (ri << 20) | (gi << 10) | bi;
+        else
+            dst[x] = 0xFF000000 | (ri << 16) | (gi << 8) | bi;
+    }
+}
+
+template void yuvToRGBRowC<uint8_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowC<uint8_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowC<uint16_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowC<uint16_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+
+template <typename T, bool rgb30>
+yuv_to_rgb_row_func selectRowFunc()
+{
+#ifdef YUV_TO_RGB_X86
+    SimdLevel level = simdLevel();
+    if (level == SimdLevel::AVX2)
+        return yuvToRGBRowAVX2<T, rgb30>;
+    if (level == SimdLevel::SSE41)
+        return yuvToRGBRowSSE41<T, rgb30>;
+#endif
+    return yuvToRGBRowC<T, rgb30>;
+}
+
+// Matrices that are not linear in Y, Cb and Cr are left to the resizer.
+static bool matrixCoefficients(int64_t matrix, YuvToRGBCoefficients &c)
+{
+    double kr;
+    double kb;
+    switch (matrix)
+    {
+    case VSC_MATRIX_BT709:
+        kr = 0.2126;
+        kb = 0.0722;
+        break;
+    case VSC_MATRIX_FCC:
+        kr = 0.30;
+        kb = 0.11;
+        break;
+    case VSC_MATRIX_BT470_BG:
+    case VSC_MATRIX_ST170_M:
+        kr = 0.299;
+        kb = 0.114;
+        break;
+    case VSC_MATRIX_ST240_M:
+        kr = 0.212;
+        kb = 0.087;
+        break;
+    case VSC_MATRIX_BT2020_NCL:
+        kr = 0.2627;
+        kb = 0.0593;
+        break;
+    case VSC_MATRIX_YCGCO:
+        c.rU = -1.0f;
+        c.rV = 1.0f;
+        c.gU = 1.0f;
+        c.gV = 0.0f;
+        c.bU = -1.0f;
+        c.bV = -1.0f;
+        return true;
+    default:
+        return false;
+    }
+    double kg = 1.0 - kr - kb;
+    c.rU = 0.0f;
+    c.rV = static_cast<float>(2.0 * (1.0 - kr));
+    c.gU = static_cast<float>(-2.0 * kb * (1.0 - kb) / kg);
+    c.gV = static_cast<float>(-2.0 * kr * (1.0 - kr) / kg);
+    c.bU = static_cast<float>(2.0 * (1.0 - kb));
+    c.bV = 0.0f;
+    return true;
+}
+
+// Interpolates the two chroma rows with weightB quarters of rowB, then
+// upsamples horizontally to the luma width.
+template <typename T>
+static void upsampleChromaRow(const T *rowA, const T *rowB, int weightB, bool centerSited, float half, float scale, float *line, float *dst, unsigned chromaWidth)
+{
+    float weightA = (4 - weightB) * 0.25f * scale;
+    float weightBScaled = weightB * 0.25f * scale;
+    float offset = half * scale;
+    for (unsigned k = 0; k < chromaWidth; ++k)
+        line[k] = rowA[k] * weightA + rowB[k] * weightBScaled - offset;
+
+    for (unsigned k = 0; k < chromaWidth; ++k)
+    {
+        float next = line[std::min(k + 1, chromaWidth - 1)];
+        if (centerSited)
+        {
+            float previous = line[k ? k - 1 : 0];
+            dst[2 * k] = 0.75f * line[k] + 0.25f * previous;
+            dst[2 * k + 1] = 0.75f * line[k] + 0.25f * next;
+        }
+        else
+        {
+            dst[2 * k] = line[k];
+            dst[2 * k + 1] = 0.5f * (line[k] + next);
+        }
+    }
+}
+
+struct YuvToRGBData
+{
+    VSNode *node;
+    int64_t matrix;
+    int64_t chromaLoc;
+    bool use10bit;
+    yuv_to_rgb_row_func rowFunc;
+};
+
+static void VS_CC yuvToRGBFree(void *instanceData, [[maybe_unused]] VSCore *core, [[maybe_unused]] const VSAPI *vsapi)
+{
+    YuvToRGBData *d = reinterpret_cast<YuvToRGBData *>(instanceData);
+    // The node is freed somewhere else
+    delete d;
+}
+
+template <typename T>
+static const VSFrame *VS_CC yuvToRGBGetFrame(int n, int activationReason, void *instanceData, [[maybe_unused]] void **frameData, VSFrameContext *frameCtx, VSCore *core, const VSAPI *vsapi)
+{
+    YuvToRGBData *d = reinterpret_cast<YuvToRGBData *>(instanceData);
+    if (activationReason == arInitial)
+    {
+        vsapi->requestFrameFilter(n, d->node, frameCtx);
+    }
+    else if (activationReason == arAllFramesReady)
+    {
+        const VSFrame *srcFrame = vsapi->getFrameFilter(n, d->node, frameCtx);
+        const VSMap *srcProps = vsapi->getFramePropertiesRO(srcFrame);
+        const VSVideoFormat *srcFormat = vsapi->getVideoFrameFormat(srcFrame);
+        int bits = srcFormat->bitsPerSample;
+
+        YuvToRGBCoefficients c;
+        int err;
+        int64_t matrix = vsapi->mapGetInt(srcProps, "_Matrix", 0, &err);
+        if (err || !matrixCoefficients(matrix, c))
+            matrixCoefficients(d->matrix, c);
+
+        int64_t range = vsapi->mapGetInt(srcProps, "_ColorRange", 0, &err);
+        bool fullRange = (!err && range == VSC_RANGE_FULL);
+
+        int64_t chromaLoc = vsapi->mapGetInt(srcProps, "_ChromaLocation", 0, &err);
+        if (err || chromaLoc < VSC_CHROMA_LEFT || chromaLoc > VSC_CHROMA_BOTTOM)
+            chromaLoc = d->chromaLoc;
+        bool centerSited = (chromaLoc == VSC_CHROMA_CENTER || chromaLoc == VSC_CHROMA_TOP || chromaLoc == VSC_CHROMA_BOTTOM);
+        bool topSited = (chromaLoc == VSC_CHROMA_TOP_LEFT || chromaLoc == VSC_CHROMA_TOP);
+        bool bottomSited = (chromaLoc == VSC_CHROMA_BOTTOM_LEFT || chromaLoc == VSC_CHROMA_BOTTOM);
+
+        c.outMax = d->use10bit ? 1023.0f : 255.0f;
+        float chromaRange;
+        if (fullRange)
+        {
+            float peak = static_cast<float>((1 << bits) - 1);
+            c.yScale = c.outMax / peak;
+            c.yOffset = 0.0f;
+            chromaRange = peak;
+        }
+        else
+        {
+            c.yScale = c.outMax / static_cast<float>(219 << (bits - 8));
+            c.yOffset = -static_cast<float>(16 << (bits - 8)) * c.yScale;
+            chromaRange = static_cast<float>(224 << (bits - 8));
+        }
+        float chromaHalf = static_cast<float>(1 << (bits - 1));
+        float chromaScale = c.outMax / chromaRange;
+
+        int width = vsapi->getFrameWidth(srcFrame, 0);
+        int height = vsapi->getFrameHeight(srcFrame, 0);
+        int chromaWidth = vsapi->getFrameWidth(srcFrame, 1);
+        int chromaHeight = vsapi->getFrameHeight(srcFrame, 1);
+
+        VSVideoFormat frameFormat;
+        vsapi->getVideoFormatByID(&frameFormat, pfGray8, core);
+        VSFrame *dstFrame = vsapi->newVideoFrame(&frameFormat, width * 4, height, nullptr, core);
+
+        const uint8_t *srcY = vsapi->getReadPtr(srcFrame, 0);
+        const uint8_t *srcU = vsapi->getReadPtr(srcFrame, 1);
+        const uint8_t *srcV = vsapi->getReadPtr(srcFrame, 2);
+        ptrdiff_t strideY = vsapi->getStride(srcFrame, 0);
+        ptrdiff_t strideUV = vsapi->getStride(srcFrame, 1);
+        uint8_t *dst = vsapi->getWritePtr(dstFrame, 0);
+        ptrdiff_t dstStride = vsapi->getStride(dstFrame, 0);
+
+        // Rows small enough to stay in cache between the chroma
+        // upsampling and the conversion.
+        std::vector<float> buffer(chromaWidth + 2 * static_cast<size_t>(width));
+        float *line = buffer.data();
+        float *rowU = line + chromaWidth;
+        float *rowV = rowU + width;
+
+        for (int y = 0; y < height; ++y)
+        {
+            int j = y / 2;
+            int k;
+            int weight;
+            if (topSited)
+            {
+                k = std::min(j + 1, chromaHeight - 1);
+                weight = (y & 1) ? 2 : 0;
+            }
+            else if (bottomSited)
+            {
+                k = std::max(j - 1, 0);
+                weight = (y & 1) ? 0 : 2;
+            }
+            else
+            {
+                k = (y & 1) ? std::min(j + 1, chromaHeight - 1) : std::max(j - 1, 0);
+                weight = 1;
+            }
+
+            upsampleChromaRow(reinterpret_cast<const T *>(srcU + j * strideUV), reinterpret_cast<const T *>(srcU + k * strideUV), weight, centerSited, chromaHalf, chromaScale, line, rowU, chromaWidth);
+            upsampleChromaRow(reinterpret_cast<const T *>(srcV + j * strideUV), reinterpret_cast<const T *>(srcV + k * strideUV), weight, centerSited, chromaHalf, chromaScale, line, rowV, chromaWidth);
+            d->rowFunc(srcY + y * strideY, rowU, rowV, reinterpret_cast<uint32_t *>(dst + y * dstStride), width, c);
+        }
+
+        VSMap *props = vsapi->getFramePropertiesRW(dstFrame);
+        enum p2p_packing packing_fmt = d->use10bit ? p2p_rgb30 : p2p_argb32;
+        vsapi->mapSetInt(props, "PackingFormat", static_cast<int64_t>(packing_fmt), maReplace);
+        vsapi->mapConsumeFrame(props, "OutputFrame", srcFrame, maReplace);
+        return dstFrame;
+    }
+    return nullptr;
+}
+
+bool yuvToRGBSupported(const VSVideoInfo *vi)
+{
+    const VSVideoFormat &format = vi->format;
+    return vsh::isConstantVideoFormat(vi)
+        && format.colorFamily == cfYUV
+        && format.sampleType == stInteger
+        && format.bitsPerSample >= 8 && format.bitsPerSample <= 16
+        && format.subSamplingW == 1 && format.subSamplingH == 1;
+}
+
+VSNode *yuvToRGBFilter(VSNode *outputNode, int64_t matrix, int64_t chromaLoc, bool use10bit, VSCore *core, const VSAPI *vsapi)
+{
+    const VSVideoInfo *srcVi = vsapi->getVideoInfo(outputNode);
+    bool bytes8 = (srcVi->format.bytesPerSample == 1);
+
+    VSVideoInfo vi = *srcVi;
+    vi.width *= 4;
+    vsapi->getVideoFormatByID(&vi.format, pfGray8, core);
+
+    yuv_to_rgb_row_func rowFunc;
+    if (bytes8)
+        rowFunc = use10bit ? selectRowFunc<uint8_t, true>() : selectRowFunc<uint8_t, false>();
+    else
+        rowFunc = use10bit ? selectRowFunc<uint16_t, true>() : selectRowFunc<uint16_t, false>();
+
+    YuvToRGBData *d = new YuvToRGBData{outputNode, matrix, chromaLoc, use10bit, rowFunc};
+
+    std::vector<VSFilterDependency> deps = {
+        {outputNode, rpStrictSpatial}};
+
+    const char *name = use10bit ? "YUVToRGB30" : "YUVToRGB24";
+    if (bytes8)
+        return vsapi->createVideoFilter2(name, &vi, yuvToRGBGetFrame<uint8_t>, yuvToRGBFree, fmParallel, deps.data(), deps.size(), d, core);
+    else
+        return vsapi->createVideoFilter2(name, &vi, yuvToRGBGetFrame<uint16_t>, yuvToRGBFree, fmParallel, deps.data(), deps.size(), d, core);
+}
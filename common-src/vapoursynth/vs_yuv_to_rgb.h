@@ -0,0 +1,15 @@
+#ifndef VS_YUV_TO_RGB_H_INCLUDED
+#define VS_YUV_TO_RGB_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+// Constant format integer 4:2:0 YUV of 8 to 16 bits.
+bool yuvToRGBSupported(const VSVideoInfo *vi);
+
+// Converts straight to the packed Gray8 frames packRGBFilter produces,
+// without an intermediate RGB clip. Chroma is upsampled bilinearly and
+// the result is not dithered. Frame properties take priority over the
+// given matrix and chroma location.
+VSNode *yuvToRGBFilter(VSNode *outputNode, int64_t matrix, int64_t chromaLoc, bool use10bit, VSCore *core, const VSAPI *vsapi);
+
+#endif
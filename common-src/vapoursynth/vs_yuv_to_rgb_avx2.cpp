@@ -0,0 +1,65 @@
+#include "vs_yuv_to_rgb_kernel.h"
+
+#ifdef YUV_TO_RGB_X86
+
+#include <immintrin.h>
+
+static inline __m256i loadLuma(const uint8_t *src)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+static inline __m256i loadLuma(const uint16_t *src)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+}
+
+static inline __m256i toChannel(__m256 value, __m256 outMax)
+{
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), outMax);
+    return _mm256_cvtps_epi32(value);
+}
+
+template <typename T, bool rgb30>
+void yuvToRGBRowAVX2(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c)
+{
+    const T *y = static_cast<const T *>(srcY);
+
+    const __m256 yScale = _mm256_set1_ps(c.yScale);
+    const __m256 yOffset = _mm256_set1_ps(c.yOffset);
+    const __m256 rU = _mm256_set1_ps(c.rU);
+    const __m256 rV = _mm256_set1_ps(c.rV);
+    const __m256 gU = _mm256_set1_ps(c.gU);
+    const __m256 gV = _mm256_set1_ps(c.gV);
+    const __m256 bU = _mm256_set1_ps(c.bU);
+    const __m256 bV = _mm256_set1_ps(c.bV);
+    const __m256 outMax = _mm256_set1_ps(c.outMax);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(rgb30 ? 0xC0000000 : 0xFF000000));
+
+    unsigned x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 luma = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(loadLuma(y + x)), yScale), yOffset);
+        __m256 cu = _mm256_loadu_ps(u + x);
+        __m256 cv = _mm256_loadu_ps(v + x);
+
+        __m256 r = _mm256_add_ps(luma, _mm256_add_ps(_mm256_mul_ps(rU, cu), _mm256_mul_ps(rV, cv)));
+        __m256 g = _mm256_add_ps(luma, _mm256_add_ps(_mm256_mul_ps(gU, cu), _mm256_mul_ps(gV, cv)));
+        __m256 b = _mm256_add_ps(luma, _mm256_add_ps(_mm256_mul_ps(bU, cu), _mm256_mul_ps(bV, cv)));
+
+        __m256i pixels = _mm256_or_si256(alpha, toChannel(b, outMax));
+        pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(toChannel(g, outMax), rgb30 ? 10 : 8));
+        pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(toChannel(r, outMax), rgb30 ? 20 : 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), pixels);
+    }
+
+    if (x < width)
+        yuvToRGBRowC<T, rgb30>(y + x, u + x, v + x, dst + x, width - x, c);
+}
+
+template void yuvToRGBRowAVX2<uint8_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowAVX2<uint8_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowAVX2<uint16_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowAVX2<uint16_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+
+#endif // YUV_TO_RGB_X86
@@ -0,0 +1,37 @@
+#ifndef VS_YUV_TO_RGB_KERNEL_H_INCLUDED
+#define VS_YUV_TO_RGB_KERNEL_H_INCLUDED
+
+#include <cstdint>
+
+struct YuvToRGBCoefficients
+{
+    // Luma in output units is y * yScale + yOffset.
+    // Chroma rows come centered and scaled to output units.
+    float yScale;
+    float yOffset;
+    float rU;
+    float rV;
+    float gU;
+    float gV;
+    float bU;
+    float bV;
+    float outMax;
+};
+
+typedef void (*yuv_to_rgb_row_func)(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c);
+
+// Defined in vs_yuv_to_rgb.cpp. The SIMD rows use it for the remainder.
+template <typename T, bool rgb30>
+void yuvToRGBRowC(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c);
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YUV_TO_RGB_X86
+
+template <typename T, bool rgb30>
+void yuvToRGBRowSSE41(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c);
+
+template <typename T, bool rgb30>
+void yuvToRGBRowAVX2(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c);
+#endif
+
+#endif
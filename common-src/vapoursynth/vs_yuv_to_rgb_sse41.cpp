@@ -0,0 +1,68 @@
+#include "vs_yuv_to_rgb_kernel.h"
+
+#ifdef YUV_TO_RGB_X86
+
+#include <cstring>
+#include <smmintrin.h>
+
+static inline __m128i loadLuma(const uint8_t *src)
+{
+    int32_t packed;
+    memcpy(&packed, src, sizeof(packed));
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+}
+
+static inline __m128i loadLuma(const uint16_t *src)
+{
+    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+static inline __m128i toChannel(__m128 value, __m128 outMax)
+{
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), outMax);
+    return _mm_cvtps_epi32(value);
+}
+
+template <typename T, bool rgb30>
+void yuvToRGBRowSSE41(const void *srcY, const float *u, const float *v, uint32_t *dst, unsigned width, const YuvToRGBCoefficients &c)
+{
+    const T *y = static_cast<const T *>(srcY);
+
+    const __m128 yScale = _mm_set1_ps(c.yScale);
+    const __m128 yOffset = _mm_set1_ps(c.yOffset);
+    const __m128 rU = _mm_set1_ps(c.rU);
+    const __m128 rV = _mm_set1_ps(c.rV);
+    const __m128 gU = _mm_set1_ps(c.gU);
+    const __m128 gV = _mm_set1_ps(c.gV);
+    const __m128 bU = _mm_set1_ps(c.bU);
+    const __m128 bV = _mm_set1_ps(c.bV);
+    const __m128 outMax = _mm_set1_ps(c.outMax);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(rgb30 ? 0xC0000000 : 0xFF000000));
+
+    unsigned x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 luma = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(loadLuma(y + x)), yScale), yOffset);
+        __m128 cu = _mm_loadu_ps(u + x);
+        __m128 cv = _mm_loadu_ps(v + x);
+
+        __m128 r = _mm_add_ps(luma, _mm_add_ps(_mm_mul_ps(rU, cu), _mm_mul_ps(rV, cv)));
+        __m128 g = _mm_add_ps(luma, _mm_add_ps(_mm_mul_ps(gU, cu), _mm_mul_ps(gV, cv)));
+        __m128 b = _mm_add_ps(luma, _mm_add_ps(_mm_mul_ps(bU, cu), _mm_mul_ps(bV, cv)));
+
+        __m128i pixels = _mm_or_si128(alpha, toChannel(b, outMax));
+        pixels = _mm_or_si128(pixels, _mm_slli_epi32(toChannel(g, outMax), rgb30 ? 10 : 8));
+        pixels = _mm_or_si128(pixels, _mm_slli_epi32(toChannel(r, outMax), rgb30 ? 20 : 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), pixels);
+    }
+
+    if (x < width)
+        yuvToRGBRowC<T, rgb30>(y + x, u + x, v + x, dst + x, width - x, c);
+}
+
+template void yuvToRGBRowSSE41<uint8_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowSSE41<uint8_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowSSE41<uint16_t, false>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+template void yuvToRGBRowSSE41<uint16_t, true>(const void *, const float *, const float *, uint32_t *, unsigned, const YuvToRGBCoefficients &);
+
+#endif // YUV_TO_RGB_X86
@@ -8,8 +8,10 @@ SUBDIRS += vsedit
 SUBDIRS += vsedit-previewer
 SUBDIRS += vsedit-job-server
 SUBDIRS += vsedit-job-server-watcher
+SUBDIRS += vsedit-tests
 
 vsedit.file = ./vsedit/vsedit.pro
 vsedit-previewer.file = ./vsedit-previewer/vsedit-previewer.pro
 vsedit-job-server.file = ./vsedit-job-server/vsedit-job-server.pro
 vsedit-job-server-watcher.file = ./vsedit-job-server-watcher/vsedit-job-server-watcher.pro
+vsedit-tests.file = ./vsedit-tests/vsedit-tests.pro
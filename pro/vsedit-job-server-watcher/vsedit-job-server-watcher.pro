@@ -174,6 +174,21 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/cpuinfo_x86.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/p2p_simd.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_set_matrix.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_completion_queue.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_pool.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_evaluation.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_resources.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_kernel.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/jobs_model.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_edit_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/jobs/job_dependencies_delegate.h
@@ -202,6 +217,17 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vapoursynth_script_proces
 SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_set_matrix.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_completion_queue.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_pool.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_evaluation.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_resources.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/jobs_model.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_edit_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/jobs/job_dependencies_delegate.cpp
@@ -261,4 +287,45 @@ if($$ARCHITECTURE_64_BIT) {
 	QMAKE_EXTRA_COMPILERS += p2p_sse41
 }
 
+# Preview conversion kernels
+if($$ARCHITECTURE_64_BIT) {
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_sse41.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_avx2.cpp
+
+	sse41.name = sse41
+	sse41.input = SOURCES_SSE41
+	sse41.dependency_type = TYPE_C
+	sse41.variable_out = OBJECTS
+	sse41.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	sse41.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		sse41.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		sse41.commands += -msse4.1
+		sse41.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += sse41
+
+	avx2.name = avx2
+	avx2.input = SOURCES_AVX2
+	avx2.dependency_type = TYPE_C
+	avx2.variable_out = OBJECTS
+	avx2.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	avx2.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		avx2.commands += -arch:AVX2
+		avx2.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		avx2.commands += -mavx2
+		avx2.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += avx2
+}
+
 include($${COMMON_DIRECTORY}/pro/local_quirks.pri)
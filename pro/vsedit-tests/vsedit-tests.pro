@@ -0,0 +1,242 @@
+CONFIG += qt
+CONFIG += console
+CONFIG += testcase
+
+QT += testlib
+
+HOST_64_BIT = contains(QMAKE_HOST.arch, "x86_64")
+TARGET_64_BIT = contains(QMAKE_TARGET.arch, "x86_64")
+ARCHITECTURE_64_BIT = $$HOST_64_BIT | $$TARGET_64_BIT
+
+PROJECT_DIRECTORY = ../../tests
+COMMON_DIRECTORY = ../..
+
+TARGET = vsedit-tests
+
+CONFIG(debug, debug|release) {
+
+	contains(QMAKE_COMPILER, gcc) {
+		if($$ARCHITECTURE_64_BIT) {
+			DESTDIR = $${COMMON_DIRECTORY}/build/debug-64bit-gcc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-debug-64bit-gcc
+		} else {
+			DESTDIR = $${COMMON_DIRECTORY}/build/debug-32bit-gcc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-debug-32bit-gcc
+		}
+
+		QMAKE_CXXFLAGS += -O0
+		QMAKE_CXXFLAGS += -g
+		QMAKE_CXXFLAGS += -ggdb3
+	}
+
+	contains(QMAKE_COMPILER, msvc) {
+		if($$ARCHITECTURE_64_BIT) {
+			DESTDIR = $${COMMON_DIRECTORY}/build/debug-64bit-msvc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-debug-64bit-msvc
+		} else {
+			DESTDIR = $${COMMON_DIRECTORY}/build/debug-32bit-msvc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-debug-32bit-msvc
+		}
+	}
+
+} else {
+
+	contains(QMAKE_COMPILER, gcc) {
+		if($$ARCHITECTURE_64_BIT) {
+			DESTDIR = $${COMMON_DIRECTORY}/build/release-64bit-gcc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-release-64bit-gcc
+		} else {
+			DESTDIR = $${COMMON_DIRECTORY}/build/release-32bit-gcc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-release-32bit-gcc
+		}
+
+		QMAKE_CXXFLAGS += -O2
+	}
+
+	contains(QMAKE_COMPILER, msvc) {
+		if($$ARCHITECTURE_64_BIT) {
+			DESTDIR = $${COMMON_DIRECTORY}/build/release-64bit-msvc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-release-64bit-msvc
+		} else {
+			DESTDIR = $${COMMON_DIRECTORY}/build/release-32bit-msvc
+			OBJECTS_DIR = $${PROJECT_DIRECTORY}/generated/obj-release-32bit-msvc
+		}
+	}
+
+}
+
+macx {
+	INCLUDEPATH += /usr/local/include
+}
+
+win32 {
+	INCLUDEPATH += 'C:/Program Files/VapourSynth/sdk/include/'
+}
+
+contains(QMAKE_COMPILER, clang) {
+	QMAKE_CXXFLAGS += -stdlib=libc++
+}
+
+contains(QMAKE_COMPILER, gcc) {
+	QMAKE_CXXFLAGS += -std=c++17
+	QMAKE_CXXFLAGS += -Wall
+	QMAKE_CXXFLAGS += -Wextra
+	QMAKE_CXXFLAGS += -Wredundant-decls
+	QMAKE_CXXFLAGS += -Wshadow
+	QMAKE_CXXFLAGS += -pedantic
+
+	LIBS += -L$$[QT_INSTALL_LIBS]
+} else {
+	CONFIG += c++17
+}
+
+TEMPLATE = app
+
+include($${COMMON_DIRECTORY}/pro/common.pri)
+
+QMAKE_TARGET_PRODUCT = 'VapourSynth Editor Tests'
+QMAKE_TARGET_DESCRIPTION = 'VapourSynth Editor Tests'
+
+MOC_DIR = $${PROJECT_DIRECTORY}/generated/moc
+
+HEADERS += $${COMMON_DIRECTORY}/common-src/chrono.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/helpers.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/helpers_vs.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/timeline_slider/frame_markers.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/p2p.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/p2p_api.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/cpuinfo_x86.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/p2p_simd.h
+
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_ticket_index_benchmark.h
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_reorder_buffer_test.h
+HEADERS += $${PROJECT_DIRECTORY}/src/frame_markers_test.h
+HEADERS += $${PROJECT_DIRECTORY}/src/in_flight_window_test.h
+HEADERS += $${PROJECT_DIRECTORY}/src/simd_kernels_test.h
+HEADERS += $${PROJECT_DIRECTORY}/src/yuv_to_rgb_benchmark.h
+
+SOURCES += $${COMMON_DIRECTORY}/common-src/helpers.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_processor_structures.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/timeline_slider/frame_markers.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.cpp
+
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_ticket_index_benchmark.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_reorder_buffer_test.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/frame_markers_test.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/in_flight_window_test.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/simd_kernels_test.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/yuv_to_rgb_benchmark.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/main.cpp
+
+# libp2p
+SOURCES_P2P += $${COMMON_DIRECTORY}/common-src/libp2p/p2p_api.cpp
+SOURCES_P2P += $${COMMON_DIRECTORY}/common-src/libp2p/v210.cpp
+SOURCES_P2P += $${COMMON_DIRECTORY}/common-src/libp2p/simd/cpuinfo_x86.cpp
+SOURCES_P2P += $${COMMON_DIRECTORY}/common-src/libp2p/simd/p2p_simd.cpp
+if($$ARCHITECTURE_64_BIT) {
+	SOURCES_P2P_SSE41 += $${COMMON_DIRECTORY}/common-src/libp2p/simd/p2p_sse41.cpp
+}
+
+p2p.name = p2p
+p2p.input = SOURCES_P2P
+p2p.dependency_type = TYPE_C
+p2p.variable_out = OBJECTS
+p2p.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+p2p.commands = $${QMAKE_CXX} $(CXXFLAGS) -DP2P_SIMD $(INCPATH) -c ${QMAKE_FILE_IN}
+contains(QMAKE_COMPILER, msvc) {
+	p2p.commands += -Fo${QMAKE_FILE_OUT}
+} else {
+	p2p.commands += -o ${QMAKE_FILE_OUT}
+	p2p.commands += -std=c++14
+	p2p.commands += -Wno-missing-field-initializers
+}
+macx {
+	p2p.commands += -Wno-gnu
+}
+QMAKE_EXTRA_COMPILERS += p2p
+
+if($$ARCHITECTURE_64_BIT) {
+	p2p_sse41.name = p2p_sse41
+	p2p_sse41.input = SOURCES_P2P_SSE41
+	p2p_sse41.dependency_type = TYPE_C
+	p2p_sse41.variable_out = OBJECTS
+	p2p_sse41.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	p2p_sse41.commands = $${QMAKE_CXX} $(CXXFLAGS) -DP2P_SIMD $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		p2p_sse41.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		p2p_sse41.commands += -msse4.1
+		p2p_sse41.commands += -o ${QMAKE_FILE_OUT}
+		p2p_sse41.commands += -std=c++14
+		p2p_sse41.commands += -Wno-missing-field-initializers
+	}
+}
+macx {
+	p2p_sse41.commands += -Wno-gnu
+}
+if($$ARCHITECTURE_64_BIT) {
+	QMAKE_EXTRA_COMPILERS += p2p_sse41
+}
+
+# SIMD kernels
+if($$ARCHITECTURE_64_BIT) {
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_sse41.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_avx2.cpp
+
+	sse41.name = sse41
+	sse41.input = SOURCES_SSE41
+	sse41.dependency_type = TYPE_C
+	sse41.variable_out = OBJECTS
+	sse41.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	sse41.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		sse41.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		sse41.commands += -msse4.1
+		sse41.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += sse41
+
+	avx2.name = avx2
+	avx2.input = SOURCES_AVX2
+	avx2.dependency_type = TYPE_C
+	avx2.variable_out = OBJECTS
+	avx2.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	avx2.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		avx2.commands += -arch:AVX2
+		avx2.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		avx2.commands += -mavx2
+		avx2.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += avx2
+}
+
+include($${COMMON_DIRECTORY}/pro/local_quirks.pri)
@@ -176,6 +176,7 @@ FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/benchmark_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/frame_consumers/encode_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.ui
 FORMS += $${PROJECT_DIRECTORY}/src/main_window.ui
+FORMS += $${PROJECT_DIRECTORY}/src/vapoursynth/node_timing_dialog.ui
 
 HEADERS += $${COMMON_DIRECTORY}/common-src/helpers.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/helpers_vs.h
@@ -208,6 +209,22 @@ HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/cpuinfo_x86.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/libp2p/simd/p2p_simd.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.h
 HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_set_matrix.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_completion_queue.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_pool.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_evaluation.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_resources.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_kernel.h
+HEADERS += $${COMMON_DIRECTORY}/common-src/timeline_slider/frame_markers.h
 
 HEADERS += $${PROJECT_DIRECTORY}/src/settings/actions_hotkey_edit_model.h
 HEADERS += $${PROJECT_DIRECTORY}/src/settings/clearable_key_sequence_editor.h
@@ -234,6 +251,21 @@ HEADERS += $${PROJECT_DIRECTORY}/src/frame_consumers/encode_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_templates/drop_file_category_model.h
 HEADERS += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.h
 HEADERS += $${PROJECT_DIRECTORY}/src/main_window.h
+HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/node_timing_dialog.h
+HEADERS += $${PROJECT_DIRECTORY}/src/vapoursynth/script_loading_dialog.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/preview_frame_cache.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/playback_statistics.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/preview_frame_widget.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/compare_image.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/scopes_worker.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/scopes_panel.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/snapshot_encoder.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/batch_snapshot_exporter.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/marker_scanner.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/compare_metrics_exporter.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/thumbnail_strip.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/thumbnail_cache.h
+HEADERS += $${PROJECT_DIRECTORY}/src/preview/thumbnail_loader.h
 
 SOURCES += $${COMMON_DIRECTORY}/common-src/helpers.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/version_info.cpp
@@ -260,6 +292,18 @@ SOURCES += $${COMMON_DIRECTORY}/common-src/jobs/job_variables.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/timeline_slider/timeline_slider.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_pack_rgb.cpp
 SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_set_matrix.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_completion_queue.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_in_flight_window.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_pool.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_script_evaluation.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_core_resources.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_reorder_buffer.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_simd.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats.cpp
+SOURCES += $${COMMON_DIRECTORY}/common-src/timeline_slider/frame_markers.cpp
 
 SOURCES += $${PROJECT_DIRECTORY}/src/settings/actions_hotkey_edit_model.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/settings/clearable_key_sequence_editor.cpp
@@ -287,6 +331,21 @@ SOURCES += $${PROJECT_DIRECTORY}/src/script_templates/drop_file_category_model.c
 SOURCES += $${PROJECT_DIRECTORY}/src/script_templates/templates_dialog.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/main_window.cpp
 SOURCES += $${PROJECT_DIRECTORY}/src/main.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/node_timing_dialog.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/vapoursynth/script_loading_dialog.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/preview_frame_cache.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/playback_statistics.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/preview_frame_widget.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/compare_image.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/scopes_worker.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/scopes_panel.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/snapshot_encoder.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/batch_snapshot_exporter.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/marker_scanner.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/compare_metrics_exporter.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/thumbnail_strip.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/thumbnail_cache.cpp
+SOURCES += $${PROJECT_DIRECTORY}/src/preview/thumbnail_loader.cpp
 
 # libp2p
 SOURCES_P2P += $${COMMON_DIRECTORY}/common-src/libp2p/p2p_api.cpp
@@ -338,4 +397,45 @@ if($$ARCHITECTURE_64_BIT) {
 	QMAKE_EXTRA_COMPILERS += p2p_sse41
 }
 
+# Preview conversion kernels
+if($$ARCHITECTURE_64_BIT) {
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_sse41.cpp
+	SOURCES_SSE41 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_sse41.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_yuv_to_rgb_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_frame_metrics_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_scopes_avx2.cpp
+	SOURCES_AVX2 += $${COMMON_DIRECTORY}/common-src/vapoursynth/vs_region_stats_avx2.cpp
+
+	sse41.name = sse41
+	sse41.input = SOURCES_SSE41
+	sse41.dependency_type = TYPE_C
+	sse41.variable_out = OBJECTS
+	sse41.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	sse41.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		sse41.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		sse41.commands += -msse4.1
+		sse41.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += sse41
+
+	avx2.name = avx2
+	avx2.input = SOURCES_AVX2
+	avx2.dependency_type = TYPE_C
+	avx2.variable_out = OBJECTS
+	avx2.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+	avx2.commands = $${QMAKE_CXX} $(CXXFLAGS) $(INCPATH) -c ${QMAKE_FILE_IN}
+	contains(QMAKE_COMPILER, msvc) {
+		avx2.commands += -arch:AVX2
+		avx2.commands += -Fo${QMAKE_FILE_OUT}
+	} else {
+		avx2.commands += -mavx2
+		avx2.commands += -o ${QMAKE_FILE_OUT}
+	}
+	QMAKE_EXTRA_COMPILERS += avx2
+}
+
 include($${COMMON_DIRECTORY}/pro/local_quirks.pri)
@@ -0,0 +1,176 @@
+#include "frame_markers_test.h"
+
+#include "../../common-src/timeline_slider/frame_markers.h"
+
+#include <QTest>
+
+//==============================================================================
+
+void FrameMarkersTest::setScannedCounts()
+{
+	FrameMarkers markers;
+	markers.reset(3);
+
+	markers.setScanned(0, true);
+	markers.setScanned(1, false);
+	QCOMPARE(markers.scannedCount(), 2);
+	QCOMPARE(markers.markedCount(), 1);
+	QVERIFY(!markers.complete());
+
+	// Rescanning a frame updates its mark without counting it twice.
+	markers.setScanned(0, false);
+	markers.setScanned(1, true);
+	QCOMPARE(markers.scannedCount(), 2);
+	QCOMPARE(markers.markedCount(), 1);
+	QVERIFY(!markers.isMarked(0));
+	QVERIFY(markers.isMarked(1));
+
+	markers.setScanned(2, false);
+	QVERIFY(markers.complete());
+
+	markers.reset(3);
+	QCOMPARE(markers.scannedCount(), 0);
+	QCOMPARE(markers.markedCount(), 0);
+	QVERIFY(!markers.isScanned(1));
+}
+
+// END OF void FrameMarkersTest::setScannedCounts()
+//==============================================================================
+
+void FrameMarkersTest::outOfRangeIgnored()
+{
+	FrameMarkers markers;
+	markers.reset(10);
+
+	markers.setScanned(-1, true);
+	markers.setScanned(10, true);
+	QCOMPARE(markers.scannedCount(), 0);
+	QVERIFY(!markers.isScanned(-1));
+	QVERIFY(!markers.isMarked(10));
+}
+
+// END OF void FrameMarkersTest::outOfRangeIgnored()
+//==============================================================================
+
+void FrameMarkersTest::nextUnscannedAcrossWords()
+{
+	FrameMarkers markers;
+	markers.reset(200);
+	for(int i = 0; i < 130; ++i)
+		markers.setScanned(i, false);
+
+	QCOMPARE(markers.nextUnscanned(0), 130);
+	QCOMPARE(markers.nextUnscanned(-5), 130);
+	QCOMPARE(markers.nextUnscanned(150), 150);
+
+	for(int i = 130; i < 200; ++i)
+		markers.setScanned(i, false);
+	QCOMPARE(markers.nextUnscanned(0), -1);
+	QVERIFY(markers.complete());
+}
+
+// END OF void FrameMarkersTest::nextUnscannedAcrossWords()
+//==============================================================================
+
+void FrameMarkersTest::markedNeighbours()
+{
+	FrameMarkers markers;
+	markers.reset(300);
+	markers.setScanned(5, true);
+	markers.setScanned(64, true);
+	markers.setScanned(250, true);
+
+	QCOMPARE(markers.nextMarked(-1), 5);
+	QCOMPARE(markers.nextMarked(5), 64);
+	QCOMPARE(markers.nextMarked(64), 250);
+	QCOMPARE(markers.nextMarked(250), -1);
+
+	QCOMPARE(markers.previousMarked(300), 250);
+	QCOMPARE(markers.previousMarked(250), 64);
+	QCOMPARE(markers.previousMarked(64), 5);
+	QCOMPARE(markers.previousMarked(5), -1);
+}
+
+// END OF void FrameMarkersTest::markedNeighbours()
+//==============================================================================
+
+void FrameMarkersTest::countInRange()
+{
+	FrameMarkers markers;
+	markers.reset(200);
+	for(int i = 60; i < 140; ++i)
+		markers.setScanned(i, (i % 10) == 0);
+
+	int scanned = 0;
+	int marked = 0;
+	markers.countInRange(0, 199, scanned, marked);
+	QCOMPARE(scanned, 80);
+	QCOMPARE(marked, 8);
+
+	markers.countInRange(63, 64, scanned, marked);
+	QCOMPARE(scanned, 2);
+	QCOMPARE(marked, 0);
+
+	markers.countInRange(70, 70, scanned, marked);
+	QCOMPARE(scanned, 1);
+	QCOMPARE(marked, 1);
+
+	// The range is clipped to the frames.
+	markers.countInRange(-100, 1000, scanned, marked);
+	QCOMPARE(scanned, 80);
+	QCOMPARE(marked, 8);
+
+	markers.countInRange(100, 50, scanned, marked);
+	QCOMPARE(scanned, 0);
+	QCOMPARE(marked, 0);
+}
+
+// END OF void FrameMarkersTest::countInRange()
+//==============================================================================
+
+void FrameMarkersTest::runsRoundTrip()
+{
+	FrameMarkers markers;
+	markers.reset(100);
+	for(int i = 0; i < 10; ++i)
+		markers.setScanned(i, false);
+	markers.setScanned(20, true);
+	for(int i = 63; i < 66; ++i)
+		markers.setScanned(i, true);
+	markers.setScanned(99, false);
+
+	QCOMPARE(markers.scannedRuns(), QString("0-9,20,63-65,99"));
+	QCOMPARE(markers.markedRuns(), QString("20,63-65"));
+
+	FrameMarkers loaded;
+	loaded.reset(100);
+	QVERIFY(loaded.setScannedRuns(markers.scannedRuns()));
+	QVERIFY(loaded.setMarkedRuns(markers.markedRuns()));
+	QCOMPARE(loaded.scannedCount(), markers.scannedCount());
+	QCOMPARE(loaded.markedCount(), markers.markedCount());
+	QCOMPARE(loaded.nextUnscanned(0), 10);
+	QCOMPARE(loaded.nextMarked(20), 63);
+
+	QVERIFY(loaded.setMarkedRuns(QString()));
+	QCOMPARE(loaded.markedCount(), 0);
+}
+
+// END OF void FrameMarkersTest::runsRoundTrip()
+//==============================================================================
+
+void FrameMarkersTest::malformedRunsRejected()
+{
+	FrameMarkers markers;
+	markers.reset(50);
+
+	QVERIFY(!markers.setScannedRuns("1-2-3"));
+	QVERIFY(!markers.setScannedRuns("a"));
+	QVERIFY(!markers.setScannedRuns("5-x"));
+	QVERIFY(!markers.setScannedRuns("9-3"));
+	QVERIFY(!markers.setScannedRuns("40-50"));
+	QVERIFY(markers.setScannedRuns("40-49"));
+	QCOMPARE(markers.scannedCount(), 10);
+}
+
+// END OF void FrameMarkersTest::malformedRunsRejected()
+//==============================================================================
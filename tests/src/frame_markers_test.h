@@ -0,0 +1,31 @@
+#ifndef FRAME_MARKERS_TEST_H_INCLUDED
+#define FRAME_MARKERS_TEST_H_INCLUDED
+
+#include <QObject>
+
+//==============================================================================
+
+class FrameMarkersTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void setScannedCounts();
+
+	void outOfRangeIgnored();
+
+	void nextUnscannedAcrossWords();
+
+	void markedNeighbours();
+
+	void countInRange();
+
+	void runsRoundTrip();
+
+	void malformedRunsRejected();
+};
+
+//==============================================================================
+
+#endif // FRAME_MARKERS_TEST_H_INCLUDED
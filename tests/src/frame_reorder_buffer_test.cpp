@@ -0,0 +1,305 @@
+#include "frame_reorder_buffer_test.h"
+
+#include "../../common-src/vapoursynth/vs_frame_reorder_buffer.h"
+
+#include <QTest>
+#include <vector>
+
+//==============================================================================
+
+namespace
+{
+
+// The buffer only passes the frames around and frees them, so any distinct
+// addresses do for frames.
+char g_frameStorage[64];
+
+std::vector<const VSFrame *> g_freedFrames;
+
+const VSFrame * outputFrame(int a_frameNumber)
+{
+	return reinterpret_cast<const VSFrame *>(&g_frameStorage[a_frameNumber]);
+}
+
+const VSFrame * previewFrame(int a_frameNumber)
+{
+	return reinterpret_cast<const VSFrame *>(
+		&g_frameStorage[32 + a_frameNumber]);
+}
+
+Frame arrivedFrame(int a_frameNumber)
+{
+	return Frame(a_frameNumber, 0, outputFrame(a_frameNumber),
+		previewFrame(a_frameNumber));
+}
+
+void VS_CC freeFrame(const VSFrame * a_cpFrame)
+{
+	if(a_cpFrame)
+		g_freedFrames.push_back(a_cpFrame);
+}
+
+const VSAPI * vsapi()
+{
+	static VSAPI api = {};
+	api.freeFrame = freeFrame;
+	return &api;
+}
+
+bool freed(const VSFrame * a_cpFrame)
+{
+	for(const VSFrame * cpFrame : g_freedFrames)
+	{
+		if(cpFrame == a_cpFrame)
+			return true;
+	}
+	return false;
+}
+
+}
+
+//==============================================================================
+
+void FrameReorderBufferTest::init()
+{
+	g_freedFrames.clear();
+}
+
+// END OF void FrameReorderBufferTest::init()
+//==============================================================================
+
+void FrameReorderBufferTest::reserveInSequence()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(3, 10);
+
+	QCOMPARE(buffer.capacity(), (size_t)3);
+	QCOMPARE(buffer.nextFrame(), 10);
+	QCOMPARE(buffer.reserveNext(), 10);
+	QCOMPARE(buffer.reserveNext(), 11);
+	QCOMPARE(buffer.reserveNext(), 12);
+	QVERIFY(!buffer.canReserve());
+	QCOMPARE(buffer.reserveNext(), -1);
+	QCOMPARE(buffer.reserved(), (size_t)3);
+	QVERIFY(buffer.empty());
+}
+
+// END OF void FrameReorderBufferTest::reserveInSequence()
+//==============================================================================
+
+void FrameReorderBufferTest::outOfOrderPut()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(4, 0);
+	for(int i = 0; i < 4; ++i)
+		buffer.reserveNext();
+
+	QVERIFY(buffer.put(arrivedFrame(2)));
+	QVERIFY(buffer.put(arrivedFrame(3)));
+	QVERIFY(buffer.put(arrivedFrame(1)));
+	QCOMPARE(buffer.size(), (size_t)3);
+	QVERIFY(buffer.front() == nullptr);
+
+	QVERIFY(buffer.put(arrivedFrame(0)));
+	Frame frame(-1, -1, nullptr);
+	for(int i = 0; i < 4; ++i)
+	{
+		QVERIFY(buffer.front() != nullptr);
+		QCOMPARE(buffer.front()->number, i);
+		QVERIFY(buffer.takeFront(frame));
+		QCOMPARE(frame.number, i);
+		QVERIFY(frame.cpOutputFrame == outputFrame(i));
+		QVERIFY(frame.cpPreviewFrame == previewFrame(i));
+	}
+
+	QVERIFY(buffer.empty());
+	QCOMPARE(buffer.reserved(), (size_t)0);
+	QCOMPARE(buffer.nextFrame(), 4);
+	QVERIFY(!buffer.takeFront(frame));
+	// Taken frames belong to the caller.
+	QVERIFY(g_freedFrames.empty());
+}
+
+// END OF void FrameReorderBufferTest::outOfOrderPut()
+//==============================================================================
+
+void FrameReorderBufferTest::rejectUnreserved()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(4, 5);
+	buffer.reserveNext();
+	buffer.reserveNext();
+
+	// Behind the window, past the reserved frames and without a frame.
+	QVERIFY(!buffer.put(arrivedFrame(4)));
+	QVERIFY(!buffer.put(arrivedFrame(7)));
+	QVERIFY(!buffer.put(Frame(5, 0, nullptr)));
+
+	QVERIFY(buffer.put(arrivedFrame(6)));
+	QVERIFY(!buffer.fits(6));
+	QVERIFY(!buffer.put(arrivedFrame(6)));
+	QCOMPARE(buffer.size(), (size_t)1);
+}
+
+// END OF void FrameReorderBufferTest::rejectUnreserved()
+//==============================================================================
+
+void FrameReorderBufferTest::gapHoldsFront()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(4, 0);
+	for(int i = 0; i < 4; ++i)
+		buffer.reserveNext();
+
+	QVERIFY(buffer.put(arrivedFrame(0)));
+	QVERIFY(buffer.put(arrivedFrame(2)));
+	QVERIFY(buffer.put(arrivedFrame(3)));
+
+	Frame frame(-1, -1, nullptr);
+	QVERIFY(buffer.takeFront(frame));
+	QCOMPARE(frame.number, 0);
+
+	// Frame 1 is missing, so the later ones wait for it.
+	QVERIFY(buffer.front() == nullptr);
+	QVERIFY(!buffer.takeFront(frame));
+	QCOMPARE(buffer.nextFrame(), 1);
+	QCOMPARE(buffer.size(), (size_t)2);
+
+	// The freed slot can be reserved while waiting.
+	QCOMPARE(buffer.reserveNext(), 4);
+
+	QVERIFY(buffer.put(arrivedFrame(1)));
+	for(int i = 1; i < 4; ++i)
+	{
+		QVERIFY(buffer.takeFront(frame));
+		QCOMPARE(frame.number, i);
+	}
+	QVERIFY(buffer.front() == nullptr);
+	QVERIFY(buffer.fits(4));
+}
+
+// END OF void FrameReorderBufferTest::gapHoldsFront()
+//==============================================================================
+
+void FrameReorderBufferTest::dropMissingFront()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(3, 0);
+	for(int i = 0; i < 3; ++i)
+		buffer.reserveNext();
+
+	QVERIFY(buffer.put(arrivedFrame(1)));
+	buffer.dropFront(vsapi());
+
+	QCOMPARE(buffer.nextFrame(), 1);
+	QCOMPARE(buffer.reserved(), (size_t)2);
+	QVERIFY(g_freedFrames.empty());
+	QVERIFY(buffer.front() != nullptr);
+	QCOMPARE(buffer.front()->number, 1);
+
+	// The skipped frame is not accepted when it comes late.
+	QVERIFY(!buffer.fits(0));
+	QVERIFY(!buffer.put(arrivedFrame(0)));
+}
+
+// END OF void FrameReorderBufferTest::dropMissingFront()
+//==============================================================================
+
+void FrameReorderBufferTest::dropArrivedFront()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(2, 0);
+	buffer.reserveNext();
+	buffer.reserveNext();
+
+	QVERIFY(buffer.put(arrivedFrame(0)));
+	buffer.dropFront(vsapi());
+
+	QCOMPARE(g_freedFrames.size(), (size_t)2);
+	QVERIFY(freed(outputFrame(0)));
+	QVERIFY(freed(previewFrame(0)));
+	QVERIFY(buffer.empty());
+	QCOMPARE(buffer.nextFrame(), 1);
+}
+
+// END OF void FrameReorderBufferTest::dropArrivedFront()
+//==============================================================================
+
+void FrameReorderBufferTest::clearFlushes()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(4, 0);
+	for(int i = 0; i < 4; ++i)
+		buffer.reserveNext();
+
+	QVERIFY(buffer.put(arrivedFrame(1)));
+	QVERIFY(buffer.put(arrivedFrame(3)));
+	buffer.clear(vsapi());
+
+	QVERIFY(buffer.empty());
+	QCOMPARE(buffer.reserved(), (size_t)0);
+	QCOMPARE(g_freedFrames.size(), (size_t)4);
+	QVERIFY(freed(outputFrame(1)));
+	QVERIFY(freed(previewFrame(1)));
+	QVERIFY(freed(outputFrame(3)));
+	QVERIFY(freed(previewFrame(3)));
+
+	// The window stays, but the frames still in process are not accepted.
+	QCOMPARE(buffer.nextFrame(), 0);
+	QVERIFY(buffer.front() == nullptr);
+	QVERIFY(!buffer.put(arrivedFrame(0)));
+	QVERIFY(!buffer.put(arrivedFrame(2)));
+
+	// Reserving starts over from the next frame.
+	QCOMPARE(buffer.reserveNext(), 0);
+	QVERIFY(buffer.put(arrivedFrame(0)));
+	QCOMPARE(buffer.front()->number, 0);
+}
+
+// END OF void FrameReorderBufferTest::clearFlushes()
+//==============================================================================
+
+void FrameReorderBufferTest::wrapAround()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(3, 4, 6);
+
+	QCOMPARE(buffer.reserveNext(), 4);
+	QCOMPARE(buffer.reserveNext(), 5);
+	QCOMPARE(buffer.reserveNext(), 0);
+
+	// Frame numbers past the end of the clip never fit.
+	QVERIFY(!buffer.put(arrivedFrame(6)));
+
+	QVERIFY(buffer.put(arrivedFrame(0)));
+	QVERIFY(buffer.put(arrivedFrame(5)));
+	QVERIFY(buffer.front() == nullptr);
+	QVERIFY(buffer.put(arrivedFrame(4)));
+
+	Frame frame(-1, -1, nullptr);
+	const int expected[] = {4, 5, 0};
+	for(int frameNumber : expected)
+	{
+		QVERIFY(buffer.takeFront(frame));
+		QCOMPARE(frame.number, frameNumber);
+	}
+	QCOMPARE(buffer.nextFrame(), 1);
+	QCOMPARE(buffer.reserveNext(), 1);
+}
+
+// END OF void FrameReorderBufferTest::wrapAround()
+//==============================================================================
+
+void FrameReorderBufferTest::capacityClampedToClip()
+{
+	FrameReorderBuffer buffer;
+	buffer.reset(8, 0, 3);
+
+	QCOMPARE(buffer.capacity(), (size_t)3);
+	for(int i = 0; i < 3; ++i)
+		QCOMPARE(buffer.reserveNext(), i);
+	QCOMPARE(buffer.reserveNext(), -1);
+}
+
+// END OF void FrameReorderBufferTest::capacityClampedToClip()
+//==============================================================================
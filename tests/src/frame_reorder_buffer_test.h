@@ -0,0 +1,37 @@
+#ifndef FRAME_REORDER_BUFFER_TEST_H_INCLUDED
+#define FRAME_REORDER_BUFFER_TEST_H_INCLUDED
+
+#include <QObject>
+
+//==============================================================================
+
+class FrameReorderBufferTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void init();
+
+	void reserveInSequence();
+
+	void outOfOrderPut();
+
+	void rejectUnreserved();
+
+	void gapHoldsFront();
+
+	void dropMissingFront();
+
+	void dropArrivedFront();
+
+	void clearFlushes();
+
+	void wrapAround();
+
+	void capacityClampedToClip();
+};
+
+//==============================================================================
+
+#endif // FRAME_REORDER_BUFFER_TEST_H_INCLUDED
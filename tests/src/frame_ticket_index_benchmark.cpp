@@ -0,0 +1,195 @@
+#include "frame_ticket_index_benchmark.h"
+
+#include "../../common-src/vapoursynth/vs_script_processor_structures.h"
+
+#include <QTest>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+
+//==============================================================================
+
+namespace
+{
+
+// Outputs the tickets are spread over, as with a compare view.
+const int OUTPUTS = 4;
+
+// Picks the frames that complete or are requested next in an order
+// that does not follow the order of the tickets.
+int nextFrame(uint32_t & a_state, int a_frames)
+{
+	a_state = a_state * 1664525u + 1013904223u;
+	return (int)((a_state >> 8) % (uint32_t)a_frames);
+}
+
+// Never dereferenced, only told apart.
+VSNode * fakeNode(int a_outputIndex)
+{
+	return reinterpret_cast<VSNode *>((uintptr_t)(a_outputIndex + 1) * 64);
+}
+
+// Adds the ticket and indexes it the way the processor dispatches it.
+void dispatch(FrameTicketList & a_tickets, FrameTicketIndex & a_index,
+	int a_frameNumber)
+{
+	int outputIndex = a_frameNumber % OUTPUTS;
+	FrameTicketList::iterator it = a_tickets.insert(a_tickets.end(),
+		FrameTicket(a_frameNumber, outputIndex, fakeNode(outputIndex)));
+	indexFrameTicket(a_index, it->pOutputNode, it);
+}
+
+void dispatch(FrameTicketList & a_tickets, FrameTicketIndex & a_index,
+	int a_first, int a_count)
+{
+	for(int i = a_first; i < a_first + a_count; ++i)
+		dispatch(a_tickets, a_index, i);
+}
+
+void addInFlightRows()
+{
+	QTest::addColumn<int>("inFlight");
+	for(int inFlight : {8, 64, 512, 4096})
+		QTest::newRow(QByteArray::number(inFlight).constData()) << inFlight;
+}
+
+}
+
+//==============================================================================
+
+void FrameTicketIndexBenchmark::completion_data()
+{
+	addInFlightRows();
+}
+
+// END OF void FrameTicketIndexBenchmark::completion_data()
+//==============================================================================
+
+void FrameTicketIndexBenchmark::completion()
+{
+	QFETCH(int, inFlight);
+
+	FrameTicketList tickets;
+	FrameTicketIndex index;
+	dispatch(tickets, index, 0, inFlight);
+
+	FrameTicketList queue;
+	FrameTicketIndex queuedIndex;
+
+	// Frames complete out of order. Each completed frame is requested
+	// again, queued and dispatched, so the number in flight stays the same.
+	uint32_t state = 0;
+	QBENCHMARK
+	{
+		int frame = nextFrame(state, inFlight);
+		FrameTicketList::iterator it;
+		QVERIFY(takeIndexedFrameTicket(index,
+			fakeNode(frame % OUTPUTS), frame, it));
+		tickets.erase(it);
+
+		dispatch(queue, queuedIndex, frame);
+		QVERIFY(unindexFrameTicket(queuedIndex, queue.front().pOutputNode,
+			queue.begin()));
+		tickets.splice(tickets.end(), queue, queue.begin());
+		indexFrameTicket(index, tickets.back().pOutputNode,
+			std::prev(tickets.end()));
+	}
+
+	QCOMPARE(tickets.size(), (size_t)inFlight);
+	QCOMPARE(index.size(), (size_t)inFlight);
+	QVERIFY(queuedIndex.empty());
+}
+
+// END OF void FrameTicketIndexBenchmark::completion()
+//==============================================================================
+
+void FrameTicketIndexBenchmark::completionByScan_data()
+{
+	addInFlightRows();
+}
+
+// END OF void FrameTicketIndexBenchmark::completionByScan_data()
+//==============================================================================
+
+void FrameTicketIndexBenchmark::completionByScan()
+{
+	QFETCH(int, inFlight);
+
+	FrameTicketList tickets;
+	FrameTicketIndex index;
+	dispatch(tickets, index, 0, inFlight);
+
+	// The same completions found by walking the tickets, for comparison.
+	uint32_t state = 0;
+	QBENCHMARK
+	{
+		int frame = nextFrame(state, inFlight);
+		int outputIndex = frame % OUTPUTS;
+		const VSNode * pNode = fakeNode(outputIndex);
+		FrameTicketList::iterator it = std::find_if(tickets.begin(),
+			tickets.end(), [&](const FrameTicket & a_ticket)
+			{
+				return (a_ticket.pOutputNode == pNode) &&
+					(a_ticket.frameNumber == frame);
+			});
+		QVERIFY(it != tickets.end());
+		tickets.erase(it);
+
+		tickets.insert(tickets.end(),
+			FrameTicket(frame, outputIndex, fakeNode(outputIndex)));
+	}
+
+	QCOMPARE(tickets.size(), (size_t)inFlight);
+}
+
+// END OF void FrameTicketIndexBenchmark::completionByScan()
+//==============================================================================
+
+void FrameTicketIndexBenchmark::coalescing_data()
+{
+	addInFlightRows();
+}
+
+// END OF void FrameTicketIndexBenchmark::coalescing_data()
+//==============================================================================
+
+void FrameTicketIndexBenchmark::coalescing()
+{
+	QFETCH(int, inFlight);
+
+	FrameTicketList tickets;
+	FrameTicketIndex index;
+	dispatch(tickets, index, 0, inFlight);
+
+	FrameTicketList queue;
+	FrameTicketIndex queuedIndex;
+	dispatch(queue, queuedIndex, inFlight, inFlight);
+
+	// Requests for frames in flight merge into their tickets, then into
+	// the queued ones, as the processor coalesces them. The others miss
+	// both indexes and would be queued.
+	uint32_t state = 0;
+	QBENCHMARK
+	{
+		int frame = nextFrame(state, inFlight * 3);
+		int outputIndex = frame % OUTPUTS;
+		const VSNode * pNode = fakeNode(outputIndex);
+		FrameTicketList::iterator it;
+		if(findIndexedFrameTicket(index, pNode, frame, outputIndex, it) ||
+			findIndexedFrameTicket(queuedIndex, pNode, frame, outputIndex,
+			it))
+			it->subscribers++;
+	}
+
+	FrameTicketList::iterator it;
+	QVERIFY(findIndexedFrameTicket(index, fakeNode(0), 0, 0, it));
+	QVERIFY(findIndexedFrameTicket(queuedIndex, fakeNode(inFlight % OUTPUTS),
+		inFlight, inFlight % OUTPUTS, it));
+	QVERIFY(!findIndexedFrameTicket(index, fakeNode(0), 0, 1, it));
+	int missed = inFlight * 2;
+	QVERIFY(!findIndexedFrameTicket(queuedIndex,
+		fakeNode(missed % OUTPUTS), missed, missed % OUTPUTS, it));
+}
+
+// END OF void FrameTicketIndexBenchmark::coalescing()
+//==============================================================================
@@ -0,0 +1,33 @@
+#ifndef FRAME_TICKET_INDEX_BENCHMARK_H_INCLUDED
+#define FRAME_TICKET_INDEX_BENCHMARK_H_INCLUDED
+
+#include <QObject>
+
+//==============================================================================
+
+// Measures the bookkeeping of the script processor per completed frame
+// and per coalesced request against the number of frames in flight,
+// through the index functions the processor uses. The index should keep
+// both flat where a scan of the tickets grows.
+class FrameTicketIndexBenchmark : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void completion_data();
+
+	void completion();
+
+	void completionByScan_data();
+
+	void completionByScan();
+
+	void coalescing_data();
+
+	void coalescing();
+};
+
+//==============================================================================
+
+#endif // FRAME_TICKET_INDEX_BENCHMARK_H_INCLUDED
@@ -0,0 +1,174 @@
+#include "in_flight_window_test.h"
+
+#include "../../common-src/vapoursynth/vs_in_flight_window.h"
+
+#include <QTest>
+#include <chrono>
+
+//==============================================================================
+
+namespace
+{
+
+// Longer than the shortest measurement period of the controller.
+const std::chrono::milliseconds PERIOD(300);
+
+// Completes enough frames for a period to be measured and moves the time
+// on by a full period, so the tests do not wait for the clock.
+void runPeriod(InFlightWindowController & a_controller, hr_time_point & a_now,
+	bool a_saturated)
+{
+	for(int i = 0; i < 8; ++i)
+		a_controller.frameCompleted(0.01);
+	if(a_saturated)
+		a_controller.setSaturated();
+	a_now += PERIOD;
+}
+
+}
+
+//==============================================================================
+
+void InFlightWindowTest::startsAtThreadCount()
+{
+	InFlightWindowController controller;
+	controller.reset(6, 0);
+	QCOMPARE(controller.limit(), (size_t)6);
+	QVERIFY(!controller.pinned());
+
+	controller.reset(0, 0);
+	QCOMPARE(controller.limit(), (size_t)1);
+}
+
+// END OF void InFlightWindowTest::startsAtThreadCount()
+//==============================================================================
+
+void InFlightWindowTest::pinnedLimitHolds()
+{
+	InFlightWindowController controller;
+	controller.reset(4, 10);
+	QVERIFY(controller.pinned());
+	QCOMPARE(controller.limit(), (size_t)10);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, true);
+	controller.update(1.0, now);
+	QCOMPARE(controller.limit(), (size_t)10);
+}
+
+// END OF void InFlightWindowTest::pinnedLimitHolds()
+//==============================================================================
+
+void InFlightWindowTest::shortPeriodNotMeasured()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	hr_time_point now = hr_clock::now();
+	for(int i = 0; i < 8; ++i)
+		controller.frameCompleted(0.01);
+	controller.setSaturated();
+	controller.update(1.0, now);
+	QCOMPARE(controller.limit(), (size_t)8);
+}
+
+// END OF void InFlightWindowTest::shortPeriodNotMeasured()
+//==============================================================================
+
+void InFlightWindowTest::unsaturatedPeriodNotMeasured()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, false);
+	controller.update(0.0, now);
+	QCOMPARE(controller.limit(), (size_t)8);
+}
+
+// END OF void InFlightWindowTest::unsaturatedPeriodNotMeasured()
+//==============================================================================
+
+void InFlightWindowTest::saturatedPeriodGrows()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, true);
+	controller.update(0.0, now);
+	QVERIFY(controller.limit() > 8);
+}
+
+// END OF void InFlightWindowTest::saturatedPeriodGrows()
+//==============================================================================
+
+void InFlightWindowTest::softCachePressureHolds()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, true);
+	controller.update(0.8, now);
+	QCOMPARE(controller.limit(), (size_t)8);
+}
+
+// END OF void InFlightWindowTest::softCachePressureHolds()
+//==============================================================================
+
+void InFlightWindowTest::hardCachePressureShrinks()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	// Cache pressure is measured even when the consumer is not waiting.
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, false);
+	controller.update(0.95, now);
+	QVERIFY(controller.limit() < 8);
+}
+
+// END OF void InFlightWindowTest::hardCachePressureShrinks()
+//==============================================================================
+
+void InFlightWindowTest::neverBelowOne()
+{
+	InFlightWindowController controller;
+	controller.reset(1, 0);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, true);
+	controller.update(0.95, now);
+	QCOMPARE(controller.limit(), (size_t)1);
+}
+
+// END OF void InFlightWindowTest::neverBelowOne()
+//==============================================================================
+
+void InFlightWindowTest::heldWindowProbesAgain()
+{
+	InFlightWindowController controller;
+	controller.reset(8, 0);
+
+	hr_time_point now = hr_clock::now();
+	runPeriod(controller, now, true);
+	controller.update(0.0, now);
+	QCOMPARE(controller.limit(), (size_t)9);
+
+	// The same throughput at the new depth holds the window still for a
+	// number of periods before it probes a step again.
+	for(int i = 0; i < 7; ++i)
+	{
+		runPeriod(controller, now, true);
+		controller.update(0.0, now);
+		QCOMPARE(controller.limit(), (size_t)9);
+	}
+
+	runPeriod(controller, now, true);
+	controller.update(0.0, now);
+	QCOMPARE(controller.limit(), (size_t)10);
+}
+
+// END OF void InFlightWindowTest::heldWindowProbesAgain()
+//==============================================================================
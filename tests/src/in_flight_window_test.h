@@ -0,0 +1,37 @@
+#ifndef IN_FLIGHT_WINDOW_TEST_H_INCLUDED
+#define IN_FLIGHT_WINDOW_TEST_H_INCLUDED
+
+#include <QObject>
+
+//==============================================================================
+
+// The tests give the controller the time of each update, so the
+// measurement periods pass without waiting for the clock.
+class InFlightWindowTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void startsAtThreadCount();
+
+	void pinnedLimitHolds();
+
+	void shortPeriodNotMeasured();
+
+	void unsaturatedPeriodNotMeasured();
+
+	void saturatedPeriodGrows();
+
+	void softCachePressureHolds();
+
+	void hardCachePressureShrinks();
+
+	void neverBelowOne();
+
+	void heldWindowProbesAgain();
+};
+
+//==============================================================================
+
+#endif // IN_FLIGHT_WINDOW_TEST_H_INCLUDED
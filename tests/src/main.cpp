@@ -0,0 +1,36 @@
+#include "frame_ticket_index_benchmark.h"
+#include "frame_reorder_buffer_test.h"
+#include "frame_markers_test.h"
+#include "in_flight_window_test.h"
+#include "simd_kernels_test.h"
+#include "yuv_to_rgb_benchmark.h"
+
+#include <QCoreApplication>
+#include <QTest>
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+
+	int failed = 0;
+
+	FrameTicketIndexBenchmark frameTicketIndexBenchmark;
+	failed += QTest::qExec(&frameTicketIndexBenchmark, argc, argv);
+
+	FrameReorderBufferTest frameReorderBufferTest;
+	failed += QTest::qExec(&frameReorderBufferTest, argc, argv);
+
+	FrameMarkersTest frameMarkersTest;
+	failed += QTest::qExec(&frameMarkersTest, argc, argv);
+
+	InFlightWindowTest inFlightWindowTest;
+	failed += QTest::qExec(&inFlightWindowTest, argc, argv);
+
+	SimdKernelsTest simdKernelsTest;
+	failed += QTest::qExec(&simdKernelsTest, argc, argv);
+
+	YuvToRGBBenchmark yuvToRGBBenchmark;
+	failed += QTest::qExec(&yuvToRGBBenchmark, argc, argv);
+
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,410 @@
+#include "simd_kernels_test.h"
+
+#include "../../common-src/vapoursynth/vs_simd.h"
+#include "../../common-src/vapoursynth/vs_frame_metrics_kernel.h"
+#include "../../common-src/vapoursynth/vs_region_stats_kernel.h"
+#include "../../common-src/vapoursynth/vs_yuv_to_rgb_kernel.h"
+#include "../../common-src/vapoursynth/vs_scopes_kernel.h"
+
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+//==============================================================================
+
+namespace
+{
+
+// Rows up to this wide cover a few AVX2 vectors of bytes and any remainder.
+const unsigned MAX_WIDTH = 100;
+
+// Float rows are summed in a different order by the SIMD rows.
+const double FLOAT_TOLERANCE = 1e-9;
+
+// Small linear congruential generator, so failures can be reproduced.
+uint32_t nextRandom(uint32_t & a_state)
+{
+	a_state = a_state * 1664525u + 1013904223u;
+	return a_state >> 8;
+}
+
+template <typename T>
+T randomSample(uint32_t & a_state)
+{
+	return (T)nextRandom(a_state);
+}
+
+template <>
+float randomSample<float>(uint32_t & a_state)
+{
+	return (float)(nextRandom(a_state) % 100000u) / 100000.0f;
+}
+
+template <typename T>
+std::vector<T> randomRow(uint32_t & a_state)
+{
+	std::vector<T> row(MAX_WIDTH);
+	for(T & sample : row)
+		sample = randomSample<T>(a_state);
+	return row;
+}
+
+bool closeEnough(double a_value, double a_expected)
+{
+	double scale = std::max(std::abs(a_expected), 1.0);
+	return (std::abs(a_value - a_expected) <= FLOAT_TOLERANCE * scale);
+}
+
+template <typename T>
+bool diffRowMatches(diff_row_func a_diffRow)
+{
+	uint32_t state = 12345u;
+	std::vector<T> a = randomRow<T>(state);
+	std::vector<T> b = randomRow<T>(state);
+
+	for(unsigned width = 0; width <= MAX_WIDTH; ++width)
+	{
+		double expectedSse = 0.0;
+		double expectedMax = 0.0;
+		diffRowC<T>(a.data(), b.data(), width, expectedSse, expectedMax);
+
+		double sse = 0.0;
+		double maxDiff = 0.0;
+		a_diffRow(a.data(), b.data(), width, sse, maxDiff);
+
+		if((!closeEnough(sse, expectedSse)) || (maxDiff != expectedMax))
+		{
+			qWarning("Row of %u samples differs.", width);
+			return false;
+		}
+	}
+	return true;
+}
+
+RegionSums emptySums()
+{
+	RegionSums sums = {};
+	sums.min = std::numeric_limits<double>::infinity();
+	sums.max = -std::numeric_limits<double>::infinity();
+	return sums;
+}
+
+template <typename T>
+bool regionStatsRowMatches(region_stats_row_func a_statsRow,
+	const RegionLimits & a_limits)
+{
+	uint32_t state = 12345u;
+	std::vector<T> row = randomRow<T>(state);
+
+	for(unsigned width = 0; width <= MAX_WIDTH; ++width)
+	{
+		RegionSums expected = emptySums();
+		regionStatsRowC<T>(row.data(), width, a_limits, expected);
+
+		RegionSums sums = emptySums();
+		a_statsRow(row.data(), width, a_limits, sums);
+
+		bool matches = (sums.intSum == expected.intSum) &&
+			(sums.intSumSquares == expected.intSumSquares) &&
+			closeEnough(sums.floatSum, expected.floatSum) &&
+			closeEnough(sums.floatSumSquares, expected.floatSumSquares) &&
+			(sums.min == expected.min) && (sums.max == expected.max) &&
+			(sums.low == expected.low) && (sums.high == expected.high);
+		if(!matches)
+		{
+			qWarning("Row of %u samples differs.", width);
+			return false;
+		}
+	}
+	return true;
+}
+
+// Limited range BT.709 from the given bit depth, as the filter sets it up.
+YuvToRGBCoefficients yuvToRGBCoefficients(int a_bits, bool a_rgb30)
+{
+	const double kr = 0.2126;
+	const double kb = 0.0722;
+	const double kg = 1.0 - kr - kb;
+
+	YuvToRGBCoefficients c;
+	c.outMax = a_rgb30 ? 1023.0f : 255.0f;
+	c.yScale = c.outMax / (float)(219 << (a_bits - 8));
+	c.yOffset = -(float)(16 << (a_bits - 8)) * c.yScale;
+	c.rU = 0.0f;
+	c.rV = (float)(2.0 * (1.0 - kr));
+	c.gU = (float)(-2.0 * kb * (1.0 - kb) / kg);
+	c.gV = (float)(-2.0 * kr * (1.0 - kr) / kg);
+	c.bU = (float)(2.0 * (1.0 - kb));
+	c.bV = 0.0f;
+	return c;
+}
+
+// Centered chroma in output units, reaching out of the gamut both ways,
+// so every channel is clamped at both ends somewhere in the row.
+std::vector<float> randomChromaRow(uint32_t & a_state, float a_outMax)
+{
+	std::vector<float> row(MAX_WIDTH);
+	for(float & sample : row)
+	{
+		float unit = (float)(nextRandom(a_state) % 2001u) / 1000.0f - 1.0f;
+		sample = unit * 0.6f * a_outMax;
+	}
+	return row;
+}
+
+// Chroma putting the green sums a few steps off halfway between two
+// outputs, where adding in another order would round the other way.
+template <typename T>
+std::vector<float> halfwayChromaRow(uint32_t & a_state,
+	const YuvToRGBCoefficients & a_c, const std::vector<T> & a_y,
+	const std::vector<float> & a_u)
+{
+	std::vector<float> row(MAX_WIDTH);
+	for(unsigned x = 0; x < MAX_WIDTH; ++x)
+	{
+		float luma = a_y[x] * a_c.yScale + a_c.yOffset;
+		float halfway = (float)(nextRandom(a_state) % (uint32_t)a_c.outMax)
+			+ 0.5f;
+		float sample = (halfway - luma - a_c.gU * a_u[x]) / a_c.gV;
+		int steps = (int)(nextRandom(a_state) % 9u) - 4;
+		for(; steps > 0; --steps)
+			sample = std::nextafter(sample, a_c.outMax);
+		for(; steps < 0; ++steps)
+			sample = std::nextafter(sample, -a_c.outMax);
+		row[x] = sample;
+	}
+	return row;
+}
+
+template <typename T, bool rgb30>
+bool yuvToRGBRowMatches(yuv_to_rgb_row_func a_yuvToRGBRow,
+	const std::vector<T> & a_y, const std::vector<float> & a_u,
+	const std::vector<float> & a_v, const YuvToRGBCoefficients & a_c)
+{
+	std::vector<uint32_t> expected(MAX_WIDTH);
+	std::vector<uint32_t> pixels(MAX_WIDTH);
+
+	for(unsigned width = 0; width <= MAX_WIDTH; ++width)
+	{
+		yuvToRGBRowC<T, rgb30>(a_y.data(), a_u.data(), a_v.data(),
+			expected.data(), width, a_c);
+
+		std::fill(pixels.begin(), pixels.end(), 0u);
+		a_yuvToRGBRow(a_y.data(), a_u.data(), a_v.data(), pixels.data(),
+			width, a_c);
+
+		if(!std::equal(pixels.begin(), pixels.begin() + width,
+			expected.begin()))
+		{
+			qWarning("Row of %u samples differs.", width);
+			return false;
+		}
+	}
+	return true;
+}
+
+// The rows add and round in the same order, so they must agree exactly,
+// at the clamps and on the sums that end up next to halfway alike.
+template <typename T, bool rgb30>
+bool yuvToRGBRowMatches(yuv_to_rgb_row_func a_yuvToRGBRow, int a_bits)
+{
+	const YuvToRGBCoefficients c = yuvToRGBCoefficients(a_bits, rgb30);
+
+	uint32_t state = 12345u;
+	std::vector<T> y(MAX_WIDTH);
+	for(T & sample : y)
+		sample = (T)(nextRandom(state) & ((1u << a_bits) - 1u));
+	std::vector<float> u = randomChromaRow(state, c.outMax);
+	std::vector<float> v = randomChromaRow(state, c.outMax);
+	std::vector<float> halfwayV = halfwayChromaRow(state, c, y, u);
+
+	return yuvToRGBRowMatches<T, rgb30>(a_yuvToRGBRow, y, u, v, c) &&
+		yuvToRGBRowMatches<T, rgb30>(a_yuvToRGBRow, y, u, halfwayV, c);
+}
+
+// Float samples reach past both ends of the range, and a few are not
+// finite, in the vectors of wide rows and in the remainders of short ones.
+std::vector<float> scopeFloatRow(uint32_t & a_state)
+{
+	std::vector<float> row(MAX_WIDTH);
+	for(float & sample : row)
+		sample = (float)(nextRandom(a_state) % 150000u) / 100000.0f - 0.25f;
+	row[3] = std::numeric_limits<float>::quiet_NaN();
+	row[21] = std::numeric_limits<float>::infinity();
+	row[42] = -std::numeric_limits<float>::infinity();
+	row[MAX_WIDTH - 2] = std::numeric_limits<float>::quiet_NaN();
+	return row;
+}
+
+template <typename T>
+bool scopeBinsRowMatches(scope_bins_row_func a_binsRow,
+	const std::vector<T> & a_row, const ScopeBinning & a_binning)
+{
+	std::vector<uint16_t> expected(MAX_WIDTH);
+	std::vector<uint16_t> bins(MAX_WIDTH);
+
+	for(unsigned width = 0; width <= MAX_WIDTH; ++width)
+	{
+		scopeBinsRowC<T>(a_row.data(), expected.data(), width, a_binning);
+
+		std::fill(bins.begin(), bins.end(), (uint16_t)0xFFFF);
+		a_binsRow(a_row.data(), bins.data(), width, a_binning);
+
+		if(!std::equal(bins.begin(), bins.begin() + width, expected.begin()))
+		{
+			qWarning("Row of %u samples differs.", width);
+			return false;
+		}
+	}
+	return true;
+}
+
+// Binnings as the scopes set them up, and integer ones whose samples
+// can go past the last bin.
+template <typename T>
+bool scopeBinsRowMatches(scope_bins_row_func a_binsRow)
+{
+	uint32_t state = 12345u;
+	std::vector<T> row = randomRow<T>(state);
+
+	ScopeBinning binning = {};
+	binning.maxBin = 255;
+	if(!scopeBinsRowMatches<T>(a_binsRow, row, binning))
+		return false;
+
+	binning.shift = (sizeof(T) == 1) ? 1 : 6;
+	binning.maxBin = 100;
+	return scopeBinsRowMatches<T>(a_binsRow, row, binning);
+}
+
+template <>
+bool scopeBinsRowMatches<float>(scope_bins_row_func a_binsRow)
+{
+	uint32_t state = 12345u;
+	std::vector<float> row = scopeFloatRow(state);
+
+	ScopeBinning binning = {};
+	binning.shift = -1;
+	binning.scale = 1023.0f;
+	binning.maxBin = 1023;
+	if(!scopeBinsRowMatches<float>(a_binsRow, row, binning))
+		return false;
+
+	// Chroma is centered on zero.
+	binning.offset = 0.5f;
+	binning.scale = 255.0f;
+	binning.maxBin = 255;
+	return scopeBinsRowMatches<float>(a_binsRow, row, binning);
+}
+
+}
+
+//==============================================================================
+
+void SimdKernelsTest::initTestCase()
+{
+	if(simdLevel() == SimdLevel::None)
+		QSKIP("The CPU does not support the SIMD kernels.");
+}
+
+// END OF void SimdKernelsTest::initTestCase()
+//==============================================================================
+
+void SimdKernelsTest::diffRow()
+{
+#ifdef FRAME_METRICS_X86
+	QVERIFY(diffRowMatches<uint8_t>(diffRowSSE41<uint8_t>));
+	QVERIFY(diffRowMatches<uint16_t>(diffRowSSE41<uint16_t>));
+	QVERIFY(diffRowMatches<float>(diffRowSSE41<float>));
+
+	if(simdLevel() != SimdLevel::AVX2)
+		return;
+
+	QVERIFY(diffRowMatches<uint8_t>(diffRowAVX2<uint8_t>));
+	QVERIFY(diffRowMatches<uint16_t>(diffRowAVX2<uint16_t>));
+	QVERIFY(diffRowMatches<float>(diffRowAVX2<float>));
+#endif
+}
+
+// END OF void SimdKernelsTest::diffRow()
+//==============================================================================
+
+void SimdKernelsTest::regionStatsRow()
+{
+#ifdef REGION_STATS_X86
+	const RegionLimits limits8 = {16.0, 235.0};
+	const RegionLimits limits16 = {4096.0, 60160.0};
+	const RegionLimits limitsFloat = {0.1, 0.9};
+
+	QVERIFY(regionStatsRowMatches<uint8_t>(regionStatsRowSSE41<uint8_t>,
+		limits8));
+	QVERIFY(regionStatsRowMatches<uint16_t>(regionStatsRowSSE41<uint16_t>,
+		limits16));
+	QVERIFY(regionStatsRowMatches<float>(regionStatsRowSSE41<float>,
+		limitsFloat));
+
+	if(simdLevel() != SimdLevel::AVX2)
+		return;
+
+	QVERIFY(regionStatsRowMatches<uint8_t>(regionStatsRowAVX2<uint8_t>,
+		limits8));
+	QVERIFY(regionStatsRowMatches<uint16_t>(regionStatsRowAVX2<uint16_t>,
+		limits16));
+	QVERIFY(regionStatsRowMatches<float>(regionStatsRowAVX2<float>,
+		limitsFloat));
+#endif
+}
+
+// END OF void SimdKernelsTest::regionStatsRow()
+//==============================================================================
+
+void SimdKernelsTest::yuvToRGBRow()
+{
+#ifdef YUV_TO_RGB_X86
+	QVERIFY((yuvToRGBRowMatches<uint8_t, false>(
+		yuvToRGBRowSSE41<uint8_t, false>, 8)));
+	QVERIFY((yuvToRGBRowMatches<uint8_t, true>(
+		yuvToRGBRowSSE41<uint8_t, true>, 8)));
+	QVERIFY((yuvToRGBRowMatches<uint16_t, false>(
+		yuvToRGBRowSSE41<uint16_t, false>, 10)));
+	QVERIFY((yuvToRGBRowMatches<uint16_t, true>(
+		yuvToRGBRowSSE41<uint16_t, true>, 10)));
+
+	if(simdLevel() != SimdLevel::AVX2)
+		return;
+
+	QVERIFY((yuvToRGBRowMatches<uint8_t, false>(
+		yuvToRGBRowAVX2<uint8_t, false>, 8)));
+	QVERIFY((yuvToRGBRowMatches<uint8_t, true>(
+		yuvToRGBRowAVX2<uint8_t, true>, 8)));
+	QVERIFY((yuvToRGBRowMatches<uint16_t, false>(
+		yuvToRGBRowAVX2<uint16_t, false>, 10)));
+	QVERIFY((yuvToRGBRowMatches<uint16_t, true>(
+		yuvToRGBRowAVX2<uint16_t, true>, 10)));
+#endif
+}
+
+// END OF void SimdKernelsTest::yuvToRGBRow()
+//==============================================================================
+
+void SimdKernelsTest::scopeBinsRow()
+{
+#ifdef SCOPES_X86
+	QVERIFY(scopeBinsRowMatches<uint8_t>(scopeBinsRowSSE41<uint8_t>));
+	QVERIFY(scopeBinsRowMatches<uint16_t>(scopeBinsRowSSE41<uint16_t>));
+	QVERIFY(scopeBinsRowMatches<float>(scopeBinsRowSSE41<float>));
+
+	if(simdLevel() != SimdLevel::AVX2)
+		return;
+
+	QVERIFY(scopeBinsRowMatches<uint8_t>(scopeBinsRowAVX2<uint8_t>));
+	QVERIFY(scopeBinsRowMatches<uint16_t>(scopeBinsRowAVX2<uint16_t>));
+	QVERIFY(scopeBinsRowMatches<float>(scopeBinsRowAVX2<float>));
+#endif
+}
+
+// END OF void SimdKernelsTest::scopeBinsRow()
+//==============================================================================
@@ -0,0 +1,29 @@
+#ifndef SIMD_KERNELS_TEST_H_INCLUDED
+#define SIMD_KERNELS_TEST_H_INCLUDED
+
+#include <QObject>
+
+//==============================================================================
+
+// Checks the SIMD rows the CPU supports against the C rows on rows of
+// every width up to a few vectors, so the remainders are covered too.
+class SimdKernelsTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void initTestCase();
+
+	void diffRow();
+
+	void regionStatsRow();
+
+	void yuvToRGBRow();
+
+	void scopeBinsRow();
+};
+
+//==============================================================================
+
+#endif // SIMD_KERNELS_TEST_H_INCLUDED
@@ -0,0 +1,358 @@
+#include "yuv_to_rgb_benchmark.h"
+
+#include "../../common-src/vapoursynth/vs_simd.h"
+#include "../../common-src/vapoursynth/vs_yuv_to_rgb.h"
+#include "../../common-src/vapoursynth/vs_yuv_to_rgb_kernel.h"
+#include "../../common-src/vapoursynth/vs_pack_rgb.h"
+
+#include <vapoursynth/VSScript4.h>
+#include <vapoursynth/VSConstants4.h>
+
+#include <QTest>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+
+namespace
+{
+
+typedef const VSSCRIPTAPI * (VS_CC * FNP_getVSSAPI)(int);
+
+// Long enough for no benchmark to request a frame twice.
+const int SOURCE_LENGTH = 1 << 20;
+
+struct FrameSize
+{
+	const char * name;
+	int width;
+	int height;
+};
+
+const FrameSize FRAME_SIZES[] = {
+	{"1080p", 1920, 1080},
+	{"2160p", 3840, 2160},
+};
+
+void addFrameRows()
+{
+	QTest::addColumn<int>("width");
+	QTest::addColumn<int>("height");
+	QTest::addColumn<int>("bits");
+	for(const FrameSize & size : FRAME_SIZES)
+	{
+		for(int bits : {8, 10})
+		{
+			QByteArray name = QByteArray(size.name) + " " +
+				QByteArray::number(bits) + " bit";
+			QTest::newRow(name.constData()) << size.width << size.height <<
+				bits;
+		}
+	}
+}
+
+// Limited range BT.709 from 8 bits to RGB24.
+YuvToRGBCoefficients coefficients()
+{
+	YuvToRGBCoefficients c;
+	c.outMax = 255.0f;
+	c.yScale = c.outMax / 219.0f;
+	c.yOffset = -16.0f * c.yScale;
+	c.rU = 0.0f;
+	c.rV = 1.5748f;
+	c.gU = -0.187324f;
+	c.gV = -0.468124f;
+	c.bU = 1.8556f;
+	c.bV = 0.0f;
+	return c;
+}
+
+}
+
+//==============================================================================
+
+YuvToRGBBenchmark::YuvToRGBBenchmark(QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_cpVSAPI(nullptr)
+	, m_pCore(nullptr)
+	, m_nextFrame(0)
+{
+}
+
+// END OF YuvToRGBBenchmark::YuvToRGBBenchmark(QObject * a_pParent)
+//==============================================================================
+
+YuvToRGBBenchmark::~YuvToRGBBenchmark()
+{
+	cleanupTestCase();
+}
+
+// END OF YuvToRGBBenchmark::~YuvToRGBBenchmark()
+//==============================================================================
+
+void YuvToRGBBenchmark::initTestCase()
+{
+	m_vsScriptLibrary.setFileName(
+#ifdef Q_OS_WIN
+		"vsscript"
+#else
+		"vapoursynth-script"
+#endif // Q_OS_WIN
+	);
+	if(!m_vsScriptLibrary.load())
+		return;
+
+	FNP_getVSSAPI getVSSAPI =
+		(FNP_getVSSAPI)m_vsScriptLibrary.resolve("getVSScriptAPI");
+	if(!getVSSAPI)
+		return;
+
+	const VSSCRIPTAPI * cpVSSAPI = getVSSAPI(VSSCRIPT_API_VERSION);
+	if(!cpVSSAPI)
+		return;
+
+	m_cpVSAPI = cpVSSAPI->getVSAPI(VAPOURSYNTH_API_VERSION);
+	if(m_cpVSAPI)
+		m_pCore = m_cpVSAPI->createCore(0);
+}
+
+// END OF void YuvToRGBBenchmark::initTestCase()
+//==============================================================================
+
+void YuvToRGBBenchmark::cleanupTestCase()
+{
+	if(m_pCore)
+	{
+		m_cpVSAPI->freeCore(m_pCore);
+		m_pCore = nullptr;
+	}
+	m_cpVSAPI = nullptr;
+
+	if(m_vsScriptLibrary.isLoaded())
+		m_vsScriptLibrary.unload();
+}
+
+// END OF void YuvToRGBBenchmark::cleanupTestCase()
+//==============================================================================
+
+void YuvToRGBBenchmark::rows_data()
+{
+	QTest::addColumn<int>("width");
+	QTest::addColumn<int>("height");
+	QTest::addColumn<int>("level");
+
+	for(const FrameSize & size : FRAME_SIZES)
+	{
+		QTest::newRow((QByteArray(size.name) + " C").constData()) <<
+			size.width << size.height << (int)SimdLevel::None;
+#ifdef YUV_TO_RGB_X86
+		SimdLevel best = simdLevel();
+		if(best == SimdLevel::None)
+			continue;
+		QTest::newRow((QByteArray(size.name) + " SSE4.1").constData()) <<
+			size.width << size.height << (int)SimdLevel::SSE41;
+		if(best != SimdLevel::AVX2)
+			continue;
+		QTest::newRow((QByteArray(size.name) + " AVX2").constData()) <<
+			size.width << size.height << (int)SimdLevel::AVX2;
+#endif
+	}
+}
+
+// END OF void YuvToRGBBenchmark::rows_data()
+//==============================================================================
+
+void YuvToRGBBenchmark::rows()
+{
+	QFETCH(int, width);
+	QFETCH(int, height);
+	QFETCH(int, level);
+
+	yuv_to_rgb_row_func yuvToRGBRow = yuvToRGBRowC<uint8_t, false>;
+#ifdef YUV_TO_RGB_X86
+	if((SimdLevel)level == SimdLevel::SSE41)
+		yuvToRGBRow = yuvToRGBRowSSE41<uint8_t, false>;
+	else if((SimdLevel)level == SimdLevel::AVX2)
+		yuvToRGBRow = yuvToRGBRowAVX2<uint8_t, false>;
+#else
+	(void)level;
+#endif
+
+	const YuvToRGBCoefficients c = coefficients();
+
+	std::vector<uint8_t> y((size_t)width);
+	std::vector<float> u((size_t)width);
+	std::vector<float> v((size_t)width);
+	for(int x = 0; x < width; ++x)
+	{
+		y[x] = (uint8_t)(16 + x % 220);
+		u[x] = (float)(x % 201 - 100);
+		v[x] = (float)(100 - x % 201);
+	}
+	std::vector<uint32_t> pixels((size_t)width);
+
+	// One frame of rows, without the chroma upsampling around them.
+	QBENCHMARK
+	{
+		for(int row = 0; row < height; ++row)
+		{
+			yuvToRGBRow(y.data(), u.data(), v.data(), pixels.data(),
+				(unsigned)width, c);
+		}
+	}
+
+	QVERIFY(pixels[0] != 0u);
+}
+
+// END OF void YuvToRGBBenchmark::rows()
+//==============================================================================
+
+void YuvToRGBBenchmark::directFilter_data()
+{
+	addFrameRows();
+}
+
+// END OF void YuvToRGBBenchmark::directFilter_data()
+//==============================================================================
+
+void YuvToRGBBenchmark::directFilter()
+{
+	if(!m_pCore)
+		QSKIP("The VapourSynth script library is not available.");
+
+	QFETCH(int, width);
+	QFETCH(int, height);
+	QFETCH(int, bits);
+
+	VSNode * pSourceNode = createSource(width, height, bits);
+	QVERIFY(pSourceNode);
+
+	VSNode * pPreviewNode = yuvToRGBFilter(pSourceNode, VSC_MATRIX_BT709,
+		VSC_CHROMA_LEFT, false, m_pCore, m_cpVSAPI);
+	QVERIFY(pPreviewNode);
+
+	bool gotFrames = true;
+	QBENCHMARK
+	{
+		gotFrames = gotFrames && getNextFrame(pPreviewNode);
+	}
+
+	m_cpVSAPI->freeNode(pPreviewNode);
+	m_cpVSAPI->freeNode(pSourceNode);
+	QVERIFY(gotFrames);
+}
+
+// END OF void YuvToRGBBenchmark::directFilter()
+//==============================================================================
+
+void YuvToRGBBenchmark::resizeFilter_data()
+{
+	addFrameRows();
+}
+
+// END OF void YuvToRGBBenchmark::resizeFilter_data()
+//==============================================================================
+
+void YuvToRGBBenchmark::resizeFilter()
+{
+	if(!m_pCore)
+		QSKIP("The VapourSynth script library is not available.");
+
+	QFETCH(int, width);
+	QFETCH(int, height);
+	QFETCH(int, bits);
+
+	VSNode * pSourceNode = createSource(width, height, bits);
+	QVERIFY(pSourceNode);
+
+	// The conversion the preview falls back to with the default settings.
+	VSPlugin * pResizePlugin = m_cpVSAPI->getPluginByID(
+		"com.vapoursynth.resize", m_pCore);
+	VSMap * pArgumentMap = m_cpVSAPI->createMap();
+	m_cpVSAPI->mapSetNode(pArgumentMap, "clip", pSourceNode, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "format", pfRGB24, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "matrix_in", VSC_MATRIX_BT709,
+		maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "chromaloc_in", VSC_CHROMA_LEFT,
+		maReplace);
+	m_cpVSAPI->mapSetData(pArgumentMap, "dither_type", "error_diffusion",
+		-1, dtUtf8, maReplace);
+	m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_a_uv", 0.0,
+		maReplace);
+	m_cpVSAPI->mapSetFloat(pArgumentMap, "filter_param_b_uv", 0.5,
+		maReplace);
+	VSMap * pResultMap = m_cpVSAPI->invoke(pResizePlugin, "Bicubic",
+		pArgumentMap);
+	m_cpVSAPI->freeMap(pArgumentMap);
+
+	const char * cpResultError = m_cpVSAPI->mapGetError(pResultMap);
+	if(cpResultError)
+	{
+		QByteArray error(cpResultError);
+		m_cpVSAPI->freeMap(pResultMap);
+		m_cpVSAPI->freeNode(pSourceNode);
+		QFAIL(error.constData());
+	}
+
+	VSNode * pRGBNode = m_cpVSAPI->mapGetNode(pResultMap, "clip", 0, nullptr);
+	m_cpVSAPI->freeMap(pResultMap);
+
+	VSNode * pPreviewNode = packRGBFilter(pRGBNode, pSourceNode, false,
+		m_pCore, m_cpVSAPI);
+	QVERIFY(pPreviewNode);
+
+	bool gotFrames = true;
+	QBENCHMARK
+	{
+		gotFrames = gotFrames && getNextFrame(pPreviewNode);
+	}
+
+	m_cpVSAPI->freeNode(pPreviewNode);
+	m_cpVSAPI->freeNode(pSourceNode);
+	QVERIFY(gotFrames);
+}
+
+// END OF void YuvToRGBBenchmark::resizeFilter()
+//==============================================================================
+
+VSNode * YuvToRGBBenchmark::createSource(int a_width, int a_height,
+	int a_bits)
+{
+	VSPlugin * pStdPlugin = m_cpVSAPI->getPluginByID("com.vapoursynth.std",
+		m_pCore);
+	VSMap * pArgumentMap = m_cpVSAPI->createMap();
+	m_cpVSAPI->mapSetInt(pArgumentMap, "width", a_width, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "height", a_height, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "format",
+		(a_bits == 8) ? pfYUV420P8 : pfYUV420P10, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "length", SOURCE_LENGTH, maReplace);
+	m_cpVSAPI->mapSetInt(pArgumentMap, "keep", 1, maReplace);
+	VSMap * pResultMap = m_cpVSAPI->invoke(pStdPlugin, "BlankClip",
+		pArgumentMap);
+	m_cpVSAPI->freeMap(pArgumentMap);
+
+	VSNode * pNode = nullptr;
+	if(!m_cpVSAPI->mapGetError(pResultMap))
+		pNode = m_cpVSAPI->mapGetNode(pResultMap, "clip", 0, nullptr);
+	m_cpVSAPI->freeMap(pResultMap);
+	return pNode;
+}
+
+// END OF VSNode * YuvToRGBBenchmark::createSource(int a_width,
+//		int a_height, int a_bits)
+//==============================================================================
+
+bool YuvToRGBBenchmark::getNextFrame(VSNode * a_pNode)
+{
+	int frame = m_nextFrame;
+	m_nextFrame = (m_nextFrame + 1) % SOURCE_LENGTH;
+
+	const VSFrame * cpFrame = m_cpVSAPI->getFrame(frame, a_pNode, nullptr, 0);
+	if(!cpFrame)
+		return false;
+	m_cpVSAPI->freeFrame(cpFrame);
+	return true;
+}
+
+// END OF bool YuvToRGBBenchmark::getNextFrame(VSNode * a_pNode)
+//==============================================================================
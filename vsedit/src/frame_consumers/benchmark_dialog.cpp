@@ -38,6 +38,8 @@ ScriptBenchmarkDialog::ScriptBenchmarkDialog(
 		this, SLOT(slotWholeVideoButtonPressed()));
 	connect(m_ui.startStopBenchmarkButton, SIGNAL(clicked()),
 		this, SLOT(slotStartStopBenchmarkButtonPressed()));
+	connect(m_ui.nodeTimingButton, SIGNAL(clicked()),
+		this, SLOT(slotShowNodeTiming()));
 }
 
 // END OF ScriptBenchmarkDialog::ScriptBenchmarkDialog(
@@ -67,6 +69,22 @@ bool ScriptBenchmarkDialog::initialize(const QString & a_script,
 //		const QString & a_scriptName)
 //==============================================================================
 
+bool ScriptBenchmarkDialog::initializeAsync(const QString & a_script,
+	const QString & a_scriptName, ProcessReason a_reason)
+{
+	bool started = VSScriptProcessorDialog::initializeAsync(a_script,
+		a_scriptName, a_reason);
+	if(!started)
+		emit signalWriteLogMessage(mtCritical,
+			m_pVapourSynthScriptProcessor->error());
+	return started;
+}
+
+// END OF bool ScriptBenchmarkDialog::initializeAsync(
+//		const QString & a_script, const QString & a_scriptName,
+//		ProcessReason a_reason)
+//==============================================================================
+
 void ScriptBenchmarkDialog::resetSavedRange()
 {
 	m_lastFromFrame = -1;
@@ -115,6 +133,23 @@ void ScriptBenchmarkDialog::call()
 // END OF void ScriptBenchmarkDialog::call()
 //==============================================================================
 
+void ScriptBenchmarkDialog::slotScriptProcessorInitialized(bool a_success)
+{
+	VSScriptProcessorDialog::slotScriptProcessorInitialized(a_success);
+	if(!a_success)
+	{
+		emit signalWriteLogMessage(mtCritical,
+			m_pVapourSynthScriptProcessor->error());
+		return;
+	}
+
+	call();
+}
+
+// END OF void ScriptBenchmarkDialog::slotScriptProcessorInitialized(
+//		bool a_success)
+//==============================================================================
+
 void ScriptBenchmarkDialog::stopAndCleanUp()
 {
 	stopProcessing();
@@ -187,10 +222,12 @@ void ScriptBenchmarkDialog::slotStartStopBenchmarkButtonPressed()
 	m_lastToFrame = lastFrame;
 
 	m_processing = true;
+	m_pVapourSynthScriptProcessor->resetNodeTimings();
 	m_benchmarkStartTime = hr_clock::now();
 
 	for(int i = firstFrame; i <= lastFrame; ++i)
-		m_pVapourSynthScriptProcessor->requestFrameAsync(i);
+		m_pVapourSynthScriptProcessor->requestFrameAsync(i, 0, false,
+			FramePriority::Background);
 }
 
 // END OF void ScriptBenchmarkDialog::slotStartStopBenchmarkButtonPressed()
@@ -23,6 +23,10 @@ public:
 		const QString & a_scriptName,
 		ProcessReason a_reason = ProcessReason::Benchmark) override;
 
+	virtual bool initializeAsync(const QString & a_script,
+		const QString & a_scriptName,
+		ProcessReason a_reason = ProcessReason::Benchmark) override;
+
 	void resetSavedRange();
 
 public slots:
@@ -41,6 +45,8 @@ protected slots:
 	virtual void slotFrameRequestDiscarded(int a_frameNumber,
 	int a_outputIndex, const QString & a_reason) override;
 
+	virtual void slotScriptProcessorInitialized(bool a_success) override;
+
 	void slotWholeVideoButtonPressed();
 
 	void slotStartStopBenchmarkButtonPressed();
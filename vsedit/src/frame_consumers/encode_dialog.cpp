@@ -2,6 +2,9 @@
 
 #include "../../../common-src/helpers.h"
 #include "../../../common-src/settings/settings_manager.h"
+#include "../../../common-src/vapoursynth/vs_script_library.h"
+#include "../../../common-src/vapoursynth/vs_script_evaluation.h"
+#include "../vapoursynth/script_loading_dialog.h"
 
 #include <vapoursynth/VapourSynth4.h>
 #include <vapoursynth/VSHelper4.h>
@@ -21,7 +24,10 @@ EncodeDialog::EncodeDialog(SettingsManager * a_pSettingsManager,
 		| Qt::WindowCloseButtonHint
 		)
 	, m_pSettingsManager(a_pSettingsManager)
+	, m_pVSScriptLibrary(a_pVSScriptLibrary)
 	, m_pJob(nullptr)
+	, m_pScriptEvaluation(nullptr)
+	, m_pScriptLoadingDialog(nullptr)
 {
 	vsedit::disableFontKerning(this);
 	m_ui.setupUi(this);
@@ -29,6 +35,10 @@ EncodeDialog::EncodeDialog(SettingsManager * a_pSettingsManager,
 	m_pJob = new vsedit::Job(JobProperties(), a_pSettingsManager,
 		a_pVSScriptLibrary, this);
 
+	m_pScriptLoadingDialog = new ScriptLoadingDialog(this);
+	connect(m_pScriptLoadingDialog, SIGNAL(canceled()),
+		this, SLOT(slotCancelInitialization()));
+
 	setUpEncodingPresets();
 
 	m_ui.feedbackTextEdit->setName("encode_log");
@@ -64,6 +74,7 @@ EncodeDialog::EncodeDialog(SettingsManager * a_pSettingsManager,
 
 EncodeDialog::~EncodeDialog()
 {
+	slotCancelInitialization();
 }
 
 // END OF EncodeDialog::~EncodeDialog()
@@ -109,6 +120,30 @@ bool EncodeDialog::initialize(const QString & a_script,
 //		const QString & a_scriptName)
 //==============================================================================
 
+bool EncodeDialog::initializeAsync(const QString & a_script,
+	const QString & a_scriptName)
+{
+	if(m_pJob->isActive())
+		return false;
+
+	slotCancelInitialization();
+
+	m_pScriptEvaluation = new ScriptEvaluation(m_pVSScriptLibrary,
+		a_script, a_scriptName, ProcessReason::Encode);
+	connect(m_pScriptEvaluation, &ScriptEvaluation::signalProgress,
+		m_pScriptLoadingDialog, &ScriptLoadingDialog::slotSetStage);
+	connect(m_pScriptEvaluation, &ScriptEvaluation::signalFinished,
+		this, &EncodeDialog::slotScriptEvaluated);
+	m_pScriptLoadingDialog->start(a_scriptName);
+	m_pScriptEvaluation->start();
+
+	return true;
+}
+
+// END OF bool EncodeDialog::initializeAsync(const QString & a_script,
+//		const QString & a_scriptName)
+//==============================================================================
+
 bool EncodeDialog::busy() const
 {
 	return m_pJob->isActive();
@@ -480,6 +515,48 @@ void EncodeDialog::slotWriteLogMessage(const QString & a_message,
 //		const QString & a_style)
 //==============================================================================
 
+void EncodeDialog::slotScriptEvaluated(VSScript * a_pScript,
+	ScriptOrigin a_origin, const QString & a_error)
+{
+	(void)a_origin;
+
+	QString script = m_pScriptEvaluation->script();
+	QString scriptName = m_pScriptEvaluation->scriptName();
+	m_pScriptEvaluation = nullptr;
+	m_pScriptLoadingDialog->finish();
+
+	if(!a_pScript)
+	{
+		slotWriteLogMessage(tr("Failed to initialize script.\n%1")
+			.arg(a_error), LOG_STYLE_ERROR);
+		return;
+	}
+
+	// The job picks the evaluated script up from the library cache.
+	bool initialized = initialize(script, scriptName);
+	m_pVSScriptLibrary->releaseScript(a_pScript);
+	if(initialized)
+		showActive();
+}
+
+// END OF void EncodeDialog::slotScriptEvaluated(VSScript * a_pScript,
+//		ScriptOrigin a_origin, const QString & a_error)
+//==============================================================================
+
+void EncodeDialog::slotCancelInitialization()
+{
+	m_pScriptLoadingDialog->finish();
+	if(!m_pScriptEvaluation)
+		return;
+
+	m_pScriptEvaluation->disconnect(this);
+	m_pScriptEvaluation->cancel();
+	m_pScriptEvaluation = nullptr;
+}
+
+// END OF void EncodeDialog::slotCancelInitialization()
+//==============================================================================
+
 void EncodeDialog::setUpEncodingPresets()
 {
 	m_encodingPresets = m_pSettingsManager->getAllEncodingPresets();
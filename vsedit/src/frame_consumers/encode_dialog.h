@@ -7,6 +7,8 @@
 
 class SettingsManager;
 class VSScriptLibrary;
+class ScriptEvaluation;
+class ScriptLoadingDialog;
 
 class EncodeDialog : public QDialog
 {
@@ -21,6 +23,11 @@ public:
 
 	bool initialize(const QString & a_script, const QString & a_scriptName);
 
+	/// Evaluates the script in the background, then initializes
+	/// the job from the evaluated script and shows the dialog.
+	bool initializeAsync(const QString & a_script,
+		const QString & a_scriptName);
+
 	bool busy() const;
 
 public slots:
@@ -58,6 +65,11 @@ private slots:
 	void slotWriteLogMessage(const QString & a_message,
 		const QString & a_style);
 
+	void slotScriptEvaluated(VSScript * a_pScript, ScriptOrigin a_origin,
+		const QString & a_error);
+
+	void slotCancelInitialization();
+
 private:
 
 	void setUpEncodingPresets();
@@ -68,8 +80,14 @@ private:
 
 	SettingsManager * m_pSettingsManager;
 
+	VSScriptLibrary * m_pVSScriptLibrary;
+
 	vsedit::Job * m_pJob;
 
+	ScriptEvaluation * m_pScriptEvaluation;
+
+	ScriptLoadingDialog * m_pScriptLoadingDialog;
+
 	std::vector<EncodingPreset> m_encodingPresets;
 
 };
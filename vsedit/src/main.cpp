@@ -5,12 +5,15 @@
 #include "../../common-src/version_info.h"
 #include "../../common-src/win32_console.h"
 
+#include <vapoursynth/VSScript4.h>
+
 #include <QApplication>
 
 #include <iostream>
 
 Q_DECLARE_OPAQUE_POINTER(const VSFrame *)
 Q_DECLARE_OPAQUE_POINTER(VSNode *)
+Q_DECLARE_OPAQUE_POINTER(VSScript *)
 
 MainWindow * pMainWindow = nullptr;
 
@@ -3,6 +3,7 @@
 #include "../../common-src/settings/settings_manager.h"
 #include "../../common-src/vapoursynth/vs_script_library.h"
 #include "../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../common-src/vapoursynth/vs_script_evaluation.h"
 #include "../../common-src/helpers.h"
 #include "../../common-src/ipc_defines.h"
 
@@ -51,6 +52,7 @@ MainWindow::MainWindow(SettingsManager *settings) : QMainWindow()
 	, m_pActionTemplates(nullptr)
 	, m_pActionSettings(nullptr)
 	, m_pActionPreview(nullptr)
+	, m_pActionReloadAndPreview(nullptr)
 	, m_pActionCheckScript(nullptr)
 	, m_pActionBenchmark(nullptr)
 	, m_pActionEncode(nullptr)
@@ -110,6 +112,7 @@ MainWindow::MainWindow(SettingsManager *settings) : QMainWindow()
 		this, SLOT(slotSettingsChanged()));
 
 	m_pVSScriptLibrary = new VSScriptLibrary(m_pSettingsManager, this);
+	m_pVSScriptLibrary->setWarmCorePoolEnabled(true);
 
 	connect(m_pVSScriptLibrary,
 		SIGNAL(signalWriteLogMessage(int, const QString &)),
@@ -471,26 +474,59 @@ void MainWindow::slotPreview()
 // END OF void MainWindow::slotPreview()
 //==============================================================================
 
-void MainWindow::slotCheckScript()
+void MainWindow::slotReloadAndPreview()
 {
-	VapourSynthScriptProcessor tempProcessor(m_pSettingsManager,
-		m_pVSScriptLibrary, this);
+	if(m_pPreviewDialog->busy())
+	{
+		slotPreview();
+		return;
+	}
 
-	const VSAPI * cpVSAPI = m_pVSScriptLibrary->getVSAPI();
+	// Picks up the changes the file watcher can not see, like packages
+	// the script imports from elsewhere.
+	m_pVSScriptLibrary->invalidateScriptCache();
+	slotPreview();
+}
 
-	connect(&tempProcessor, SIGNAL(signalWriteLogMessage(int, const QString &)),
-		this, SLOT(slotWriteLogMessage(int, const QString &)));
+// END OF void MainWindow::slotReloadAndPreview()
+//==============================================================================
 
-	bool correct = tempProcessor.initialize(m_ui.scriptEdit->text(),
-		m_scriptFilePath, 0, ProcessReason::Check);
-	if(correct)
-	{
-		VSNodeInfo info = tempProcessor.nodeInfo();
-		QString message = tr("Script was successfully evaluated. "
-			"Output %1 info:\n").arg(info.isAudio() ? "audio" : "video");
-		message += vsedit::nodeInfoString(info, cpVSAPI);
-		m_ui.logView->addEntry(message, LOG_STYLE_POSITIVE);
-	}
+void MainWindow::slotCheckScript()
+{
+	QString script = m_ui.scriptEdit->text();
+	QString scriptName = m_scriptFilePath;
+
+	ScriptEvaluation * pEvaluation = new ScriptEvaluation(m_pVSScriptLibrary,
+		script, scriptName, ProcessReason::Check);
+	connect(pEvaluation, &ScriptEvaluation::signalFinished, this,
+		[this, script, scriptName](VSScript * a_pScript, ScriptOrigin,
+			const QString & a_error)
+		{
+			if(!a_pScript)
+			{
+				slotWriteLogMessage(mtCritical, a_error);
+				return;
+			}
+
+			VapourSynthScriptProcessor tempProcessor(m_pSettingsManager,
+				m_pVSScriptLibrary, this);
+			connect(&tempProcessor,
+				SIGNAL(signalWriteLogMessage(int, const QString &)),
+				this, SLOT(slotWriteLogMessage(int, const QString &)));
+
+			bool correct = tempProcessor.initialize(a_pScript, script,
+				scriptName, 0, ProcessReason::Check);
+			if(correct)
+			{
+				const VSAPI * cpVSAPI = m_pVSScriptLibrary->getVSAPI();
+				VSNodeInfo info = tempProcessor.nodeInfo();
+				QString message = tr("Script was successfully evaluated. "
+					"Output %1 info:\n").arg(info.isAudio() ? "audio" : "video");
+				message += vsedit::nodeInfoString(info, cpVSAPI);
+				m_ui.logView->addEntry(message, LOG_STYLE_POSITIVE);
+			}
+		});
+	pEvaluation->start();
 }
 
 // END OF void MainWindow::slotCheckScript()
@@ -507,8 +543,8 @@ void MainWindow::slotBenchmark()
 		return;
 	}
 
-	m_pBenchmarkDialog->initialize(m_ui.scriptEdit->text(), m_scriptFilePath);
-	m_pBenchmarkDialog->call();
+	m_pBenchmarkDialog->initializeAsync(m_ui.scriptEdit->text(),
+		m_scriptFilePath);
 }
 
 // END OF void MainWindow::slotBenchmark()
@@ -522,10 +558,8 @@ void MainWindow::slotEncode()
 		return;
 	}
 
-	bool initialized = m_pEncodeDialog->initialize(
-		m_ui.scriptEdit->text(), m_scriptFilePath);
-	if(initialized)
-		m_pEncodeDialog->showActive();
+	m_pEncodeDialog->initializeAsync(m_ui.scriptEdit->text(),
+		m_scriptFilePath);
 }
 
 // END OF void MainWindow::slotEncode()
@@ -641,6 +675,8 @@ void MainWindow::slotSettingsChanged()
 		pAction->setShortcut(hotkey);
 	}
 
+	m_pVSScriptLibrary->slotResetSettings();
+
 	m_pVapourSynthPluginsManager->slotRefill(m_pVSScriptLibrary->getVSAPI());
 	VSPluginsList vsPluginsList = m_pVapourSynthPluginsManager->pluginsList();
 	m_ui.scriptEdit->setPluginsList(vsPluginsList);
@@ -737,6 +773,8 @@ void MainWindow::createActionsAndMenus()
 			m_pSettingsDialog, SLOT(slotCall())},
 		{&m_pActionPreview, ACTION_ID_PREVIEW,
 			this, SLOT(slotPreview())},
+		{&m_pActionReloadAndPreview, ACTION_ID_RELOAD_AND_PREVIEW,
+			this, SLOT(slotReloadAndPreview())},
 		{&m_pActionCheckScript, ACTION_ID_CHECK_SCRIPT,
 			this, SLOT(slotCheckScript())},
 		{&m_pActionBenchmark, ACTION_ID_BENCHMARK,
@@ -801,6 +839,7 @@ void MainWindow::createActionsAndMenus()
 	QMenu * pScriptMenu = m_ui.menuBar->addMenu(tr("Script"));
 	vsedit::disableFontKerning(pScriptMenu);
 	pScriptMenu->addAction(m_pActionPreview);
+	pScriptMenu->addAction(m_pActionReloadAndPreview);
 	pScriptMenu->addAction(m_pActionCheckScript);
 	pScriptMenu->addAction(m_pActionBenchmark);
 	pScriptMenu->addAction(m_pActionEncode);
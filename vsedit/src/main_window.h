@@ -60,6 +60,7 @@ private slots:
 	void slotTemplates();
 
 	void slotPreview();
+	void slotReloadAndPreview();
 	void slotCheckScript();
 	void slotBenchmark();
 	void slotEncode();
@@ -120,6 +121,7 @@ private:
 	QAction * m_pActionTemplates;
 	QAction * m_pActionSettings;
 	QAction * m_pActionPreview;
+	QAction * m_pActionReloadAndPreview;
 	QAction * m_pActionCheckScript;
 	QAction * m_pActionBenchmark;
 	QAction * m_pActionEncode;
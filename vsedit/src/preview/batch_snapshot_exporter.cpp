@@ -0,0 +1,247 @@
+#include "batch_snapshot_exporter.h"
+
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+
+//==============================================================================
+
+// Frames requested and images being saved at once, unless the encoder
+// has more threads.
+const size_t SNAPSHOT_EXPORT_FRAMES_IN_FLIGHT = 8;
+
+//==============================================================================
+
+BatchSnapshotExporter::BatchSnapshotExporter(
+	VapourSynthScriptProcessor * a_pProcessor, QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_pProcessor(a_pProcessor)
+	, m_cpVSAPI(nullptr)
+	, m_outputIndex(-1)
+	, m_filePath()
+	, m_format()
+	, m_quality(-1)
+	, m_queue()
+	, m_pending()
+	, m_encoding(0)
+	, m_total(0)
+	, m_saved(0)
+	, m_failed(0)
+	, m_startTime()
+	, m_snapshotEncoder()
+{
+	connect(&m_snapshotEncoder,
+		SIGNAL(signalSnapshotSaved(const QString &, bool)),
+		this, SLOT(slotSnapshotSaved(const QString &, bool)));
+}
+
+// END OF BatchSnapshotExporter::BatchSnapshotExporter(
+//		VapourSynthScriptProcessor * a_pProcessor, QObject * a_pParent)
+//==============================================================================
+
+BatchSnapshotExporter::~BatchSnapshotExporter()
+{
+	clear();
+}
+
+// END OF BatchSnapshotExporter::~BatchSnapshotExporter()
+//==============================================================================
+
+bool BatchSnapshotExporter::exporting() const
+{
+	return (m_outputIndex > -1);
+}
+
+// END OF bool BatchSnapshotExporter::exporting() const
+//==============================================================================
+
+void BatchSnapshotExporter::start(int a_outputIndex,
+	const std::deque<int> & a_frames, const FilePathFunction & a_filePath,
+	const QByteArray & a_format, int a_quality, const VSAPI * a_cpVSAPI)
+{
+	clear();
+	if(a_frames.empty() || (!a_cpVSAPI))
+		return;
+
+	m_cpVSAPI = a_cpVSAPI;
+	m_outputIndex = a_outputIndex;
+	m_filePath = a_filePath;
+	m_format = a_format;
+	m_quality = a_quality;
+	m_queue = a_frames;
+	m_total = a_frames.size();
+	m_startTime = hr_clock::now();
+	requestFrames();
+}
+
+// END OF void BatchSnapshotExporter::start(int a_outputIndex,
+//		const std::deque<int> & a_frames,
+//		const FilePathFunction & a_filePath, const QByteArray & a_format,
+//		int a_quality, const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+bool BatchSnapshotExporter::frameRequested(int a_frameNumber,
+	int a_outputIndex) const
+{
+	return (a_outputIndex == m_outputIndex) &&
+		(m_pending.find(a_frameNumber) != m_pending.end());
+}
+
+// END OF bool BatchSnapshotExporter::frameRequested(int a_frameNumber,
+//		int a_outputIndex) const
+//==============================================================================
+
+void BatchSnapshotExporter::takeFrame(int a_frameNumber,
+	const VSFrame * a_cpPreviewFrame, const QImage & a_image)
+{
+	if(m_pending.erase(a_frameNumber) == 0)
+		return;
+
+	if(a_image.isNull())
+	{
+		m_failed++;
+		requestFrames();
+		return;
+	}
+
+	// The names come with the frame of the output the preview is made of.
+	QString clipName;
+	QString sceneName;
+	int error = 0;
+	const VSMap * cpProps = m_cpVSAPI->getFramePropertiesRO(a_cpPreviewFrame);
+	const VSFrame * cpOutputFrame = m_cpVSAPI->mapGetFrame(cpProps,
+		"OutputFrame", 0, &error);
+	if(cpOutputFrame)
+	{
+		const VSMap * cpOutputProps =
+			m_cpVSAPI->getFramePropertiesRO(cpOutputFrame);
+		const char * name = m_cpVSAPI->mapGetData(cpOutputProps, "Name",
+			0, &error);
+		clipName = QString(name ? name : "");
+		name = m_cpVSAPI->mapGetData(cpOutputProps, "SceneName", 0, &error);
+		sceneName = QString(name ? name : "");
+		m_cpVSAPI->freeFrame(cpOutputFrame);
+	}
+
+	QString filePath = m_filePath(a_frameNumber, clipName, sceneName);
+	QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+	m_snapshotEncoder.encode(a_image, a_cpPreviewFrame, m_cpVSAPI, filePath,
+		m_format, m_quality);
+	m_encoding++;
+	requestFrames();
+}
+
+// END OF void BatchSnapshotExporter::takeFrame(int a_frameNumber,
+//		const VSFrame * a_cpPreviewFrame, const QImage & a_image)
+//==============================================================================
+
+void BatchSnapshotExporter::clear()
+{
+	bool wasExporting = exporting();
+	m_outputIndex = -1;
+	m_filePath = FilePathFunction();
+	m_format.clear();
+	m_quality = -1;
+	m_queue.clear();
+	m_pending.clear();
+	m_encoding = 0;
+	m_total = 0;
+	m_saved = 0;
+	m_failed = 0;
+	m_snapshotEncoder.clear();
+	if(wasExporting)
+		emit signalFinished();
+}
+
+// END OF void BatchSnapshotExporter::clear()
+//==============================================================================
+
+void BatchSnapshotExporter::slotSnapshotSaved(const QString & a_filePath,
+	bool a_success)
+{
+	if(!exporting())
+		return;
+
+	Q_ASSERT(m_encoding > 0);
+	m_encoding--;
+	if(a_success)
+		m_saved++;
+	else
+	{
+		m_failed++;
+		emit signalWriteLogMessage(mtWarning,
+			tr("Error while saving image %1").arg(a_filePath));
+	}
+	requestFrames();
+}
+
+// END OF void BatchSnapshotExporter::slotSnapshotSaved(
+//		const QString & a_filePath, bool a_success)
+//==============================================================================
+
+void BatchSnapshotExporter::requestFrames()
+{
+	size_t window = std::max(SNAPSHOT_EXPORT_FRAMES_IN_FLIGHT,
+		(size_t)m_snapshotEncoder.maxThreadCount());
+	while((m_pending.size() + m_encoding < window) && (!m_queue.empty()))
+	{
+		int frameNumber = m_queue.front();
+		bool requested = m_pProcessor->requestFullSizePreviewFrameAsync(
+			frameNumber, m_outputIndex);
+		if(!requested)
+		{
+			emit signalWriteLogMessage(mtCritical,
+				tr("Failed to export the snapshot of frame %1.")
+				.arg(frameNumber));
+			clear();
+			return;
+		}
+		m_queue.pop_front();
+		m_pending.insert(frameNumber);
+	}
+
+	if(m_pending.empty() && (m_encoding == 0))
+		finish();
+	else
+		updateProgress();
+}
+
+// END OF void BatchSnapshotExporter::requestFrames()
+//==============================================================================
+
+void BatchSnapshotExporter::updateProgress()
+{
+	size_t done = m_saved + m_failed;
+	double seconds = duration_to_double(hr_clock::now() - m_startTime);
+	double framesPerSecond = (seconds > 0.0) ? (double)done / seconds : 0.0;
+	emit signalProgress(tr("Exporting snapshots: %1 of %2, %3 frames/s")
+		.arg(done).arg(m_total)
+		.arg(QString::number(framesPerSecond, 'f', 2)));
+}
+
+// END OF void BatchSnapshotExporter::updateProgress()
+//==============================================================================
+
+void BatchSnapshotExporter::finish()
+{
+	double seconds = duration_to_double(hr_clock::now() - m_startTime);
+	double framesPerSecond = (seconds > 0.0) ?
+		(double)m_saved / seconds : 0.0;
+	emit signalWriteLogMessage(mtInformation,
+		tr("%1 snapshots of output %2 are saved in %3 s (%4 frames/s).")
+		.arg(m_saved).arg(m_outputIndex)
+		.arg(QString::number(seconds, 'f', 2))
+		.arg(QString::number(framesPerSecond, 'f', 2)));
+	if(m_failed > 0)
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("%1 snapshots could not be saved.").arg(m_failed));
+	}
+	clear();
+}
+
+// END OF void BatchSnapshotExporter::finish()
+//==============================================================================
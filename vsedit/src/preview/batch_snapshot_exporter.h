@@ -0,0 +1,104 @@
+#ifndef BATCH_SNAPSHOT_EXPORTER_H_INCLUDED
+#define BATCH_SNAPSHOT_EXPORTER_H_INCLUDED
+
+#include "snapshot_encoder.h"
+#include "../../../common-src/chrono.h"
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QByteArray>
+#include <deque>
+#include <set>
+#include <functional>
+#include <cstddef>
+
+class VapourSynthScriptProcessor;
+
+//==============================================================================
+
+// Exports the snapshots of a list of frames of one output. The full size
+// preview frames are requested from the processor a window at a time and
+// saved by the encoder, so the frames are not requested faster than they
+// are saved.
+class BatchSnapshotExporter : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	// Makes the file path of the frame from its number and the names
+	// its output frame carries.
+	typedef std::function<QString(int a_frameNumber,
+		const QString & a_clipName, const QString & a_sceneName)>
+		FilePathFunction;
+
+	BatchSnapshotExporter(VapourSynthScriptProcessor * a_pProcessor,
+		QObject * a_pParent = nullptr);
+
+	virtual ~BatchSnapshotExporter();
+
+	bool exporting() const;
+
+	void start(int a_outputIndex, const std::deque<int> & a_frames,
+		const FilePathFunction & a_filePath, const QByteArray & a_format,
+		int a_quality, const VSAPI * a_cpVSAPI);
+
+	// Returns true if the full size preview frame was requested
+	// for the export and is waited for.
+	bool frameRequested(int a_frameNumber, int a_outputIndex) const;
+
+	// The image may share the memory of the frame.
+	void takeFrame(int a_frameNumber, const VSFrame * a_cpPreviewFrame,
+		const QImage & a_image);
+
+	// Results of the requests in process are ignored. Returns when
+	// no frame reference is held any more.
+	void clear();
+
+signals:
+
+	void signalWriteLogMessage(int a_messageType,
+		const QString & a_message);
+
+	void signalProgress(const QString & a_message);
+
+	void signalFinished();
+
+private slots:
+
+	void slotSnapshotSaved(const QString & a_filePath, bool a_success);
+
+private:
+
+	void requestFrames();
+
+	void updateProgress();
+
+	void finish();
+
+	VapourSynthScriptProcessor * m_pProcessor;
+
+	const VSAPI * m_cpVSAPI;
+
+	// The export is in progress while the output index is set.
+	int m_outputIndex;
+	FilePathFunction m_filePath;
+	QByteArray m_format;
+	int m_quality;
+	std::deque<int> m_queue;
+	std::set<int> m_pending;
+	size_t m_encoding;
+	size_t m_total;
+	size_t m_saved;
+	size_t m_failed;
+	hr_time_point m_startTime;
+
+	SnapshotEncoder m_snapshotEncoder;
+};
+
+//==============================================================================
+
+#endif // BATCH_SNAPSHOT_EXPORTER_H_INCLUDED
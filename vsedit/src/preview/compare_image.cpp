@@ -0,0 +1,65 @@
+#include "compare_image.h"
+
+#include <QPainter>
+#include <algorithm>
+
+//==============================================================================
+
+QImage vsedit::composeCompareImage(const std::vector<QImage> & a_images,
+	CompareMode a_mode, double a_wipePosition)
+{
+	if(a_images.size() < 2)
+		return QImage();
+
+	for(const QImage & image : a_images)
+	{
+		if(image.isNull())
+			return QImage();
+	}
+
+	const QImage & first = a_images[0];
+
+	if(a_mode == CompareMode::SideBySide)
+	{
+		int width = 0;
+		int height = 0;
+		for(const QImage & image : a_images)
+		{
+			width += image.width();
+			height = std::max(height, image.height());
+		}
+
+		QImage result(width, height, first.format());
+		result.fill(Qt::black);
+		QPainter painter(&result);
+		int x = 0;
+		for(const QImage & image : a_images)
+		{
+			painter.drawImage(x, 0, image);
+			x += image.width();
+		}
+		return result;
+	}
+
+	if(a_mode == CompareMode::Wipe)
+	{
+		QImage result = first.copy();
+		int split = (int)(std::clamp(a_wipePosition, 0.0, 1.0) *
+			first.width());
+		QRect rightRect = QRect(split, 0, first.width() - split,
+			first.height()).intersected(a_images[1].rect());
+		if(!rightRect.isEmpty())
+		{
+			QPainter painter(&result);
+			painter.drawImage(rightRect, a_images[1], rightRect);
+		}
+		return result;
+	}
+
+	return QImage();
+}
+
+// END OF QImage vsedit::composeCompareImage(
+//		const std::vector<QImage> & a_images, CompareMode a_mode,
+//		double a_wipePosition)
+//==============================================================================
@@ -0,0 +1,22 @@
+#ifndef COMPARE_IMAGE_H_INCLUDED
+#define COMPARE_IMAGE_H_INCLUDED
+
+#include "../../../common-src/settings/settings_definitions.h"
+
+#include <QImage>
+#include <vector>
+
+namespace vsedit
+{
+
+// Lays the preview images of the compared outputs out in one image.
+// Side by side puts them in a row aligned to the top. Wipe shows the
+// first image left of the split and the second one right of it, the
+// split position being a fraction of the first image width.
+// A null image is returned for the flip mode and for too few images.
+QImage composeCompareImage(const std::vector<QImage> & a_images,
+	CompareMode a_mode, double a_wipePosition = 0.5);
+
+}
+
+#endif // COMPARE_IMAGE_H_INCLUDED
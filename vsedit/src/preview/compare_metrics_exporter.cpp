@@ -0,0 +1,176 @@
+#include "compare_metrics_exporter.h"
+
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+
+//==============================================================================
+
+// Enough to keep the worker threads busy while exporting the metrics
+// without flooding the core with requests.
+const size_t METRICS_EXPORT_FRAMES_IN_FLIGHT = 8;
+
+//==============================================================================
+
+CompareMetricsExporter::CompareMetricsExporter(
+	VapourSynthScriptProcessor * a_pProcessor, QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_pProcessor(a_pProcessor)
+	, m_filePath()
+	, m_referenceIndex(-1)
+	, m_comparedIndex(-1)
+	, m_nextFrame(0)
+	, m_lastFrame(-1)
+	, m_pending()
+	, m_results()
+{
+}
+
+// END OF CompareMetricsExporter::CompareMetricsExporter(
+//		VapourSynthScriptProcessor * a_pProcessor, QObject * a_pParent)
+//==============================================================================
+
+CompareMetricsExporter::~CompareMetricsExporter()
+{
+}
+
+// END OF CompareMetricsExporter::~CompareMetricsExporter()
+//==============================================================================
+
+bool CompareMetricsExporter::exporting() const
+{
+	return (!m_filePath.isEmpty());
+}
+
+// END OF bool CompareMetricsExporter::exporting() const
+//==============================================================================
+
+void CompareMetricsExporter::start(const QString & a_filePath,
+	int a_referenceIndex, int a_comparedIndex, int a_firstFrame,
+	int a_lastFrame)
+{
+	clear();
+	m_filePath = a_filePath;
+	m_referenceIndex = a_referenceIndex;
+	m_comparedIndex = a_comparedIndex;
+	m_nextFrame = a_firstFrame;
+	m_lastFrame = a_lastFrame;
+	requestMetrics();
+}
+
+// END OF void CompareMetricsExporter::start(const QString & a_filePath,
+//		int a_referenceIndex, int a_comparedIndex, int a_firstFrame,
+//		int a_lastFrame)
+//==============================================================================
+
+bool CompareMetricsExporter::takeMetrics(const FrameMetrics & a_metrics)
+{
+	bool exported = exporting() &&
+		(a_metrics.referenceIndex == m_referenceIndex) &&
+		(a_metrics.comparedIndex == m_comparedIndex) &&
+		(m_pending.erase(a_metrics.frameNumber) > 0);
+	if(!exported)
+		return false;
+
+	m_results.emplace(a_metrics.frameNumber, a_metrics);
+	requestMetrics();
+	return true;
+}
+
+// END OF bool CompareMetricsExporter::takeMetrics(
+//		const FrameMetrics & a_metrics)
+//==============================================================================
+
+void CompareMetricsExporter::clear()
+{
+	m_filePath.clear();
+	m_referenceIndex = -1;
+	m_comparedIndex = -1;
+	m_nextFrame = 0;
+	m_lastFrame = -1;
+	m_pending.clear();
+	m_results.clear();
+}
+
+// END OF void CompareMetricsExporter::clear()
+//==============================================================================
+
+void CompareMetricsExporter::requestMetrics()
+{
+	while((m_pending.size() < METRICS_EXPORT_FRAMES_IN_FLIGHT) &&
+		(m_nextFrame <= m_lastFrame))
+	{
+		bool requested = m_pProcessor->requestFrameMetricsAsync(m_nextFrame,
+			m_referenceIndex, m_comparedIndex);
+		if(!requested)
+		{
+			emit signalWriteLogMessage(mtCritical,
+				tr("Failed to export the compare metrics to %1.")
+				.arg(m_filePath));
+			clear();
+			return;
+		}
+		m_pending.insert(m_nextFrame);
+		m_nextFrame++;
+	}
+
+	if(m_pending.empty())
+		write();
+}
+
+// END OF void CompareMetricsExporter::requestMetrics()
+//==============================================================================
+
+void CompareMetricsExporter::write()
+{
+	QFile file(m_filePath);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		emit signalWriteLogMessage(mtCritical,
+			tr("Couldn't open %1 for writing.").arg(m_filePath));
+		clear();
+		return;
+	}
+
+	size_t planes = 0;
+	for(const std::pair<const int, FrameMetrics> & result : m_results)
+		planes = std::max(planes, result.second.psnr.size());
+
+	QTextStream stream(&file);
+	stream << "frame";
+	for(size_t i = 0; i < planes; ++i)
+		stream << QString(",psnr_%1,ssim_%1,max_abs_diff_%1").arg(i);
+	stream << "\n";
+
+	// Frames that could not be measured are left blank.
+	for(const std::pair<const int, FrameMetrics> & result : m_results)
+	{
+		const FrameMetrics & metrics = result.second;
+		const std::vector<double> * values[] =
+			{&metrics.psnr, &metrics.ssim, &metrics.maxAbsDiff};
+		stream << result.first;
+		for(size_t i = 0; i < planes; ++i)
+		{
+			for(const std::vector<double> * pValues : values)
+			{
+				stream << ",";
+				if(i < pValues->size())
+					stream << QString::number((*pValues)[i], 'g', 10);
+			}
+		}
+		stream << "\n";
+	}
+
+	stream.flush();
+	emit signalWriteLogMessage(mtInformation,
+		tr("Compare metrics of output %1 against output %2 are saved "
+		"to %3.").arg(m_comparedIndex).arg(m_referenceIndex)
+		.arg(m_filePath));
+	clear();
+}
+
+// END OF void CompareMetricsExporter::write()
+//==============================================================================
@@ -0,0 +1,66 @@
+#ifndef COMPARE_METRICS_EXPORTER_H_INCLUDED
+#define COMPARE_METRICS_EXPORTER_H_INCLUDED
+
+#include "../../../common-src/vapoursynth/vs_script_processor_structures.h"
+
+#include <QObject>
+#include <QString>
+#include <map>
+#include <set>
+
+class VapourSynthScriptProcessor;
+
+//==============================================================================
+
+// Measures a range of frames of one output against another and writes
+// the metrics to a CSV file when all of them are measured.
+class CompareMetricsExporter : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	CompareMetricsExporter(VapourSynthScriptProcessor * a_pProcessor,
+		QObject * a_pParent = nullptr);
+
+	virtual ~CompareMetricsExporter();
+
+	bool exporting() const;
+
+	void start(const QString & a_filePath, int a_referenceIndex,
+		int a_comparedIndex, int a_firstFrame, int a_lastFrame);
+
+	// Returns true if the metrics were requested for the export.
+	bool takeMetrics(const FrameMetrics & a_metrics);
+
+	// Results of the requests in process are ignored.
+	void clear();
+
+signals:
+
+	void signalWriteLogMessage(int a_messageType,
+		const QString & a_message);
+
+private:
+
+	// Keeps a few frames of the range requested and writes the file
+	// when all of them are measured.
+	void requestMetrics();
+
+	void write();
+
+	VapourSynthScriptProcessor * m_pProcessor;
+
+	// The export is in progress while the file path is set.
+	QString m_filePath;
+	int m_referenceIndex;
+	int m_comparedIndex;
+	int m_nextFrame;
+	int m_lastFrame;
+	std::set<int> m_pending;
+	std::map<int, FrameMetrics> m_results;
+};
+
+//==============================================================================
+
+#endif // COMPARE_METRICS_EXPORTER_H_INCLUDED
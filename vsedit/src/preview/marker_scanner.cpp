@@ -0,0 +1,439 @@
+#include "marker_scanner.h"
+
+#include <QFile>
+#include <QStringList>
+#include <map>
+
+//==============================================================================
+
+const char TIMELINE_MARKERS_FILE_SUFFIX[] = ".markers";
+
+// How the property marks a frame. Markers found another way are dropped.
+const char TIMELINE_MARKERS_FILTER[] = "nonzero";
+
+// Enough to keep the processor's in-flight window busy when nothing else
+// is requested. The window itself decides how many run at once.
+const size_t MARKERS_SCAN_FRAMES_IN_FLIGHT = 8;
+
+// Frames scanned between saving the markers, so an interrupted scan
+// does not start over.
+const int MARKERS_SAVE_INTERVAL = 1000;
+
+//==============================================================================
+
+MarkerScanner::MarkerScanner(VapourSynthScriptProcessor * a_pProcessor,
+	const CancelFunction & a_cancelFrameTickets, QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_pProcessor(a_pProcessor)
+	, m_cancelFrameTickets(a_cancelFrameTickets)
+	, m_scriptName()
+	, m_frameMarkers()
+	, m_prop()
+	, m_outputIndex(-1)
+	, m_scriptHash()
+	, m_scanning(false)
+	, m_paused(false)
+	, m_scanNext(0)
+	, m_pending()
+	, m_failedFrames(0)
+	, m_unsavedFrames(0)
+	, m_progress(-1)
+{
+}
+
+// END OF MarkerScanner::MarkerScanner(
+//		VapourSynthScriptProcessor * a_pProcessor,
+//		const CancelFunction & a_cancelFrameTickets, QObject * a_pParent)
+//==============================================================================
+
+MarkerScanner::~MarkerScanner()
+{
+}
+
+// END OF MarkerScanner::~MarkerScanner()
+//==============================================================================
+
+const FrameMarkers * MarkerScanner::frameMarkers() const
+{
+	return &m_frameMarkers;
+}
+
+// END OF const FrameMarkers * MarkerScanner::frameMarkers() const
+//==============================================================================
+
+QString MarkerScanner::prop() const
+{
+	return m_prop;
+}
+
+// END OF QString MarkerScanner::prop() const
+//==============================================================================
+
+void MarkerScanner::setScriptName(const QString & a_scriptName)
+{
+	m_scriptName = a_scriptName;
+}
+
+// END OF void MarkerScanner::setScriptName(const QString & a_scriptName)
+//==============================================================================
+
+void MarkerScanner::load(const QByteArray & a_scriptHash)
+{
+	m_scanning = false;
+	m_scanNext = 0;
+	m_pending.clear();
+	m_failedFrames = 0;
+	m_unsavedFrames = 0;
+	m_progress = -1;
+	m_frameMarkers.reset(0);
+	m_prop.clear();
+	m_outputIndex = -1;
+	emit signalMarkersChanged();
+
+	if(m_scriptName.isEmpty())
+		return;
+
+	// Taken now, as the script may be changed before the markers are saved.
+	m_scriptHash = a_scriptHash;
+
+	QFile markersFile(m_scriptName + QString(TIMELINE_MARKERS_FILE_SUFFIX));
+	if(!markersFile.open(QIODevice::ReadOnly))
+		return;
+
+	QString markersString = QString::fromUtf8(markersFile.readAll());
+	markersFile.close();
+
+	std::map<QString, QString> values;
+	for(const QString & line : markersString.split("\n"))
+	{
+		int separator = line.indexOf('=');
+		if(separator < 0)
+			continue;
+		values[line.left(separator).trimmed()] =
+			line.mid(separator + 1).trimmed();
+	}
+
+	// The markers are dropped when the script or the modules it imports
+	// changed, even if the output kept its length.
+	if((values["script"] != QString::fromLatin1(m_scriptHash)) ||
+		(values["filter"] != TIMELINE_MARKERS_FILTER))
+		return;
+
+	QString prop = values["prop"];
+	bool converted = false;
+	int outputIndex = values["output"].toInt(&converted);
+	if(prop.isEmpty() || (!converted))
+		return;
+	int framesNumber = values["frames"].toInt(&converted);
+	if(!converted)
+		return;
+
+	// The markers are dropped when the output changed its length.
+	VSNodeInfo nodeInfo = m_pProcessor->nodeInfo(outputIndex);
+	if(nodeInfo.isInvalid() || (!nodeInfo.getAsVideo()) ||
+		(nodeInfo.numFrames() != framesNumber))
+		return;
+
+	m_frameMarkers.reset(framesNumber);
+	if((!m_frameMarkers.setScannedRuns(values["scanned"])) ||
+		(!m_frameMarkers.setMarkedRuns(values["marked"])))
+	{
+		m_frameMarkers.reset(0);
+		return;
+	}
+
+	m_prop = prop;
+	m_outputIndex = outputIndex;
+	m_scanning = (!m_frameMarkers.complete());
+	emit signalMarkersChanged();
+}
+
+// END OF void MarkerScanner::load(const QByteArray & a_scriptHash)
+//==============================================================================
+
+void MarkerScanner::scan(const QString & a_prop, int a_outputIndex,
+	int a_framesNumber)
+{
+	bool resume = (a_prop == m_prop) && (a_outputIndex == m_outputIndex) &&
+		(m_frameMarkers.framesNumber() == a_framesNumber);
+	if(resume && m_frameMarkers.complete())
+	{
+		emit signalWriteLogMessage(mtInformation,
+			tr("Frames of output %1 are scanned for %2 already.")
+			.arg(m_outputIndex).arg(m_prop));
+		return;
+	}
+
+	if(!resume)
+	{
+		cancelPending();
+		m_frameMarkers.reset(a_framesNumber);
+		m_prop = a_prop;
+		m_outputIndex = a_outputIndex;
+		emit signalMarkersChanged();
+	}
+
+	m_scanning = true;
+	m_progress = -1;
+	m_failedFrames = 0;
+	requestFrames();
+}
+
+// END OF void MarkerScanner::scan(const QString & a_prop,
+//		int a_outputIndex, int a_framesNumber)
+//==============================================================================
+
+void MarkerScanner::clear()
+{
+	cancelPending();
+	if(m_scanning)
+		emit signalFinished();
+	m_scanning = false;
+	m_progress = -1;
+	m_frameMarkers.reset(0);
+	m_prop.clear();
+	m_outputIndex = -1;
+	emit signalMarkersChanged();
+
+	if(!m_scriptName.isEmpty())
+		QFile::remove(m_scriptName + QString(TIMELINE_MARKERS_FILE_SUFFIX));
+}
+
+// END OF void MarkerScanner::clear()
+//==============================================================================
+
+void MarkerScanner::stop()
+{
+	if(m_scanning)
+		save();
+	m_pending.clear();
+	m_progress = -1;
+}
+
+// END OF void MarkerScanner::stop()
+//==============================================================================
+
+void MarkerScanner::pause()
+{
+	m_paused = true;
+	cancelPending();
+}
+
+// END OF void MarkerScanner::pause()
+//==============================================================================
+
+void MarkerScanner::resume()
+{
+	m_paused = false;
+	requestFrames();
+}
+
+// END OF void MarkerScanner::resume()
+//==============================================================================
+
+bool MarkerScanner::takeFrame(int a_frameNumber, int a_outputIndex,
+	const VSFrame * a_cpOutputFrame, const VSAPI * a_cpVSAPI)
+{
+	if(a_outputIndex != m_outputIndex)
+		return false;
+
+	std::set<int>::iterator it = m_pending.find(a_frameNumber);
+	if(it == m_pending.end())
+		return false;
+	m_pending.erase(it);
+
+	Q_ASSERT(a_cpVSAPI);
+	const VSMap * cpProps = a_cpVSAPI->getFramePropertiesRO(a_cpOutputFrame);
+	QByteArray key = m_prop.toUtf8();
+	int error = 0;
+	bool marked = false;
+	switch(a_cpVSAPI->mapGetType(cpProps, key.constData()))
+	{
+	case ptInt:
+		marked = (a_cpVSAPI->mapGetInt(cpProps, key.constData(), 0,
+			&error) != 0);
+		break;
+	case ptFloat:
+		marked = (a_cpVSAPI->mapGetFloat(cpProps, key.constData(), 0,
+			&error) != 0.0);
+		break;
+	case ptData:
+		marked = (a_cpVSAPI->mapGetDataSize(cpProps, key.constData(), 0,
+			&error) > 0);
+		break;
+	default:
+		break;
+	}
+	marked = marked && (!error);
+
+	m_frameMarkers.setScanned(a_frameNumber, marked);
+	if(marked)
+		emit signalMarkersChanged();
+
+	m_unsavedFrames++;
+	if(m_unsavedFrames >= MARKERS_SAVE_INTERVAL)
+		save();
+
+	updateProgress();
+	requestFrames();
+	return true;
+}
+
+// END OF bool MarkerScanner::takeFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrame * a_cpOutputFrame,
+//		const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+bool MarkerScanner::discardFrame(int a_frameNumber, int a_outputIndex)
+{
+	if((a_outputIndex != m_outputIndex) ||
+		(m_pending.erase(a_frameNumber) == 0))
+		return false;
+
+	// The frame is left unscanned, so a resumed scan tries it again.
+	m_failedFrames++;
+	requestFrames();
+	return true;
+}
+
+// END OF bool MarkerScanner::discardFrame(int a_frameNumber,
+//		int a_outputIndex)
+//==============================================================================
+
+void MarkerScanner::requestFrames()
+{
+	if((!m_scanning) || m_paused || (!m_pProcessor->isInitialized()))
+		return;
+
+	while(m_pending.size() < MARKERS_SCAN_FRAMES_IN_FLIGHT)
+	{
+		int frame = m_frameMarkers.nextUnscanned(m_scanNext);
+		if(frame < 0)
+			break;
+
+		bool requested = m_pProcessor->requestFrameAsync(frame,
+			m_outputIndex, false, FramePriority::Background);
+		if(!requested)
+		{
+			emit signalWriteLogMessage(mtWarning,
+				tr("Could not request frame %1 of output %2 to scan "
+				"for markers.").arg(frame).arg(m_outputIndex));
+			cancelPending();
+			save();
+			m_scanning = false;
+			emit signalFinished();
+			return;
+		}
+		m_pending.insert(frame);
+		m_scanNext = frame + 1;
+	}
+
+	if(m_pending.empty())
+		finish();
+}
+
+// END OF void MarkerScanner::requestFrames()
+//==============================================================================
+
+void MarkerScanner::updateProgress()
+{
+	int framesNumber = m_frameMarkers.framesNumber();
+	if(framesNumber <= 0)
+		return;
+
+	int progress = (int)((qint64)m_frameMarkers.scannedCount() * 100 /
+		framesNumber);
+	if(progress == m_progress)
+		return;
+	m_progress = progress;
+
+	emit signalProgress(tr("Scanning output %1 for %2: %3%, "
+		"%4 frames marked").arg(m_outputIndex).arg(m_prop)
+		.arg(progress).arg(m_frameMarkers.markedCount()));
+}
+
+// END OF void MarkerScanner::updateProgress()
+//==============================================================================
+
+void MarkerScanner::finish()
+{
+	if(!m_scanning)
+		return;
+
+	m_scanning = false;
+	m_progress = -1;
+	save();
+	emit signalFinished();
+	emit signalMarkersChanged();
+
+	emit signalWriteLogMessage(mtInformation,
+		tr("%1 of %2 frames of output %3 are marked by %4.")
+		.arg(m_frameMarkers.markedCount())
+		.arg(m_frameMarkers.framesNumber()).arg(m_outputIndex)
+		.arg(m_prop));
+
+	if(m_failedFrames > 0)
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("%1 frames of output %2 failed and are left unscanned. "
+			"Scan again to retry them.").arg(m_failedFrames)
+			.arg(m_outputIndex));
+	}
+}
+
+// END OF void MarkerScanner::finish()
+//==============================================================================
+
+void MarkerScanner::cancelPending()
+{
+	m_scanNext = 0;
+	if(m_pending.empty())
+		return;
+
+	// Tickets that also answer other requests are kept.
+	const std::set<int> & pending = m_pending;
+	int outputIndex = m_outputIndex;
+	m_cancelFrameTickets(
+		[&](const FrameTicket & a_ticket)
+		{
+			return (a_ticket.priority == FramePriority::Background) &&
+				(a_ticket.kind == FrameTicketKind::Frame) &&
+				(a_ticket.subscribers == 1) &&
+				(a_ticket.outputIndex == outputIndex) &&
+				(pending.count(a_ticket.frameNumber) != 0);
+		});
+	m_pending.clear();
+}
+
+// END OF void MarkerScanner::cancelPending()
+//==============================================================================
+
+void MarkerScanner::save()
+{
+	m_unsavedFrames = 0;
+
+	if(m_scriptName.isEmpty() || (m_outputIndex < 0))
+		return;
+
+	QString markersFilePath = m_scriptName +
+		QString(TIMELINE_MARKERS_FILE_SUFFIX);
+	QFile markersFile(markersFilePath);
+	if(!markersFile.open(QIODevice::WriteOnly))
+		return;
+
+	// Scanned and marked frames are written as ranges,
+	// which keeps the file small for long clips.
+	QStringList lines;
+	lines += QString("script=%1").arg(QString::fromLatin1(m_scriptHash));
+	lines += QString("prop=%1").arg(m_prop);
+	lines += QString("filter=%1").arg(TIMELINE_MARKERS_FILTER);
+	lines += QString("output=%1").arg(m_outputIndex);
+	lines += QString("frames=%1").arg(m_frameMarkers.framesNumber());
+	lines += QString("scanned=%1").arg(m_frameMarkers.scannedRuns());
+	lines += QString("marked=%1").arg(m_frameMarkers.markedRuns());
+	markersFile.write(lines.join("\n").toUtf8());
+	markersFile.close();
+}
+
+// END OF void MarkerScanner::save()
+//==============================================================================
@@ -0,0 +1,120 @@
+#ifndef MARKER_SCANNER_H_INCLUDED
+#define MARKER_SCANNER_H_INCLUDED
+
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../../common-src/timeline_slider/frame_markers.h"
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <set>
+#include <functional>
+
+//==============================================================================
+
+// Scans the frames of an output for a frame property in the background
+// and keeps the frames it marks in a file next to the script, so an
+// interrupted scan is resumed where it stopped.
+class MarkerScanner : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	// Cancels the tickets the predicate matches, so the discards they
+	// are answered with are not taken for failed frames.
+	typedef std::function<void(const FrameTicketPredicate & a_predicate)>
+		CancelFunction;
+
+	MarkerScanner(VapourSynthScriptProcessor * a_pProcessor,
+		const CancelFunction & a_cancelFrameTickets,
+		QObject * a_pParent = nullptr);
+
+	virtual ~MarkerScanner();
+
+	// The markers are of the frames of one output with the property
+	// prop() set and not zero.
+	const FrameMarkers * frameMarkers() const;
+
+	QString prop() const;
+
+	void setScriptName(const QString & a_scriptName);
+
+	// Loads the markers of the script and resumes the scan if it was
+	// not complete. The hex hash of the script is kept in the markers file
+	// to tell stale markers.
+	void load(const QByteArray & a_scriptHash);
+
+	// Starts the scan of the output anew unless it is the one scanned.
+	void scan(const QString & a_prop, int a_outputIndex, int a_framesNumber);
+
+	// Drops the markers and their file.
+	void clear();
+
+	// Saves the markers and drops the requests in process
+	// of a script that is not previewed any more.
+	void stop();
+
+	// Cancels the requests of the scan until it is resumed.
+	void pause();
+
+	void resume();
+
+	// Returns true if the frame was requested by the scan.
+	bool takeFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpOutputFrame, const VSAPI * a_cpVSAPI);
+
+	// The scan goes on past the frames that fail. They are not marked
+	// scanned, so they are retried when the scan is resumed.
+	bool discardFrame(int a_frameNumber, int a_outputIndex);
+
+signals:
+
+	void signalWriteLogMessage(int a_messageType,
+		const QString & a_message);
+
+	void signalProgress(const QString & a_message);
+
+	void signalFinished();
+
+	void signalMarkersChanged();
+
+private:
+
+	// Keeps the frames of the scan requested within the window.
+	// The scan goes on from the first frame not scanned yet.
+	void requestFrames();
+
+	void updateProgress();
+
+	void finish();
+
+	// Cancels the requests of the scan, so it can be resumed later.
+	void cancelPending();
+
+	void save();
+
+	VapourSynthScriptProcessor * m_pProcessor;
+
+	CancelFunction m_cancelFrameTickets;
+
+	QString m_scriptName;
+
+	FrameMarkers m_frameMarkers;
+	QString m_prop;
+	int m_outputIndex;
+	QByteArray m_scriptHash;
+	bool m_scanning;
+	bool m_paused;
+	int m_scanNext;
+	std::set<int> m_pending;
+	int m_failedFrames;
+	int m_unsavedFrames;
+	int m_progress;
+};
+
+//==============================================================================
+
+#endif // MARKER_SCANNER_H_INCLUDED
@@ -0,0 +1,112 @@
+#include "playback_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+
+// Frames the statistics are taken over.
+const size_t PLAYBACK_STATISTICS_WINDOW = 240;
+
+//==============================================================================
+
+PlaybackStatistics::PlaybackStatistics():
+	  m_framesShown(0)
+	, m_framesDropped(0)
+{
+}
+
+// END OF PlaybackStatistics::PlaybackStatistics()
+//==============================================================================
+
+PlaybackStatistics::~PlaybackStatistics()
+{
+}
+
+// END OF PlaybackStatistics::~PlaybackStatistics()
+//==============================================================================
+
+void PlaybackStatistics::reset()
+{
+	m_framesShown = 0;
+	m_framesDropped = 0;
+	m_showTimes.clear();
+	m_lateness.clear();
+}
+
+// END OF void PlaybackStatistics::reset()
+//==============================================================================
+
+void PlaybackStatistics::frameShown(const hr_time_point & a_time,
+	double a_lateness)
+{
+	m_framesShown++;
+
+	m_showTimes.push_back(a_time);
+	if(m_showTimes.size() > PLAYBACK_STATISTICS_WINDOW)
+		m_showTimes.pop_front();
+
+	m_lateness.push_back(std::max(a_lateness, 0.0));
+	if(m_lateness.size() > PLAYBACK_STATISTICS_WINDOW)
+		m_lateness.pop_front();
+}
+
+// END OF void PlaybackStatistics::frameShown(const hr_time_point & a_time,
+//		double a_lateness)
+//==============================================================================
+
+void PlaybackStatistics::frameDropped()
+{
+	m_framesDropped++;
+}
+
+// END OF void PlaybackStatistics::frameDropped()
+//==============================================================================
+
+size_t PlaybackStatistics::framesShown() const
+{
+	return m_framesShown;
+}
+
+// END OF size_t PlaybackStatistics::framesShown() const
+//==============================================================================
+
+size_t PlaybackStatistics::framesDropped() const
+{
+	return m_framesDropped;
+}
+
+// END OF size_t PlaybackStatistics::framesDropped() const
+//==============================================================================
+
+double PlaybackStatistics::fps() const
+{
+	if(m_showTimes.size() < 2)
+		return 0.0;
+
+	double seconds = duration_to_double(m_showTimes.back() -
+		m_showTimes.front());
+	if(seconds <= 0.0)
+		return 0.0;
+	return (double)(m_showTimes.size() - 1) / seconds;
+}
+
+// END OF double PlaybackStatistics::fps() const
+//==============================================================================
+
+double PlaybackStatistics::jitterPercentile(double a_percent) const
+{
+	if(m_lateness.empty())
+		return 0.0;
+
+	std::vector<double> lateness(m_lateness.begin(), m_lateness.end());
+	double rank = std::ceil(a_percent / 100.0 * lateness.size());
+	size_t index = (size_t)std::max(rank, 1.0) - 1;
+	index = std::min(index, lateness.size() - 1);
+	std::nth_element(lateness.begin(), lateness.begin() + index,
+		lateness.end());
+	return lateness[index];
+}
+
+// END OF double PlaybackStatistics::jitterPercentile(double a_percent) const
+//==============================================================================
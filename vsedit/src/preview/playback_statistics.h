@@ -0,0 +1,51 @@
+#ifndef PLAYBACK_STATISTICS_H_INCLUDED
+#define PLAYBACK_STATISTICS_H_INCLUDED
+
+#include "../../../common-src/chrono.h"
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+//==============================================================================
+
+// Measures how well the playback keeps to its schedule. Frame rate and
+// jitter are taken over the recently shown frames only, so the numbers
+// follow changes of the load. Jitter is how late a frame was shown against
+// the time it was due.
+class PlaybackStatistics
+{
+public:
+
+	PlaybackStatistics();
+
+	virtual ~PlaybackStatistics();
+
+	void reset();
+
+	void frameShown(const hr_time_point & a_time, double a_lateness);
+
+	void frameDropped();
+
+	size_t framesShown() const;
+
+	size_t framesDropped() const;
+
+	// Frames per second over the recent frames.
+	double fps() const;
+
+	// Lateness in seconds that a_percent of the recent frames keep within.
+	double jitterPercentile(double a_percent) const;
+
+private:
+
+	size_t m_framesShown;
+	size_t m_framesDropped;
+
+	std::deque<hr_time_point> m_showTimes;
+	std::deque<double> m_lateness;
+};
+
+//==============================================================================
+
+#endif // PLAYBACK_STATISTICS_H_INCLUDED
@@ -127,6 +127,17 @@ void PreviewAdvancedSettingsDialog::slotCall()
 	if(comboIndex != -1)
 		m_ui.syncOutputComboBox->setCurrentIndex(comboIndex);
 
+	m_ui.frameRequestsLimitSpinBox->setValue(
+		m_pSettingsManager->getFrameRequestsLimit());
+	m_ui.fastYuvToRgbCheckBox->setChecked(
+		m_pSettingsManager->getFastYuvToRgb());
+	m_ui.previewAtDisplaySizeCheckBox->setChecked(
+		m_pSettingsManager->getPreviewAtDisplaySize());
+	m_ui.previewFrameCacheSizeSpinBox->setValue(
+		m_pSettingsManager->getPreviewFrameCacheSize());
+	m_ui.previewPrefetchFramesSpinBox->setValue(
+		m_pSettingsManager->getPreviewPrefetchFrames());
+
 	show();
 }
 
@@ -164,6 +175,16 @@ void PreviewAdvancedSettingsDialog::slotApply()
 		m_ui.saveSnapshotTemplateLineEdit->text());
 	m_pSettingsManager->setSyncOutputMode((SyncOutputNodesMode)
 		m_ui.syncOutputComboBox->currentData().toInt());
+	m_pSettingsManager->setFrameRequestsLimit(
+		m_ui.frameRequestsLimitSpinBox->value());
+	m_pSettingsManager->setFastYuvToRgb(
+		m_ui.fastYuvToRgbCheckBox->isChecked());
+	m_pSettingsManager->setPreviewAtDisplaySize(
+		m_ui.previewAtDisplaySizeCheckBox->isChecked());
+	m_pSettingsManager->setPreviewFrameCacheSize(
+		m_ui.previewFrameCacheSizeSpinBox->value());
+	m_pSettingsManager->setPreviewPrefetchFrames(
+		m_ui.previewPrefetchFramesSpinBox->value());
 
 	emit signalSettingsChanged();
 }
@@ -208,6 +229,15 @@ void PreviewAdvancedSettingsDialog::slotResetToDefault()
 	m_ui.silentSnapshotCheckBox->setChecked(DEFAULT_SILENT_SNAPSHOT);
 	m_ui.saveSnapshotTemplateLineEdit->setText(DEFAULT_SNAPSHOT_TEMPLATE);
 	m_ui.saveSnapshotTemplateLineEdit->setEnabled(false);
+
+	m_ui.frameRequestsLimitSpinBox->setValue(DEFAULT_FRAME_REQUESTS_LIMIT);
+	m_ui.fastYuvToRgbCheckBox->setChecked(DEFAULT_FAST_YUV_TO_RGB);
+	m_ui.previewAtDisplaySizeCheckBox->setChecked(
+		DEFAULT_PREVIEW_AT_DISPLAY_SIZE);
+	m_ui.previewFrameCacheSizeSpinBox->setValue(
+		DEFAULT_PREVIEW_FRAME_CACHE_SIZE);
+	m_ui.previewPrefetchFramesSpinBox->setValue(
+		DEFAULT_PREVIEW_PREFETCH_FRAMES);
 }
 
 // END OF void PreviewAdvancedSettingsDialog::slotResetToDefault()
@@ -1,8 +1,10 @@
 #include "preview_area.h"
 
 #include "scroll_navigator.h"
+#include "preview_frame_widget.h"
 
 #include <QLabel>
+#include <QRubberBand>
 #include <QKeyEvent>
 #include <QWheelEvent>
 #include <QMouseEvent>
@@ -14,19 +16,23 @@
 //==============================================================================
 
 PreviewArea::PreviewArea(QWidget * a_pParent) : QScrollArea(a_pParent)
-	, m_pPreviewLabel(nullptr)
+	, m_pFrameWidget(nullptr)
 	, m_pScrollNavigator(nullptr)
+	, m_pOverlayLabel(nullptr)
+	, m_pRegionBand(nullptr)
+	, m_pRegionLabel(nullptr)
+	, m_regionSelection(false)
+	, m_selectingRegion(false)
+	, m_regionOrigin(0, 0)
 	, m_draggingPreview(false)
 	, m_lastCursorPos(0, 0)
 	, m_lastPreviewLabelPos(0, 0)
 	, m_lastScenePos(0.0, 0.0)
 	, m_newToPreviewer(false)
 {
-	m_pPreviewLabel = new QLabel(this);
-	m_pPreviewLabel->setPixmap(QPixmap());
-	m_pPreviewLabel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-	m_pPreviewLabel->move(0, 0);
-	QScrollArea::setWidget(m_pPreviewLabel);
+	m_pFrameWidget = new PreviewFrameWidget(this);
+	m_pFrameWidget->move(0, 0);
+	QScrollArea::setWidget(m_pFrameWidget);
 	setWidgetResizable(true);
 
 	m_pScrollNavigator = new ScrollNavigator(this);
@@ -35,9 +41,27 @@ PreviewArea::PreviewArea(QWidget * a_pParent) : QScrollArea(a_pParent)
 		QPoint(scrollFrameWidth, scrollFrameWidth));
 	m_pScrollNavigator->setVisible(false);
 
+	m_pOverlayLabel = new QLabel(this);
+	m_pOverlayLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+	m_pOverlayLabel->setTextFormat(Qt::PlainText);
+	m_pOverlayLabel->setStyleSheet(
+		"QLabel {color: white; background-color: rgba(0, 0, 0, 160);"
+		" padding: 4px; font-family: monospace;}");
+	m_pOverlayLabel->setVisible(false);
+
+	// The band is a child of the frame, so it scrolls along.
+	m_pRegionBand = new QRubberBand(QRubberBand::Rectangle, m_pFrameWidget);
+	m_pRegionBand->setVisible(false);
+
+	m_pRegionLabel = new QLabel(this);
+	m_pRegionLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+	m_pRegionLabel->setTextFormat(Qt::PlainText);
+	m_pRegionLabel->setStyleSheet(m_pOverlayLabel->styleSheet());
+	m_pRegionLabel->setVisible(false);
+
 	setAttribute(Qt::WA_Hover, true);
 	setMouseTracking(true);
-	m_pPreviewLabel->setMouseTracking(true);
+	m_pFrameWidget->setMouseTracking(true);
 }
 
 // END OF PreviewArea::PreviewArea(QWidget * a_pParent)
@@ -51,11 +75,28 @@ PreviewArea::~PreviewArea()
 // END OF PreviewArea::~PreviewArea()
 //==============================================================================
 
-void PreviewArea::setPixmap(const QPixmap & a_pixmap, bool a_isVideoFrame)
+int PreviewArea::displayWidth() const
 {
-	m_pPreviewLabel->setPixmap(a_pixmap);
-	m_pixmapWidth = a_pixmap.width();
-	m_pixmapHeight = a_pixmap.height();
+	return m_pFrameWidget->displaySize().width();
+}
+
+// END OF int PreviewArea::displayWidth() const
+//==============================================================================
+
+int PreviewArea::displayHeight() const
+{
+	return m_pFrameWidget->displaySize().height();
+}
+
+// END OF int PreviewArea::displayHeight() const
+//==============================================================================
+
+void PreviewArea::setFrame(const QImage & a_image, const QRect & a_sourceRect,
+	const QSize & a_displaySize, Qt::TransformationMode a_scaleMode,
+	bool a_isVideoFrame)
+{
+	m_pFrameWidget->setFrame(a_image, a_sourceRect, a_displaySize,
+		a_scaleMode);
 	if(a_isVideoFrame && m_newToPreviewer)
 	{
 		m_newToPreviewer = false;
@@ -64,18 +105,28 @@ void PreviewArea::setPixmap(const QPixmap & a_pixmap, bool a_isVideoFrame)
 	}
 }
 
-// END OF void PreviewArea::setPixmap(const QPixmap & a_pixmap)
+// END OF void PreviewArea::setFrame(const QImage & a_image,
+//		const QRect & a_sourceRect, const QSize & a_displaySize,
+//		Qt::TransformationMode a_scaleMode, bool a_isVideoFrame)
+//==============================================================================
+
+void PreviewArea::setBlank(const QSize & a_displaySize)
+{
+	m_pFrameWidget->setBlank(a_displaySize);
+}
+
+// END OF void PreviewArea::setBlank(const QSize & a_displaySize)
 //==============================================================================
 
 void PreviewArea::checkMouseOverPreview(const QPointF & a_pixelPos) 
 {
-        if(!m_pPreviewLabel->underMouse())
+        if(!m_pFrameWidget->underMouse())
 		return;
 
 	double pX = a_pixelPos.x();
 	double pY = a_pixelPos.y();
 	if(pX < 0 || pY < 0 ||
-		pX >= pixmapWidth() || pY >= pixmapHeight())
+		pX >= displayWidth() || pY >= displayHeight())
 		return;
 
 	emit signalMouseOverPoint(pX, pY);
@@ -121,9 +172,70 @@ void PreviewArea::slotScrollBottom()
 // END OF void PreviewArea::slotScrollBottom()
 //==============================================================================
 
+void PreviewArea::setOverlayText(const QString & a_text)
+{
+	if(a_text.isEmpty())
+	{
+		m_pOverlayLabel->setVisible(false);
+		return;
+	}
+
+	m_pOverlayLabel->setText(a_text);
+	m_pOverlayLabel->adjustSize();
+	placeOverlay();
+	m_pOverlayLabel->setVisible(true);
+	m_pOverlayLabel->raise();
+}
+
+// END OF void PreviewArea::setOverlayText(const QString & a_text)
+//==============================================================================
+
+void PreviewArea::setRegionSelection(bool a_enabled)
+{
+	m_regionSelection = a_enabled;
+	if(a_enabled)
+		return;
+
+	m_selectingRegion = false;
+	m_pRegionBand->setVisible(false);
+	setRegionText(QString());
+}
+
+// END OF void PreviewArea::setRegionSelection(bool a_enabled)
+//==============================================================================
+
+QRect PreviewArea::region() const
+{
+	if(!m_pRegionBand->isVisible())
+		return QRect();
+	return m_pRegionBand->geometry();
+}
+
+// END OF QRect PreviewArea::region() const
+//==============================================================================
+
+void PreviewArea::setRegionText(const QString & a_text)
+{
+	if(a_text.isEmpty())
+	{
+		m_pRegionLabel->setVisible(false);
+		return;
+	}
+
+	m_pRegionLabel->setText(a_text);
+	m_pRegionLabel->adjustSize();
+	placeOverlay();
+	m_pRegionLabel->setVisible(true);
+	m_pRegionLabel->raise();
+}
+
+// END OF void PreviewArea::setRegionText(const QString & a_text)
+//==============================================================================
+
 void PreviewArea::resizeEvent(QResizeEvent * a_pEvent)
 {
 	QScrollArea::resizeEvent(a_pEvent);
+	placeOverlay();
 	emit signalSizeChanged();
 }
 
@@ -171,11 +283,22 @@ void PreviewArea::wheelEvent(QWheelEvent * a_pEvent)
 
 void PreviewArea::mousePressEvent(QMouseEvent * a_pEvent)
 {
+	if(m_regionSelection && (a_pEvent->buttons() == Qt::LeftButton))
+	{
+		m_selectingRegion = true;
+		m_regionOrigin = m_pFrameWidget->mapFromGlobal(
+			a_pEvent->globalPosition().toPoint());
+		m_pRegionBand->setGeometry(QRect(m_regionOrigin, QSize()));
+		m_pRegionBand->setVisible(true);
+		a_pEvent->accept();
+		return;
+	}
+
 	if(a_pEvent->buttons() == Qt::LeftButton)
 	{
 		m_draggingPreview = true;
 		m_lastCursorPos = a_pEvent->globalPosition().toPoint();
-		m_lastPreviewLabelPos = m_pPreviewLabel->pos();
+		m_lastPreviewLabelPos = m_pFrameWidget->pos();
 		m_pScrollNavigator->setVisible(true);
 		drawScrollNavigator();
 		a_pEvent->accept();
@@ -190,6 +313,22 @@ void PreviewArea::mousePressEvent(QMouseEvent * a_pEvent)
 
 void PreviewArea::mouseMoveEvent(QMouseEvent * a_pEvent)
 {
+	if((a_pEvent->buttons() & Qt::LeftButton) && m_selectingRegion)
+	{
+		QPoint cursorPos = m_pFrameWidget->mapFromGlobal(
+			a_pEvent->globalPosition().toPoint());
+		QSizeF frameSize = QSizeF(m_pFrameWidget->displaySize()) /
+			m_pFrameWidget->devicePixelRatioF();
+		QRect frameRect(QPoint(0, 0), frameSize.toSize());
+		m_pRegionBand->setGeometry(
+			QRect(m_regionOrigin, cursorPos).normalized() & frameRect);
+		m_lastScenePos = a_pEvent->scenePosition();
+		checkMouseOverPreview(pixelPosition());
+		emit signalRegionChanged();
+		a_pEvent->accept();
+		return;
+	}
+
 	if((a_pEvent->buttons() & Qt::LeftButton) && m_draggingPreview)
 	{
 		QPoint newCursorPos = a_pEvent->globalPosition().toPoint();
@@ -216,7 +355,14 @@ void PreviewArea::mouseMoveEvent(QMouseEvent * a_pEvent)
 void PreviewArea::mouseReleaseEvent(QMouseEvent * a_pEvent)
 {
 	Qt::MouseButton releasedButton = a_pEvent->button();
-	if(releasedButton == Qt::LeftButton)
+	if((releasedButton == Qt::LeftButton) && m_selectingRegion)
+	{
+		m_selectingRegion = false;
+		emit signalRegionChanged();
+		a_pEvent->accept();
+		return;
+	}
+	else if(releasedButton == Qt::LeftButton)
 	{
 		m_draggingPreview = false;
 		m_pScrollNavigator->setVisible(false);
@@ -244,10 +390,10 @@ void PreviewArea::enterEvent(QEnterEvent *a_pEvent)
 
 void PreviewArea::drawScrollNavigator()
 {
-	int contentsWidth = this->pixmapWidth();
-	int contentsHeight = this->pixmapHeight();
-	int viewportX = -m_pPreviewLabel->x();
-	int viewportY = -m_pPreviewLabel->y();
+	int contentsWidth = displayWidth();
+	int contentsHeight = displayHeight();
+	int viewportX = -m_pFrameWidget->x();
+	int viewportY = -m_pFrameWidget->y();
 	int viewportWidth = viewport()->width();
 	int viewportHeight = viewport()->height();
 
@@ -260,7 +406,7 @@ void PreviewArea::drawScrollNavigator()
 
 QPointF PreviewArea::pixelPosition() const
 {
-	QPoint lPos = m_pPreviewLabel->geometry().topLeft();
+	QPoint lPos = m_pFrameWidget->geometry().topLeft();
 	QMargins lMargin = contentsMargins();
 	QPoint mOffset = QPoint(lMargin.left(), lMargin.top());
 	return m_lastScenePos - lPos - mOffset;
@@ -284,3 +430,15 @@ void PreviewArea::getScrollBarPositionsFromPreviewer(const QPoint & pos)
 	m_newToPreviewer = true;
 	m_lastScrollBarPos = pos;
 }
+
+void PreviewArea::placeOverlay()
+{
+	QRect viewportRect = viewport()->geometry();
+	m_pOverlayLabel->move(viewportRect.x() + viewportRect.width() -
+		m_pOverlayLabel->width(), viewportRect.y());
+	m_pRegionLabel->move(viewportRect.x(), viewportRect.y() +
+		viewportRect.height() - m_pRegionLabel->height());
+}
+
+// END OF void PreviewArea::placeOverlay()
+//==============================================================================
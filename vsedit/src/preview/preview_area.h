@@ -2,11 +2,14 @@
 #define PREVIEWAREA_H
 
 #include <QScrollArea>
-#include <QPixmap>
+#include <QImage>
 #include <QPoint>
+#include <QRect>
 
 class QLabel;
+class QRubberBand;
 class ScrollNavigator;
+class PreviewFrameWidget;
 class QKeyEvent;
 class QWheelEvent;
 class QMouseEvent;
@@ -24,11 +27,18 @@ public:
 
 	void setWidget(QWidget * a_pWidget) = delete;
 
-	int pixmapWidth() const { return m_pixmapWidth; }
+	// Size of the shown frame in device pixels.
+	int displayWidth() const;
 
-	int pixmapHeight() const { return m_pixmapHeight; }
+	int displayHeight() const;
 
-	void setPixmap(const QPixmap & a_pixmap, bool a_isVideoFrame = false);
+	// The image is painted as it is, without a copy, and must stay valid
+	// until it is replaced by another frame or a blank.
+	void setFrame(const QImage & a_image, const QRect & a_sourceRect,
+		const QSize & a_displaySize, Qt::TransformationMode a_scaleMode,
+		bool a_isVideoFrame = false);
+
+	void setBlank(const QSize & a_displaySize = QSize(0, 0));
 
 	void checkMouseOverPreview(const QPointF & a_pixelPos);
 
@@ -38,6 +48,22 @@ public:
 
 	void getScrollBarPositionsFromPreviewer(const QPoint & pos);
 
+	// Text shown over the top right corner of the preview. An empty text
+	// hides it.
+	void setOverlayText(const QString & a_text);
+
+	// In region selection mode dragging with the left button marks
+	// a rectangle instead of scrolling the preview.
+	void setRegionSelection(bool a_enabled);
+
+	// The marked rectangle in the coordinates of pixelPosition().
+	// Empty when nothing is marked.
+	QRect region() const;
+
+	// Text shown over the bottom left corner of the preview. An empty text
+	// hides it.
+	void setRegionText(const QString & a_text);
+
 public slots:
 
 	void slotScrollLeft();
@@ -64,23 +90,31 @@ signals:
 	void signalMouseMiddleButtonReleased();
 	void signalMouseRightButtonReleased();
 	void signalMouseOverPoint(double a_normX, double a_normY);
+	void signalRegionChanged();
 
 private:
 
 	void drawScrollNavigator();
 
-	QLabel * m_pPreviewLabel;
+	void placeOverlay();
+
+	PreviewFrameWidget * m_pFrameWidget;
 
 	ScrollNavigator * m_pScrollNavigator;
 
+	QLabel * m_pOverlayLabel;
+
+	QRubberBand * m_pRegionBand;
+	QLabel * m_pRegionLabel;
+	bool m_regionSelection;
+	bool m_selectingRegion;
+	QPoint m_regionOrigin;
+
 	bool m_draggingPreview;
 	QPoint m_lastCursorPos;
 	QPoint m_lastPreviewLabelPos;
 	QPointF m_lastScenePos;
 
-	int m_pixmapWidth = 0;
-	int m_pixmapHeight = 0;
-
 	bool m_newToPreviewer;
 	QPoint m_lastScrollBarPos;
 };
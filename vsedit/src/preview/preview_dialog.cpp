@@ -3,11 +3,20 @@
 #include "../../../common-src/helpers.h"
 #include "../../../common-src/libp2p/p2p_api.h"
 #include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../../common-src/vapoursynth/vs_script_library.h"
 #include "../../../common-src/settings/settings_manager.h"
 #include "scroll_navigator.h"
 #include "../../../common-src/timeline_slider/timeline_slider.h"
 #include "preview_advanced_settings_dialog.h"
 #include "zoom_ratio_spinbox.h"
+#include "compare_image.h"
+#include "scopes_panel.h"
+#include "scopes_worker.h"
+#include "compare_metrics_exporter.h"
+#include "batch_snapshot_exporter.h"
+#include "marker_scanner.h"
+#include "thumbnail_strip.h"
+#include "thumbnail_loader.h"
 
 #include <vapoursynth/VapourSynth4.h>
 #include <vapoursynth/VSHelper4.h>
@@ -31,9 +40,13 @@
 #include <QImageWriter>
 #include <QFileInfo>
 #include <QInputDialog>
+#include <QFile>
+#include <QDir>
 #include <QRegExp>
+#include <QRegularExpression>
 #include <algorithm>
 #include <cmath>
+#include <deque>
 
 #ifdef Q_OS_WIN // AUDIO
 #include <QMediaDevices>
@@ -87,6 +100,16 @@ bool PreviewDialog::AudioFrame::operator==(const AudioFrame &a_other) const
 
 const char TIMELINE_BOOKMARKS_FILE_SUFFIX[] = ".bookmarks";
 
+// Milliseconds the preview area has to keep its size before the frames
+// are converted at the new size.
+const int PREVIEW_SIZE_UPDATE_DELAY = 200;
+
+// Seconds between the updates of the playback statistics overlay.
+const double PLAYBACK_STATISTICS_UPDATE_INTERVAL = 0.25;
+
+// Outputs compared at once.
+const size_t COMPARE_MAX_OUTPUTS = 4;
+
 //==============================================================================
 
 PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
@@ -100,10 +123,30 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 	, m_bigFrameStep(10)
 	, m_cpFrame(nullptr)
 	, m_cpPreviewFrame(nullptr)
+	, m_previewFrameCache()
+	, m_frameToCache(-1)
+	, m_prefetchWindow(DEFAULT_PREVIEW_PREFETCH_FRAMES)
 	, m_changingCropValues(false)
+	, m_compareMode(DEFAULT_COMPARE_MODE)
+	, m_compareOutputs()
+	, m_compareWipePosition(0.5)
+	, m_compareFrameNumber(-1)
+	, m_comparedFrames()
+	, m_comparedFramesPending()
+	, m_comparedFramesStale(false)
+	, m_compareImage()
+	, m_frameMetrics()
+	, m_frameMetricsRequested()
+	, m_pCompareMetricsExporter(nullptr)
+	, m_pBatchSnapshotExporter(nullptr)
+	, m_fullSizeFrameRequests()
+	, m_pThumbnailStrip(nullptr)
+	, m_pThumbnailLoader(nullptr)
+	, m_pMarkerScanner(nullptr)
 	, m_pPreviewContextMenu(nullptr)
 	, m_pActionFrameToClipboard(nullptr)
 	, m_pActionSaveSnapshot(nullptr)
+	, m_pActionBatchSnapshotExport(nullptr)
 	, m_pActionToggleZoomPanel(nullptr)
 	, m_pMenuZoomModes(nullptr)
 	, m_pActionGroupZoomModes(nullptr)
@@ -125,16 +168,28 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 	, m_pActionPasteCropSnippetIntoScript(nullptr)
 	, m_pActionAdvancedSettingsDialog(nullptr)
 	, m_pActionToggleColorPicker(nullptr)
+	, m_pActionToggleRegionStatistics(nullptr)
+	, m_pActionShowNodeTiming(nullptr)
 	, m_pActionPlay(nullptr)
+	, m_pActionToggleRealTimePlay(nullptr)
+	, m_pActionTogglePlaybackStatistics(nullptr)
+	, m_pActionCompareFlip(nullptr)
+	, m_pActionExportCompareMetrics(nullptr)
 	, m_pActionLoadChapters(nullptr)
 	, m_pActionClearBookmarks(nullptr)
 	, m_pActionBookmarkCurrentFrame(nullptr)
 	, m_pActionUnbookmarkCurrentFrame(nullptr)
 	, m_pActionGoToPreviousBookmark(nullptr)
 	, m_pActionGoToNextBookmark(nullptr)
+	, m_pActionScanMarkers(nullptr)
+	, m_pActionClearMarkers(nullptr)
+	, m_pActionGoToPreviousMarker(nullptr)
+	, m_pActionGoToNextMarker(nullptr)
 	, m_pActionPasteShownFrameNumberIntoScript(nullptr)
 	, m_pActionJumpToFrame(nullptr)
 	, m_pActionToggleFramePropsPanel(nullptr)
+	, m_pActionToggleScopesPanel(nullptr)
+	, m_pActionToggleThumbnailStrip(nullptr)
 	, m_pActionSwitchToOutputIndex0(nullptr)
 	, m_pActionSwitchToOutputIndex1(nullptr)
 	, m_pActionSwitchToOutputIndex2(nullptr)
@@ -157,13 +212,23 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 	, m_pActionSwitchToOutputIndex19(nullptr)
 	, m_playing(false)
 	, m_processingPlayQueue(false)
+	, m_cancellingFrameTickets(false)
 	, m_nativePlaybackRate(false)
 	, m_secondsBetweenFrames(0)
 	, m_pPlayTimer(nullptr)
+	, m_realTimePlayback(DEFAULT_PLAY_REAL_TIME)
+	, m_playScheduleStarted(false)
+	, m_showPlaybackStatistics(DEFAULT_SHOW_PLAYBACK_STATISTICS)
+	, m_firstFrameTimePending(false)
+	, m_previousScript()
+	, m_previousScriptName()
 	, m_alwaysKeepCurrentFrame(DEFAULT_ALWAYS_KEEP_CURRENT_FRAME)
 	, m_pGeometrySaveTimer(nullptr)
+	, m_pPreviewSizeTimer(nullptr)
 	, m_devicePixelRatio(-1)
 	, m_pFramePropsPanel(nullptr)
+	, m_pScopesPanel(nullptr)
+	, m_pScopesWorker(nullptr)
 	, m_toChangeTitle(false)
 	, m_inPreviewer(a_inPreviewer)
 {
@@ -183,6 +248,25 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 
 	m_pFramePropsPanel = new FramePropsPanel(a_pSettingsManager, this);
 
+	m_pScopesPanel = new ScopesPanel(a_pSettingsManager, this);
+	m_pScopesWorker = new ScopesWorker();
+	m_pCompareMetricsExporter = new CompareMetricsExporter(
+		m_pVapourSynthScriptProcessor);
+	m_pBatchSnapshotExporter = new BatchSnapshotExporter(
+		m_pVapourSynthScriptProcessor);
+	m_pMarkerScanner = new MarkerScanner(m_pVapourSynthScriptProcessor,
+		[this](const FrameTicketPredicate & a_predicate)
+		{
+			cancelFrameTickets(a_predicate);
+		});
+
+	m_pThumbnailStrip = new ThumbnailStrip(this);
+	m_ui.mainLayout->insertWidget(1, m_pThumbnailStrip);
+	m_pThumbnailStrip->setVisible(
+		m_pSettingsManager->getThumbnailStripVisible());
+	m_pThumbnailLoader = new ThumbnailLoader(m_pVapourSynthScriptProcessor,
+		m_pThumbnailStrip);
+
 	createActionsAndMenus();
 
 	createStatusBar();
@@ -190,6 +274,7 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 		m_pSettingsManager->getColorPickerVisible());
 
 	m_ui.frameNumberSlider->setBigStep(m_bigFrameStep);
+	m_ui.frameNumberSlider->setMarkers(m_pMarkerScanner->frameMarkers());
 	m_ui.frameNumberSlider->setDisplayMode(
 		m_pSettingsManager->getTimeLineMode());
 
@@ -201,6 +286,7 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 	setUpZoomPanel();
 	setUpCropPanel();
 	setUpTimeLinePanel();
+	setUpCompareControls();
 
 	m_ui.colorPickerButton->setDefaultAction(m_pActionToggleColorPicker);
 
@@ -209,6 +295,12 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 	connect(m_pGeometrySaveTimer, &QTimer::timeout,
 		this, &PreviewDialog::slotSaveGeometry);
 
+	m_pPreviewSizeTimer = new QTimer(this);
+	m_pPreviewSizeTimer->setInterval(PREVIEW_SIZE_UPDATE_DELAY);
+	m_pPreviewSizeTimer->setSingleShot(true);
+	connect(m_pPreviewSizeTimer, &QTimer::timeout,
+		this, &PreviewDialog::slotUpdatePreviewSize);
+
 	m_windowGeometry = m_pSettingsManager->getPreviewDialogGeometry();
 	if(!m_windowGeometry.isEmpty())
 		restoreGeometry(m_windowGeometry);
@@ -229,8 +321,42 @@ PreviewDialog::PreviewDialog(SettingsManager * a_pSettingsManager,
 		this, SLOT(slotPreviewAreaMouseRightButtonReleased()));
 	connect(m_ui.previewArea, SIGNAL(signalMouseOverPoint(double, double)),
 		this, SLOT(slotPreviewAreaMouseOverPoint(double, double)));
+	connect(m_ui.previewArea, SIGNAL(signalRegionChanged()),
+		this, SLOT(slotPreviewAreaRegionChanged()));
 	connect(m_pPlayTimer, SIGNAL(timeout()),
 		this, SLOT(slotProcessPlayQueue()));
+	connect(m_pVapourSynthScriptProcessor,
+		SIGNAL(signalFrameMetricsReady(const FrameMetrics &)),
+		this, SLOT(slotFrameMetricsReady(const FrameMetrics &)));
+	connect(m_pCompareMetricsExporter,
+		SIGNAL(signalWriteLogMessage(int, const QString &)),
+		this, SIGNAL(signalWriteLogMessage(int, const QString &)));
+	connect(m_pScopesWorker, SIGNAL(signalScopesReady(const Scopes &)),
+		this, SLOT(slotScopesReady(const Scopes &)));
+	connect(m_pVapourSynthScriptProcessor,
+		SIGNAL(signalFullSizePreviewFrameReady(int, int, const VSFrame *)),
+		this, SLOT(slotFullSizePreviewFrameReady(int, int, const VSFrame *)));
+	connect(m_pBatchSnapshotExporter,
+		SIGNAL(signalWriteLogMessage(int, const QString &)),
+		this, SIGNAL(signalWriteLogMessage(int, const QString &)));
+	connect(m_pBatchSnapshotExporter, SIGNAL(signalProgress(const QString &)),
+		m_pStatusBar, SLOT(showMessage(const QString &)));
+	connect(m_pBatchSnapshotExporter, SIGNAL(signalFinished()),
+		m_pStatusBar, SLOT(clearMessage()));
+	connect(m_pMarkerScanner,
+		SIGNAL(signalWriteLogMessage(int, const QString &)),
+		this, SIGNAL(signalWriteLogMessage(int, const QString &)));
+	connect(m_pMarkerScanner, SIGNAL(signalProgress(const QString &)),
+		m_pStatusBar, SLOT(showMessage(const QString &)));
+	connect(m_pMarkerScanner, SIGNAL(signalFinished()),
+		m_pStatusBar, SLOT(clearMessage()));
+	connect(m_pMarkerScanner, SIGNAL(signalMarkersChanged()),
+		m_ui.frameNumberSlider, SLOT(update()));
+	connect(m_pVapourSynthScriptProcessor,
+		SIGNAL(signalThumbnailReady(int, int, const VSFrame *)),
+		this, SLOT(slotThumbnailReady(int, int, const VSFrame *)));
+	connect(m_pThumbnailStrip, SIGNAL(signalFrameClicked(int)),
+		this, SLOT(slotThumbnailStripFrameClicked(int)));
 
 #ifdef Q_OS_WIN // AUDIO
 	qputenv("QT_MEDIA_BACKEND", QString("windows").toLocal8Bit());
@@ -272,6 +398,13 @@ PreviewDialog::~PreviewDialog()
 		slotSaveGeometry();
 	}
 	delete m_pFramePropsPanel;
+	delete m_pScopesPanel;
+	// Lets go of the frames before the processor is finalized.
+	delete m_pScopesWorker;
+	delete m_pCompareMetricsExporter;
+	delete m_pBatchSnapshotExporter;
+	delete m_pMarkerScanner;
+	delete m_pThumbnailLoader;
 }
 
 // END OF PreviewDialog::~PreviewDialog()
@@ -280,6 +413,7 @@ PreviewDialog::~PreviewDialog()
 void PreviewDialog::setScriptName(const QString & a_scriptName)
 {
 	VSScriptProcessorDialog::setScriptName(a_scriptName);
+	m_pMarkerScanner->setScriptName(a_scriptName);
 	setTitle();
 }
 
@@ -289,18 +423,33 @@ void PreviewDialog::setScriptName(const QString & a_scriptName)
 void PreviewDialog::previewScript(const QString& a_script,
 	const QString& a_scriptName)
 {
-	QString previousScript = script();
-	QString previousScriptName = scriptName();
+	if(!m_pVapourSynthScriptProcessor->isInitializing())
+	{
+		m_previousScript = script();
+		m_previousScriptName = scriptName();
+	}
 	m_scriptTextChanged = false;
+	m_previewStartTime = hr_clock::now();
+	m_firstFrameTimePending = false;
 
 	if(!m_inPreviewer)
 		stopAndCleanUp();
 
-	bool initialized = initialize(a_script, a_scriptName,
-		ProcessReason::Preview);
-	if(!initialized)
+	initializeAsync(a_script, a_scriptName, ProcessReason::Preview);
+}
+
+// END OF void PreviewDialog::previewScript(const QString& a_script,
+//		const QString& a_scriptName)
+//==============================================================================
+
+void PreviewDialog::slotScriptProcessorInitialized(bool a_success)
+{
+	VSScriptProcessorDialog::slotScriptProcessorInitialized(a_success);
+	if(!a_success)
 		return;
 
+	m_firstFrameTimePending = true;
+
 	m_outputIndices = m_pVapourSynthScriptProcessor->getOutputIndices();
 	if(m_outputIndices.size() > 0)
 	{
@@ -314,6 +463,8 @@ void PreviewDialog::previewScript(const QString& a_script,
 		// Use old layout
 		m_ui.outputIndexLabel->hide();
 		m_ui.outputIndexComboBox->hide();
+		m_ui.compareModeComboBox->hide();
+		m_ui.compareOutputsEdit->hide();
 		m_ui.frameLabel->hide();
 	}
 
@@ -358,6 +509,7 @@ void PreviewDialog::previewScript(const QString& a_script,
 		m_pActionToggleCropPanel->setEnabled(false);
 		m_ui.saveSnapshotButton->setEnabled(false);
 		m_pActionSaveSnapshot->setEnabled(false);
+		m_pActionBatchSnapshotExport->setEnabled(false);
 		m_pStatusBarWidget->setColorPickerString("");
 		m_ui.playFpsLimitSpinBox->setEnabled(false);
 		m_ui.playFpsLimitModeComboBox->setEnabled(false);
@@ -383,13 +535,13 @@ void PreviewDialog::previewScript(const QString& a_script,
 		0.0 : (double)m_fpsNum / (double)m_fpsDen);
 #endif
 
-	bool scriptChanged = ((previousScript != a_script) &&
-		(previousScriptName != a_scriptName));
+	bool scriptChanged = ((m_previousScript != script()) &&
+		(m_previousScriptName != scriptName()));
 
 	if(scriptChanged && (!m_alwaysKeepCurrentFrame))
 	{
 		m_frameExpected = 0;
-		m_ui.previewArea->setPixmap(QPixmap());
+		m_ui.previewArea->setBlank();
 	}
 
 	if(m_frameExpected > lastFrameNumber)
@@ -399,9 +551,11 @@ void PreviewDialog::previewScript(const QString& a_script,
 
 	slotSetPlayFPSLimit();
 
-	setScriptName(a_scriptName);
+	setScriptName(scriptName());
 
 	loadTimelineBookmarks();
+	m_pMarkerScanner->load(
+		VSScriptLibrary::scriptContentsHash(script(), scriptName()).toHex());
 
 	if(m_pSettingsManager->getPreviewDialogMaximized())
 		showMaximized();
@@ -419,7 +573,14 @@ void PreviewDialog::previewScript(const QString& a_script,
 	else if(m_frameExpected < 0)
 		setExpectedFrame(0);
 
+	m_previewFrameCache.setVSAPI(m_cpVSAPI);
+	resetPreviewFrameCache();
+	updateCompareOutputs();
+
+	updatePreviewSize();
 	slotShowFrame(m_frameExpected, false);
+	resetThumbnails();
+	m_pMarkerScanner->resume();
 
 	if(m_outputIndices.size() > 0)
 	{
@@ -435,8 +596,7 @@ void PreviewDialog::previewScript(const QString& a_script,
 	setTitle();
 }
 
-// END OF void PreviewDialog::previewScript(const QString& a_script,
-//		const QString& a_scriptName)
+// END OF void PreviewDialog::slotScriptProcessorInitialized(bool a_success)
 //==============================================================================
 
 void PreviewDialog::stopAndCleanUp()
@@ -455,16 +615,26 @@ void PreviewDialog::stopAndCleanUp()
 		m_pSettingsManager->setLastPreviewTimestamp(m_frameTimestampExpected, m_inPreviewer);
 	}
 	m_frameShown = -1;
-	m_framePixmap = QPixmap();
+	clearPreviewFrameCache();
+	clearComparedFrames();
+	m_compareImage = QImage();
+	m_frameMetrics = FrameMetrics();
+	m_frameMetricsRequested = FrameMetrics();
+	m_pCompareMetricsExporter->clear();
+	m_pBatchSnapshotExporter->clear();
+	m_fullSizeFrameRequests.clear();
+	m_pThumbnailLoader->clear();
+	m_pMarkerScanner->stop();
+	m_pScopesWorker->clear();
+	m_pScopesPanel->clear();
 	// Replace shown image with a blank one of the same dimension:
 	// -helps to keep the scrolling position when refreshing the script;
 	// -leaves the image blank on sudden error;
 	// -creates a blinking effect indicating the script is being refreshed.
-	int pixmapWidth = m_ui.previewArea->pixmapWidth();
-	int pixmapHeight = m_ui.previewArea->pixmapHeight();
-	QPixmap blackPixmap(pixmapWidth, pixmapHeight);
-	blackPixmap.fill(Qt::black);
-	m_ui.previewArea->setPixmap(blackPixmap);
+	// The preview area lets go of the frame memory before it is freed.
+	m_ui.previewArea->setBlank(QSize(m_ui.previewArea->displayWidth(),
+		m_ui.previewArea->displayHeight()));
+	m_frameImage = QImage();
 
 	if(m_cpFrame)
 	{
@@ -525,6 +695,7 @@ void PreviewDialog::changeEvent(QEvent * a_pEvent)
 void PreviewDialog::closeEvent(QCloseEvent *a_pEvent)
 {
 	m_pFramePropsPanel->setVisible(false);
+	m_pScopesPanel->setVisible(false);
 	if(m_inPreviewer)
 	{
 		slotSaveGeometry();
@@ -608,6 +779,18 @@ void PreviewDialog::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 	if(!a_cpOutputFrame)
 		return;
 
+	if(m_pMarkerScanner->takeFrame(a_frameNumber, a_outputIndex,
+		a_cpOutputFrame, m_cpVSAPI))
+		return;
+
+	if(takeComparedFrame(a_frameNumber, a_outputIndex, a_cpOutputFrame,
+		a_cpPreviewFrame))
+		return;
+
+	if((!m_playing) && takePrefetchedFrame(a_frameNumber, a_outputIndex,
+		a_cpOutputFrame, a_cpPreviewFrame))
+		return;
+
 	Q_ASSERT(m_cpVSAPI);
 	const VSFrame * cpOutputFrame =
 		m_cpVSAPI->addFrameRef(a_cpOutputFrame);
@@ -618,7 +801,12 @@ void PreviewDialog::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 	{
 		Frame newFrame(a_frameNumber, a_outputIndex,
 			cpOutputFrame, cpPreviewFrame);
-		m_framesCache[m_outputIndex].push_back(newFrame);
+		if(!m_framesCache[m_outputIndex].put(newFrame))
+		{
+			m_cpVSAPI->freeFrame(cpOutputFrame);
+			m_cpVSAPI->freeFrame(cpPreviewFrame);
+			return;
+		}
 #ifdef Q_OS_WIN // AUDIO
 		if(m_currentIsAudio && m_pAudioSink)
 		{
@@ -635,11 +823,42 @@ void PreviewDialog::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 	}
 	else
 	{
+		if((a_frameNumber == m_frameToCache) &&
+			(a_outputIndex == m_outputIndex))
+		{
+			m_previewFrameCache.add(a_frameNumber, a_outputIndex,
+				cpOutputFrame, cpPreviewFrame);
+		}
 		setCurrentFrame(cpOutputFrame, cpPreviewFrame);
 		m_frameShown = a_frameNumber;
 		if(m_frameShown == m_frameExpected)
 			m_ui.frameStatusLabel->setPixmap(m_readyPixmap);
 	}
+
+	if(m_firstFrameTimePending)
+	{
+		m_firstFrameTimePending = false;
+		double seconds =
+			duration_to_double(hr_clock::now() - m_previewStartTime);
+
+		QString origin;
+		switch(m_pVapourSynthScriptProcessor->scriptOrigin())
+		{
+		case ScriptOrigin::Evaluated:
+			origin = tr("new core");
+			break;
+		case ScriptOrigin::EvaluatedOnWarmCore:
+			origin = tr("warm core");
+			break;
+		case ScriptOrigin::Cached:
+			origin = tr("cached script");
+			break;
+		}
+
+		emit signalWriteLogMessage(mtDebug,
+			tr("Time to first preview frame: %1 ms (%2).")
+			.arg(seconds * 1000.0, 0, 'f', 0).arg(origin));
+	}
 }
 
 // END OF void PreviewDialog::slotReceiveFrame(int a_frameNumber,
@@ -650,16 +869,37 @@ void PreviewDialog::slotReceiveFrame(int a_frameNumber, int a_outputIndex,
 void PreviewDialog::slotFrameRequestDiscarded(int a_frameNumber,
 	int a_outputIndex, const QString & a_reason)
 {
-	(void)a_outputIndex;
 	(void)a_reason;
 
+	if(m_cancellingFrameTickets)
+		return;
+
+	if(m_pMarkerScanner->discardFrame(a_frameNumber, a_outputIndex))
+		return;
+
+	// The group can not be completed without the frame,
+	// so it is rolled back as a whole.
+	bool groupDiscarded = false;
+	std::map<int, int>::const_iterator pendingIt =
+		m_comparedFramesPending.find(a_outputIndex);
+	if((pendingIt != m_comparedFramesPending.end()) &&
+		(pendingIt->second == a_frameNumber))
+	{
+		groupDiscarded = true;
+		clearComparedFrames();
+	}
+
+	if((!groupDiscarded) && (a_outputIndex == m_outputIndex) &&
+		m_prefetchedFrames.erase(a_frameNumber))
+		return;
+
 	if(m_playing)
 	{
 		slotPlay(false);
 	}
 	else
 	{
-		if(a_frameNumber != m_frameExpected)
+		if((!groupDiscarded) && (a_frameNumber != m_frameExpected))
 			return;
 
 		if(m_frameShown == -1)
@@ -689,7 +929,7 @@ void PreviewDialog::slotFrameRequestDiscarded(int a_frameNumber,
 
 void PreviewDialog::slotShowFrame(int a_frameNumber, bool a_refreshCache)
 {
-	if((m_frameShown == a_frameNumber) && (!m_framePixmap.isNull()))
+	if((m_frameShown == a_frameNumber) && (!m_frameImage.isNull()))
 		return;
 
 	if(m_playing)
@@ -714,11 +954,21 @@ void PreviewDialog::slotShowFrame(int a_frameNumber, bool a_refreshCache)
 	m_ui.frameNumberSpinBox->setValue(a_frameNumber);
 	m_ui.frameNumberSlider->setFrame(a_frameNumber, a_refreshCache);
 
+	int step = a_frameNumber - m_frameExpected;
+
+	if(showCachedFrame(a_frameNumber))
+	{
+		prefetchFrames(step);
+		requestingFrame = false;
+		return;
+	}
+
 	bool requested = requestShowFrame(a_frameNumber);
 	if(requested)
 	{
 		setExpectedFrame(a_frameNumber);
 		m_ui.frameStatusLabel->setPixmap(m_busyPixmap);
+		prefetchFrames(step);
 	}
 	else
 	{
@@ -733,7 +983,7 @@ void PreviewDialog::slotShowFrame(int a_frameNumber, bool a_refreshCache)
 
 void PreviewDialog::slotSaveSnapshot()
 {
-	if((m_frameShown < 0) || m_framePixmap.isNull())
+	if((m_frameShown < 0) || m_frameImage.isNull())
 		return;
 
 	if(!m_nodeInfo[m_outputIndex].isVideo())
@@ -759,77 +1009,8 @@ void PreviewDialog::slotSaveSnapshot()
 	QString snapshotTemplate = m_pSettingsManager->getSnapshotTemplate();
 	if(!currScriptNotSaved)
 	{
-		std::vector<vsedit::VariableToken> variables =
-		{
-			{"{f}", tr("script file path"),
-				[&]()
-				{
-					return currScriptName;
-				}
-			},
-
-			{"{d}", tr("script file directory"),
-				[&]()
-				{
-					QFileInfo file(currScriptName);
-					return QDir::toNativeSeparators(file.path());
-				}
-			},
-
-			{"{n}", tr("script file name"),
-				[&]()
-				{
-					QFileInfo file(currScriptName);
-					return file.completeBaseName();
-				}
-			},
-
-			{"{o}", tr("output index"),
-				[&]()
-				{
-					return QString::number(m_outputIndex);
-				}
-			},
-
-			{"{i}", tr("frame number"),
-				[&]()
-				{
-					return QString::number(m_frameShown);
-				}
-			},
-
-			{"{t}", tr("timestamp"),
-				[&]()
-				{
-					if(m_fpsDen == 0 || m_fpsNum == 0)
-						return QString();
-					QString timeStr = vsedit::timeToString(
-						(double)m_frameShown / m_fpsNum * m_fpsDen, true)
-						.replace(":", ".");
-					return timeStr;
-				}
-			},
-
-			{"{nm}", tr("clip name"),
-				[&]()
-				{
-					return m_clipName;
-				}
-			},
-
-			{"{sc}", tr("scene name"),
-				[&]()
-				{
-					return m_sceneName;
-				}
-			},
-		};
-
-		for(const vsedit::VariableToken & var : variables)
-		{
-			snapshotTemplate = snapshotTemplate.replace(
-				var.token, var.evaluate());
-		}
+		snapshotTemplate = evaluateSnapshotTemplate(snapshotTemplate,
+			m_frameShown, m_outputIndex, m_clipName, m_sceneName);
 	}
 
 	bool silentSnapshot = m_pSettingsManager->getSilentSnapshot();
@@ -866,22 +1047,140 @@ void PreviewDialog::slotSaveSnapshot()
 		format = "webp";
 	else if(silentSnapshot && suffix != "png")
 		snapshotFilePath += ".png";
-	if(!snapshotFilePath.isEmpty())
+	if(snapshotFilePath.isEmpty())
+		return;
+
+	requestFullSizeFrameImage(
+		[this, snapshotFilePath, format, suffix](const QImage & a_image)
+		{
+			bool success = (!a_image.isNull()) &&
+				a_image.save(snapshotFilePath, format,
+				format == "webp" ? 100 :
+				m_pSettingsManager->getPNGSnapshotCompressionLevel());
+			if(success)
+				m_pSettingsManager->setLastSnapshotExtension(suffix);
+			else
+			{
+				QMessageBox::critical(this, tr("Image save error"),
+					tr("Error while saving image ") + snapshotFilePath);
+			}
+		});
+}
+
+// END OF void PreviewDialog::slotSaveSnapshot()
+//==============================================================================
+
+void PreviewDialog::slotBatchSnapshotExport()
+{
+	if(m_pBatchSnapshotExporter->exporting())
 	{
-		bool success = m_framePixmap.save(snapshotFilePath, format,
-			format == "webp" ? 100 :
-			m_pSettingsManager->getPNGSnapshotCompressionLevel());
-		if(success)
-			m_pSettingsManager->setLastSnapshotExtension(suffix);
-		else
+		emit signalWriteLogMessage(mtWarning,
+			tr("Snapshots are still being exported."));
+		return;
+	}
+
+	if((m_frameShown < 0) || (!m_nodeInfo[m_outputIndex].isVideo()))
+		return;
+
+	int lastFrame = m_nodeInfo[m_outputIndex].numFrames() - 1;
+	bool accepted = false;
+	QString range = QInputDialog::getText(this, tr("Batch snapshot export"),
+		tr("Frames (first-last, first-last/N for every Nth frame "
+		"or b for the bookmarks):"), QLineEdit::Normal,
+		QString("0-%1").arg(lastFrame), &accepted);
+	if(!accepted)
+		return;
+
+	std::deque<int> frames;
+	static const QRegularExpression rangeFormat(
+		"^\\s*(\\d+)\\s*-\\s*(\\d+)\\s*(?:/\\s*(\\d+)\\s*)?$");
+	QRegularExpressionMatch match = rangeFormat.match(range);
+	if(range.trimmed().compare("b", Qt::CaseInsensitive) == 0)
+	{
+		for(int bookmark : m_ui.frameNumberSlider->bookmarks())
 		{
-			QMessageBox::critical(this, tr("Image save error"),
-				tr("Error while saving image ") + snapshotFilePath);
+			if((bookmark >= 0) && (bookmark <= lastFrame))
+				frames.push_back(bookmark);
 		}
 	}
+	else if(match.hasMatch())
+	{
+		// Numbers too large for an int do not parse.
+		bool firstParsed = false;
+		bool lastParsed = false;
+		bool stepParsed = true;
+		int firstFrame = match.captured(1).toInt(&firstParsed);
+		int rangeLastFrame = match.captured(2).toInt(&lastParsed);
+		int step = match.captured(3).isEmpty() ? 1 :
+			match.captured(3).toInt(&stepParsed);
+		// The step is checked against the frames left before it is taken,
+		// so a large step can not overflow the frame number.
+		if(firstParsed && lastParsed && stepParsed && (step > 0) &&
+			(firstFrame <= rangeLastFrame) && (rangeLastFrame <= lastFrame))
+		{
+			for(int frame = firstFrame; ; frame += step)
+			{
+				frames.push_back(frame);
+				if(step > rangeLastFrame - frame)
+					break;
+			}
+		}
+	}
+	if(frames.empty())
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("No frames to export in \"%1\".").arg(range));
+		return;
+	}
+
+	// The files would overwrite each other without the frame in the name.
+	QString snapshotTemplate = m_pSettingsManager->getSnapshotTemplate();
+	bool templatePerFrame = (!scriptName().isEmpty()) &&
+		(snapshotTemplate.contains("{i}") || snapshotTemplate.contains("{t}"));
+	if(!templatePerFrame)
+	{
+		QString directory = QFileDialog::getExistingDirectory(this,
+			tr("Batch snapshot export"), QStandardPaths::writableLocation(
+			QStandardPaths::PicturesLocation));
+		if(directory.isEmpty())
+			return;
+		snapshotTemplate = directory + "/{i}-{o}." +
+			m_pSettingsManager->getLastSnapshotExtension();
+	}
+
+	QList<QByteArray> supportedFormats = QImageWriter::supportedImageFormats();
+	bool webpSupported = (supportedFormats.indexOf("webp") > -1);
+	QString suffix = QFileInfo(snapshotTemplate).suffix().toLower();
+
+	// Other formats are saved as PNG under the PNG suffix. A suffix that
+	// is a template field is kept as part of the name.
+	QByteArray format("png");
+	if((suffix == "webp") && webpSupported)
+		format = "webp";
+	else if(suffix.isEmpty() || suffix.contains('{'))
+		snapshotTemplate += ".png";
+	else if(suffix != "png")
+	{
+		snapshotTemplate.chop(suffix.size());
+		snapshotTemplate += "png";
+		emit signalWriteLogMessage(mtWarning,
+			tr("Snapshots can not be exported as \"%1\". "
+			"Exporting them as PNG.").arg(suffix));
+	}
+
+	int outputIndex = m_outputIndex;
+	int quality = (format == "webp") ? 100 :
+		m_pSettingsManager->getPNGSnapshotCompressionLevel();
+	m_pBatchSnapshotExporter->start(outputIndex, frames,
+		[this, snapshotTemplate, outputIndex](int a_frameNumber,
+			const QString & a_clipName, const QString & a_sceneName)
+		{
+			return evaluateSnapshotTemplate(snapshotTemplate, a_frameNumber,
+				outputIndex, a_clipName, a_sceneName);
+		}, format, quality, m_cpVSAPI);
 }
 
-// END OF void PreviewDialog::slotSaveSnapshot()
+// END OF void PreviewDialog::slotBatchSnapshotExport()
 //==============================================================================
 
 void PreviewDialog::slotToggleZoomPanelVisible(bool a_zoomPanelVisible)
@@ -928,6 +1227,7 @@ void PreviewDialog::slotZoomModeChanged()
 	}
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 	bool fixedRatio(zoomMode == ZoomMode::FixedRatio);
 	m_ui.zoomRatioSpinBox->setEnabled(fixedRatio);
 	bool noZoom = (zoomMode == ZoomMode::NoZoom);
@@ -998,6 +1298,7 @@ void PreviewDialog::slotToggleCropPanelVisible(bool a_cropPanelVisible)
 {
 	m_ui.cropPanel->setVisible(a_cropPanelVisible);
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 }
 
 // END OF void PreviewDialog::slotToggleCropPanelVisible(
@@ -1062,6 +1363,7 @@ void PreviewDialog::slotCropLeftValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollLeft();
 
@@ -1105,6 +1407,7 @@ void PreviewDialog::slotCropTopValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollTop();
 
@@ -1131,6 +1434,7 @@ void PreviewDialog::slotCropWidthValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollRight();
 
@@ -1157,6 +1461,7 @@ void PreviewDialog::slotCropHeightValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollBottom();
 
@@ -1183,6 +1488,7 @@ void PreviewDialog::slotCropRightValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollRight();
 
@@ -1209,6 +1515,7 @@ void PreviewDialog::slotCropBottomValueChanged(int a_value)
 	recalculateCropMods();
 
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 
 	m_ui.previewArea->slotScrollBottom();
 
@@ -1222,6 +1529,7 @@ void PreviewDialog::slotCropZoomRatioValueChanged(int a_cropZoomRatio)
 {
 	m_pSettingsManager->setCropZoomRatio(a_cropZoomRatio);
 	setPreviewPixmap();
+	slotUpdatePreviewSize();
 }
 
 // END OF void PreviewDialog::slotCropZoomRatioValueChanged(int a_cropZoomRatio)
@@ -1371,7 +1679,17 @@ void PreviewDialog::slotSettingsChanged()
 		m_pSettingsManager->getColor(COLOR_ID_TIMELINE_BOOKMARKS);
 	m_ui.frameNumberSlider->setColor(TimeLineSlider::Bookmark, bookmarksColor);
 
+	QColor markersColor =
+		m_pSettingsManager->getColor(COLOR_ID_TIMELINE_MARKERS);
+	m_ui.frameNumberSlider->setColor(TimeLineSlider::Marker, markersColor);
+
 	m_ui.frameNumberSlider->setUpdatesEnabled(true);
+
+	// Thumbnails converted with other settings are not shown any more.
+	if(m_pVapourSynthScriptProcessor->isInitialized() &&
+		m_pThumbnailLoader->updateKey(VSScriptLibrary::scriptContentsHash(
+		script(), scriptName()), m_outputIndex))
+		resetThumbnails();
 }
 
 // END OF void PreviewDialog::slotSettingsChanged()
@@ -1381,12 +1699,24 @@ void PreviewDialog::slotPreviewAreaSizeChanged()
 {
 	ZoomMode zoomMode = (ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
 	if(zoomMode == ZoomMode::FitToFrame)
+	{
 		setPreviewPixmap();
+		m_pPreviewSizeTimer->start();
+	}
 }
 
 // END OF void PreviewDialog::slotPreviewAreaSizeChanged()
 //==============================================================================
 
+void PreviewDialog::slotUpdatePreviewSize()
+{
+	if(updatePreviewSize() && (!m_playing))
+		requestShowFrame(m_frameExpected);
+}
+
+// END OF void PreviewDialog::slotUpdatePreviewSize()
+//==============================================================================
+
 void PreviewDialog::slotPreviewAreaCtrlWheel(QPoint a_angleDelta)
 {
 #ifdef Q_OS_WIN // AUDIO
@@ -1454,9 +1784,26 @@ void PreviewDialog::slotPreviewAreaMouseRightButtonReleased()
 
 void PreviewDialog::slotPreviewAreaMouseOverPoint(double a_pX, double a_pY)
 {
+	// The wipe follows the mouse.
+	if(compareActive() && (m_compareMode == CompareMode::Wipe) &&
+		(!m_compareImage.isNull()) && (m_ui.previewArea->displayWidth() > 0))
+	{
+		m_compareWipePosition = a_pX / m_ui.previewArea->displayWidth();
+		composeComparedImage();
+		setPreviewPixmap();
+	}
+
 	if(!m_cpFrame)
 		return;
 
+	// The values are read from one frame, not from the row of them.
+	if(compareActive() && (m_compareMode == CompareMode::SideBySide) &&
+		(!m_compareImage.isNull()))
+	{
+		m_pStatusBarWidget->setColorPickerString(QString());
+		return;
+	}
+
 	if(m_cpVSAPI->getFrameType(m_cpFrame) == mtAudio)
 		return;
 
@@ -1468,61 +1815,19 @@ void PreviewDialog::slotPreviewAreaMouseOverPoint(double a_pX, double a_pY)
 	double value3 = 0.0;
 	int preview_values[3] = {0, 0, 0};
 
-	size_t frameX = 0;
-	size_t frameY = 0;
-
-	double zoomRatio;
-
-	int width = m_cpVSAPI->getFrameWidth(m_cpFrame, 0);
-	int height = m_cpVSAPI->getFrameHeight(m_cpFrame, 0);
 	const VSVideoFormat * cpFormat = m_cpVSAPI->getVideoFrameFormat(m_cpFrame);
 
-	if(m_ui.cropPanel->isVisible())
-	{
-		zoomRatio = m_ui.cropZoomRatioSpinBox->value();
-		int cropLeft = m_ui.cropLeftSpinBox->value();
-		int cropTop = m_ui.cropTopSpinBox->value();
-		int cropWidth = m_ui.cropWidthSpinBox->value();
-		int cropHeight = m_ui.cropHeightSpinBox->value();
-		frameX = (size_t)(a_pX * m_devicePixelRatio / zoomRatio + cropLeft);
-		frameY = (size_t)(a_pY * m_devicePixelRatio / zoomRatio + cropTop);
-		if(frameX >= (size_t)(cropLeft + cropWidth) ||
-			frameY >= (size_t)(cropTop + cropHeight))
-			return;
-	}
-	else
+	QPointF framePoint;
+	if(!framePosition(QPointF(a_pX, a_pY), framePoint))
 	{
-		ZoomMode zoomMode = (ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
-		if(zoomMode == ZoomMode::NoZoom)
-		{
-			zoomRatio = 1.0;
-		}
-		else if(zoomMode == ZoomMode::FixedRatio)
-		{
-			zoomRatio = m_ui.zoomRatioSpinBox->value();
-		}
-		else
-		{
-			if(m_framePixmap.isNull())
-			{
-				m_pStatusBarWidget->setColorPickerString(QString());
-				return;
-			}
-			QRect previewRect = m_ui.previewArea->geometry();
-			int cropSize = m_ui.previewArea->frameWidth() * 2;
-			int frameWidth = previewRect.width() * m_devicePixelRatio - cropSize;
-			int frameHeight = previewRect.height() * m_devicePixelRatio - cropSize;
-			double scaleW = (double)frameWidth / m_framePixmap.width();
-			double scaleH = (double)frameHeight / m_framePixmap.height();
-			zoomRatio = scaleW < scaleH ? scaleW : scaleH;
-		}
-		if(zoomRatio <= 0)
-			return;
-		frameX = (size_t)(a_pX * m_devicePixelRatio / zoomRatio);
-		frameY = (size_t)(a_pY * m_devicePixelRatio / zoomRatio);
-		if((frameX >= (size_t)width) || (frameY >= (size_t)height))
-			return;
+		m_pStatusBarWidget->setColorPickerString(QString());
+		return;
 	}
+	QPoint frameSample((int)framePoint.x(), (int)framePoint.y());
+	if(!shownFrameRect().contains(frameSample))
+		return;
+	size_t frameX = (size_t)frameSample.x();
+	size_t frameY = (size_t)frameSample.y();
 
 	value1 = valueAtPoint(frameX, frameY, 0);
 	if(cpFormat->numPlanes > 1)
@@ -1578,11 +1883,16 @@ void PreviewDialog::slotPreviewAreaMouseOverPoint(double a_pX, double a_pY)
 
 void PreviewDialog::slotFrameToClipboard()
 {
-	if(m_framePixmap.isNull())
+	if(m_frameImage.isNull())
 		return;
 
-	QClipboard * pClipboard = QApplication::clipboard();
-	pClipboard->setPixmap(m_framePixmap);
+	requestFullSizeFrameImage([](const QImage & a_image)
+		{
+			if(a_image.isNull())
+				return;
+			QClipboard * pClipboard = QApplication::clipboard();
+			pClipboard->setImage(a_image);
+		});
 }
 
 // END OF void PreviewDialog::slotFrameToClipboard()
@@ -1591,6 +1901,8 @@ void PreviewDialog::slotFrameToClipboard()
 void PreviewDialog::slotAdvancedSettingsChanged()
 {
 	m_pVapourSynthScriptProcessor->slotResetSettings();
+	resetPreviewFrameCache();
+	updatePreviewSize();
 	if(!m_playing)
 		requestShowFrame(m_frameExpected);
 }
@@ -1607,6 +1919,23 @@ void PreviewDialog::slotToggleColorPicker(bool a_colorPickerVisible)
 // END OF void PreviewDialog::slotToggleColorPicker(bool a_colorPickerVisible)
 //==============================================================================
 
+void PreviewDialog::slotToggleRegionStatistics(bool a_enabled)
+{
+	m_ui.previewArea->setRegionSelection(a_enabled);
+	updateRegionStatistics();
+}
+
+// END OF void PreviewDialog::slotToggleRegionStatistics(bool a_enabled)
+//==============================================================================
+
+void PreviewDialog::slotPreviewAreaRegionChanged()
+{
+	updateRegionStatistics();
+}
+
+// END OF void PreviewDialog::slotPreviewAreaRegionChanged()
+//==============================================================================
+
 void PreviewDialog::slotSetPlayFPSLimit()
 {
 	double limit = m_ui.playFpsLimitSpinBox->value();
@@ -1659,9 +1988,29 @@ void PreviewDialog::slotPlay(bool a_play)
 
 	if(m_playing)
 	{
+		cancelPrefetch();
+		// Thumbnails wait for the playback to stop.
+		cancelFrameTickets(
+			[](const FrameTicket & a_ticket)
+			{
+				return (a_ticket.kind == FrameTicketKind::Thumbnail);
+			});
+		m_pThumbnailLoader->pause();
+		m_pMarkerScanner->pause();
+		clearComparedFrames();
+		m_compareImage = QImage();
 		m_ui.outputIndexComboBox->setEnabled(false);
+		m_ui.compareModeComboBox->setEnabled(false);
 		m_pActionPlay->setIcon(m_iconPause);
 		m_lastFrameRequestedForPlay = m_frameShown;
+		m_playScheduleStarted = false;
+		m_playbackStatistics.reset();
+		updatePlaybackStatistics(true);
+		int numFrames = m_nodeInfo[m_outputIndex].numFrames();
+		size_t capacity = FrameReorderBuffer::capacityFor(m_cachedFramesLimit,
+			m_nodeInfo[m_outputIndex].getAsVideo(), true);
+		m_framesCache[m_outputIndex].reset(capacity,
+			(m_frameShown + 1) % numFrames, numFrames);
 #ifdef Q_OS_WIN // AUDIO
 		if(m_currentIsAudio && m_pAudioSink)
 			slotProcessAudioPlayQueue();
@@ -1679,124 +2028,365 @@ void PreviewDialog::slotPlay(bool a_play)
 #endif
 		m_pVapourSynthScriptProcessor->flushFrameTicketsQueue();
 		m_ui.outputIndexComboBox->setEnabled(true);
+		m_ui.compareModeComboBox->setEnabled(true);
 		m_pActionPlay->setIcon(m_iconPlay);
 		setTitle();
+
+		if(m_showPlaybackStatistics &&
+			(m_playbackStatistics.framesShown() > 0))
+		{
+			emit signalWriteLogMessage(mtDebug,
+				tr("Playback: %1 frames shown, %2 dropped, "
+				"jitter p50/p95/p99 %3/%4/%5 ms.")
+				.arg(m_playbackStatistics.framesShown())
+				.arg(m_playbackStatistics.framesDropped())
+				.arg(m_playbackStatistics.jitterPercentile(50) * 1000.0, 0,
+					'f', 1)
+				.arg(m_playbackStatistics.jitterPercentile(95) * 1000.0, 0,
+					'f', 1)
+				.arg(m_playbackStatistics.jitterPercentile(99) * 1000.0, 0,
+					'f', 1));
+		}
+		m_ui.previewArea->setOverlayText(QString());
+		m_pThumbnailLoader->resume();
+		m_pMarkerScanner->resume();
 	}
 }
 
 // END OF void PreviewDialog::slotPlay(bool a_play)
 //==============================================================================
 
-void PreviewDialog::slotProcessPlayQueue()
+void PreviewDialog::slotToggleRealTimePlay(bool a_realTime)
 {
-	if(!m_playing)
-		return;
-
-	if(m_processingPlayQueue)
-		return;
-	m_processingPlayQueue = true;
-
-	const VSVideoInfo * vi = m_nodeInfo[m_outputIndex].getAsVideo();
-	if(!vi)
-		return;
+	m_realTimePlayback = a_realTime;
+	// Start the schedule anew from the next frame shown.
+	m_playScheduleStarted = false;
+	m_pSettingsManager->setPlayRealTime(a_realTime);
+}
 
-	int nextFrame = (m_frameShown + 1) % vi->numFrames;
-	Frame referenceFrame(nextFrame, m_outputIndex, nullptr);
+// END OF void PreviewDialog::slotToggleRealTimePlay(bool a_realTime)
+//==============================================================================
 
-	while(!m_framesCache[m_outputIndex].empty())
-	{
-		std::list<Frame>::const_iterator it =
-			std::find(m_framesCache[m_outputIndex].begin(),
-			m_framesCache[m_outputIndex].end(), referenceFrame);
+void PreviewDialog::slotTogglePlaybackStatistics(bool a_show)
+{
+	m_showPlaybackStatistics = a_show;
+	m_pSettingsManager->setShowPlaybackStatistics(a_show);
+	updatePlaybackStatistics(true);
+}
 
-		if(it == m_framesCache[m_outputIndex].end())
-			break;
+// END OF void PreviewDialog::slotTogglePlaybackStatistics(bool a_show)
+//==============================================================================
 
-		if(m_nativePlaybackRate)
-		{
-			Q_ASSERT(m_cpVSAPI);
-			const VSMap * frameProps = m_cpVSAPI->getFramePropertiesRO(
-				it->cpOutputFrame);
-			int err_num, err_den;
-			int64_t durNum = m_cpVSAPI->mapGetInt(frameProps, "_DurationNum", 0, &err_num);
-			int64_t durDen = m_cpVSAPI->mapGetInt(frameProps, "_DurationDen", 0, &err_den);
-			if(err_num || err_den || durNum <= 0 || durDen <= 0)
-			{
-				// Fallback to custom
-				double limit = m_ui.playFpsLimitSpinBox->value();
-				if(limit < 1e-3)
-					limit = 1e-3;
-				m_secondsBetweenFrames = 1.0 / limit;
-			}
-			else
-				m_secondsBetweenFrames = (double)durNum / (double)durDen;
-		}
-		hr_time_point now = hr_clock::now();
-		double passed = duration_to_double(now - m_lastFrameShowTime);
-		double secondsToNextFrame = m_secondsBetweenFrames - passed;
-		if(secondsToNextFrame > 0)
-		{
-			int millisecondsToNextFrame = std::ceil(secondsToNextFrame * 1000);
-			m_pPlayTimer->start(millisecondsToNextFrame);
-			break;
-		}
+void PreviewDialog::slotCompareModeChanged()
+{
+	m_compareMode =
+		(CompareMode)m_ui.compareModeComboBox->currentData().toInt();
+	m_pSettingsManager->setCompareMode(m_compareMode);
+	m_ui.compareOutputsEdit->setEnabled(m_compareMode != CompareMode::Off);
+	refreshCompare();
+}
 
-		setCurrentFrame(it->cpOutputFrame, it->cpPreviewFrame);
-		m_lastFrameShowTime = hr_clock::now();
+// END OF void PreviewDialog::slotCompareModeChanged()
+//==============================================================================
 
-		m_frameShown = nextFrame;
-		setExpectedFrame(m_frameShown);
-		m_ui.frameNumberSpinBox->setValue(m_frameExpected);
-		m_ui.frameNumberSlider->setFrame(m_frameExpected, false);
-		m_framesCache[m_outputIndex].erase(it);
-		nextFrame = (m_frameShown + 1) % vi->numFrames;
-		referenceFrame.number = nextFrame;
-	}
+void PreviewDialog::slotCompareOutputsChanged()
+{
+	m_pSettingsManager->setCompareOutputs(m_ui.compareOutputsEdit->text());
+	refreshCompare();
+}
 
-	nextFrame = (m_lastFrameRequestedForPlay + 1) % vi->numFrames;
+// END OF void PreviewDialog::slotCompareOutputsChanged()
+//==============================================================================
 
-	while(((m_framesInQueue[m_outputIndex] + m_framesInProcess[m_outputIndex]) <
-		m_maxThreads) &&
-		(m_framesCache[m_outputIndex].size() <= m_cachedFramesLimit))
-	{
-		m_pVapourSynthScriptProcessor->requestFrameAsync(nextFrame,
-			m_outputIndex, true);
-		m_lastFrameRequestedForPlay = nextFrame;
-		nextFrame = (nextFrame + 1) % vi->numFrames;
-	}
+void PreviewDialog::slotCompareFlip()
+{
+	if(!compareActive())
+		return;
 
-	m_processingPlayQueue = false;
+	std::vector<int>::const_iterator it = std::find(
+		m_compareOutputs.begin(), m_compareOutputs.end(), m_outputIndex);
+	++it;
+	if(it == m_compareOutputs.end())
+		it = m_compareOutputs.begin();
+	setOutputIndex(*it);
 }
 
-// END OF void PreviewDialog::slotProcessPlayQueue()
+// END OF void PreviewDialog::slotCompareFlip()
 //==============================================================================
 
-#ifdef Q_OS_WIN // AUDIO
-void PreviewDialog::slotProcessAudioPlayQueue()
+void PreviewDialog::slotFrameMetricsReady(const FrameMetrics & a_metrics)
 {
-	if(!m_playing)
+	if(m_pCompareMetricsExporter->takeMetrics(a_metrics))
 		return;
 
-	if(m_processingPlayQueue)
+	if((a_metrics.frameNumber != m_frameMetricsRequested.frameNumber) ||
+		(a_metrics.referenceIndex != m_frameMetricsRequested.referenceIndex) ||
+		(a_metrics.comparedIndex != m_frameMetricsRequested.comparedIndex))
 		return;
-	m_processingPlayQueue = true;
 
-	int numFrames = m_nodeInfo[m_outputIndex].numFrames();
-	int nextFrame = (m_frameShown + 1) % numFrames;
+	m_frameMetrics = a_metrics;
+	if(m_pFramePropsPanel->isVisible())
+		updateFrameProps(false);
+}
 
-	static double delay_estimate = 0.0;
+// END OF void PreviewDialog::slotFrameMetricsReady(
+//		const FrameMetrics & a_metrics)
+//==============================================================================
 
-	while(!m_framesCache[m_outputIndex].empty())
+void PreviewDialog::slotExportCompareMetrics()
+{
+	if(m_pCompareMetricsExporter->exporting())
 	{
-		auto ait = m_audioCache.find(nextFrame);
-		if(ait == m_audioCache.end())
-			break;
-		auto af = m_audioCache[nextFrame];
+		emit signalWriteLogMessage(mtWarning,
+			tr("Compare metrics are still being exported."));
+		return;
+	}
 
-		double ms_offset = 0.0;
-		hr_time_point now = hr_clock::now();
-		double passed = duration_to_double(now - m_lastFrameShowTime);
-		double secondsToNextFrame = m_secondsBetweenFrames - passed - delay_estimate;
+	int referenceIndex = -1;
+	int comparedIndex = -1;
+	if(!metricsOutputs(referenceIndex, comparedIndex))
+	{
+		emit signalWriteLogMessage(mtWarning, tr("Turn on the compare mode "
+			"with at least two outputs to export the compare metrics."));
+		return;
+	}
+
+	int lastFrame = std::min(m_nodeInfo[referenceIndex].numFrames(),
+		m_nodeInfo[comparedIndex].numFrames()) - 1;
+	bool accepted = false;
+	QString range = QInputDialog::getText(this, tr("Export compare metrics"),
+		tr("Frame range (first-last):"), QLineEdit::Normal,
+		QString("0-%1").arg(lastFrame), &accepted);
+	if(!accepted)
+		return;
+
+	static const QRegularExpression rangeFormat(
+		"^\\s*(\\d+)\\s*-\\s*(\\d+)\\s*$");
+	QRegularExpressionMatch match = rangeFormat.match(range);
+	int firstFrame = match.captured(1).toInt();
+	int rangeLastFrame = match.captured(2).toInt();
+	if((!match.hasMatch()) || (firstFrame > rangeLastFrame) ||
+		(rangeLastFrame > lastFrame))
+	{
+		emit signalWriteLogMessage(mtWarning,
+			tr("Invalid frame range \"%1\".").arg(range));
+		return;
+	}
+
+	QString filePath =
+		QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+	filePath += QString("/metrics-%1-%2.csv").arg(comparedIndex)
+		.arg(referenceIndex);
+	filePath = QFileDialog::getSaveFileName(this,
+		tr("Export compare metrics"), filePath, tr("CSV file (*.csv)"));
+	if(filePath.isEmpty())
+		return;
+
+	m_pCompareMetricsExporter->start(filePath, referenceIndex, comparedIndex,
+		firstFrame, rangeLastFrame);
+}
+
+// END OF void PreviewDialog::slotExportCompareMetrics()
+//==============================================================================
+
+void PreviewDialog::slotFullSizePreviewFrameReady(int a_frameNumber,
+	int a_outputIndex, const VSFrame * a_cpPreviewFrame)
+{
+	std::multimap<std::pair<int, int>, FullSizeFrameCallback>::iterator
+		requestIt = m_fullSizeFrameRequests.find(
+		std::make_pair(a_frameNumber, a_outputIndex));
+	if(requestIt != m_fullSizeFrameRequests.end())
+	{
+		FullSizeFrameCallback callback = requestIt->second;
+		m_fullSizeFrameRequests.erase(requestIt);
+		// The frame is freed after the signal.
+		callback(imageFromRGB(a_cpPreviewFrame).copy());
+		return;
+	}
+
+	if(!m_pBatchSnapshotExporter->frameRequested(a_frameNumber,
+		a_outputIndex))
+		return;
+
+	m_pBatchSnapshotExporter->takeFrame(a_frameNumber, a_cpPreviewFrame,
+		imageFromRGB(a_cpPreviewFrame));
+}
+
+// END OF void PreviewDialog::slotFullSizePreviewFrameReady(int a_frameNumber,
+//		int a_outputIndex, const VSFrame * a_cpPreviewFrame)
+//==============================================================================
+
+void PreviewDialog::slotToggleThumbnailStrip(bool a_visible)
+{
+	m_pThumbnailStrip->setVisible(a_visible);
+	m_pSettingsManager->setThumbnailStripVisible(a_visible);
+	m_pThumbnailLoader->slotRequestThumbnails();
+}
+
+// END OF void PreviewDialog::slotToggleThumbnailStrip(bool a_visible)
+//==============================================================================
+
+void PreviewDialog::slotThumbnailReady(int a_frameNumber, int a_outputIndex,
+	const VSFrame * a_cpThumbnailFrame)
+{
+	if(!m_pThumbnailLoader->thumbnailRequested(a_frameNumber, a_outputIndex))
+		return;
+
+	// The frame is freed after the signal.
+	QImage thumbnail;
+	if(a_cpThumbnailFrame)
+		thumbnail = imageFromRGB(a_cpThumbnailFrame).copy();
+	m_pThumbnailLoader->takeThumbnail(a_frameNumber, thumbnail);
+}
+
+// END OF void PreviewDialog::slotThumbnailReady(int a_frameNumber,
+//		int a_outputIndex, const VSFrame * a_cpThumbnailFrame)
+//==============================================================================
+
+void PreviewDialog::slotThumbnailStripFrameClicked(int a_frame)
+{
+	slotShowFrame(a_frame, true);
+}
+
+// END OF void PreviewDialog::slotThumbnailStripFrameClicked(int a_frame)
+//==============================================================================
+
+void PreviewDialog::slotProcessPlayQueue()
+{
+	if(!m_playing)
+		return;
+
+	if(m_processingPlayQueue)
+		return;
+	m_processingPlayQueue = true;
+
+	const VSVideoInfo * vi = m_nodeInfo[m_outputIndex].getAsVideo();
+	if(!vi)
+		return;
+
+	FrameReorderBuffer & playBuffer = m_framesCache[m_outputIndex];
+	Frame frame(-1, -1, nullptr);
+
+	while(true)
+	{
+		const Frame * cpNextFrame = playBuffer.front();
+		if(cpNextFrame && m_nativePlaybackRate)
+		{
+			Q_ASSERT(m_cpVSAPI);
+			const VSMap * frameProps = m_cpVSAPI->getFramePropertiesRO(
+				cpNextFrame->cpOutputFrame);
+			int err_num, err_den;
+			int64_t durNum = m_cpVSAPI->mapGetInt(frameProps, "_DurationNum", 0, &err_num);
+			int64_t durDen = m_cpVSAPI->mapGetInt(frameProps, "_DurationDen", 0, &err_den);
+			if(err_num || err_den || durNum <= 0 || durDen <= 0)
+			{
+				// Fallback to custom
+				double limit = m_ui.playFpsLimitSpinBox->value();
+				if(limit < 1e-3)
+					limit = 1e-3;
+				m_secondsBetweenFrames = 1.0 / limit;
+			}
+			else
+				m_secondsBetweenFrames = (double)durNum / (double)durDen;
+		}
+		double_duration frameDuration(m_secondsBetweenFrames);
+		hr_time_point now = hr_clock::now();
+		double secondsToNextFrame = m_playScheduleStarted ?
+			duration_to_double(m_nextFrameDueTime - now) : 0.0;
+
+		// Once the frame after the next one is due too, the next frame is
+		// skipped whether it has arrived or not.
+		if(m_realTimePlayback && m_playScheduleStarted &&
+			(m_secondsBetweenFrames > 0.0) &&
+			(-secondsToNextFrame > m_secondsBetweenFrames))
+		{
+			playBuffer.dropFront(m_cpVSAPI);
+			m_playbackStatistics.frameDropped();
+			m_nextFrameDueTime += std::chrono::duration_cast<
+				hr_clock::duration>(frameDuration);
+			continue;
+		}
+
+		if(!cpNextFrame)
+			break;
+
+		if(secondsToNextFrame > 0)
+		{
+			int millisecondsToNextFrame = std::ceil(secondsToNextFrame * 1000);
+			m_pPlayTimer->start(millisecondsToNextFrame);
+			break;
+		}
+
+		playBuffer.takeFront(frame);
+		setCurrentFrame(frame.cpOutputFrame, frame.cpPreviewFrame);
+		m_lastFrameShowTime = hr_clock::now();
+		m_playbackStatistics.frameShown(now, -secondsToNextFrame);
+
+		// The real time schedule goes on from the due time, so the delays
+		// do not add up. Otherwise the next frame waits its full duration
+		// after this one has been shown.
+		if(m_realTimePlayback && m_playScheduleStarted)
+		{
+			m_nextFrameDueTime += std::chrono::duration_cast<
+				hr_clock::duration>(frameDuration);
+		}
+		else
+		{
+			m_nextFrameDueTime = m_lastFrameShowTime +
+				std::chrono::duration_cast<hr_clock::duration>(frameDuration);
+		}
+		m_playScheduleStarted = true;
+
+		m_frameShown = frame.number;
+		setExpectedFrame(m_frameShown);
+		m_ui.frameNumberSpinBox->setValue(m_frameExpected);
+		m_ui.frameNumberSlider->setFrame(m_frameExpected, false);
+	}
+
+	updatePlaybackStatistics();
+
+	while(((m_framesInQueue[m_outputIndex] + m_framesInProcess[m_outputIndex]) <
+		m_inFlightLimit) && playBuffer.canReserve())
+	{
+		int nextFrame = playBuffer.reserveNext();
+		m_pVapourSynthScriptProcessor->requestFrameAsync(nextFrame,
+			m_outputIndex, true, FramePriority::Playback);
+		m_lastFrameRequestedForPlay = nextFrame;
+	}
+
+	m_processingPlayQueue = false;
+}
+
+// END OF void PreviewDialog::slotProcessPlayQueue()
+//==============================================================================
+
+#ifdef Q_OS_WIN // AUDIO
+void PreviewDialog::slotProcessAudioPlayQueue()
+{
+	if(!m_playing)
+		return;
+
+	if(m_processingPlayQueue)
+		return;
+	m_processingPlayQueue = true;
+
+	FrameReorderBuffer & playBuffer = m_framesCache[m_outputIndex];
+	int nextFrame = playBuffer.nextFrame();
+	Frame frame(-1, -1, nullptr);
+
+	static double delay_estimate = 0.0;
+
+	while(!playBuffer.empty())
+	{
+		auto ait = m_audioCache.find(nextFrame);
+		if(ait == m_audioCache.end())
+			break;
+		auto af = m_audioCache[nextFrame];
+
+		double ms_offset = 0.0;
+		hr_time_point now = hr_clock::now();
+		double passed = duration_to_double(now - m_lastFrameShowTime);
+		double secondsToNextFrame = m_secondsBetweenFrames - passed - delay_estimate;
 		if(secondsToNextFrame > 0)
 		{
 			int millisecondsToNextFrame = std::round(secondsToNextFrame * 1000);
@@ -1811,38 +2401,28 @@ void PreviewDialog::slotProcessAudioPlayQueue()
 		delay_estimate = duration_to_double(time_post - m_lastFrameShowTime) - ms_offset;
 		m_audioCache.erase(nextFrame);
 
-		Frame referenceFrame(nextFrame, m_outputIndex, nullptr);
-		std::list<Frame>::const_iterator it =
-			std::find(m_framesCache[m_outputIndex].begin(),
-			m_framesCache[m_outputIndex].end(), referenceFrame);
-
 		// caches are synced so this won't happen...
-		if(it == m_framesCache[m_outputIndex].end())
+		if(!playBuffer.takeFront(frame))
 			break;
 
-		setCurrentFrame(it->cpOutputFrame, it->cpPreviewFrame);
-		m_frameShown = nextFrame;
+		setCurrentFrame(frame.cpOutputFrame, frame.cpPreviewFrame);
+		m_frameShown = frame.number;
 		setExpectedFrame(m_frameShown);
 		m_ui.frameNumberSpinBox->setValue(m_frameExpected);
 		m_ui.frameNumberSlider->setFrame(m_frameExpected, false);
-		m_framesCache[m_outputIndex].erase(it);
-		nextFrame = (m_frameShown + 1) % numFrames;
-		referenceFrame.number = nextFrame;
+		nextFrame = playBuffer.nextFrame();
 	}
 
-	nextFrame = (m_lastFrameRequestedForPlay + 1) % numFrames;
-
 	while(((m_framesInQueue[m_outputIndex] + m_framesInProcess[m_outputIndex]) <
-		m_maxThreads) &&
-		(m_framesCache[m_outputIndex].size() <= m_cachedFramesLimit))
+		m_inFlightLimit) && playBuffer.canReserve())
 	{
-		m_pVapourSynthScriptProcessor->requestFrameAsync(nextFrame,
-			m_outputIndex, true);
-		m_lastFrameRequestedForPlay = nextFrame;
-		nextFrame = (nextFrame + 1) % numFrames;
+		int requestFrame = playBuffer.reserveNext();
+		m_pVapourSynthScriptProcessor->requestFrameAsync(requestFrame,
+			m_outputIndex, true, FramePriority::Playback);
+		m_lastFrameRequestedForPlay = requestFrame;
 	}
 
-	if(m_framesCache[m_outputIndex].empty())
+	if(playBuffer.empty())
 		m_audioCache.clear();
 
 	m_processingPlayQueue = false;
@@ -1960,6 +2540,67 @@ void PreviewDialog::slotGoToNextBookmark()
 // END OF void PreviewDialog::slotGoToNextBookmark()
 //==============================================================================
 
+void PreviewDialog::slotScanMarkers()
+{
+	if(m_playing)
+		return;
+
+	if(!m_nodeInfo[m_outputIndex].getAsVideo())
+		return;
+
+	QStringList props = {"_SceneChangePrev", "_SceneChangeNext", "_Combed"};
+	QString lastProp = m_pMarkerScanner->prop();
+	if((!lastProp.isEmpty()) && (!props.contains(lastProp)))
+		props.prepend(lastProp);
+	int current = std::max(props.indexOf(lastProp), 0);
+
+	bool accepted = false;
+	QString prop = QInputDialog::getItem(this, tr("Scan frames for markers"),
+		tr("Mark the frames with the frame property:"), props, current,
+		true, &accepted).trimmed();
+	if((!accepted) || prop.isEmpty())
+		return;
+
+	m_pMarkerScanner->scan(prop, m_outputIndex,
+		m_nodeInfo[m_outputIndex].numFrames());
+}
+
+// END OF void PreviewDialog::slotScanMarkers()
+//==============================================================================
+
+void PreviewDialog::slotClearMarkers()
+{
+	if(m_playing)
+		return;
+
+	m_pMarkerScanner->clear();
+}
+
+// END OF void PreviewDialog::slotClearMarkers()
+//==============================================================================
+
+void PreviewDialog::slotGoToPreviousMarker()
+{
+	if(m_playing)
+		return;
+
+	m_ui.frameNumberSlider->slotGoToPreviousMarker();
+}
+
+// END OF void PreviewDialog::slotGoToPreviousMarker()
+//==============================================================================
+
+void PreviewDialog::slotGoToNextMarker()
+{
+	if(m_playing)
+		return;
+
+	m_ui.frameNumberSlider->slotGoToNextMarker();
+}
+
+// END OF void PreviewDialog::slotGoToNextMarker()
+//==============================================================================
+
 void PreviewDialog::slotPasteShownFrameNumberIntoScript()
 {
 	emit signalPasteIntoScriptAtCursor(QString::number(m_frameShown));
@@ -1979,7 +2620,8 @@ void PreviewDialog::slotJumpToFrame()
 	if(m_playing)
 		return;
 
-	if(busy())
+	// Prefetched frames alone do not count.
+	if(busy() && (m_frameShown != m_frameExpected))
 		return;
 
 	int currFrameNumber = m_frameExpected;
@@ -2171,6 +2813,31 @@ void PreviewDialog::slotToggleFrameProps()
 // END OF void PreviewDialog::slotToggleFrameProps()
 //==============================================================================
 
+void PreviewDialog::slotToggleScopes()
+{
+	if(m_pScopesPanel->isVisible())
+	{
+		m_pScopesPanel->setVisible(false);
+	}
+	else
+	{
+		m_pScopesPanel->setVisible(true);
+		updateScopes();
+	}
+}
+
+// END OF void PreviewDialog::slotToggleScopes()
+//==============================================================================
+
+void PreviewDialog::slotScopesReady(const Scopes & a_scopes)
+{
+	if(m_pScopesPanel->isVisible())
+		m_pScopesPanel->setScopes(a_scopes);
+}
+
+// END OF void PreviewDialog::slotScopesReady(const Scopes & a_scopes)
+//==============================================================================
+
 void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
 {
 	// Assuming there's a change
@@ -2185,8 +2852,10 @@ void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
 	if(m_playing)
 		return;
 
+	cancelPrefetch();
+
 	// Don't switch when busy processing the current frame
-	if(busy())
+	if(busy() && (m_frameShown != m_frameExpected))
 		return;
 
 	// Check if output index is available
@@ -2255,6 +2924,7 @@ void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
 		m_pActionToggleCropPanel->setEnabled(false);
 		m_ui.saveSnapshotButton->setEnabled(false);
 		m_pActionSaveSnapshot->setEnabled(false);
+		m_pActionBatchSnapshotExport->setEnabled(false);
 		m_pStatusBarWidget->setColorPickerString("");
 		m_ui.playFpsLimitSpinBox->setEnabled(false);
 		m_ui.playFpsLimitModeComboBox->setEnabled(false);
@@ -2272,6 +2942,7 @@ void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
 		m_pActionToggleCropPanel->setEnabled(true);
 		m_ui.saveSnapshotButton->setEnabled(true);
 		m_pActionSaveSnapshot->setEnabled(true);
+		m_pActionBatchSnapshotExport->setEnabled(true);
 		m_ui.playFpsLimitSpinBox->setEnabled(true);
 		m_ui.playFpsLimitModeComboBox->setEnabled(true);
 	}
@@ -2282,10 +2953,20 @@ void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
 
 	resetCropSpinBoxes();
 
-	m_pVapourSynthScriptProcessor->requestFrameAsync(m_frameExpected,
-		m_outputIndex, true);
+	// Switching between the compared outputs takes the frames at hand.
+	if(!showCachedFrame(m_frameExpected))
+	{
+		if(compareActive())
+			requestComparedFrames(m_frameExpected);
+		else
+		{
+			m_pVapourSynthScriptProcessor->requestFrameAsync(
+				m_frameExpected, m_outputIndex, true);
+		}
+	}
 
 	slotShowFrame(m_frameExpected, false);
+	resetThumbnails();
 }
 
 // END OF void PreviewDialog::slotSwitchOutputIndex(int a_outputIndex)
@@ -2329,6 +3010,8 @@ void PreviewDialog::createActionsAndMenus()
 			false, SLOT(slotFrameToClipboard())},
 		{&m_pActionSaveSnapshot, ACTION_ID_SAVE_SNAPSHOT,
 			false, SLOT(slotSaveSnapshot())},
+		{&m_pActionBatchSnapshotExport, ACTION_ID_BATCH_SNAPSHOT_EXPORT,
+			false, SLOT(slotBatchSnapshotExport())},
 		{&m_pActionToggleZoomPanel, ACTION_ID_TOGGLE_ZOOM_PANEL,
 			true, SLOT(slotToggleZoomPanelVisible(bool))},
 		{&m_pActionSetZoomModeNoZoom, ACTION_ID_SET_ZOOM_MODE_NO_ZOOM,
@@ -2362,8 +3045,21 @@ void PreviewDialog::createActionsAndMenus()
 			false, SLOT(slotCallAdvancedSettingsDialog())},
 		{&m_pActionToggleColorPicker, ACTION_ID_TOGGLE_COLOR_PICKER,
 			true, SLOT(slotToggleColorPicker(bool))},
+		{&m_pActionToggleRegionStatistics, ACTION_ID_TOGGLE_REGION_STATISTICS,
+			true, SLOT(slotToggleRegionStatistics(bool))},
+		{&m_pActionShowNodeTiming, ACTION_ID_SHOW_NODE_TIMING,
+			false, SLOT(slotShowNodeTiming())},
 		{&m_pActionPlay, ACTION_ID_PLAY,
 			true, SLOT(slotPlay(bool))},
+		{&m_pActionToggleRealTimePlay, ACTION_ID_TOGGLE_REAL_TIME_PLAY,
+			true, SLOT(slotToggleRealTimePlay(bool))},
+		{&m_pActionTogglePlaybackStatistics,
+			ACTION_ID_TOGGLE_PLAYBACK_STATISTICS,
+			true, SLOT(slotTogglePlaybackStatistics(bool))},
+		{&m_pActionCompareFlip, ACTION_ID_COMPARE_FLIP,
+			false, SLOT(slotCompareFlip())},
+		{&m_pActionExportCompareMetrics, ACTION_ID_EXPORT_COMPARE_METRICS,
+			false, SLOT(slotExportCompareMetrics())},
 		{&m_pActionLoadChapters, ACTION_ID_TIMELINE_LOAD_CHAPTERS,
 			false, SLOT(slotLoadChapters())},
 		{&m_pActionClearBookmarks, ACTION_ID_TIMELINE_CLEAR_BOOKMARKS,
@@ -2377,6 +3073,15 @@ void PreviewDialog::createActionsAndMenus()
 		{&m_pActionGoToPreviousBookmark,
 			ACTION_ID_TIMELINE_GO_TO_PREVIOUS_BOOKMARK,
 			false, SLOT(slotGoToPreviousBookmark())},
+		{&m_pActionScanMarkers, ACTION_ID_TIMELINE_SCAN_MARKERS,
+			false, SLOT(slotScanMarkers())},
+		{&m_pActionClearMarkers, ACTION_ID_TIMELINE_CLEAR_MARKERS,
+			false, SLOT(slotClearMarkers())},
+		{&m_pActionGoToPreviousMarker,
+			ACTION_ID_TIMELINE_GO_TO_PREVIOUS_MARKER,
+			false, SLOT(slotGoToPreviousMarker())},
+		{&m_pActionGoToNextMarker, ACTION_ID_TIMELINE_GO_TO_NEXT_MARKER,
+			false, SLOT(slotGoToNextMarker())},
 		{&m_pActionGoToNextBookmark, ACTION_ID_TIMELINE_GO_TO_NEXT_BOOKMARK,
 			false, SLOT(slotGoToNextBookmark())},
 		{&m_pActionPasteShownFrameNumberIntoScript,
@@ -2386,6 +3091,10 @@ void PreviewDialog::createActionsAndMenus()
 			false, SLOT(slotJumpToFrame())},
 		{&m_pActionToggleFramePropsPanel, ACTION_ID_TOGGLE_FRAME_PROPS,
 			false, SLOT(slotToggleFrameProps())},
+		{&m_pActionToggleScopesPanel, ACTION_ID_TOGGLE_SCOPES,
+			false, SLOT(slotToggleScopes())},
+		{&m_pActionToggleThumbnailStrip, ACTION_ID_TOGGLE_THUMBNAIL_STRIP,
+			true, SLOT(slotToggleThumbnailStrip(bool))},
 		{&m_pActionSwitchToOutputIndex0, ACTION_ID_SET_OUTPUT_INDEX_0,
 			false, SLOT(slotSwitchOutputIndex0())},
 		{&m_pActionSwitchToOutputIndex1, ACTION_ID_SET_OUTPUT_INDEX_1,
@@ -2444,7 +3153,11 @@ void PreviewDialog::createActionsAndMenus()
 	m_pPreviewContextMenu->addAction(m_pActionJumpToFrame);
 	m_pPreviewContextMenu->addAction(m_pActionFrameToClipboard);
 	m_pPreviewContextMenu->addAction(m_pActionSaveSnapshot);
+	m_pPreviewContextMenu->addAction(m_pActionBatchSnapshotExport);
 	m_pPreviewContextMenu->addAction(m_pActionToggleFramePropsPanel);
+	m_pPreviewContextMenu->addAction(m_pActionToggleScopesPanel);
+	m_pPreviewContextMenu->addAction(m_pActionToggleThumbnailStrip);
+	m_pPreviewContextMenu->addAction(m_pActionExportCompareMetrics);
 	m_pActionToggleZoomPanel->setChecked(
 		m_pSettingsManager->getZoomPanelVisible());
 	m_pPreviewContextMenu->addAction(m_pActionToggleZoomPanel);
@@ -2572,9 +3285,44 @@ void PreviewDialog::createActionsAndMenus()
 		m_pSettingsManager->getColorPickerVisible());
 	m_pPreviewContextMenu->addAction(m_pActionToggleColorPicker);
 
+	m_pActionToggleRegionStatistics->setToolTip(
+		tr("Drag over the preview to get the statistics of a region "
+		"instead of scrolling"));
+	addAction(m_pActionToggleRegionStatistics);
+	m_pPreviewContextMenu->addAction(m_pActionToggleRegionStatistics);
+
+	m_pPreviewContextMenu->addAction(m_pActionShowNodeTiming);
+	addAction(m_pActionShowNodeTiming);
+
 	m_pActionPlay->setChecked(false);
 	addAction(m_pActionPlay);
 
+	m_realTimePlayback = m_pSettingsManager->getPlayRealTime();
+	m_pActionToggleRealTimePlay->setChecked(m_realTimePlayback);
+	m_pActionToggleRealTimePlay->setToolTip(
+		tr("Keep to the wall clock and skip the frames that come late"));
+	addAction(m_pActionToggleRealTimePlay);
+
+	m_showPlaybackStatistics = m_pSettingsManager->getShowPlaybackStatistics();
+	m_pActionTogglePlaybackStatistics->setChecked(m_showPlaybackStatistics);
+	m_pActionTogglePlaybackStatistics->setToolTip(
+		tr("Show frame rate, dropped frames and jitter while playing"));
+	addAction(m_pActionTogglePlaybackStatistics);
+
+	m_pActionCompareFlip->setToolTip(
+		tr("Switch to the next of the compared outputs"));
+	addAction(m_pActionCompareFlip);
+
+	m_pActionBatchSnapshotExport->setToolTip(
+		tr("Save snapshots of a range of frames, every Nth frame "
+		"of the range or the bookmarked frames"));
+	addAction(m_pActionBatchSnapshotExport);
+
+	m_pActionExportCompareMetrics->setToolTip(
+		tr("Save PSNR, SSIM and the largest difference of the compared "
+		"outputs for a range of frames"));
+	addAction(m_pActionExportCompareMetrics);
+
 	addAction(m_pActionLoadChapters);
 	addAction(m_pActionClearBookmarks);
 	addAction(m_pActionBookmarkCurrentFrame);
@@ -2582,11 +3330,28 @@ void PreviewDialog::createActionsAndMenus()
 	addAction(m_pActionGoToPreviousBookmark);
 	addAction(m_pActionGoToNextBookmark);
 
+	m_pActionScanMarkers->setToolTip(
+		tr("Mark the frames of the output that have a frame property set, "
+		"scanning in the background"));
+	addAction(m_pActionScanMarkers);
+	m_pPreviewContextMenu->addAction(m_pActionScanMarkers);
+	addAction(m_pActionClearMarkers);
+	m_pPreviewContextMenu->addAction(m_pActionClearMarkers);
+	addAction(m_pActionGoToPreviousMarker);
+	addAction(m_pActionGoToNextMarker);
+
 	addAction(m_pActionPasteShownFrameNumberIntoScript);
 	m_pPreviewContextMenu->addAction(m_pActionPasteShownFrameNumberIntoScript);
 
 	addAction(m_pActionJumpToFrame);
 	addAction(m_pActionToggleFramePropsPanel);
+	addAction(m_pActionToggleScopesPanel);
+
+	m_pActionToggleThumbnailStrip->setChecked(
+		m_pSettingsManager->getThumbnailStripVisible());
+	m_pActionToggleThumbnailStrip->setToolTip(
+		tr("Show thumbnails of the clip above the time line"));
+	addAction(m_pActionToggleThumbnailStrip);
 //------------------------------------------------------------------------------
 
 	addAction(m_pActionSwitchToOutputIndex0);
@@ -2678,6 +3443,9 @@ void PreviewDialog::setUpTimeLinePanel()
 		m_pSettingsManager->getTimeLinePanelVisible());
 
     m_ui.playButton->setDefaultAction(m_pActionPlay);
+	m_ui.realTimePlayButton->setDefaultAction(m_pActionToggleRealTimePlay);
+	m_ui.playbackStatisticsButton->setDefaultAction(
+		m_pActionTogglePlaybackStatistics);
     m_ui.timeLineCheckButton->setDefaultAction(m_pActionToggleTimeLinePanel);
     m_ui.timeStepForwardButton->setDefaultAction(m_pActionTimeStepForward);
     m_ui.timeStepBackButton->setDefaultAction(m_pActionTimeStepBack);
@@ -2777,6 +3545,34 @@ void PreviewDialog::setUpCropPanel()
 // END OF void PreviewDialog::setUpCropPanel()
 //==============================================================================
 
+void PreviewDialog::setUpCompareControls()
+{
+	m_ui.compareModeComboBox->addItem(tr("No compare"),
+		(int)CompareMode::Off);
+	m_ui.compareModeComboBox->addItem(tr("Side by side"),
+		(int)CompareMode::SideBySide);
+	m_ui.compareModeComboBox->addItem(tr("Wipe"), (int)CompareMode::Wipe);
+	m_ui.compareModeComboBox->addItem(tr("A/B flip"), (int)CompareMode::Flip);
+
+	int comboIndex = m_ui.compareModeComboBox->findData(
+		(int)m_pSettingsManager->getCompareMode());
+	if(comboIndex != -1)
+		m_ui.compareModeComboBox->setCurrentIndex(comboIndex);
+	m_compareMode =
+		(CompareMode)m_ui.compareModeComboBox->currentData().toInt();
+
+	m_ui.compareOutputsEdit->setText(m_pSettingsManager->getCompareOutputs());
+	m_ui.compareOutputsEdit->setEnabled(m_compareMode != CompareMode::Off);
+
+	connect(m_ui.compareModeComboBox, SIGNAL(currentIndexChanged(int)),
+		this, SLOT(slotCompareModeChanged()));
+	connect(m_ui.compareOutputsEdit, SIGNAL(editingFinished()),
+		this, SLOT(slotCompareOutputsChanged()));
+}
+
+// END OF void PreviewDialog::setUpCompareControls()
+//==============================================================================
+
 bool PreviewDialog::requestShowFrame(int a_frameNumber)
 {
 	if(!m_pVapourSynthScriptProcessor->isInitialized())
@@ -2785,83 +3581,846 @@ bool PreviewDialog::requestShowFrame(int a_frameNumber)
 	if((m_frameShown != -1) && (m_frameShown != m_frameExpected))
 		return false;
 
+	if(compareActive())
+		return requestComparedFrames(a_frameNumber);
+
 	m_pVapourSynthScriptProcessor->requestFrameAsync(a_frameNumber,
 		m_outputIndex, true);
+	m_frameToCache = a_frameNumber;
 	return true;
 }
 
 // END OF bool PreviewDialog::requestShowFrame(int a_frameNumber)
 //==============================================================================
 
-void PreviewDialog::setPreviewPixmap()
+bool PreviewDialog::showCachedFrame(int a_frameNumber)
 {
-	m_devicePixelRatio = window()->devicePixelRatioF();
-	if(!m_framePixmap.isNull())
-		m_framePixmap.setDevicePixelRatio(m_devicePixelRatio);
-	if(m_ui.cropPanel->isVisible())
-	{
-		int cropLeft = m_ui.cropLeftSpinBox->value();
-		int cropTop = m_ui.cropTopSpinBox->value();
-		int cropWidth = m_ui.cropWidthSpinBox->value();
-		int cropHeight = m_ui.cropHeightSpinBox->value();
-		QPixmap croppedPixmap = m_framePixmap.copy(cropLeft, cropTop,
-			cropWidth, cropHeight);
-		int ratio = m_ui.cropZoomRatioSpinBox->value();
-
-		if(abs(ratio * m_devicePixelRatio - 1) < 1e-7)
-		{
-			m_ui.previewArea->setPixmap(croppedPixmap);
-			return;
-		}
+	if(!m_pVapourSynthScriptProcessor->isInitialized())
+		return false;
 
-		QPixmap zoomedPixmap = croppedPixmap.scaled(
-			croppedPixmap.width() * ratio, croppedPixmap.height() * ratio,
-			Qt::KeepAspectRatio, Qt::FastTransformation);
-		m_ui.previewArea->setPixmap(zoomedPixmap);
-		return;
-	}
+	if((m_frameShown != -1) && (m_frameShown != m_frameExpected))
+		return false;
 
-	ZoomMode zoomMode = (ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
-	if(zoomMode == ZoomMode::NoZoom)
+	if(compareActive())
 	{
-		m_ui.previewArea->setPixmap(m_framePixmap, true);
-		return;
+		if(!takeCachedComparedFrames(a_frameNumber))
+			return false;
+		setExpectedFrame(a_frameNumber);
+		showComparedFrames();
+		return true;
 	}
 
-	QPixmap previewPixmap;
-	int frameWidth = 0;
-	int frameHeight = 0;
-	Qt::TransformationMode scaleMode = (Qt::TransformationMode)
-		m_ui.scaleModeComboBox->currentData().toInt();
+	const VSFrame * cpOutputFrame = nullptr;
+	const VSFrame * cpPreviewFrame = nullptr;
+	bool cached = m_previewFrameCache.get(a_frameNumber, m_outputIndex,
+		&cpOutputFrame, &cpPreviewFrame);
+	if(!cached)
+		return false;
 
-	if(zoomMode == ZoomMode::FixedRatio)
-	{
-		double ratio = m_ui.zoomRatioSpinBox->value();
-		frameWidth = m_framePixmap.width() * ratio;
-		frameHeight = m_framePixmap.height() * ratio;
-	}
-	else
-	{
-		if(m_framePixmap.isNull())
-			return;
-		QRect previewRect = m_ui.previewArea->geometry();
-		int cropSize = m_ui.previewArea->frameWidth() * 2;
-		frameWidth = previewRect.width() * m_devicePixelRatio - cropSize;
-		frameHeight = previewRect.height() * m_devicePixelRatio - cropSize;
-	}
+	setExpectedFrame(a_frameNumber);
+	setCurrentFrame(cpOutputFrame, cpPreviewFrame);
+	m_frameShown = a_frameNumber;
+	m_ui.frameStatusLabel->setPixmap(m_readyPixmap);
+	return true;
+}
 
-	previewPixmap = m_framePixmap.scaled(frameWidth, frameHeight,
-		Qt::KeepAspectRatio, scaleMode);
+// END OF bool PreviewDialog::showCachedFrame(int a_frameNumber)
+//==============================================================================
 
-	m_ui.previewArea->setPixmap(previewPixmap, true);
+bool PreviewDialog::compareActive() const
+{
+	return (m_compareMode != CompareMode::Off) && (!m_playing) &&
+		(m_compareOutputs.size() > 1) &&
+		vsedit::contains(m_compareOutputs, m_outputIndex);
 }
 
-// END OF bool void PreviewDialog::setPreviewPixmap()
+// END OF bool PreviewDialog::compareActive() const
 //==============================================================================
 
-void PreviewDialog::recalculateCropMods()
+void PreviewDialog::updateCompareOutputs()
 {
-	QSpinBox * cropSpinBoxes[] = {m_ui.cropLeftSpinBox, m_ui.cropTopSpinBox,
+	m_compareOutputs.clear();
+	if(!m_pVapourSynthScriptProcessor->isInitialized())
+		return;
+
+	static const QRegularExpression separators("[,;\\s]+");
+	QStringList indexStrings = m_ui.compareOutputsEdit->text().split(
+		separators, Qt::SkipEmptyParts);
+
+	for(const QString & indexString : indexStrings)
+	{
+		bool isNumber = false;
+		int index = indexString.toInt(&isNumber);
+		if((!isNumber) || (index < 0) || (index >= MAX_VS_OUTPUT))
+			continue;
+		if(vsedit::contains(m_compareOutputs, index))
+			continue;
+		if((!m_outputIndices.empty()) &&
+			(!vsedit::contains(m_outputIndices, index)))
+			continue;
+
+		VSNodeInfo nodeInfo =
+			m_pVapourSynthScriptProcessor->nodeInfo(index);
+		if(nodeInfo.isInvalid() || (!nodeInfo.isVideo()))
+			continue;
+
+		m_nodeInfo[index] = nodeInfo;
+		m_compareOutputs.push_back(index);
+		if(m_compareOutputs.size() == COMPARE_MAX_OUTPUTS)
+			break;
+	}
+}
+
+// END OF void PreviewDialog::updateCompareOutputs()
+//==============================================================================
+
+void PreviewDialog::refreshCompare()
+{
+	clearComparedFrames();
+	m_compareImage = QImage();
+	updateCompareOutputs();
+
+	if((!m_pVapourSynthScriptProcessor->isInitialized()) || m_playing)
+		return;
+
+	if((m_compareMode != CompareMode::Off) && (m_compareOutputs.size() > 1) &&
+		(!vsedit::contains(m_compareOutputs, m_outputIndex)))
+	{
+		// Switching the output requests the compared frames.
+		setOutputIndex(m_compareOutputs[0]);
+		if(m_outputIndex == m_compareOutputs[0])
+			return;
+	}
+
+	if(!compareActive())
+	{
+		setPreviewPixmap();
+		return;
+	}
+
+	if(showCachedFrame(m_frameExpected))
+		return;
+
+	if(requestShowFrame(m_frameExpected))
+		m_ui.frameStatusLabel->setPixmap(m_busyPixmap);
+}
+
+// END OF void PreviewDialog::refreshCompare()
+//==============================================================================
+
+bool PreviewDialog::requestComparedFrames(int a_frameNumber)
+{
+	if(m_compareFrameNumber != a_frameNumber)
+		clearComparedFrames();
+	m_compareFrameNumber = a_frameNumber;
+
+	// All the requests are queued at once,
+	// so the core works on the group together.
+	for(int outputIndex : m_compareOutputs)
+	{
+		if(m_comparedFrames.count(outputIndex) ||
+			m_comparedFramesPending.count(outputIndex))
+			continue;
+
+		int frameNumber = std::min(a_frameNumber,
+			m_nodeInfo[outputIndex].numFrames() - 1);
+		bool requested = m_pVapourSynthScriptProcessor->requestFrameAsync(
+			frameNumber, outputIndex, true);
+		if(!requested)
+		{
+			clearComparedFrames();
+			return false;
+		}
+		m_comparedFramesPending[outputIndex] = frameNumber;
+	}
+
+	m_frameToCache = -1;
+
+	if(m_comparedFramesPending.empty())
+		showComparedFrames();
+	return true;
+}
+
+// END OF bool PreviewDialog::requestComparedFrames(int a_frameNumber)
+//==============================================================================
+
+bool PreviewDialog::takeCachedComparedFrames(int a_frameNumber)
+{
+	if(m_compareFrameNumber != a_frameNumber)
+		clearComparedFrames();
+	m_compareFrameNumber = a_frameNumber;
+
+	for(int outputIndex : m_compareOutputs)
+	{
+		if(m_comparedFrames.count(outputIndex) ||
+			m_comparedFramesPending.count(outputIndex))
+			continue;
+
+		int frameNumber = std::min(a_frameNumber,
+			m_nodeInfo[outputIndex].numFrames() - 1);
+		const VSFrame * cpOutputFrame = nullptr;
+		const VSFrame * cpPreviewFrame = nullptr;
+		bool cached = m_previewFrameCache.get(frameNumber, outputIndex,
+			&cpOutputFrame, &cpPreviewFrame);
+		if(!cached)
+			continue;
+
+		m_comparedFrames.emplace(outputIndex, Frame(frameNumber, outputIndex,
+			cpOutputFrame, cpPreviewFrame));
+	}
+
+	return (m_comparedFrames.size() == m_compareOutputs.size());
+}
+
+// END OF bool PreviewDialog::takeCachedComparedFrames(int a_frameNumber)
+//==============================================================================
+
+bool PreviewDialog::takeComparedFrame(int a_frameNumber, int a_outputIndex,
+	const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame)
+{
+	std::map<int, int>::iterator it =
+		m_comparedFramesPending.find(a_outputIndex);
+	if((it == m_comparedFramesPending.end()) || (it->second != a_frameNumber))
+	{
+		// Late frames of a group given up are not shown.
+		return (m_compareMode != CompareMode::Off) &&
+			(a_outputIndex != m_outputIndex) &&
+			vsedit::contains(m_compareOutputs, a_outputIndex);
+	}
+	m_comparedFramesPending.erase(it);
+
+	Q_ASSERT(m_cpVSAPI);
+	m_comparedFrames.emplace(a_outputIndex, Frame(a_frameNumber,
+		a_outputIndex, m_cpVSAPI->addFrameRef(a_cpOutputFrame),
+		m_cpVSAPI->addFrameRef(a_cpPreviewFrame)));
+	if(!m_comparedFramesStale)
+	{
+		m_previewFrameCache.add(a_frameNumber, a_outputIndex,
+			a_cpOutputFrame, a_cpPreviewFrame);
+	}
+
+	if(m_comparedFramesPending.empty())
+		showComparedFrames();
+	return true;
+}
+
+// END OF bool PreviewDialog::takeComparedFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrame * a_cpOutputFrame,
+//		const VSFrame * a_cpPreviewFrame)
+//==============================================================================
+
+void PreviewDialog::showComparedFrames()
+{
+	std::map<int, Frame>::const_iterator it =
+		m_comparedFrames.find(m_outputIndex);
+	if(it == m_comparedFrames.end())
+		return;
+
+	// Composed first, so the current frame is shown with the others.
+	composeComparedImage();
+
+	Q_ASSERT(m_cpVSAPI);
+	const Frame & frame = it->second;
+	setCurrentFrame(m_cpVSAPI->addFrameRef(frame.cpOutputFrame),
+		m_cpVSAPI->addFrameRef(frame.cpPreviewFrame));
+	m_frameShown = m_compareFrameNumber;
+	if(m_frameShown == m_frameExpected)
+		m_ui.frameStatusLabel->setPixmap(m_readyPixmap);
+
+	if(m_comparedFramesStale)
+		clearComparedFrames();
+}
+
+// END OF void PreviewDialog::showComparedFrames()
+//==============================================================================
+
+void PreviewDialog::composeComparedImage()
+{
+	std::vector<QImage> images;
+	for(int outputIndex : m_compareOutputs)
+	{
+		std::map<int, Frame>::const_iterator it =
+			m_comparedFrames.find(outputIndex);
+		if(it == m_comparedFrames.end())
+			return;
+		images.push_back(imageFromRGB(it->second.cpPreviewFrame));
+	}
+
+	m_compareImage = vsedit::composeCompareImage(images, m_compareMode,
+		m_compareWipePosition);
+}
+
+// END OF void PreviewDialog::composeComparedImage()
+//==============================================================================
+
+void PreviewDialog::clearComparedFrames()
+{
+	if(!m_comparedFramesPending.empty())
+	{
+		// Tickets that also answer other requests are kept.
+		const std::map<int, int> & pending = m_comparedFramesPending;
+		cancelFrameTickets(
+			[&](const FrameTicket & a_ticket)
+			{
+				std::map<int, int>::const_iterator it =
+					pending.find(a_ticket.outputIndex);
+				return (a_ticket.kind == FrameTicketKind::Frame) &&
+					(a_ticket.priority == FramePriority::Interactive) &&
+					(a_ticket.subscribers == 1) &&
+					(it != pending.end()) &&
+					(it->second == a_ticket.frameNumber);
+			});
+		m_comparedFramesPending.clear();
+	}
+
+	for(std::pair<const int, Frame> & item : m_comparedFrames)
+	{
+		Q_ASSERT(m_cpVSAPI);
+		m_cpVSAPI->freeFrame(item.second.cpOutputFrame);
+		m_cpVSAPI->freeFrame(item.second.cpPreviewFrame);
+	}
+	m_comparedFrames.clear();
+
+	m_compareFrameNumber = -1;
+	m_comparedFramesStale = false;
+}
+
+// END OF void PreviewDialog::clearComparedFrames()
+//==============================================================================
+
+bool PreviewDialog::metricsOutputs(int & a_referenceIndex,
+	int & a_comparedIndex) const
+{
+	if(!compareActive())
+		return false;
+
+	a_referenceIndex = m_compareOutputs[0];
+	a_comparedIndex = m_outputIndex;
+	if(a_comparedIndex == a_referenceIndex)
+	{
+		a_referenceIndex = m_compareOutputs[1];
+		a_comparedIndex = m_compareOutputs[0];
+	}
+	return true;
+}
+
+// END OF bool PreviewDialog::metricsOutputs(int & a_referenceIndex,
+//		int & a_comparedIndex) const
+//==============================================================================
+
+void PreviewDialog::requestShownFrameMetrics()
+{
+	int referenceIndex = -1;
+	int comparedIndex = -1;
+	if((m_frameShown < 0) || (!metricsOutputs(referenceIndex, comparedIndex)))
+		return;
+
+	bool requested = (m_frameMetricsRequested.frameNumber == m_frameShown) &&
+		(m_frameMetricsRequested.referenceIndex == referenceIndex) &&
+		(m_frameMetricsRequested.comparedIndex == comparedIndex);
+	if(requested)
+		return;
+
+	// Not retried on failure - the processor reports it.
+	m_frameMetricsRequested = FrameMetrics(m_frameShown, referenceIndex,
+		comparedIndex);
+	m_pVapourSynthScriptProcessor->requestFrameMetricsAsync(m_frameShown,
+		referenceIndex, comparedIndex, FramePriority::Interactive);
+}
+
+// END OF void PreviewDialog::requestShownFrameMetrics()
+//==============================================================================
+
+QString PreviewDialog::frameMetricsString() const
+{
+	int referenceIndex = -1;
+	int comparedIndex = -1;
+	if(!metricsOutputs(referenceIndex, comparedIndex))
+		return QString();
+
+	bool current = (m_frameMetrics.frameNumber == m_frameShown) &&
+		(m_frameMetrics.referenceIndex == referenceIndex) &&
+		(m_frameMetrics.comparedIndex == comparedIndex);
+	if((!current) || m_frameMetrics.isEmpty())
+		return QString();
+
+	QString metricsString = QString("\nOutput %1 against output %2\n")
+		.arg(comparedIndex).arg(referenceIndex);
+	for(size_t i = 0; i < m_frameMetrics.psnr.size(); ++i)
+	{
+		double ssim = (i < m_frameMetrics.ssim.size()) ?
+			m_frameMetrics.ssim[i] : NAN;
+		double maxAbsDiff = (i < m_frameMetrics.maxAbsDiff.size()) ?
+			m_frameMetrics.maxAbsDiff[i] : NAN;
+		metricsString += QString("Plane %1: PSNR %2 dB | SSIM %3 | "
+			"Max abs diff %4\n").arg(i)
+			.arg(QString::number(m_frameMetrics.psnr[i], 'f', 3))
+			.arg(std::isnan(ssim) ? QString("-") :
+				QString::number(ssim, 'f', 5))
+			.arg(QString::number(maxAbsDiff, 'g', 6));
+	}
+	return metricsString;
+}
+
+// END OF QString PreviewDialog::frameMetricsString() const
+//==============================================================================
+
+QString PreviewDialog::evaluateSnapshotTemplate(const QString & a_template,
+	int a_frameNumber, int a_outputIndex, const QString & a_clipName,
+	const QString & a_sceneName) const
+{
+	const QString & currScriptName = scriptName();
+	std::pair<int64_t, int64_t> fpsPair =
+		m_nodeInfo[a_outputIndex].fpsPair();
+
+	std::vector<vsedit::VariableToken> variables =
+	{
+		{"{f}", tr("script file path"),
+			[&]()
+			{
+				return currScriptName;
+			}
+		},
+
+		{"{d}", tr("script file directory"),
+			[&]()
+			{
+				QFileInfo file(currScriptName);
+				return QDir::toNativeSeparators(file.path());
+			}
+		},
+
+		{"{n}", tr("script file name"),
+			[&]()
+			{
+				QFileInfo file(currScriptName);
+				return file.completeBaseName();
+			}
+		},
+
+		{"{o}", tr("output index"),
+			[&]()
+			{
+				return QString::number(a_outputIndex);
+			}
+		},
+
+		{"{i}", tr("frame number"),
+			[&]()
+			{
+				return QString::number(a_frameNumber);
+			}
+		},
+
+		{"{t}", tr("timestamp"),
+			[&]()
+			{
+				if(fpsPair.first == 0 || fpsPair.second == 0)
+					return QString();
+				QString timeStr = vsedit::timeToString(
+					(double)a_frameNumber / fpsPair.first * fpsPair.second,
+					true).replace(":", ".");
+				return timeStr;
+			}
+		},
+
+		{"{nm}", tr("clip name"),
+			[&]()
+			{
+				return a_clipName;
+			}
+		},
+
+		{"{sc}", tr("scene name"),
+			[&]()
+			{
+				return a_sceneName;
+			}
+		},
+	};
+
+	QString result = a_template;
+	for(const vsedit::VariableToken & var : variables)
+		result = result.replace(var.token, var.evaluate());
+	return result;
+}
+
+// END OF QString PreviewDialog::evaluateSnapshotTemplate(
+//		const QString & a_template, int a_frameNumber, int a_outputIndex,
+//		const QString & a_clipName, const QString & a_sceneName) const
+//==============================================================================
+
+void PreviewDialog::resetThumbnails()
+{
+	m_pThumbnailLoader->reset(
+		VSScriptLibrary::scriptContentsHash(script(), scriptName()),
+		m_outputIndex, m_nodeInfo[m_outputIndex], m_frameExpected);
+}
+
+// END OF void PreviewDialog::resetThumbnails()
+//==============================================================================
+
+void PreviewDialog::updatePlaybackStatistics(bool a_force)
+{
+	if(!(m_playing && m_showPlaybackStatistics))
+	{
+		m_ui.previewArea->setOverlayText(QString());
+		return;
+	}
+
+	hr_time_point now = hr_clock::now();
+	if((!a_force) && (duration_to_double(now - m_lastStatisticsUpdateTime) <
+		PLAYBACK_STATISTICS_UPDATE_INTERVAL))
+		return;
+	m_lastStatisticsUpdateTime = now;
+
+	QString fpsString = QString::number(m_playbackStatistics.fps(), 'f', 2);
+	if(m_secondsBetweenFrames > 0.0)
+	{
+		fpsString += QString(" / %1").arg(1.0 / m_secondsBetweenFrames, 0,
+			'f', 2);
+	}
+
+	QString text = tr("FPS: %1\nDropped: %2\n"
+		"Jitter p50/p95/p99: %3/%4/%5 ms")
+		.arg(fpsString)
+		.arg(m_playbackStatistics.framesDropped())
+		.arg(m_playbackStatistics.jitterPercentile(50) * 1000.0, 0, 'f', 1)
+		.arg(m_playbackStatistics.jitterPercentile(95) * 1000.0, 0, 'f', 1)
+		.arg(m_playbackStatistics.jitterPercentile(99) * 1000.0, 0, 'f', 1);
+	m_ui.previewArea->setOverlayText(text);
+}
+
+// END OF void PreviewDialog::updatePlaybackStatistics(bool a_force)
+//==============================================================================
+
+void PreviewDialog::clearPreviewFrameCache()
+{
+	cancelPrefetch();
+	if(m_comparedFramesPending.empty())
+		clearComparedFrames();
+	else
+		m_comparedFramesStale = true;
+	m_previewFrameCache.clear();
+	m_frameToCache = -1;
+}
+
+// END OF void PreviewDialog::clearPreviewFrameCache()
+//==============================================================================
+
+void PreviewDialog::resetPreviewFrameCache()
+{
+	m_previewFrameCache.setMaxSize(
+		(size_t)m_pSettingsManager->getPreviewFrameCacheSize() * 1024 * 1024);
+	m_prefetchWindow = m_pSettingsManager->getPreviewPrefetchFrames();
+	clearPreviewFrameCache();
+}
+
+// END OF void PreviewDialog::resetPreviewFrameCache()
+//==============================================================================
+
+void PreviewDialog::prefetchFrames(int a_step)
+{
+	if(m_playing || (a_step == 0))
+		return;
+
+	if(!m_pVapourSynthScriptProcessor->isInitialized())
+		return;
+
+	// Only the navigation steps are followed, jumps are not.
+	int maxStep = std::max(m_bigFrameStep, 1);
+	if(m_fpsDen != 0)
+	{
+		double timeStep = vsedit::qtimeToSeconds(m_ui.timeStepEdit->time());
+		maxStep = std::max(maxStep,
+			(int)std::ceil(timeStep * m_fpsNum / m_fpsDen));
+	}
+
+	// Prefetched frames have nowhere to go without the cache.
+	std::vector<int> window;
+	if((m_previewFrameCache.maxSize() != 0) && (std::abs(a_step) <= maxStep))
+	{
+		int numFrames = m_nodeInfo[m_outputIndex].numFrames();
+		int frame = m_frameExpected;
+		for(int i = 0; i < m_prefetchWindow; ++i)
+		{
+			frame += a_step;
+			if((frame < 0) || (frame >= numFrames))
+				break;
+			window.push_back(frame);
+		}
+	}
+
+	cancelPrefetch(window);
+
+	// Nearest frames first.
+	for(int frame : window)
+	{
+		if(m_prefetchedFrames.count(frame) ||
+			m_previewFrameCache.contains(frame, m_outputIndex))
+			continue;
+
+		bool requested = m_pVapourSynthScriptProcessor->requestFrameAsync(
+			frame, m_outputIndex, true, FramePriority::Prefetch);
+		if(!requested)
+			break;
+		m_prefetchedFrames.insert(frame);
+	}
+}
+
+// END OF void PreviewDialog::prefetchFrames(int a_step)
+//==============================================================================
+
+void PreviewDialog::cancelFrameTickets(
+	const FrameTicketPredicate & a_predicate)
+{
+	m_cancellingFrameTickets = true;
+	m_pVapourSynthScriptProcessor->cancelFrameTickets(a_predicate);
+	m_cancellingFrameTickets = false;
+}
+
+// END OF void PreviewDialog::cancelFrameTickets(
+//		const FrameTicketPredicate & a_predicate)
+//==============================================================================
+
+void PreviewDialog::cancelPrefetch(const std::vector<int> & a_window)
+{
+	std::set<int> droppedFrames;
+	for(int frame : m_prefetchedFrames)
+	{
+		if(std::find(a_window.begin(), a_window.end(), frame) ==
+			a_window.end())
+			droppedFrames.insert(frame);
+	}
+
+	if(droppedFrames.empty())
+		return;
+
+	for(int frame : droppedFrames)
+		m_prefetchedFrames.erase(frame);
+
+	// Tickets that also answer a request for the shown frame are kept.
+	int outputIndex = m_outputIndex;
+	cancelFrameTickets(
+		[&](const FrameTicket & a_ticket)
+		{
+			return (a_ticket.kind == FrameTicketKind::Frame) &&
+				(a_ticket.priority == FramePriority::Prefetch) &&
+				(a_ticket.subscribers == 1) &&
+				(a_ticket.outputIndex == outputIndex) &&
+				(droppedFrames.count(a_ticket.frameNumber) != 0);
+		});
+}
+
+// END OF void PreviewDialog::cancelPrefetch(
+//		const std::vector<int> & a_window)
+//==============================================================================
+
+bool PreviewDialog::takePrefetchedFrame(int a_frameNumber, int a_outputIndex,
+	const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame)
+{
+	if(a_outputIndex != m_outputIndex)
+		return false;
+
+	std::set<int>::iterator it = m_prefetchedFrames.find(a_frameNumber);
+	if(it == m_prefetchedFrames.end())
+		return false;
+
+	m_prefetchedFrames.erase(it);
+	m_previewFrameCache.add(a_frameNumber, a_outputIndex, a_cpOutputFrame,
+		a_cpPreviewFrame);
+	return true;
+}
+
+// END OF bool PreviewDialog::takePrefetchedFrame(int a_frameNumber,
+//		int a_outputIndex, const VSFrame * a_cpOutputFrame,
+//		const VSFrame * a_cpPreviewFrame)
+//==============================================================================
+
+void PreviewDialog::setPreviewPixmap()
+{
+	m_devicePixelRatio = window()->devicePixelRatioF();
+	if(m_frameImage.isNull())
+		return;
+
+	// The compared outputs are shown laid out together as one frame.
+	bool comparing = compareActive() && (!m_compareImage.isNull());
+	const QImage & image = comparing ? m_compareImage : m_frameImage;
+
+	QRect sourceRect = image.rect();
+	QSize displaySize = sourceRect.size();
+	Qt::TransformationMode scaleMode = Qt::FastTransformation;
+	bool isVideoFrame = true;
+
+	QRect crop;
+	int cropZoom = 1;
+	if(comparing && m_ui.cropPanel->isVisible())
+		isVideoFrame = false;
+	else if(previewFrameCropped(crop, cropZoom))
+		isVideoFrame = false;
+	else if(m_ui.cropPanel->isVisible())
+	{
+		// The frame came before the preview node was rebuilt with the crop.
+		// The crop is in frame coordinates, so it only applies to a full
+		// size image. Otherwise the last image is kept until the rebuilt
+		// node delivers.
+		if((!m_cpFrame) || (m_frameImage.size() !=
+			QSize(m_cpVSAPI->getFrameWidth(m_cpFrame, 0),
+			m_cpVSAPI->getFrameHeight(m_cpFrame, 0))))
+			return;
+
+		sourceRect = QRect(m_ui.cropLeftSpinBox->value(),
+			m_ui.cropTopSpinBox->value(), m_ui.cropWidthSpinBox->value(),
+			m_ui.cropHeightSpinBox->value()).intersected(m_frameImage.rect());
+		int ratio = m_ui.cropZoomRatioSpinBox->value();
+		displaySize = sourceRect.size() * ratio;
+		isVideoFrame = false;
+	}
+	else
+	{
+		ZoomMode zoomMode =
+			(ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
+		scaleMode = (Qt::TransformationMode)
+			m_ui.scaleModeComboBox->currentData().toInt();
+
+		if(zoomMode == ZoomMode::FixedRatio)
+		{
+			double ratio = m_ui.zoomRatioSpinBox->value();
+			displaySize = QSize(sourceRect.width() * ratio,
+				sourceRect.height() * ratio);
+		}
+		else if(zoomMode == ZoomMode::FitToFrame)
+		{
+			QRect previewRect = m_ui.previewArea->geometry();
+			int cropSize = m_ui.previewArea->frameWidth() * 2;
+			int frameWidth = previewRect.width() * m_devicePixelRatio -
+				cropSize;
+			int frameHeight = previewRect.height() * m_devicePixelRatio -
+				cropSize;
+			displaySize.scale(frameWidth, frameHeight, Qt::KeepAspectRatio);
+		}
+	}
+
+	m_ui.previewArea->setFrame(image, sourceRect, displaySize,
+		scaleMode, isVideoFrame);
+}
+
+// END OF bool void PreviewDialog::setPreviewPixmap()
+//==============================================================================
+
+bool PreviewDialog::updatePreviewSize()
+{
+	if(!m_pVapourSynthScriptProcessor->isInitialized())
+		return false;
+
+	int previewWidth = 0;
+	int previewHeight = 0;
+
+	ZoomMode zoomMode = (ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
+	if(m_pSettingsManager->getPreviewAtDisplaySize() &&
+		(zoomMode == ZoomMode::FitToFrame) && (!m_ui.cropPanel->isVisible()))
+	{
+		QRect previewRect = m_ui.previewArea->geometry();
+		int cropSize = m_ui.previewArea->frameWidth() * 2;
+		double devicePixelRatio = window()->devicePixelRatioF();
+		previewWidth = std::max(
+			(int)(previewRect.width() * devicePixelRatio) - cropSize, 1);
+		previewHeight = std::max(
+			(int)(previewRect.height() * devicePixelRatio) - cropSize, 1);
+	}
+
+	// With the crop panel open only the cropped part is converted.
+	QRect crop;
+	int cropZoom = 1;
+	if(m_ui.cropPanel->isVisible())
+	{
+		crop = QRect(m_ui.cropLeftSpinBox->value(),
+			m_ui.cropTopSpinBox->value(), m_ui.cropWidthSpinBox->value(),
+			m_ui.cropHeightSpinBox->value());
+		cropZoom = m_ui.cropZoomRatioSpinBox->value();
+	}
+
+	bool sizeChanged = m_pVapourSynthScriptProcessor->setPreviewSize(
+		previewWidth, previewHeight);
+	bool cropChanged = m_pVapourSynthScriptProcessor->setPreviewCrop(crop,
+		cropZoom);
+	bool changed = sizeChanged || cropChanged;
+	if(changed)
+		clearPreviewFrameCache();
+	return changed;
+}
+
+// END OF bool PreviewDialog::updatePreviewSize()
+//==============================================================================
+
+bool PreviewDialog::previewFrameCropped(QRect & a_crop, int & a_zoom) const
+{
+	if((!m_ui.cropPanel->isVisible()) || m_frameImage.isNull() || (!m_cpFrame))
+		return false;
+
+	QRect crop = m_pVapourSynthScriptProcessor->previewCrop();
+	QRect frameRect(0, 0, m_cpVSAPI->getFrameWidth(m_cpFrame, 0),
+		m_cpVSAPI->getFrameHeight(m_cpFrame, 0));
+	crop = crop.intersected(frameRect);
+	if(crop.isEmpty())
+		return false;
+
+	int zoom = m_pVapourSynthScriptProcessor->previewCropZoom();
+	if(m_frameImage.size() != crop.size() * zoom)
+		return false;
+
+	a_crop = crop;
+	a_zoom = zoom;
+	return true;
+}
+
+// END OF bool PreviewDialog::previewFrameCropped(QRect & a_crop,
+//		int & a_zoom) const
+//==============================================================================
+
+void PreviewDialog::requestFullSizeFrameImage(
+	const FullSizeFrameCallback & a_callback)
+{
+	if(m_frameImage.isNull() || (!m_cpFrame) || (m_frameShown < 0))
+	{
+		a_callback(QImage());
+		return;
+	}
+
+	// A cropped preview can match the frame in one dimension,
+	// so both are checked. Detach from the frame memory,
+	// the image may outlive the frame.
+	QRect crop;
+	int cropZoom = 1;
+	QSize frameSize(m_cpVSAPI->getFrameWidth(m_cpFrame, 0),
+		m_cpVSAPI->getFrameHeight(m_cpFrame, 0));
+	if((!previewFrameCropped(crop, cropZoom)) &&
+		(m_frameImage.size() == frameSize))
+	{
+		a_callback(m_frameImage.copy());
+		return;
+	}
+
+	bool requested = m_pVapourSynthScriptProcessor->
+		requestFullSizePreviewFrameAsync(m_frameShown, m_outputIndex,
+		FramePriority::Interactive);
+	if(!requested)
+	{
+		a_callback(QImage());
+		return;
+	}
+
+	m_fullSizeFrameRequests.emplace(std::make_pair(m_frameShown,
+		m_outputIndex), a_callback);
+}
+
+// END OF void PreviewDialog::requestFullSizeFrameImage(
+//		const FullSizeFrameCallback & a_callback)
+//==============================================================================
+
+void PreviewDialog::recalculateCropMods()
+{
+	QSpinBox * cropSpinBoxes[] = {m_ui.cropLeftSpinBox, m_ui.cropTopSpinBox,
 		m_ui.cropWidthSpinBox, m_ui.cropHeightSpinBox, m_ui.cropRightSpinBox,
 		m_ui.cropBottomSpinBox};
 
@@ -2961,17 +4520,20 @@ void PreviewDialog::setCurrentFrame(const VSFrame * a_cpOutputFrame,
 		m_toChangeTitle = false;
 		setTitle();
 	}
-	if (m_cpPreviewFrame)
-	{
-		m_cpVSAPI->freeFrame(m_cpPreviewFrame);
-		m_cpPreviewFrame = nullptr;
-	}
-	m_framePixmap = pixmapFromRGB(a_cpPreviewFrame);
+	// The preview area paints from the frame memory, so the previous
+	// frame is freed only after it is replaced there.
+	const VSFrame * cpPreviousPreviewFrame = m_cpPreviewFrame;
+	m_frameImage = imageFromRGB(a_cpPreviewFrame);
 	m_cpPreviewFrame = a_cpPreviewFrame;
 	setPreviewPixmap();
+	if(m_frameImage.isNull())
+		m_ui.previewArea->setBlank();
+	m_cpVSAPI->freeFrame(cpPreviousPreviewFrame);
 	QPointF pixelPos = m_ui.previewArea->pixelPosition();
 	m_ui.previewArea->checkMouseOverPreview(pixelPos);
 	updateFrameProps(false);
+	updateScopes();
+	updateRegionStatistics();
 }
 
 // END OF void PreviewDialog::setCurrentFrame(
@@ -2987,13 +4549,34 @@ void PreviewDialog::updateFrameProps(bool a_forced)
 			framePropsString(m_cpFrame);
 		QString info = QString("Index %1 | Frame %2 \n\n")
 			.arg(m_outputIndex).arg(m_frameExpected);
-		m_pFramePropsPanel->setText(info + props + QString("\n"));
+		if(a_forced || m_pFramePropsPanel->isVisible())
+			requestShownFrameMetrics();
+		m_pFramePropsPanel->setText(info + props + frameMetricsString() +
+			QString("\n"));
 	}
 }
 
 // END OF void PreviewDialog::updateFrameProps(bool a_forced)
 //==============================================================================
 
+void PreviewDialog::updateScopes()
+{
+	if((!m_pScopesPanel->isVisible()) || (!m_cpFrame))
+		return;
+
+	Q_ASSERT(m_cpVSAPI);
+	if(m_cpVSAPI->getFrameType(m_cpFrame) != mtVideo)
+	{
+		m_pScopesPanel->clear();
+		return;
+	}
+
+	m_pScopesWorker->compute(m_cpFrame, m_cpVSAPI);
+}
+
+// END OF void PreviewDialog::updateScopes()
+//==============================================================================
+
 double PreviewDialog::valueAtPoint(size_t a_x, size_t a_y, int a_plane)
 {
 	Q_ASSERT(m_cpVSAPI);
@@ -3072,6 +4655,29 @@ void PreviewDialog::previewValueAtPoint(size_t a_x, size_t a_y, int a_ret[])
 	size_t x = a_x;
 	size_t y = a_y;
 
+	// The preview frame may be cropped or converted at the display size.
+	size_t previewWidth =
+		(size_t)m_cpVSAPI->getFrameWidth(m_cpPreviewFrame, 0) / 4;
+	size_t previewHeight =
+		(size_t)m_cpVSAPI->getFrameHeight(m_cpPreviewFrame, 0);
+	size_t frameWidth = (size_t)m_cpVSAPI->getFrameWidth(m_cpFrame, 0);
+	size_t frameHeight = (size_t)m_cpVSAPI->getFrameHeight(m_cpFrame, 0);
+	QRect crop;
+	int cropZoom = 1;
+	if(previewFrameCropped(crop, cropZoom))
+	{
+		if((a_x < (size_t)crop.left()) || (a_y < (size_t)crop.top()))
+			return;
+		x = std::min((a_x - crop.left()) * (size_t)cropZoom, previewWidth - 1);
+		y = std::min((a_y - crop.top()) * (size_t)cropZoom,
+			previewHeight - 1);
+	}
+	else if((previewWidth != frameWidth) || (previewHeight != frameHeight))
+	{
+		x = std::min(x * previewWidth / frameWidth, previewWidth - 1);
+		y = std::min(y * previewHeight / frameHeight, previewHeight - 1);
+	}
+
 	int stride = m_cpVSAPI->getStride(m_cpPreviewFrame, 0);
 	const uint8_t * cpLoc = cpPlane + y * stride + x * 4;
 
@@ -3116,11 +4722,170 @@ void PreviewDialog::previewValueAtPoint(size_t a_x, size_t a_y, int a_ret[])
 //		int a_ret[])
 //==============================================================================
 
-QPixmap PreviewDialog::pixmapFromRGB(
+bool PreviewDialog::framePosition(const QPointF & a_previewPoint,
+	QPointF & a_framePoint)
+{
+	double zoomRatio = 1.0;
+	QPointF offset(0.0, 0.0);
+
+	if(m_ui.cropPanel->isVisible())
+	{
+		zoomRatio = m_ui.cropZoomRatioSpinBox->value();
+		offset = QPointF(m_ui.cropLeftSpinBox->value(),
+			m_ui.cropTopSpinBox->value());
+	}
+	else
+	{
+		ZoomMode zoomMode = (ZoomMode)m_ui.zoomModeComboBox->currentData().toInt();
+		if(zoomMode == ZoomMode::FixedRatio)
+		{
+			zoomRatio = m_ui.zoomRatioSpinBox->value();
+		}
+		else if(zoomMode != ZoomMode::NoZoom)
+		{
+			if(m_frameImage.isNull() || (!m_cpFrame))
+				return false;
+			// The pixmap may be converted at the display size already.
+			int width = m_cpVSAPI->getFrameWidth(m_cpFrame, 0);
+			int height = m_cpVSAPI->getFrameHeight(m_cpFrame, 0);
+			QRect previewRect = m_ui.previewArea->geometry();
+			int cropSize = m_ui.previewArea->frameWidth() * 2;
+			int frameWidth = previewRect.width() * m_devicePixelRatio - cropSize;
+			int frameHeight = previewRect.height() * m_devicePixelRatio - cropSize;
+			double scaleW = (double)frameWidth / width;
+			double scaleH = (double)frameHeight / height;
+			zoomRatio = scaleW < scaleH ? scaleW : scaleH;
+		}
+	}
+
+	if(zoomRatio <= 0)
+		return false;
+
+	a_framePoint = a_previewPoint * m_devicePixelRatio / zoomRatio + offset;
+	return true;
+}
+
+// END OF bool PreviewDialog::framePosition(const QPointF & a_previewPoint,
+//		QPointF & a_framePoint)
+//==============================================================================
+
+QRect PreviewDialog::shownFrameRect() const
+{
+	Q_ASSERT(m_cpFrame);
+
+	if(m_ui.cropPanel->isVisible())
+	{
+		return QRect(m_ui.cropLeftSpinBox->value(),
+			m_ui.cropTopSpinBox->value(), m_ui.cropWidthSpinBox->value(),
+			m_ui.cropHeightSpinBox->value());
+	}
+
+	return QRect(0, 0, m_cpVSAPI->getFrameWidth(m_cpFrame, 0),
+		m_cpVSAPI->getFrameHeight(m_cpFrame, 0));
+}
+
+// END OF QRect PreviewDialog::shownFrameRect() const
+//==============================================================================
+
+void PreviewDialog::updateRegionStatistics()
+{
+	QRect region = m_ui.previewArea->region();
+	if((!m_pActionToggleRegionStatistics->isChecked()) || region.isEmpty() ||
+		(!m_cpFrame) || (m_cpVSAPI->getFrameType(m_cpFrame) == mtAudio))
+	{
+		m_ui.previewArea->setRegionText(QString());
+		return;
+	}
+
+	// The statistics are taken from one frame, not from the row of them.
+	if(compareActive() && (m_compareMode == CompareMode::SideBySide) &&
+		(!m_compareImage.isNull()))
+	{
+		m_ui.previewArea->setRegionText(QString());
+		return;
+	}
+
+	QPointF topLeft;
+	QPointF bottomRight;
+	if((!framePosition(QPointF(region.topLeft()), topLeft)) ||
+		(!framePosition(QPointF(region.right() + 1, region.bottom() + 1),
+		bottomRight)))
+	{
+		m_ui.previewArea->setRegionText(QString());
+		return;
+	}
+
+	// Every sample the region touches is taken.
+	QRect frameRect(QPoint((int)std::floor(topLeft.x()),
+		(int)std::floor(topLeft.y())),
+		QPoint((int)std::ceil(bottomRight.x()) - 1,
+		(int)std::ceil(bottomRight.y()) - 1));
+	frameRect &= shownFrameRect();
+	if(frameRect.isEmpty())
+	{
+		m_ui.previewArea->setRegionText(QString());
+		return;
+	}
+
+	RegionStats stats = computeRegionStats(m_cpFrame, m_cpVSAPI,
+		frameRect.x(), frameRect.y(), frameRect.width(), frameRect.height());
+	m_ui.previewArea->setRegionText(regionStatisticsString(frameRect, stats));
+}
+
+// END OF void PreviewDialog::updateRegionStatistics()
+//==============================================================================
+
+QString PreviewDialog::regionStatisticsString(const QRect & a_frameRect,
+	const RegionStats & a_stats) const
+{
+	QString text = QString("Region: X:%1|Y:%2 %3x%4")
+		.arg(a_frameRect.x()).arg(a_frameRect.y())
+		.arg(a_frameRect.width()).arg(a_frameRect.height());
+	if(a_stats.isEmpty())
+		return text + QString("\nThe sample format is not supported.");
+
+	const char * labels[3] = {"1", "2", "3"};
+	if(a_stats.colorFamily == cfYUV)
+	{
+		labels[0] = "Y";
+		labels[1] = "U";
+		labels[2] = "V";
+	}
+	else if(a_stats.colorFamily == cfRGB)
+	{
+		labels[0] = "R";
+		labels[1] = "G";
+		labels[2] = "B";
+	}
+	else if(a_stats.colorFamily == cfGray)
+		labels[0] = "G";
+
+	for(int i = 0; i < a_stats.planes; ++i)
+	{
+		const PlaneRegionStats & stats = a_stats.stats[i];
+		double lowPercent = 100.0 * stats.low / stats.count;
+		double highPercent = 100.0 * stats.high / stats.count;
+		text += QString("\n%1: min %2  max %3  mean %4  sd %5  "
+			"<=%6: %7 (%8%)  >=%9: %10 (%11%)")
+			.arg(labels[i]).arg(stats.min).arg(stats.max)
+			.arg(stats.mean, 0, 'f', 3).arg(stats.stddev, 0, 'f', 3)
+			.arg(stats.lowLimit).arg(stats.low).arg(lowPercent, 0, 'f', 2)
+			.arg(stats.highLimit).arg(stats.high)
+			.arg(highPercent, 0, 'f', 2);
+	}
+
+	return text;
+}
+
+// END OF QString PreviewDialog::regionStatisticsString(
+//		const QRect & a_frameRect, const RegionStats & a_stats) const
+//==============================================================================
+
+QImage PreviewDialog::imageFromRGB(
 	const VSFrame * a_cpFrame)
 {
 	if((!m_cpVSAPI) || (!a_cpFrame))
-		return QPixmap();
+		return QImage();
 
 	const VSVideoFormat * cpFormat = m_cpVSAPI->getVideoFrameFormat(a_cpFrame);
 	Q_ASSERT(cpFormat);
@@ -3130,10 +4895,10 @@ QPixmap PreviewDialog::pixmapFromRGB(
 		|| (cpFormat->bitsPerSample != 8)
 		|| (wwidth % 4))
 	{
-		QString errorString = tr("Error forming pixmap from frame. "
+		QString errorString = tr("Error forming image from frame. "
 			"Expected format Gray8 with width divisible by 4. ");
 		emit signalWriteLogMessage(mtCritical, errorString);
-		return QPixmap();
+		return QImage();
 	}
 
 	const VSMap *props = m_cpVSAPI->getFramePropertiesRO(a_cpFrame);
@@ -3150,10 +4915,10 @@ QPixmap PreviewDialog::pixmapFromRGB(
 	}
 	else
 	{
-		QString errorString = tr("Error forming pixmap from frame. "
+		QString errorString = tr("Error forming image from frame. "
 			"Expected frame being packed from RGB24 or RGB30.");
 		emit signalWriteLogMessage(mtCritical, errorString);
-		return QPixmap();
+		return QImage();
 	}
 
 	int width = wwidth / 4;
@@ -3164,11 +4929,10 @@ QPixmap PreviewDialog::pixmapFromRGB(
 	QImage frameImage(reinterpret_cast<const uchar *>(pData),
 		width, height, stride, is_10_bits ?
 		QImage::Format_RGB30 : QImage::Format_ARGB32);
-	QPixmap framePixmap = QPixmap::fromImage(frameImage, Qt::NoFormatConversion);
-	return framePixmap;
+	return frameImage;
 }
 
-// END OF QPixmap PreviewDialog::pixmapFromRGB(
+// END OF QImage PreviewDialog::imageFromRGB(
 //		const VSFrame * a_cpFrame)
 //==============================================================================
 
@@ -3211,6 +4975,7 @@ void PreviewDialog::setExpectedFrame(int a_frame)
 {
 	m_frameExpected = a_frame;
 	m_frameTimestampExpected = frameToTimestamp(m_frameExpected);
+	m_pThumbnailLoader->setCurrentFrame(m_frameExpected);
 }
 
 void PreviewDialog::saveTimelineBookmarks()
@@ -4,10 +4,15 @@
 #include <ui_preview_dialog.h>
 
 #include "../vapoursynth/vs_script_processor_dialog.h"
+#include "preview_frame_cache.h"
+#include "playback_statistics.h"
+#include "../../../common-src/vapoursynth/vs_scopes.h"
+#include "../../../common-src/vapoursynth/vs_region_stats.h"
 #include "../../../common-src/settings/settings_definitions.h"
 #include "../../../common-src/chrono.h"
 
 #include <QPixmap>
+#include <QImage>
 #include <QTextEdit>
 #include <QIcon>
 #ifdef Q_OS_WIN // AUDIO
@@ -15,8 +20,10 @@
 #include <QIODevice>
 #endif
 #include <map>
+#include <set>
 #include <vector>
 #include <chrono>
+#include <functional>
 
 class QEvent;
 class QMoveEvent;
@@ -31,6 +38,13 @@ class SettingsDialog;
 class PreviewAdvancedSettingsDialog;
 class VSNodeInfo;
 class FramePropsPanel;
+class ScopesPanel;
+class ScopesWorker;
+class CompareMetricsExporter;
+class BatchSnapshotExporter;
+class MarkerScanner;
+class ThumbnailStrip;
+class ThumbnailLoader;
 
 extern const char TIMELINE_BOOKMARKS_FILE_SUFFIX[];
 
@@ -87,10 +101,14 @@ protected slots:
 	virtual void slotFrameRequestDiscarded(int a_frameNumber,
 		int a_outputIndex, const QString & a_reason) override;
 
+	virtual void slotScriptProcessorInitialized(bool a_success) override;
+
 	void slotShowFrame(int a_frameNumber, bool a_refreshCache = true);
 
 	void slotSaveSnapshot();
 
+	void slotBatchSnapshotExport();
+
 	void slotToggleZoomPanelVisible(bool a_zoomPanelVisible);
 
 	void slotZoomModeChanged();
@@ -135,6 +153,8 @@ protected slots:
 
 	void slotPreviewAreaSizeChanged();
 
+	void slotUpdatePreviewSize();
+
 	void slotPreviewAreaCtrlWheel(QPoint a_angleDelta);
 
 	void slotPreviewAreaMouseMiddleButtonReleased();
@@ -149,11 +169,39 @@ protected slots:
 
 	void slotToggleColorPicker(bool a_colorPickerVisible);
 
+	void slotToggleRegionStatistics(bool a_enabled);
+
+	void slotPreviewAreaRegionChanged();
+
 	void slotSetPlayFPSLimit();
 
 	void slotPlay(bool a_play);
 
+	void slotToggleRealTimePlay(bool a_realTime);
+
+	void slotTogglePlaybackStatistics(bool a_show);
+
 	void slotProcessPlayQueue();
+
+	void slotCompareModeChanged();
+
+	void slotCompareOutputsChanged();
+
+	void slotCompareFlip();
+
+	void slotFrameMetricsReady(const FrameMetrics & a_metrics);
+
+	void slotExportCompareMetrics();
+
+	void slotFullSizePreviewFrameReady(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpPreviewFrame);
+
+	void slotToggleThumbnailStrip(bool a_visible);
+
+	void slotThumbnailReady(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpThumbnailFrame);
+
+	void slotThumbnailStripFrameClicked(int a_frame);
 #ifdef Q_OS_WIN // AUDIO
 	void slotProcessAudioPlayQueue();
 #endif
@@ -165,6 +213,11 @@ protected slots:
 	void slotGoToPreviousBookmark();
 	void slotGoToNextBookmark();
 
+	void slotScanMarkers();
+	void slotClearMarkers();
+	void slotGoToPreviousMarker();
+	void slotGoToNextMarker();
+
 	void slotPasteShownFrameNumberIntoScript();
 
 	void slotSaveGeometry();
@@ -173,6 +226,10 @@ protected slots:
 
 	void slotToggleFrameProps();
 
+	void slotToggleScopes();
+
+	void slotScopesReady(const Scopes & a_scopes);
+
 	void slotSwitchOutputIndex(int a_outputIndex);
 
 	void setOutputIndex(int a_index);
@@ -206,6 +263,7 @@ protected slots:
 protected:
 
 	friend class FramePropsPanel;
+	friend class ScopesPanel;
 
 	virtual void stopAndCleanUp() override;
 
@@ -227,10 +285,108 @@ protected:
 
 	void setUpCropPanel();
 
+	void setUpCompareControls();
+
 	bool requestShowFrame(int a_frameNumber);
 
+	// Shows the frame from the cache of recently shown frames if it is
+	// there and no other frame is being requested.
+	bool showCachedFrame(int a_frameNumber);
+
+	// True if the shown frame is compared with the same frame of other
+	// outputs.
+	bool compareActive() const;
+
+	// Reads the compared outputs from the edit, keeping up to
+	// COMPARE_MAX_OUTPUTS video outputs.
+	void updateCompareOutputs();
+
+	// Applies a change of the compare mode or outputs to the shown frame.
+	void refreshCompare();
+
+	// Requests the frame from all the compared outputs as one group.
+	// Outputs already held or cached are not requested again.
+	bool requestComparedFrames(int a_frameNumber);
+
+	// Fills the group from the cache. Returns true if it is complete.
+	bool takeCachedComparedFrames(int a_frameNumber);
+
+	// Puts a frame requested for the group into it and shows the group
+	// once complete. Also swallows late frames of the other compared
+	// outputs. Returns false if the frame is not for the group.
+	bool takeComparedFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame);
+
+	void showComparedFrames();
+
+	void composeComparedImage();
+
+	// Cancels the requests of the group and frees its frames.
+	// The composed image is kept until the next group replaces it.
+	void clearComparedFrames();
+
+	// The shown output is measured against the first compared output,
+	// which is measured against the second one.
+	bool metricsOutputs(int & a_referenceIndex, int & a_comparedIndex) const;
+
+	void requestShownFrameMetrics();
+
+	QString frameMetricsString() const;
+
+	// Replaces the snapshot template variables with the values
+	// of the frame.
+	QString evaluateSnapshotTemplate(const QString & a_template,
+		int a_frameNumber, int a_outputIndex, const QString & a_clipName,
+		const QString & a_sceneName) const;
+
+	// Starts over with the thumbnails of the current output.
+	void resetThumbnails();
+
+	// Refreshes the playback statistics overlay no more often than a few
+	// times a second unless forced.
+	void updatePlaybackStatistics(bool a_force = false);
+
+	// Call when the shown frames would look different if requested again.
+	void clearPreviewFrameCache();
+
+	// Re-reads the cache and prefetch settings and clears the cache.
+	void resetPreviewFrameCache();
+
+	// Requests the frames the navigation by a_step from the expected frame
+	// is heading to, and cancels prefetched frames that are off the course.
+	void prefetchFrames(int a_step);
+
+	void cancelPrefetch(const std::vector<int> & a_window =
+		std::vector<int>());
+
+	// Cancels the tickets of requests the dialog lets go of itself,
+	// ignoring the discards they are answered with.
+	void cancelFrameTickets(const FrameTicketPredicate & a_predicate);
+
+	// Puts a prefetched frame into the cache. Returns false if the frame
+	// was not prefetched.
+	bool takePrefetchedFrame(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame);
+
+	// Shows the current frame with the crop and zoom applied.
 	void setPreviewPixmap();
 
+	// Tells the script processor the size to convert preview frames at.
+	// Returns true if the preview nodes were rebuilt.
+	bool updatePreviewSize();
+
+	// True if the shown preview frame was cropped and zoomed by the
+	// preview node already. Gives the crop and zoom applied.
+	bool previewFrameCropped(QRect & a_crop, int & a_zoom) const;
+
+	typedef std::function<void(const QImage &)> FullSizeFrameCallback;
+
+	// Calls back with the shown frame at full resolution even if the
+	// preview is scaled, or with a null image if it is not available.
+	// A scaled frame is converted anew on the worker threads, so the
+	// callback may come later.
+	void requestFullSizeFrameImage(const FullSizeFrameCallback & a_callback);
+
 	void recalculateCropMods();
 
 	void resetCropSpinBoxes();
@@ -245,11 +401,27 @@ protected:
 
 	void updateFrameProps(bool a_forced);
 
+	void updateScopes();
+
 	double valueAtPoint(size_t a_x, size_t a_y, int a_plane);
 
 	void previewValueAtPoint(size_t a_x, size_t a_y, int a_ret[]);
 
-	QPixmap pixmapFromRGB(const VSFrame * a_cpFrame);
+	// Maps a point of the preview area to the frame. Fails if the zoom
+	// is not known yet.
+	bool framePosition(const QPointF & a_previewPoint,
+		QPointF & a_framePoint);
+
+	// The part of the frame the preview shows.
+	QRect shownFrameRect() const;
+
+	void updateRegionStatistics();
+
+	QString regionStatisticsString(const QRect & a_frameRect,
+		const RegionStats & a_stats) const;
+
+	// The image wraps the frame memory and is valid as long as the frame.
+	QImage imageFromRGB(const VSFrame * a_cpFrame);
 
 	void setTitle();
 
@@ -285,13 +457,54 @@ protected:
 
 	const VSFrame * m_cpFrame;
 	const VSFrame * m_cpPreviewFrame;
-	QPixmap m_framePixmap;
+	// Wraps m_cpPreviewFrame.
+	QImage m_frameImage;
+
+	PreviewFrameCache m_previewFrameCache;
+	// Frames requested before the cache was cleared may come converted
+	// with old settings. Only the frame requested after it is cached.
+	int m_frameToCache;
+
+	int m_prefetchWindow;
+	// Prefetch requests of the current output that are not answered yet.
+	std::set<int> m_prefetchedFrames;
 
 	bool m_changingCropValues;
 
+	CompareMode m_compareMode;
+	std::vector<int> m_compareOutputs;
+	double m_compareWipePosition;
+	// The group of frames of the compared outputs by output index.
+	// The frame number of an output may be clamped to its length.
+	int m_compareFrameNumber;
+	std::map<int, Frame> m_comparedFrames;
+	std::map<int, int> m_comparedFramesPending;
+	// The preview settings changed while the group was being requested.
+	// It is shown when complete, but not cached or kept.
+	bool m_comparedFramesStale;
+	// The compared outputs laid out together.
+	QImage m_compareImage;
+
+	FrameMetrics m_frameMetrics;
+	FrameMetrics m_frameMetricsRequested;
+
+	CompareMetricsExporter * m_pCompareMetricsExporter;
+
+	BatchSnapshotExporter * m_pBatchSnapshotExporter;
+
+	// Single full size frames by the frame number and output index.
+	std::multimap<std::pair<int, int>, FullSizeFrameCallback>
+		m_fullSizeFrameRequests;
+
+	ThumbnailStrip * m_pThumbnailStrip;
+	ThumbnailLoader * m_pThumbnailLoader;
+
+	MarkerScanner * m_pMarkerScanner;
+
 	QMenu * m_pPreviewContextMenu;
 	QAction * m_pActionFrameToClipboard;
 	QAction * m_pActionSaveSnapshot;
+	QAction * m_pActionBatchSnapshotExport;
 	QAction * m_pActionToggleZoomPanel;
 	QMenu * m_pMenuZoomModes;
 	QActionGroup * m_pActionGroupZoomModes;
@@ -313,16 +526,28 @@ protected:
 	QAction * m_pActionPasteCropSnippetIntoScript;
 	QAction * m_pActionAdvancedSettingsDialog;
 	QAction * m_pActionToggleColorPicker;
+	QAction * m_pActionToggleRegionStatistics;
+	QAction * m_pActionShowNodeTiming;
 	QAction * m_pActionPlay;
+	QAction * m_pActionToggleRealTimePlay;
+	QAction * m_pActionTogglePlaybackStatistics;
+	QAction * m_pActionCompareFlip;
+	QAction * m_pActionExportCompareMetrics;
 	QAction * m_pActionLoadChapters;
 	QAction * m_pActionClearBookmarks;
 	QAction * m_pActionBookmarkCurrentFrame;
 	QAction * m_pActionUnbookmarkCurrentFrame;
 	QAction * m_pActionGoToPreviousBookmark;
 	QAction * m_pActionGoToNextBookmark;
+	QAction * m_pActionScanMarkers;
+	QAction * m_pActionClearMarkers;
+	QAction * m_pActionGoToPreviousMarker;
+	QAction * m_pActionGoToNextMarker;
 	QAction * m_pActionPasteShownFrameNumberIntoScript;
 	QAction * m_pActionJumpToFrame;
 	QAction * m_pActionToggleFramePropsPanel;
+	QAction * m_pActionToggleScopesPanel;
+	QAction * m_pActionToggleThumbnailStrip;
 	QAction * m_pActionSwitchToOutputIndex0;
 	QAction * m_pActionSwitchToOutputIndex1;
 	QAction * m_pActionSwitchToOutputIndex2;
@@ -355,10 +580,26 @@ protected:
 
 	bool m_playing;
 	bool m_processingPlayQueue;
+	bool m_cancellingFrameTickets;
 	bool m_nativePlaybackRate;
 	double m_secondsBetweenFrames;
 	hr_time_point m_lastFrameShowTime;
 	QTimer * m_pPlayTimer;
+
+	// In real time mode frames are due on a fixed schedule from the first
+	// frame shown and the frames that miss it are skipped.
+	bool m_realTimePlayback;
+	bool m_playScheduleStarted;
+	hr_time_point m_nextFrameDueTime;
+
+	bool m_showPlaybackStatistics;
+	PlaybackStatistics m_playbackStatistics;
+	hr_time_point m_lastStatisticsUpdateTime;
+
+	hr_time_point m_previewStartTime;
+	bool m_firstFrameTimePending;
+	QString m_previousScript;
+	QString m_previousScriptName;
 	QIcon m_iconPlay;
 	QIcon m_iconPause;
 
@@ -367,10 +608,15 @@ protected:
 	QTimer * m_pGeometrySaveTimer;
 	QByteArray m_windowGeometry;
 
+	QTimer * m_pPreviewSizeTimer;
+
 	qreal m_devicePixelRatio;
 
 	FramePropsPanel * m_pFramePropsPanel;
 
+	ScopesPanel * m_pScopesPanel;
+	ScopesWorker * m_pScopesWorker;
+
 	bool m_toChangeTitle;
 	bool m_scriptTextChanged = false;
 
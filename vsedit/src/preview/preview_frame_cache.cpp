@@ -0,0 +1,205 @@
+#include "preview_frame_cache.h"
+
+#include <vapoursynth/VapourSynth4.h>
+
+//==============================================================================
+
+PreviewFrameCache::CachedFrame::CachedFrame(const Frame & a_frame,
+	size_t a_size):
+	  frame(a_frame)
+	, size(a_size)
+{
+}
+
+//==============================================================================
+
+PreviewFrameCache::PreviewFrameCache():
+	  m_cpVSAPI(nullptr)
+	, m_maxSize(0)
+	, m_size(0)
+{
+}
+
+// END OF PreviewFrameCache::PreviewFrameCache()
+//==============================================================================
+
+PreviewFrameCache::~PreviewFrameCache()
+{
+	clear();
+}
+
+// END OF PreviewFrameCache::~PreviewFrameCache()
+//==============================================================================
+
+void PreviewFrameCache::setVSAPI(const VSAPI * a_cpVSAPI)
+{
+	if(m_cpVSAPI == a_cpVSAPI)
+		return;
+
+	clear();
+	m_cpVSAPI = a_cpVSAPI;
+}
+
+// END OF void PreviewFrameCache::setVSAPI(const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+void PreviewFrameCache::setMaxSize(size_t a_bytes)
+{
+	m_maxSize = a_bytes;
+	trim();
+}
+
+// END OF void PreviewFrameCache::setMaxSize(size_t a_bytes)
+//==============================================================================
+
+size_t PreviewFrameCache::maxSize() const
+{
+	return m_maxSize;
+}
+
+// END OF size_t PreviewFrameCache::maxSize() const
+//==============================================================================
+
+size_t PreviewFrameCache::size() const
+{
+	return m_size;
+}
+
+// END OF size_t PreviewFrameCache::size() const
+//==============================================================================
+
+void PreviewFrameCache::add(int a_frameNumber, int a_outputIndex,
+	const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame)
+{
+	if((!m_cpVSAPI) || (!a_cpOutputFrame) || (m_maxSize == 0))
+		return;
+
+	FrameKey key(a_outputIndex, a_frameNumber);
+	std::map<FrameKey, std::list<CachedFrame>::iterator>::iterator it =
+		m_index.find(key);
+	if(it != m_index.end())
+	{
+		// Shown again. The frames are the same unless the cache was not
+		// cleared after a change, so only refresh the order.
+		m_frames.splice(m_frames.begin(), m_frames, it->second);
+		return;
+	}
+
+	size_t size = frameSize(a_cpOutputFrame) + frameSize(a_cpPreviewFrame);
+	if(size > m_maxSize)
+		return;
+
+	Frame frame(a_frameNumber, a_outputIndex,
+		m_cpVSAPI->addFrameRef(a_cpOutputFrame),
+		a_cpPreviewFrame ? m_cpVSAPI->addFrameRef(a_cpPreviewFrame) : nullptr);
+	m_frames.push_front(CachedFrame(frame, size));
+	m_index[key] = m_frames.begin();
+	m_size += size;
+
+	trim();
+}
+
+// END OF void PreviewFrameCache::add(int a_frameNumber, int a_outputIndex,
+//		const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame)
+//==============================================================================
+
+bool PreviewFrameCache::contains(int a_frameNumber, int a_outputIndex) const
+{
+	return (m_index.find(FrameKey(a_outputIndex, a_frameNumber)) !=
+		m_index.end());
+}
+
+// END OF bool PreviewFrameCache::contains(int a_frameNumber,
+//		int a_outputIndex) const
+//==============================================================================
+
+bool PreviewFrameCache::get(int a_frameNumber, int a_outputIndex,
+	const VSFrame ** a_pcpOutputFrame, const VSFrame ** a_pcpPreviewFrame)
+{
+	Q_ASSERT(a_pcpOutputFrame);
+	Q_ASSERT(a_pcpPreviewFrame);
+
+	std::map<FrameKey, std::list<CachedFrame>::iterator>::iterator it =
+		m_index.find(FrameKey(a_outputIndex, a_frameNumber));
+	if(it == m_index.end())
+		return false;
+
+	m_frames.splice(m_frames.begin(), m_frames, it->second);
+
+	const Frame & frame = it->second->frame;
+	*a_pcpOutputFrame = m_cpVSAPI->addFrameRef(frame.cpOutputFrame);
+	*a_pcpPreviewFrame = frame.cpPreviewFrame ?
+		m_cpVSAPI->addFrameRef(frame.cpPreviewFrame) : nullptr;
+	return true;
+}
+
+// END OF bool PreviewFrameCache::get(int a_frameNumber, int a_outputIndex,
+//		const VSFrame ** a_pcpOutputFrame, const VSFrame ** a_pcpPreviewFrame)
+//==============================================================================
+
+void PreviewFrameCache::clear()
+{
+	for(const CachedFrame & cachedFrame : m_frames)
+		freeFrame(cachedFrame);
+	m_frames.clear();
+	m_index.clear();
+	m_size = 0;
+}
+
+// END OF void PreviewFrameCache::clear()
+//==============================================================================
+
+size_t PreviewFrameCache::frameSize(const VSFrame * a_cpFrame) const
+{
+	if(!a_cpFrame)
+		return 0;
+
+	if(m_cpVSAPI->getFrameType(a_cpFrame) == mtAudio)
+	{
+		const VSAudioFormat * cpFormat =
+			m_cpVSAPI->getAudioFrameFormat(a_cpFrame);
+		return (size_t)m_cpVSAPI->getFrameLength(a_cpFrame) *
+			cpFormat->bytesPerSample * cpFormat->numChannels;
+	}
+
+	const VSVideoFormat * cpFormat = m_cpVSAPI->getVideoFrameFormat(a_cpFrame);
+	size_t size = 0;
+	for(int i = 0; i < cpFormat->numPlanes; ++i)
+	{
+		size += (size_t)m_cpVSAPI->getStride(a_cpFrame, i) *
+			m_cpVSAPI->getFrameHeight(a_cpFrame, i);
+	}
+	return size;
+}
+
+// END OF size_t PreviewFrameCache::frameSize(const VSFrame * a_cpFrame)
+//		const
+//==============================================================================
+
+void PreviewFrameCache::freeFrame(const CachedFrame & a_cachedFrame)
+{
+	Q_ASSERT(m_cpVSAPI);
+	m_cpVSAPI->freeFrame(a_cachedFrame.frame.cpOutputFrame);
+	if(a_cachedFrame.frame.cpPreviewFrame)
+		m_cpVSAPI->freeFrame(a_cachedFrame.frame.cpPreviewFrame);
+}
+
+// END OF void PreviewFrameCache::freeFrame(
+//		const CachedFrame & a_cachedFrame)
+//==============================================================================
+
+void PreviewFrameCache::trim()
+{
+	while((m_size > m_maxSize) && (!m_frames.empty()))
+	{
+		const CachedFrame & cachedFrame = m_frames.back();
+		m_index.erase(FrameKey(cachedFrame.frame.outputIndex,
+			cachedFrame.frame.number));
+		m_size -= cachedFrame.size;
+		freeFrame(cachedFrame);
+		m_frames.pop_back();
+	}
+}
+
+// END OF void PreviewFrameCache::trim()
+//==============================================================================
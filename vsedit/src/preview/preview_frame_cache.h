@@ -0,0 +1,76 @@
+#ifndef PREVIEW_FRAME_CACHE_H_INCLUDED
+#define PREVIEW_FRAME_CACHE_H_INCLUDED
+
+#include "../../../common-src/vapoursynth/vs_script_processor_structures.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+//==============================================================================
+
+// Keeps the recently shown frames of the preview, so going back to one
+// of them does not need a round trip to the core. Holds references to
+// both the output frame and the packed preview frame and drops the least
+// recently shown ones when their size exceeds the budget.
+class PreviewFrameCache
+{
+public:
+
+	PreviewFrameCache();
+
+	virtual ~PreviewFrameCache();
+
+	void setVSAPI(const VSAPI * a_cpVSAPI);
+
+	// Zero disables the cache.
+	void setMaxSize(size_t a_bytes);
+
+	size_t maxSize() const;
+
+	size_t size() const;
+
+	// The cache takes its own references.
+	void add(int a_frameNumber, int a_outputIndex,
+		const VSFrame * a_cpOutputFrame, const VSFrame * a_cpPreviewFrame);
+
+	bool contains(int a_frameNumber, int a_outputIndex) const;
+
+	// On success the caller owns the new references returned.
+	bool get(int a_frameNumber, int a_outputIndex,
+		const VSFrame ** a_pcpOutputFrame, const VSFrame ** a_pcpPreviewFrame);
+
+	void clear();
+
+private:
+
+	typedef std::pair<int, int> FrameKey;
+
+	struct CachedFrame
+	{
+		Frame frame;
+		size_t size;
+
+		CachedFrame(const Frame & a_frame, size_t a_size);
+	};
+
+	size_t frameSize(const VSFrame * a_cpFrame) const;
+
+	void freeFrame(const CachedFrame & a_cachedFrame);
+
+	void trim();
+
+	const VSAPI * m_cpVSAPI;
+
+	size_t m_maxSize;
+	size_t m_size;
+
+	// Most recently shown first.
+	std::list<CachedFrame> m_frames;
+	std::map<FrameKey, std::list<CachedFrame>::iterator> m_index;
+};
+
+//==============================================================================
+
+#endif // PREVIEW_FRAME_CACHE_H_INCLUDED
@@ -0,0 +1,121 @@
+#include "preview_frame_widget.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+
+//==============================================================================
+
+PreviewFrameWidget::PreviewFrameWidget(QWidget * a_pParent):
+	  QWidget(a_pParent)
+	, m_image()
+	, m_sourceRect()
+	, m_displaySize(0, 0)
+	, m_scaleMode(Qt::FastTransformation)
+{
+	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+// END OF PreviewFrameWidget::PreviewFrameWidget(QWidget * a_pParent)
+//==============================================================================
+
+PreviewFrameWidget::~PreviewFrameWidget()
+{
+}
+
+// END OF PreviewFrameWidget::~PreviewFrameWidget()
+//==============================================================================
+
+void PreviewFrameWidget::setFrame(const QImage & a_image,
+	const QRect & a_sourceRect, const QSize & a_displaySize,
+	Qt::TransformationMode a_scaleMode)
+{
+	m_image = a_image;
+	m_sourceRect = a_sourceRect.intersected(a_image.rect());
+	m_scaleMode = a_scaleMode;
+	if(m_image.isNull() || m_sourceRect.isEmpty())
+		setDisplaySize(QSize(0, 0));
+	else
+		setDisplaySize(a_displaySize);
+	update();
+}
+
+// END OF void PreviewFrameWidget::setFrame(const QImage & a_image,
+//		const QRect & a_sourceRect, const QSize & a_displaySize,
+//		Qt::TransformationMode a_scaleMode)
+//==============================================================================
+
+void PreviewFrameWidget::setBlank(const QSize & a_displaySize)
+{
+	m_image = QImage();
+	m_sourceRect = QRect();
+	setDisplaySize(a_displaySize);
+	update();
+}
+
+// END OF void PreviewFrameWidget::setBlank(const QSize & a_displaySize)
+//==============================================================================
+
+QSize PreviewFrameWidget::displaySize() const
+{
+	return m_displaySize;
+}
+
+// END OF QSize PreviewFrameWidget::displaySize() const
+//==============================================================================
+
+QSize PreviewFrameWidget::sizeHint() const
+{
+	return minimumSizeHint();
+}
+
+// END OF QSize PreviewFrameWidget::sizeHint() const
+//==============================================================================
+
+QSize PreviewFrameWidget::minimumSizeHint() const
+{
+	// Widget geometry is in device independent pixels.
+	qreal dpr = devicePixelRatioF();
+	return QSize(qRound(m_displaySize.width() / dpr),
+		qRound(m_displaySize.height() / dpr));
+}
+
+// END OF QSize PreviewFrameWidget::minimumSizeHint() const
+//==============================================================================
+
+void PreviewFrameWidget::paintEvent(QPaintEvent * a_pEvent)
+{
+	if(m_displaySize.isEmpty())
+		return;
+
+	qreal dpr = devicePixelRatioF();
+	QRectF targetRect(0.0, 0.0, m_displaySize.width() / dpr,
+		m_displaySize.height() / dpr);
+
+	QPainter painter(this);
+	painter.setClipRect(a_pEvent->rect());
+
+	if(m_image.isNull())
+	{
+		painter.fillRect(targetRect, Qt::black);
+		return;
+	}
+
+	painter.setRenderHint(QPainter::SmoothPixmapTransform,
+		m_scaleMode == Qt::SmoothTransformation);
+	painter.drawImage(targetRect, m_image, QRectF(m_sourceRect));
+}
+
+// END OF void PreviewFrameWidget::paintEvent(QPaintEvent * a_pEvent)
+//==============================================================================
+
+void PreviewFrameWidget::setDisplaySize(const QSize & a_displaySize)
+{
+	if(m_displaySize == a_displaySize)
+		return;
+
+	m_displaySize = a_displaySize;
+	updateGeometry();
+}
+
+// END OF void PreviewFrameWidget::setDisplaySize(const QSize & a_displaySize)
+//==============================================================================
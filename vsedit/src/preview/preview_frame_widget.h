@@ -0,0 +1,57 @@
+#ifndef PREVIEW_FRAME_WIDGET_H_INCLUDED
+#define PREVIEW_FRAME_WIDGET_H_INCLUDED
+
+#include <QWidget>
+#include <QImage>
+#include <QRect>
+#include <QSize>
+
+class QPaintEvent;
+
+//==============================================================================
+
+// Paints the preview frame straight from the image it is given, with the
+// crop and zoom applied at paint time, so no pixmap copies of the frame are
+// made. The image usually wraps the memory of a packed frame and must stay
+// valid until it is replaced.
+class PreviewFrameWidget : public QWidget
+{
+public:
+
+	PreviewFrameWidget(QWidget * a_pParent = nullptr);
+
+	virtual ~PreviewFrameWidget();
+
+	// a_sourceRect is the part of the image to show and a_displaySize is
+	// its size on screen in device pixels.
+	void setFrame(const QImage & a_image, const QRect & a_sourceRect,
+		const QSize & a_displaySize, Qt::TransformationMode a_scaleMode);
+
+	// Shows a black rectangle of the given size in device pixels instead
+	// of the frame and drops the image.
+	void setBlank(const QSize & a_displaySize);
+
+	// Size of the shown frame in device pixels.
+	QSize displaySize() const;
+
+	QSize sizeHint() const override;
+
+	QSize minimumSizeHint() const override;
+
+protected:
+
+	void paintEvent(QPaintEvent * a_pEvent) override;
+
+private:
+
+	void setDisplaySize(const QSize & a_displaySize);
+
+	QImage m_image;
+	QRect m_sourceRect;
+	QSize m_displaySize;
+	Qt::TransformationMode m_scaleMode;
+};
+
+//==============================================================================
+
+#endif // PREVIEW_FRAME_WIDGET_H_INCLUDED
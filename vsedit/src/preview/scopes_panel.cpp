@@ -0,0 +1,304 @@
+#include "scopes_panel.h"
+#include "preview_dialog.h"
+#include "../../../common-src/settings/settings_manager.h"
+
+#include <QAction>
+#include <QKeyEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+
+const int HISTOGRAM_HEIGHT = 128;
+
+const int SCOPES_MARGIN = 4;
+
+//==============================================================================
+
+// Planes are drawn additively, so overlapping planes turn brighter.
+static QRgb planeColor(int a_colorFamily, int a_plane)
+{
+	if(a_colorFamily == cfRGB)
+	{
+		const QRgb colors[] = {qRgb(220, 40, 40), qRgb(40, 220, 40),
+			qRgb(40, 40, 220)};
+		return colors[a_plane];
+	}
+	if(a_colorFamily == cfYUV)
+	{
+		const QRgb colors[] = {qRgb(200, 200, 200), qRgb(60, 90, 220),
+			qRgb(220, 70, 70)};
+		return colors[a_plane];
+	}
+	return qRgb(200, 200, 200);
+}
+
+static void addColor(QImage & a_image, int a_x, int a_y, QRgb a_color,
+	double a_intensity)
+{
+	QRgb * pLine = reinterpret_cast<QRgb *>(a_image.scanLine(a_y));
+	QRgb pixel = pLine[a_x];
+	pLine[a_x] = qRgb(
+		std::min(255, qRed(pixel) + int(qRed(a_color) * a_intensity)),
+		std::min(255, qGreen(pixel) + int(qGreen(a_color) * a_intensity)),
+		std::min(255, qBlue(pixel) + int(qBlue(a_color) * a_intensity)));
+}
+
+//==============================================================================
+
+ScopesPanel::ScopesPanel(SettingsManager * a_pSettingsManager,
+	PreviewDialog * a_pFakeParent)
+{
+	m_pFakeParent = a_pFakeParent;
+
+	setWindowModality(Qt::NonModal);
+	setWindowTitle(QString("Scopes"));
+	setMinimumSize(160, 240);
+
+	setVisible(false);
+
+	setHideAction(a_pSettingsManager);
+}
+
+// END OF ScopesPanel::ScopesPanel(SettingsManager * a_pSettingsManager,
+//		PreviewDialog * a_pFakeParent)
+//==============================================================================
+
+void ScopesPanel::setScopes(const Scopes & a_scopes)
+{
+	if(a_scopes.isEmpty())
+	{
+		clear();
+		return;
+	}
+
+	drawHistogram(a_scopes);
+	drawWaveform(a_scopes);
+	drawVectorscope(a_scopes);
+	update();
+}
+
+// END OF void ScopesPanel::setScopes(const Scopes & a_scopes)
+//==============================================================================
+
+void ScopesPanel::clear()
+{
+	m_histogramImage = QImage();
+	m_waveformImage = QImage();
+	m_vectorscopeImage = QImage();
+	update();
+}
+
+// END OF void ScopesPanel::clear()
+//==============================================================================
+
+void ScopesPanel::setVisible(bool visible)
+{
+	if(visible)
+		resize(m_widgetWidth, m_widgetHeight);
+	else
+	{
+		m_widgetWidth = width();
+		m_widgetHeight = height();
+	}
+	QWidget::setVisible(visible);
+}
+
+// END OF void ScopesPanel::setVisible(bool visible)
+//==============================================================================
+
+void ScopesPanel::keyPressEvent(QKeyEvent * a_pEvent)
+{
+	if(a_pEvent->modifiers() != Qt::NoModifier)
+		QWidget::keyPressEvent(a_pEvent);
+	else if(a_pEvent->key() == Qt::Key_Escape)
+		setVisible(false);
+	else
+		m_pFakeParent->keyPressEvent(a_pEvent);
+}
+
+// END OF void ScopesPanel::keyPressEvent(QKeyEvent * a_pEvent)
+//==============================================================================
+
+void ScopesPanel::paintEvent(QPaintEvent * a_pEvent)
+{
+	(void)a_pEvent;
+
+	QPainter painter(this);
+	painter.fillRect(rect(), Qt::black);
+
+	if(m_histogramImage.isNull())
+	{
+		painter.setPen(palette().color(QPalette::Mid));
+		painter.drawText(rect(), Qt::AlignCenter,
+			QString("No scopes for this frame"));
+		return;
+	}
+
+	QRect area = rect().adjusted(SCOPES_MARGIN, SCOPES_MARGIN,
+		-SCOPES_MARGIN, -SCOPES_MARGIN);
+	int histogramHeight = area.height() / 5;
+	int waveformHeight = (area.height() - histogramHeight) / 2;
+
+	QRect histogramRect(area.left(), area.top(), area.width(),
+		histogramHeight - SCOPES_MARGIN);
+	painter.drawImage(histogramRect, m_histogramImage);
+
+	QRect waveformRect(area.left(), area.top() + histogramHeight,
+		area.width(), waveformHeight - SCOPES_MARGIN);
+	painter.drawImage(waveformRect, m_waveformImage);
+
+	// 0, 25, 50, 75 and 100 percent of the range.
+	painter.setPen(QColor(70, 70, 70));
+	for(int i = 0; i <= 4; ++i)
+	{
+		int y = waveformRect.top() + (waveformRect.height() - 1) * i / 4;
+		painter.drawLine(waveformRect.left(), y, waveformRect.right(), y);
+	}
+
+	if(m_vectorscopeImage.isNull())
+		return;
+
+	QRect vectorscopeArea(area.left(),
+		area.top() + histogramHeight + waveformHeight, area.width(),
+		area.height() - histogramHeight - waveformHeight);
+	int side = std::min(vectorscopeArea.width(), vectorscopeArea.height());
+	QRect vectorscopeRect(0, 0, side, side);
+	vectorscopeRect.moveCenter(vectorscopeArea.center());
+
+	painter.drawLine(vectorscopeRect.center().x(), vectorscopeRect.top(),
+		vectorscopeRect.center().x(), vectorscopeRect.bottom());
+	painter.drawLine(vectorscopeRect.left(), vectorscopeRect.center().y(),
+		vectorscopeRect.right(), vectorscopeRect.center().y());
+	painter.drawEllipse(vectorscopeRect);
+	painter.setCompositionMode(QPainter::CompositionMode_Plus);
+	painter.drawImage(vectorscopeRect, m_vectorscopeImage);
+}
+
+// END OF void ScopesPanel::paintEvent(QPaintEvent * a_pEvent)
+//==============================================================================
+
+void ScopesPanel::setHideAction(SettingsManager * a_pSettingsManager)
+{
+	m_pActionHide = a_pSettingsManager->createStandardAction(
+		ACTION_ID_TOGGLE_SCOPES, this);
+	m_pActionHide->setCheckable(false);
+	QKeySequence hotkey = a_pSettingsManager->
+		getHotkey(m_pActionHide->data().toString());
+	m_pActionHide->setShortcut(hotkey);
+	connect(m_pActionHide, SIGNAL(triggered()), this, SLOT(slotHide()));
+	addAction(m_pActionHide);
+}
+
+// END OF void ScopesPanel::setHideAction(SettingsManager * a_pSettingsManager)
+//==============================================================================
+
+void ScopesPanel::drawHistogram(const Scopes & a_scopes)
+{
+	m_histogramImage = QImage(SCOPE_LEVELS, HISTOGRAM_HEIGHT,
+		QImage::Format_RGB32);
+	m_histogramImage.fill(Qt::black);
+
+	// The bins are a power of two of at least SCOPE_LEVELS.
+	int binsPerColumn = a_scopes.bins / SCOPE_LEVELS;
+	std::vector<uint64_t> columns(SCOPE_LEVELS);
+
+	for(int plane = 0; plane < a_scopes.planes; ++plane)
+	{
+		const std::vector<uint32_t> & histogram = a_scopes.histograms[plane];
+		std::fill(columns.begin(), columns.end(), 0);
+		for(size_t i = 0; i < histogram.size(); ++i)
+			columns[i / binsPerColumn] += histogram[i];
+
+		uint64_t maxCount = *std::max_element(columns.begin(), columns.end());
+		if(maxCount == 0)
+			continue;
+
+		QRgb color = planeColor(a_scopes.colorFamily, plane);
+		for(int x = 0; x < SCOPE_LEVELS; ++x)
+		{
+			int height = int((columns[x] * HISTOGRAM_HEIGHT + maxCount - 1) /
+				maxCount);
+			for(int y = HISTOGRAM_HEIGHT - height; y < HISTOGRAM_HEIGHT; ++y)
+				addColor(m_histogramImage, x, y, color, 1.0);
+		}
+	}
+}
+
+// END OF void ScopesPanel::drawHistogram(const Scopes & a_scopes)
+//==============================================================================
+
+void ScopesPanel::drawWaveform(const Scopes & a_scopes)
+{
+	m_waveformImage = QImage(a_scopes.waveformWidth, SCOPE_LEVELS,
+		QImage::Format_RGB32);
+	m_waveformImage.fill(Qt::black);
+
+	for(int plane = 0; plane < a_scopes.planes; ++plane)
+	{
+		const std::vector<uint32_t> & waveform = a_scopes.waveforms[plane];
+		if(waveform.empty())
+			continue;
+
+		uint32_t maxCount = *std::max_element(waveform.begin(),
+			waveform.end());
+		if(maxCount == 0)
+			continue;
+
+		double logMax = std::log1p(double(maxCount));
+		QRgb color = planeColor(a_scopes.colorFamily, plane);
+		for(int y = 0; y < SCOPE_LEVELS; ++y)
+		{
+			const uint32_t * pCounts =
+				waveform.data() + size_t(y) * a_scopes.waveformWidth;
+			for(int x = 0; x < a_scopes.waveformWidth; ++x)
+			{
+				if(pCounts[x] == 0)
+					continue;
+				addColor(m_waveformImage, x, y, color,
+					0.25 + 0.75 * std::log1p(double(pCounts[x])) / logMax);
+			}
+		}
+	}
+}
+
+// END OF void ScopesPanel::drawWaveform(const Scopes & a_scopes)
+//==============================================================================
+
+void ScopesPanel::drawVectorscope(const Scopes & a_scopes)
+{
+	if(a_scopes.vectorscope.empty())
+	{
+		m_vectorscopeImage = QImage();
+		return;
+	}
+
+	m_vectorscopeImage = QImage(SCOPE_LEVELS, SCOPE_LEVELS,
+		QImage::Format_RGB32);
+	m_vectorscopeImage.fill(Qt::black);
+
+	uint32_t maxCount = *std::max_element(a_scopes.vectorscope.begin(),
+		a_scopes.vectorscope.end());
+	if(maxCount == 0)
+		return;
+
+	double logMax = std::log1p(double(maxCount));
+	QRgb color = qRgb(120, 230, 140);
+	for(int y = 0; y < SCOPE_LEVELS; ++y)
+	{
+		const uint32_t * pCounts =
+			a_scopes.vectorscope.data() + size_t(y) * SCOPE_LEVELS;
+		for(int x = 0; x < SCOPE_LEVELS; ++x)
+		{
+			if(pCounts[x] == 0)
+				continue;
+			addColor(m_vectorscopeImage, x, y, color,
+				0.25 + 0.75 * std::log1p(double(pCounts[x])) / logMax);
+		}
+	}
+}
+
+// END OF void ScopesPanel::drawVectorscope(const Scopes & a_scopes)
+//==============================================================================
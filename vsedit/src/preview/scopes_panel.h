@@ -0,0 +1,67 @@
+#ifndef SCOPES_PANEL_H_INCLUDED
+#define SCOPES_PANEL_H_INCLUDED
+
+#include "../../../common-src/vapoursynth/vs_scopes.h"
+
+#include <QWidget>
+#include <QImage>
+
+class QAction;
+class QKeyEvent;
+class QPaintEvent;
+class SettingsManager;
+class PreviewDialog;
+
+//==============================================================================
+
+// Histogram, waveform and vectorscope of the shown frame, stacked top
+// to bottom. The waveform and the vectorscope are drawn with logarithmic
+// intensity so that sparse samples stay visible.
+class ScopesPanel: public QWidget
+{
+	Q_OBJECT
+
+public:
+
+	ScopesPanel(SettingsManager * a_pSettingsManager,
+		PreviewDialog * a_pFakeParent);
+
+	void setScopes(const Scopes & a_scopes);
+
+	void clear();
+
+	void setVisible(bool visible) override;
+
+	void keyPressEvent(QKeyEvent * a_pEvent) override;
+
+public slots:
+
+	void slotHide() { setVisible(false); }
+
+protected:
+
+	void paintEvent(QPaintEvent * a_pEvent) override;
+
+private:
+
+	void setHideAction(SettingsManager * a_pSettingsManager);
+
+	void drawHistogram(const Scopes & a_scopes);
+
+	void drawWaveform(const Scopes & a_scopes);
+
+	void drawVectorscope(const Scopes & a_scopes);
+
+	PreviewDialog * m_pFakeParent;
+	QAction * m_pActionHide;
+	int m_widgetWidth = 360;
+	int m_widgetHeight = 720;
+
+	QImage m_histogramImage;
+	QImage m_waveformImage;
+	QImage m_vectorscopeImage;
+};
+
+//==============================================================================
+
+#endif // SCOPES_PANEL_H_INCLUDED
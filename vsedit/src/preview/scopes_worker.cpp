@@ -0,0 +1,116 @@
+#include "scopes_worker.h"
+
+//==============================================================================
+
+ScopesWorker::ScopesWorker(QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_cpVSAPI(nullptr)
+	, m_cpPendingFrame(nullptr)
+	, m_generation(0)
+	, m_busy(false)
+	, m_stopRequested(false)
+{
+	m_thread = std::thread(&ScopesWorker::run, this);
+}
+
+// END OF ScopesWorker::ScopesWorker(QObject * a_pParent)
+//==============================================================================
+
+ScopesWorker::~ScopesWorker()
+{
+	clear();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopRequested = true;
+	}
+	m_condition.notify_all();
+	m_thread.join();
+}
+
+// END OF ScopesWorker::~ScopesWorker()
+//==============================================================================
+
+void ScopesWorker::compute(const VSFrame * a_cpFrame, const VSAPI * a_cpVSAPI)
+{
+	if(!a_cpFrame || !a_cpVSAPI)
+		return;
+
+	const VSFrame * cpReplacedFrame = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		cpReplacedFrame = m_cpPendingFrame;
+		m_cpPendingFrame = a_cpVSAPI->addFrameRef(a_cpFrame);
+		m_cpVSAPI = a_cpVSAPI;
+	}
+	if(cpReplacedFrame)
+		a_cpVSAPI->freeFrame(cpReplacedFrame);
+	m_condition.notify_all();
+}
+
+// END OF void ScopesWorker::compute(const VSFrame * a_cpFrame,
+//		const VSAPI * a_cpVSAPI)
+//==============================================================================
+
+void ScopesWorker::clear()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if(m_cpPendingFrame)
+	{
+		m_cpVSAPI->freeFrame(m_cpPendingFrame);
+		m_cpPendingFrame = nullptr;
+	}
+	m_generation++;
+	m_condition.wait(lock, [this]() { return !m_busy; });
+}
+
+// END OF void ScopesWorker::clear()
+//==============================================================================
+
+void ScopesWorker::run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		m_condition.wait(lock, [this]()
+			{
+				return m_stopRequested || m_cpPendingFrame;
+			});
+		if(m_stopRequested)
+			break;
+
+		const VSFrame * cpFrame = m_cpPendingFrame;
+		const VSAPI * cpVSAPI = m_cpVSAPI;
+		size_t generation = m_generation;
+		m_cpPendingFrame = nullptr;
+		m_busy = true;
+
+		lock.unlock();
+		Scopes scopes = computeScopes(cpFrame, cpVSAPI);
+		cpVSAPI->freeFrame(cpFrame);
+		QMetaObject::invokeMethod(this, [this, generation, scopes]()
+			{
+				deliver(generation, scopes);
+			}, Qt::QueuedConnection);
+		lock.lock();
+
+		m_busy = false;
+		m_condition.notify_all();
+	}
+}
+
+// END OF void ScopesWorker::run()
+//==============================================================================
+
+void ScopesWorker::deliver(size_t a_generation, const Scopes & a_scopes)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(a_generation != m_generation)
+			return;
+	}
+	emit signalScopesReady(a_scopes);
+}
+
+// END OF void ScopesWorker::deliver(size_t a_generation,
+//		const Scopes & a_scopes)
+//==============================================================================
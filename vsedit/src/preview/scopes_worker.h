@@ -0,0 +1,60 @@
+#ifndef SCOPES_WORKER_H_INCLUDED
+#define SCOPES_WORKER_H_INCLUDED
+
+#include "../../../common-src/vapoursynth/vs_scopes.h"
+
+#include <QObject>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+//==============================================================================
+
+// Computes the scopes of preview frames on its own thread, so the frame
+// display never waits for them. Only the latest frame is kept waiting:
+// during playback the scopes skip frames rather than fall behind.
+class ScopesWorker : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	ScopesWorker(QObject * a_pParent = nullptr);
+
+	virtual ~ScopesWorker();
+
+	// Takes its own reference of the frame.
+	void compute(const VSFrame * a_cpFrame, const VSAPI * a_cpVSAPI);
+
+	// Drops the waiting frame and the results not delivered yet. Returns
+	// when no frame reference is held any more, so it must be called
+	// before the frames' core is freed.
+	void clear();
+
+signals:
+
+	void signalScopesReady(const Scopes & a_scopes);
+
+private:
+
+	void run();
+
+	void deliver(size_t a_generation, const Scopes & a_scopes);
+
+	const VSAPI * m_cpVSAPI;
+	const VSFrame * m_cpPendingFrame;
+
+	// Changed by clear() to tell the results of dropped frames.
+	size_t m_generation;
+	bool m_busy;
+	bool m_stopRequested;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+};
+
+//==============================================================================
+
+#endif // SCOPES_WORKER_H_INCLUDED
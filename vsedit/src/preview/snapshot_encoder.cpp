@@ -0,0 +1,78 @@
+#include "snapshot_encoder.h"
+
+//==============================================================================
+
+SnapshotEncoder::SnapshotEncoder(QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_threadPool()
+	, m_generation(0)
+{
+}
+
+// END OF SnapshotEncoder::SnapshotEncoder(QObject * a_pParent)
+//==============================================================================
+
+SnapshotEncoder::~SnapshotEncoder()
+{
+	clear();
+}
+
+// END OF SnapshotEncoder::~SnapshotEncoder()
+//==============================================================================
+
+void SnapshotEncoder::encode(const QImage & a_image,
+	const VSFrame * a_cpFrame, const VSAPI * a_cpVSAPI,
+	const QString & a_filePath, const QByteArray & a_format, int a_quality)
+{
+	const VSFrame * cpFrame = nullptr;
+	if(a_cpFrame && a_cpVSAPI)
+		cpFrame = a_cpVSAPI->addFrameRef(a_cpFrame);
+	size_t generation = m_generation;
+
+	m_threadPool.start([=]()
+		{
+			bool success = (!a_image.isNull()) &&
+				a_image.save(a_filePath, a_format.constData(), a_quality);
+			if(cpFrame)
+				a_cpVSAPI->freeFrame(cpFrame);
+			QMetaObject::invokeMethod(this, [=]()
+				{
+					deliver(generation, a_filePath, success);
+				}, Qt::QueuedConnection);
+		});
+}
+
+// END OF void SnapshotEncoder::encode(const QImage & a_image,
+//		const VSFrame * a_cpFrame, const VSAPI * a_cpVSAPI,
+//		const QString & a_filePath, const QByteArray & a_format,
+//		int a_quality)
+//==============================================================================
+
+int SnapshotEncoder::maxThreadCount() const
+{
+	return m_threadPool.maxThreadCount();
+}
+
+// END OF int SnapshotEncoder::maxThreadCount() const
+//==============================================================================
+
+void SnapshotEncoder::clear()
+{
+	m_generation++;
+	m_threadPool.waitForDone();
+}
+
+// END OF void SnapshotEncoder::clear()
+//==============================================================================
+
+void SnapshotEncoder::deliver(size_t a_generation, const QString & a_filePath,
+	bool a_success)
+{
+	if(a_generation != m_generation)
+		return;
+	emit signalSnapshotSaved(a_filePath, a_success);
+}
+
+// END OF void SnapshotEncoder::deliver(size_t a_generation,
+//		const QString & a_filePath, bool a_success)
+//==============================================================================
@@ -0,0 +1,58 @@
+#ifndef SNAPSHOT_ENCODER_H_INCLUDED
+#define SNAPSHOT_ENCODER_H_INCLUDED
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QByteArray>
+#include <QThreadPool>
+#include <atomic>
+#include <cstddef>
+
+//==============================================================================
+
+// Saves snapshots on a thread pool, so the preview stays responsive while
+// a batch of frames is compressed.
+class SnapshotEncoder : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	SnapshotEncoder(QObject * a_pParent = nullptr);
+
+	virtual ~SnapshotEncoder();
+
+	// The image may share the memory of the frame. The encoder takes
+	// its own reference of the frame and holds it until the image is saved.
+	void encode(const QImage & a_image, const VSFrame * a_cpFrame,
+		const VSAPI * a_cpVSAPI, const QString & a_filePath,
+		const QByteArray & a_format, int a_quality);
+
+	int maxThreadCount() const;
+
+	// Drops the results not delivered yet. Returns when no frame reference
+	// is held any more, so it must be called before the frames' core
+	// is freed.
+	void clear();
+
+signals:
+
+	void signalSnapshotSaved(const QString & a_filePath, bool a_success);
+
+private:
+
+	void deliver(size_t a_generation, const QString & a_filePath,
+		bool a_success);
+
+	QThreadPool m_threadPool;
+
+	// Changed by clear() to tell the results of dropped images.
+	std::atomic<size_t> m_generation;
+};
+
+//==============================================================================
+
+#endif // SNAPSHOT_ENCODER_H_INCLUDED
@@ -0,0 +1,233 @@
+#include "thumbnail_cache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <algorithm>
+#include <vector>
+
+//==============================================================================
+
+const char THUMBNAIL_CACHE_DIRECTORY[] = "thumbnails";
+const char THUMBNAIL_FORMAT[] = "JPG";
+const int THUMBNAIL_QUALITY = 85;
+// Disk space all the thumbnails may take.
+const qint64 THUMBNAIL_CACHE_MAX_BYTES = 256 * 1024 * 1024;
+// The file in each key directory whose time is the last use of the key.
+// The directory time only changes when files are added or removed.
+const char THUMBNAIL_CACHE_STAMP[] = "last_used";
+
+//==============================================================================
+
+ThumbnailCache::ThumbnailCache(QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_directory()
+	, m_threadPool()
+	, m_generation(0)
+{
+	m_threadPool.setMaxThreadCount(1);
+}
+
+// END OF ThumbnailCache::ThumbnailCache(QObject * a_pParent)
+//==============================================================================
+
+ThumbnailCache::~ThumbnailCache()
+{
+	m_generation++;
+	m_threadPool.waitForDone();
+}
+
+// END OF ThumbnailCache::~ThumbnailCache()
+//==============================================================================
+
+bool ThumbnailCache::setKey(const QByteArray & a_scriptHash,
+	int a_outputIndex, const QSize & a_size, qreal a_devicePixelRatio,
+	const QByteArray & a_conversionKey)
+{
+	QString directory;
+	QString cacheLocation =
+		QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	QString root = QString("%1/%2").arg(cacheLocation)
+		.arg(THUMBNAIL_CACHE_DIRECTORY);
+	if(!cacheLocation.isEmpty())
+	{
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		hash.addData(a_scriptHash);
+		hash.addData(QString(":%1:%2x%3@%4:").arg(a_outputIndex)
+			.arg(a_size.width()).arg(a_size.height())
+			.arg(a_devicePixelRatio).toUtf8());
+		hash.addData(a_conversionKey);
+
+		directory = QString("%1/%2").arg(root)
+			.arg(QString::fromLatin1(hash.result().toHex()));
+	}
+
+	if(directory == m_directory)
+		return false;
+	m_directory = directory;
+	m_generation++;
+
+	if(!m_directory.isEmpty())
+	{
+		m_threadPool.start([=]()
+			{
+				if(QFileInfo::exists(directory))
+					touch(directory);
+				prune(root, directory);
+			});
+	}
+	return true;
+}
+
+// END OF bool ThumbnailCache::setKey(const QByteArray & a_scriptHash,
+//		int a_outputIndex, const QSize & a_size, qreal a_devicePixelRatio,
+//		const QByteArray & a_conversionKey)
+//==============================================================================
+
+void ThumbnailCache::reset()
+{
+	m_directory.clear();
+	m_generation++;
+}
+
+// END OF void ThumbnailCache::reset()
+//==============================================================================
+
+void ThumbnailCache::requestLoad(int a_frame)
+{
+	QString directory = m_directory;
+	size_t generation = m_generation;
+
+	m_threadPool.start([=]()
+		{
+			QImage thumbnail;
+			QString path = directory.isEmpty() ? QString() :
+				framePath(directory, a_frame);
+			if((!path.isEmpty()) && QFileInfo::exists(path))
+				thumbnail.load(path, THUMBNAIL_FORMAT);
+			QMetaObject::invokeMethod(this, [=]()
+				{
+					deliver(generation, a_frame, thumbnail);
+				}, Qt::QueuedConnection);
+		});
+}
+
+// END OF void ThumbnailCache::requestLoad(int a_frame)
+//==============================================================================
+
+void ThumbnailCache::save(int a_frame, const QImage & a_thumbnail)
+{
+	if(m_directory.isEmpty() || a_thumbnail.isNull())
+		return;
+
+	QString directory = m_directory;
+
+	m_threadPool.start([=]()
+		{
+			if(!QFileInfo::exists(directory))
+			{
+				if(!QDir().mkpath(directory))
+					return;
+				touch(directory);
+			}
+			a_thumbnail.save(framePath(directory, a_frame), THUMBNAIL_FORMAT,
+				THUMBNAIL_QUALITY);
+		});
+}
+
+// END OF void ThumbnailCache::save(int a_frame, const QImage & a_thumbnail)
+//==============================================================================
+
+void ThumbnailCache::deliver(size_t a_generation, int a_frame,
+	const QImage & a_thumbnail)
+{
+	if(a_generation != m_generation)
+		return;
+	emit signalThumbnailLoaded(a_frame, a_thumbnail);
+}
+
+// END OF void ThumbnailCache::deliver(size_t a_generation, int a_frame,
+//		const QImage & a_thumbnail)
+//==============================================================================
+
+QString ThumbnailCache::framePath(const QString & a_directory, int a_frame)
+{
+	return QString("%1/%2.jpg").arg(a_directory).arg(a_frame);
+}
+
+// END OF QString ThumbnailCache::framePath(const QString & a_directory,
+//		int a_frame)
+//==============================================================================
+
+void ThumbnailCache::touch(const QString & a_directory)
+{
+	QFile stamp(QString("%1/%2").arg(a_directory).arg(THUMBNAIL_CACHE_STAMP));
+	if(stamp.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		stamp.write(QDateTime::currentDateTimeUtc().toString(Qt::ISODate)
+			.toLatin1());
+}
+
+// END OF void ThumbnailCache::touch(const QString & a_directory)
+//==============================================================================
+
+void ThumbnailCache::prune(const QString & a_root, const QString & a_keep)
+{
+	struct KeyDirectory
+	{
+		QString path;
+		QDateTime lastUsed;
+		qint64 size;
+	};
+
+	std::vector<KeyDirectory> directories;
+	qint64 totalSize = 0;
+
+	QDir root(a_root);
+	for(const QFileInfo & directoryInfo :
+		root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+	{
+		KeyDirectory directory = {directoryInfo.absoluteFilePath(),
+			directoryInfo.lastModified(), 0};
+		QFileInfo stampInfo(QString("%1/%2").arg(directory.path)
+			.arg(THUMBNAIL_CACHE_STAMP));
+		if(stampInfo.exists())
+			directory.lastUsed = stampInfo.lastModified();
+
+		QDirIterator it(directory.path, QDir::Files);
+		while(it.hasNext())
+		{
+			it.next();
+			directory.size += it.fileInfo().size();
+		}
+		totalSize += directory.size;
+		directories.push_back(directory);
+	}
+
+	if(totalSize <= THUMBNAIL_CACHE_MAX_BYTES)
+		return;
+
+	std::sort(directories.begin(), directories.end(),
+		[](const KeyDirectory & a_first, const KeyDirectory & a_second)
+		{
+			return a_first.lastUsed < a_second.lastUsed;
+		});
+
+	QString keep = QFileInfo(a_keep).absoluteFilePath();
+	for(const KeyDirectory & directory : directories)
+	{
+		if(totalSize <= THUMBNAIL_CACHE_MAX_BYTES)
+			break;
+		if(directory.path == keep)
+			continue;
+		if(QDir(directory.path).removeRecursively())
+			totalSize -= directory.size;
+	}
+}
+
+// END OF void ThumbnailCache::prune(const QString & a_root,
+//		const QString & a_keep)
+//==============================================================================
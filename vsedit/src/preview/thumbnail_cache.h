@@ -0,0 +1,74 @@
+#ifndef THUMBNAIL_CACHE_H_INCLUDED
+#define THUMBNAIL_CACHE_H_INCLUDED
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QThreadPool>
+#include <atomic>
+#include <cstddef>
+
+//==============================================================================
+
+// Keeps the thumbnails on disk, so reopening the preview of an unchanged
+// script does not have to render them again. The thumbnails are keyed by
+// the script with the modules it imports, the output, the thumbnail size
+// and the settings the frames are converted with. The least recently used
+// keys are dropped when the cache grows too large. The files are read
+// and written on a worker thread, so the preview never waits for the disk.
+class ThumbnailCache : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	ThumbnailCache(QObject * a_pParent = nullptr);
+
+	virtual ~ThumbnailCache();
+
+	// Returns true if the key has changed. Loads requested with another
+	// key are not delivered.
+	bool setKey(const QByteArray & a_scriptHash, int a_outputIndex,
+		const QSize & a_size, qreal a_devicePixelRatio,
+		const QByteArray & a_conversionKey);
+
+	void reset();
+
+	// The thumbnail comes with signalThumbnailLoaded().
+	void requestLoad(int a_frame);
+
+	void save(int a_frame, const QImage & a_thumbnail);
+
+signals:
+
+	// The thumbnail is null if it is not in the cache.
+	void signalThumbnailLoaded(int a_frame, const QImage & a_thumbnail);
+
+private:
+
+	void deliver(size_t a_generation, int a_frame, const QImage & a_thumbnail);
+
+	static QString framePath(const QString & a_directory, int a_frame);
+
+	// Marks the key directory as used now.
+	static void touch(const QString & a_directory);
+
+	// Removes the least recently used key directories under the root
+	// until the rest fits the size limit. The kept directory stays anyway.
+	static void prune(const QString & a_root, const QString & a_keep);
+
+	QString m_directory;
+
+	// A single thread, so the files of a key are written before they are
+	// read and pruning never runs along with the writes.
+	QThreadPool m_threadPool;
+
+	// Changed with the key to tell the results of dropped loads.
+	std::atomic<size_t> m_generation;
+};
+
+//==============================================================================
+
+#endif // THUMBNAIL_CACHE_H_INCLUDED
@@ -0,0 +1,225 @@
+#include "thumbnail_loader.h"
+
+#include "thumbnail_strip.h"
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../../common-src/helpers_vs.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+//==============================================================================
+
+// Thumbnails are background work, so only a couple are requested at once
+// to leave the core to the interactive requests.
+const size_t THUMBNAIL_FRAMES_IN_FLIGHT = 2;
+
+// Thumbnails loaded from the disk cache at once. Enough to fill the strip
+// quickly without queueing loads the strip may not need after scrolling.
+const size_t THUMBNAIL_LOADS_IN_FLIGHT = 8;
+
+//==============================================================================
+
+ThumbnailLoader::ThumbnailLoader(VapourSynthScriptProcessor * a_pProcessor,
+	ThumbnailStrip * a_pThumbnailStrip, QObject * a_pParent):
+	  QObject(a_pParent)
+	, m_pProcessor(a_pProcessor)
+	, m_pThumbnailStrip(a_pThumbnailStrip)
+	, m_thumbnailCache()
+	, m_outputIndex(-1)
+	, m_video(false)
+	, m_currentFrame(0)
+	, m_paused(false)
+	, m_pending()
+	, m_loading()
+	, m_notCached()
+{
+	connect(&m_thumbnailCache,
+		SIGNAL(signalThumbnailLoaded(int, const QImage &)),
+		this, SLOT(slotThumbnailLoaded(int, const QImage &)));
+	connect(m_pThumbnailStrip, SIGNAL(signalShownFramesChanged()),
+		this, SLOT(slotRequestThumbnails()));
+}
+
+// END OF ThumbnailLoader::ThumbnailLoader(
+//		VapourSynthScriptProcessor * a_pProcessor,
+//		ThumbnailStrip * a_pThumbnailStrip, QObject * a_pParent)
+//==============================================================================
+
+ThumbnailLoader::~ThumbnailLoader()
+{
+}
+
+// END OF ThumbnailLoader::~ThumbnailLoader()
+//==============================================================================
+
+void ThumbnailLoader::reset(const QByteArray & a_scriptHash,
+	int a_outputIndex, const VSNodeInfo & a_nodeInfo, int a_currentFrame)
+{
+	m_pending.clear();
+	m_loading.clear();
+	m_notCached.clear();
+	m_video = (a_nodeInfo.getAsVideo() != nullptr);
+	m_currentFrame = a_currentFrame;
+	m_pThumbnailStrip->setFramesNumber(a_nodeInfo.numFrames());
+	m_pThumbnailStrip->setCurrentFrame(m_currentFrame);
+	updateKey(a_scriptHash, a_outputIndex);
+	m_pProcessor->setThumbnailSize(m_pThumbnailStrip->thumbnailSize());
+	slotRequestThumbnails();
+}
+
+// END OF void ThumbnailLoader::reset(const QByteArray & a_scriptHash,
+//		int a_outputIndex, const VSNodeInfo & a_nodeInfo,
+//		int a_currentFrame)
+//==============================================================================
+
+bool ThumbnailLoader::updateKey(const QByteArray & a_scriptHash,
+	int a_outputIndex)
+{
+	m_outputIndex = a_outputIndex;
+	return m_thumbnailCache.setKey(a_scriptHash, a_outputIndex,
+		m_pThumbnailStrip->thumbnailSize(),
+		m_pThumbnailStrip->devicePixelRatioF(),
+		m_pProcessor->previewConversionKey());
+}
+
+// END OF bool ThumbnailLoader::updateKey(const QByteArray & a_scriptHash,
+//		int a_outputIndex)
+//==============================================================================
+
+void ThumbnailLoader::clear()
+{
+	m_pending.clear();
+	m_loading.clear();
+	m_notCached.clear();
+	m_outputIndex = -1;
+	m_video = false;
+	m_thumbnailCache.reset();
+	m_pThumbnailStrip->clear();
+}
+
+// END OF void ThumbnailLoader::clear()
+//==============================================================================
+
+void ThumbnailLoader::setCurrentFrame(int a_frame)
+{
+	m_currentFrame = a_frame;
+	m_pThumbnailStrip->setCurrentFrame(a_frame);
+}
+
+// END OF void ThumbnailLoader::setCurrentFrame(int a_frame)
+//==============================================================================
+
+void ThumbnailLoader::pause()
+{
+	m_paused = true;
+	m_pending.clear();
+}
+
+// END OF void ThumbnailLoader::pause()
+//==============================================================================
+
+void ThumbnailLoader::resume()
+{
+	m_paused = false;
+	slotRequestThumbnails();
+}
+
+// END OF void ThumbnailLoader::resume()
+//==============================================================================
+
+bool ThumbnailLoader::thumbnailRequested(int a_frameNumber,
+	int a_outputIndex) const
+{
+	return (a_outputIndex == m_outputIndex) &&
+		(m_pending.find(a_frameNumber) != m_pending.end());
+}
+
+// END OF bool ThumbnailLoader::thumbnailRequested(int a_frameNumber,
+//		int a_outputIndex) const
+//==============================================================================
+
+void ThumbnailLoader::takeThumbnail(int a_frameNumber,
+	const QImage & a_thumbnail)
+{
+	if(m_pending.erase(a_frameNumber) == 0)
+		return;
+
+	if(!a_thumbnail.isNull())
+	{
+		m_thumbnailCache.save(a_frameNumber, a_thumbnail);
+		m_notCached.erase(a_frameNumber);
+		m_pThumbnailStrip->setThumbnail(a_frameNumber, a_thumbnail);
+	}
+
+	slotRequestThumbnails();
+}
+
+// END OF void ThumbnailLoader::takeThumbnail(int a_frameNumber,
+//		const QImage & a_thumbnail)
+//==============================================================================
+
+void ThumbnailLoader::slotRequestThumbnails()
+{
+	if((!m_pThumbnailStrip->isVisible()) || m_paused || (!m_video) ||
+		(!m_pProcessor->isInitialized()))
+		return;
+
+	if((m_pending.size() >= THUMBNAIL_FRAMES_IN_FLIGHT) &&
+		(m_loading.size() >= THUMBNAIL_LOADS_IN_FLIGHT))
+		return;
+
+	std::vector<int> frames = m_pThumbnailStrip->shownFrames();
+	std::stable_sort(frames.begin(), frames.end(),
+		[&](int a_first, int a_second)
+		{
+			return std::abs(a_first - m_currentFrame) <
+				std::abs(a_second - m_currentFrame);
+		});
+
+	for(int frame : frames)
+	{
+		if(m_pThumbnailStrip->hasThumbnail(frame) ||
+			(m_pending.count(frame) > 0) || (m_loading.count(frame) > 0))
+			continue;
+
+		if(m_notCached.count(frame) == 0)
+		{
+			if(m_loading.size() < THUMBNAIL_LOADS_IN_FLIGHT)
+			{
+				m_loading.insert(frame);
+				m_thumbnailCache.requestLoad(frame);
+			}
+			continue;
+		}
+
+		if(m_pending.size() >= THUMBNAIL_FRAMES_IN_FLIGHT)
+			continue;
+		if(!m_pProcessor->requestThumbnailAsync(frame, m_outputIndex))
+			break;
+		m_pending.insert(frame);
+	}
+}
+
+// END OF void ThumbnailLoader::slotRequestThumbnails()
+//==============================================================================
+
+void ThumbnailLoader::slotThumbnailLoaded(int a_frame,
+	const QImage & a_thumbnail)
+{
+	std::set<int>::iterator it = m_loading.find(a_frame);
+	if(it == m_loading.end())
+		return;
+	m_loading.erase(it);
+
+	if(a_thumbnail.isNull())
+		m_notCached.insert(a_frame);
+	else
+		m_pThumbnailStrip->setThumbnail(a_frame, a_thumbnail);
+
+	slotRequestThumbnails();
+}
+
+// END OF void ThumbnailLoader::slotThumbnailLoaded(int a_frame,
+//		const QImage & a_thumbnail)
+//==============================================================================
@@ -0,0 +1,92 @@
+#ifndef THUMBNAIL_LOADER_H_INCLUDED
+#define THUMBNAIL_LOADER_H_INCLUDED
+
+#include "thumbnail_cache.h"
+
+#include <QObject>
+#include <QImage>
+#include <QByteArray>
+#include <set>
+
+class VapourSynthScriptProcessor;
+class VSNodeInfo;
+class ThumbnailStrip;
+
+//==============================================================================
+
+// Fills the thumbnail strip. Every thumbnail is looked up in the disk cache
+// first and rendered by the processor only if it is not there.
+class ThumbnailLoader : public QObject
+{
+	Q_OBJECT
+
+public:
+
+	ThumbnailLoader(VapourSynthScriptProcessor * a_pProcessor,
+		ThumbnailStrip * a_pThumbnailStrip, QObject * a_pParent = nullptr);
+
+	virtual ~ThumbnailLoader();
+
+	// Starts over with the thumbnails of the output.
+	void reset(const QByteArray & a_scriptHash, int a_outputIndex,
+		const VSNodeInfo & a_nodeInfo, int a_currentFrame);
+
+	// Keys the thumbnail cache by the script, output, thumbnail size
+	// and conversion settings. Returns true if the key has changed.
+	bool updateKey(const QByteArray & a_scriptHash, int a_outputIndex);
+
+	// Drops the thumbnails of a script that is not previewed any more.
+	void clear();
+
+	// The thumbnails around the current frame come first.
+	void setCurrentFrame(int a_frame);
+
+	// Forgets the thumbnails requested until it is resumed. Their tickets
+	// are expected to be cancelled.
+	void pause();
+
+	void resume();
+
+	// Returns true if the thumbnail was requested and is waited for.
+	bool thumbnailRequested(int a_frameNumber, int a_outputIndex) const;
+
+	// The thumbnail is null if the frame could not be rendered.
+	void takeThumbnail(int a_frameNumber, const QImage & a_thumbnail);
+
+public slots:
+
+	void slotRequestThumbnails();
+
+private slots:
+
+	void slotThumbnailLoaded(int a_frame, const QImage & a_thumbnail);
+
+private:
+
+	VapourSynthScriptProcessor * m_pProcessor;
+
+	ThumbnailStrip * m_pThumbnailStrip;
+
+	ThumbnailCache m_thumbnailCache;
+
+	int m_outputIndex;
+
+	// Only video outputs have thumbnails.
+	bool m_video;
+
+	int m_currentFrame;
+
+	bool m_paused;
+
+	// Thumbnails requested from the processor.
+	std::set<int> m_pending;
+
+	// Thumbnails being loaded from the disk cache and the ones that were
+	// not found there.
+	std::set<int> m_loading;
+	std::set<int> m_notCached;
+};
+
+//==============================================================================
+
+#endif // THUMBNAIL_LOADER_H_INCLUDED
@@ -0,0 +1,374 @@
+#include "thumbnail_strip.h"
+
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+
+const int THUMBNAIL_WIDTH = 96;
+const int THUMBNAIL_HEIGHT = 54;
+const int THUMBNAIL_SPACING = 2;
+
+// About 20 KiB each.
+const size_t MAX_THUMBNAILS = 1024;
+
+//==============================================================================
+
+ThumbnailStrip::ThumbnailStrip(QWidget * a_pParent):
+	  QWidget(a_pParent)
+	, m_framesNumber(0)
+	, m_currentFrame(0)
+	, m_viewFirstFrame(0)
+	, m_viewLastFrame(-1)
+{
+	setFixedHeight(THUMBNAIL_HEIGHT + THUMBNAIL_SPACING * 2);
+	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+	setToolTip(tr("Click to jump to the frame. "
+		"Mouse wheel zooms, Shift + mouse wheel scrolls."));
+}
+
+// END OF ThumbnailStrip::ThumbnailStrip(QWidget * a_pParent)
+//==============================================================================
+
+ThumbnailStrip::~ThumbnailStrip()
+{
+}
+
+// END OF ThumbnailStrip::~ThumbnailStrip()
+//==============================================================================
+
+QSize ThumbnailStrip::thumbnailSize() const
+{
+	return QSize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+}
+
+// END OF QSize ThumbnailStrip::thumbnailSize() const
+//==============================================================================
+
+void ThumbnailStrip::setFramesNumber(int a_framesNumber)
+{
+	m_thumbnails.clear();
+	update();
+	if(m_framesNumber == std::max(a_framesNumber, 0))
+		return;
+	m_framesNumber = std::max(a_framesNumber, 0);
+	setView(0, m_framesNumber - 1);
+}
+
+// END OF void ThumbnailStrip::setFramesNumber(int a_framesNumber)
+//==============================================================================
+
+void ThumbnailStrip::setCurrentFrame(int a_frame)
+{
+	if(m_currentFrame == a_frame)
+		return;
+	m_currentFrame = a_frame;
+	update();
+}
+
+// END OF void ThumbnailStrip::setCurrentFrame(int a_frame)
+//==============================================================================
+
+void ThumbnailStrip::setThumbnail(int a_frame, const QImage & a_thumbnail)
+{
+	if((a_frame < 0) || (a_frame >= m_framesNumber) || a_thumbnail.isNull())
+		return;
+	m_thumbnails[a_frame] = a_thumbnail;
+	trimThumbnails();
+	update();
+}
+
+// END OF void ThumbnailStrip::setThumbnail(int a_frame,
+//		const QImage & a_thumbnail)
+//==============================================================================
+
+bool ThumbnailStrip::hasThumbnail(int a_frame) const
+{
+	return (m_thumbnails.find(a_frame) != m_thumbnails.end());
+}
+
+// END OF bool ThumbnailStrip::hasThumbnail(int a_frame) const
+//==============================================================================
+
+std::vector<int> ThumbnailStrip::shownFrames() const
+{
+	std::vector<int> frames;
+	if(m_viewLastFrame < m_viewFirstFrame)
+		return frames;
+
+	int step = frameStep();
+	int first = (m_viewFirstFrame + step - 1) / step * step;
+	for(int frame = first; frame <= m_viewLastFrame; frame += step)
+		frames.push_back(frame);
+	return frames;
+}
+
+// END OF std::vector<int> ThumbnailStrip::shownFrames() const
+//==============================================================================
+
+void ThumbnailStrip::clear()
+{
+	m_thumbnails.clear();
+	update();
+}
+
+// END OF void ThumbnailStrip::clear()
+//==============================================================================
+
+QSize ThumbnailStrip::sizeHint() const
+{
+	return QSize((THUMBNAIL_WIDTH + THUMBNAIL_SPACING) * 8,
+		THUMBNAIL_HEIGHT + THUMBNAIL_SPACING * 2);
+}
+
+// END OF QSize ThumbnailStrip::sizeHint() const
+//==============================================================================
+
+void ThumbnailStrip::mousePressEvent(QMouseEvent * a_pEvent)
+{
+	if((a_pEvent->button() != Qt::LeftButton) ||
+		(m_viewLastFrame < m_viewFirstFrame))
+	{
+		QWidget::mousePressEvent(a_pEvent);
+		return;
+	}
+
+	int step = frameStep();
+	int frame = (int)posToFrame(a_pEvent->pos().x()) / step * step;
+	frame = std::clamp(frame, m_viewFirstFrame, m_viewLastFrame);
+	emit signalFrameClicked(frame);
+	a_pEvent->accept();
+}
+
+// END OF void ThumbnailStrip::mousePressEvent(QMouseEvent * a_pEvent)
+//==============================================================================
+
+void ThumbnailStrip::paintEvent(QPaintEvent * a_pEvent)
+{
+	QPainter painter(this);
+	painter.fillRect(rect(), palette().color(QPalette::Dark));
+
+	if(m_viewLastFrame < m_viewFirstFrame)
+	{
+		a_pEvent->accept();
+		return;
+	}
+
+	painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+	int step = frameStep();
+	for(int frame : shownFrames())
+	{
+		int left = (int)frameToPos(frame);
+		int right = (int)frameToPos(std::min(frame + step,
+			m_viewLastFrame + 1));
+		QRect cell(left + THUMBNAIL_SPACING / 2, THUMBNAIL_SPACING,
+			std::min(right - left - THUMBNAIL_SPACING, THUMBNAIL_WIDTH),
+			THUMBNAIL_HEIGHT);
+		if(!cell.intersects(a_pEvent->rect()))
+			continue;
+
+		const QImage * cpThumbnail = closestThumbnail(frame, step);
+		if(!cpThumbnail)
+		{
+			painter.fillRect(cell, palette().color(QPalette::Mid));
+			continue;
+		}
+
+		QSize size = cpThumbnail->size().scaled(cell.size(),
+			Qt::KeepAspectRatio);
+		QRect target(QPoint(0, 0), size);
+		target.moveCenter(cell.center());
+		painter.drawImage(target, *cpThumbnail);
+	}
+
+	if((m_currentFrame >= m_viewFirstFrame) &&
+		(m_currentFrame <= m_viewLastFrame))
+	{
+		int x = (int)frameToPos(m_currentFrame + 0.5);
+		painter.setPen(QPen(palette().color(QPalette::Highlight), 2));
+		painter.drawLine(x, 0, x, height() - 1);
+	}
+
+	a_pEvent->accept();
+}
+
+// END OF void ThumbnailStrip::paintEvent(QPaintEvent * a_pEvent)
+//==============================================================================
+
+void ThumbnailStrip::resizeEvent(QResizeEvent * a_pEvent)
+{
+	QWidget::resizeEvent(a_pEvent);
+	// The step depends on the width.
+	emit signalShownFramesChanged();
+}
+
+// END OF void ThumbnailStrip::resizeEvent(QResizeEvent * a_pEvent)
+//==============================================================================
+
+void ThumbnailStrip::wheelEvent(QWheelEvent * a_pEvent)
+{
+	// Some platforms turn the vertical scroll sideways with Shift held.
+	QPoint angleDelta = a_pEvent->angleDelta();
+	int delta = (angleDelta.y() != 0) ? angleDelta.y() : angleDelta.x();
+	if((delta == 0) || (m_viewLastFrame < m_viewFirstFrame))
+	{
+		QWidget::wheelEvent(a_pEvent);
+		return;
+	}
+
+	int span = m_viewLastFrame - m_viewFirstFrame + 1;
+
+	if(a_pEvent->modifiers() == Qt::ShiftModifier)
+	{
+		int shift = std::max(span / 4, 1);
+		if(delta > 0)
+			shift = -shift;
+		setView(m_viewFirstFrame + shift, m_viewLastFrame + shift);
+		a_pEvent->accept();
+		return;
+	}
+
+	if(a_pEvent->modifiers() != Qt::NoModifier)
+	{
+		QWidget::wheelEvent(a_pEvent);
+		return;
+	}
+
+	int slots = std::max(width() / (THUMBNAIL_WIDTH + THUMBNAIL_SPACING), 1);
+	int newSpan = (delta > 0) ? std::max(span / 2, slots) :
+		std::min(span * 2, m_framesNumber);
+
+	// Keep the frame under the cursor in place.
+	double pointerFrame = posToFrame(a_pEvent->position().x());
+	double ratio = (double)newSpan / (double)span;
+	int first = (int)std::lround(pointerFrame -
+		(pointerFrame - m_viewFirstFrame) * ratio);
+	setView(first, first + newSpan - 1);
+	a_pEvent->accept();
+}
+
+// END OF void ThumbnailStrip::wheelEvent(QWheelEvent * a_pEvent)
+//==============================================================================
+
+int ThumbnailStrip::frameStep() const
+{
+	int slots = std::max(width() / (THUMBNAIL_WIDTH + THUMBNAIL_SPACING), 1);
+	int span = m_viewLastFrame - m_viewFirstFrame + 1;
+	int step = 1;
+	while((long long)step * slots < span)
+		step *= 2;
+	return step;
+}
+
+// END OF int ThumbnailStrip::frameStep() const
+//==============================================================================
+
+double ThumbnailStrip::frameToPos(double a_frame) const
+{
+	int span = m_viewLastFrame - m_viewFirstFrame + 1;
+	if(span <= 0)
+		return 0.0;
+	return (a_frame - m_viewFirstFrame) * width() / span;
+}
+
+// END OF double ThumbnailStrip::frameToPos(double a_frame) const
+//==============================================================================
+
+double ThumbnailStrip::posToFrame(double a_pos) const
+{
+	int span = m_viewLastFrame - m_viewFirstFrame + 1;
+	if(width() <= 0)
+		return m_viewFirstFrame;
+	return m_viewFirstFrame + a_pos * span / width();
+}
+
+// END OF double ThumbnailStrip::posToFrame(double a_pos) const
+//==============================================================================
+
+const QImage * ThumbnailStrip::closestThumbnail(int a_frame,
+	int a_range) const
+{
+	std::map<int, QImage>::const_iterator it =
+		m_thumbnails.lower_bound(a_frame);
+	const QImage * cpClosest = nullptr;
+	int distance = a_range + 1;
+
+	if(it != m_thumbnails.end())
+	{
+		distance = it->first - a_frame;
+		cpClosest = &it->second;
+	}
+	if(it != m_thumbnails.begin())
+	{
+		--it;
+		if(a_frame - it->first < distance)
+		{
+			distance = a_frame - it->first;
+			cpClosest = &it->second;
+		}
+	}
+
+	if(distance > a_range)
+		return nullptr;
+	return cpClosest;
+}
+
+// END OF const QImage * ThumbnailStrip::closestThumbnail(int a_frame,
+//		int a_range) const
+//==============================================================================
+
+void ThumbnailStrip::setView(int a_firstFrame, int a_lastFrame)
+{
+	int span = std::min(a_lastFrame - a_firstFrame + 1, m_framesNumber);
+	int first = std::clamp(a_firstFrame, 0,
+		std::max(m_framesNumber - span, 0));
+	int last = first + span - 1;
+
+	if((first == m_viewFirstFrame) && (last == m_viewLastFrame))
+		return;
+	m_viewFirstFrame = first;
+	m_viewLastFrame = last;
+	update();
+	emit signalShownFramesChanged();
+}
+
+// END OF void ThumbnailStrip::setView(int a_firstFrame, int a_lastFrame)
+//==============================================================================
+
+void ThumbnailStrip::trimThumbnails()
+{
+	if(m_thumbnails.size() <= MAX_THUMBNAILS)
+		return;
+
+	auto distance = [&](int a_frame)
+		{
+			if(a_frame < m_viewFirstFrame)
+				return m_viewFirstFrame - a_frame;
+			if(a_frame > m_viewLastFrame)
+				return a_frame - m_viewLastFrame;
+			return 0;
+		};
+
+	std::vector<int> frames;
+	frames.reserve(m_thumbnails.size());
+	for(const std::pair<const int, QImage> & thumbnail : m_thumbnails)
+		frames.push_back(thumbnail.first);
+	std::stable_sort(frames.begin(), frames.end(),
+		[&](int a_first, int a_second)
+		{
+			return distance(a_first) > distance(a_second);
+		});
+
+	size_t toDrop = m_thumbnails.size() - MAX_THUMBNAILS * 3 / 4;
+	for(size_t i = 0; i < toDrop; ++i)
+		m_thumbnails.erase(frames[i]);
+}
+
+// END OF void ThumbnailStrip::trimThumbnails()
+//==============================================================================
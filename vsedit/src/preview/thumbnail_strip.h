@@ -0,0 +1,94 @@
+#ifndef THUMBNAIL_STRIP_H_INCLUDED
+#define THUMBNAIL_STRIP_H_INCLUDED
+
+#include <QWidget>
+#include <QImage>
+#include <map>
+#include <vector>
+
+class QMouseEvent;
+class QPaintEvent;
+class QResizeEvent;
+class QWheelEvent;
+
+//==============================================================================
+
+// Thumbnails of evenly spaced frames of the shown range of the clip.
+// The spacing is a power of two, so zooming in with the mouse wheel keeps
+// half of the thumbnails, and the coarser ones stand in for the missing
+// finer ones until they come.
+class ThumbnailStrip : public QWidget
+{
+	Q_OBJECT
+
+public:
+
+	ThumbnailStrip(QWidget * a_pParent = nullptr);
+
+	virtual ~ThumbnailStrip();
+
+	// Thumbnails are expected to fit the size.
+	QSize thumbnailSize() const;
+
+	// Drops the thumbnails. Shows the whole clip unless the number
+	// of frames is the same.
+	void setFramesNumber(int a_framesNumber);
+
+	void setCurrentFrame(int a_frame);
+
+	void setThumbnail(int a_frame, const QImage & a_thumbnail);
+
+	bool hasThumbnail(int a_frame) const;
+
+	// Frames the thumbnails are shown for, left to right.
+	std::vector<int> shownFrames() const;
+
+	void clear();
+
+	QSize sizeHint() const override;
+
+signals:
+
+	void signalFrameClicked(int a_frame);
+
+	void signalShownFramesChanged();
+
+protected:
+
+	void mousePressEvent(QMouseEvent * a_pEvent) override;
+
+	void paintEvent(QPaintEvent * a_pEvent) override;
+
+	void resizeEvent(QResizeEvent * a_pEvent) override;
+
+	void wheelEvent(QWheelEvent * a_pEvent) override;
+
+private:
+
+	int frameStep() const;
+
+	double frameToPos(double a_frame) const;
+
+	double posToFrame(double a_pos) const;
+
+	// The thumbnail of the frame or the closest one within the range.
+	const QImage * closestThumbnail(int a_frame, int a_range) const;
+
+	void setView(int a_firstFrame, int a_lastFrame);
+
+	// Drops the thumbnails farthest from the shown range when there are
+	// too many of them.
+	void trimThumbnails();
+
+	int m_framesNumber;
+	int m_currentFrame;
+
+	int m_viewFirstFrame;
+	int m_viewLastFrame;
+
+	std::map<int, QImage> m_thumbnails;
+};
+
+//==============================================================================
+
+#endif // THUMBNAIL_STRIP_H_INCLUDED
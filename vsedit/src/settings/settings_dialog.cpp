@@ -2,6 +2,7 @@
 
 #include "../../../common-src/settings/settings_manager.h"
 #include "../../../common-src/helpers.h"
+#include "../../../common-src/helpers_vs.h"
 
 #include "item_delegate_for_hotkey.h"
 #include "theme_elements_model.h"
@@ -35,6 +36,17 @@ SettingsDialog::SettingsDialog(SettingsManager * a_pSettingsManager,
 	m_ui.removeVSLibraryPathButton->setIcon(QIcon(":folder_remove.png"));
 	m_ui.selectVSLibraryPathButton->setIcon(QIcon(":folder.png"));
 
+	QComboBox * cacheSizeUnitComboBoxes[] = {
+		m_ui.previewCacheSizeUnitComboBox,
+		m_ui.benchmarkCacheSizeUnitComboBox,
+		m_ui.encodeCacheSizeUnitComboBox,
+	};
+	for(QComboBox * pComboBox : cacheSizeUnitComboBoxes)
+	{
+		pComboBox->addItem(tr("MB"), (int)CacheSizeUnit::Megabytes);
+		pComboBox->addItem(tr("% of RAM"), (int)CacheSizeUnit::PercentOfRAM);
+	}
+
 	m_pActionsHotkeyEditModel = new ActionsHotkeyEditModel(m_pSettingsManager,
 		this);
 	m_ui.hotkeysTable->setModel(m_pActionsHotkeyEditModel);
@@ -109,6 +121,17 @@ void SettingsDialog::slotCall()
 		m_pSettingsManager->getShowDebugMessages());
 	m_ui.snapshotCompressionLevelSpinBox->setValue(
 		m_pSettingsManager->getPNGSnapshotCompressionLevel());
+	m_ui.warmCorePoolSizeSpinBox->setValue(
+		m_pSettingsManager->getWarmCorePoolSize());
+	loadCoreResourceSettings(ProcessReason::Preview,
+		m_ui.previewCacheSizeSpinBox, m_ui.previewCacheSizeUnitComboBox,
+		m_ui.previewThreadsSpinBox);
+	loadCoreResourceSettings(ProcessReason::Benchmark,
+		m_ui.benchmarkCacheSizeSpinBox, m_ui.benchmarkCacheSizeUnitComboBox,
+		m_ui.benchmarkThreadsSpinBox);
+	loadCoreResourceSettings(ProcessReason::Encode,
+		m_ui.encodeCacheSizeSpinBox, m_ui.encodeCacheSizeUnitComboBox,
+		m_ui.encodeThreadsSpinBox);
 	m_ui.preferLibraryFromListCheckBox->setChecked(
 		m_pSettingsManager->getPreferVSLibrariesFromList());
 	m_ui.darkModeCheckBox->setChecked(m_pSettingsManager->getDarkMode());
@@ -165,11 +188,49 @@ void SettingsDialog::addThemeElements()
 		tr("Selection matches color"));
 	m_pThemeElementsModel->addColor(COLOR_ID_TIMELINE_BOOKMARKS,
 		tr("Timeline bookmarks color"));
+	m_pThemeElementsModel->addColor(COLOR_ID_TIMELINE_MARKERS,
+		tr("Timeline markers color"));
 }
 
 // END OF void SettingsDialog::addThemeElements()
 //==============================================================================
 
+void SettingsDialog::loadCoreResourceSettings(ProcessReason a_reason,
+	QSpinBox * a_pCacheSizeSpinBox, QComboBox * a_pCacheSizeUnitComboBox,
+	QSpinBox * a_pThreadsSpinBox)
+{
+	CoreResourceSettings resources =
+		m_pSettingsManager->getCoreResourceSettings(a_reason);
+	a_pCacheSizeSpinBox->setValue(resources.cacheSize);
+	int comboIndex = a_pCacheSizeUnitComboBox->findData(
+		(int)resources.cacheSizeUnit);
+	if(comboIndex != -1)
+		a_pCacheSizeUnitComboBox->setCurrentIndex(comboIndex);
+	a_pThreadsSpinBox->setValue(resources.threads);
+}
+
+// END OF void SettingsDialog::loadCoreResourceSettings(
+//		ProcessReason a_reason, QSpinBox * a_pCacheSizeSpinBox,
+//		QComboBox * a_pCacheSizeUnitComboBox, QSpinBox * a_pThreadsSpinBox)
+//==============================================================================
+
+void SettingsDialog::saveCoreResourceSettings(ProcessReason a_reason,
+	QSpinBox * a_pCacheSizeSpinBox, QComboBox * a_pCacheSizeUnitComboBox,
+	QSpinBox * a_pThreadsSpinBox)
+{
+	CoreResourceSettings resources;
+	resources.cacheSize = a_pCacheSizeSpinBox->value();
+	resources.cacheSizeUnit =
+		(CacheSizeUnit)a_pCacheSizeUnitComboBox->currentData().toInt();
+	resources.threads = a_pThreadsSpinBox->value();
+	m_pSettingsManager->setCoreResourceSettings(a_reason, resources);
+}
+
+// END OF void SettingsDialog::saveCoreResourceSettings(
+//		ProcessReason a_reason, QSpinBox * a_pCacheSizeSpinBox,
+//		QComboBox * a_pCacheSizeUnitComboBox, QSpinBox * a_pThreadsSpinBox)
+//==============================================================================
+
 void SettingsDialog::slotOk()
 {
 	slotApply();
@@ -209,6 +270,17 @@ void SettingsDialog::slotApply()
 		m_ui.debugMsgCheckBox->isChecked());
 	m_pSettingsManager->setPNGSnapshotCompressionLevel(
 		m_ui.snapshotCompressionLevelSpinBox->value());
+	m_pSettingsManager->setWarmCorePoolSize(
+		m_ui.warmCorePoolSizeSpinBox->value());
+	saveCoreResourceSettings(ProcessReason::Preview,
+		m_ui.previewCacheSizeSpinBox, m_ui.previewCacheSizeUnitComboBox,
+		m_ui.previewThreadsSpinBox);
+	saveCoreResourceSettings(ProcessReason::Benchmark,
+		m_ui.benchmarkCacheSizeSpinBox, m_ui.benchmarkCacheSizeUnitComboBox,
+		m_ui.benchmarkThreadsSpinBox);
+	saveCoreResourceSettings(ProcessReason::Encode,
+		m_ui.encodeCacheSizeSpinBox, m_ui.encodeCacheSizeUnitComboBox,
+		m_ui.encodeThreadsSpinBox);
 	m_pSettingsManager->setPreferVSLibrariesFromList(
 		m_ui.preferLibraryFromListCheckBox->isChecked());
 
@@ -8,6 +8,9 @@
 class SettingsManager;
 class ItemDelegateForHotkey;
 class ThemeElementsModel;
+class QSpinBox;
+class QComboBox;
+enum class ProcessReason;
 
 class SettingsDialog : public QDialog
 {
@@ -34,6 +37,14 @@ private:
 
 	void addThemeElements();
 
+	void loadCoreResourceSettings(ProcessReason a_reason,
+		QSpinBox * a_pCacheSizeSpinBox, QComboBox * a_pCacheSizeUnitComboBox,
+		QSpinBox * a_pThreadsSpinBox);
+
+	void saveCoreResourceSettings(ProcessReason a_reason,
+		QSpinBox * a_pCacheSizeSpinBox, QComboBox * a_pCacheSizeUnitComboBox,
+		QSpinBox * a_pThreadsSpinBox);
+
 	Ui::SettingsDialog m_ui;
 
 	SettingsManager * m_pSettingsManager;
@@ -0,0 +1,187 @@
+#include "node_timing_dialog.h"
+
+#include "../../../common-src/helpers.h"
+#include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+
+#include <vapoursynth/VapourSynth4.h>
+
+#include <QTimer>
+#include <QHeaderView>
+
+//==============================================================================
+
+const int NODE_TIMING_REFRESH_INTERVAL = 500;
+
+enum NodeTimingColumn
+{
+	FilterColumn,
+	ModeColumn,
+	TimeColumn,
+	TimePerFrameColumn,
+	ShareColumn,
+	ColumnsNumber,
+};
+
+//==============================================================================
+
+NodeTimingDialog::NodeTimingDialog(
+	VapourSynthScriptProcessor * a_pScriptProcessor, QWidget * a_pParent):
+	QDialog(a_pParent, Qt::Window
+		| Qt::CustomizeWindowHint
+		| Qt::WindowMinimizeButtonHint
+		| Qt::WindowCloseButtonHint)
+	, m_pScriptProcessor(a_pScriptProcessor)
+	, m_outputIndex(0)
+	, m_pRefreshTimer(nullptr)
+{
+	Q_ASSERT(m_pScriptProcessor);
+
+	vsedit::disableFontKerning(this);
+	m_ui.setupUi(this);
+	setWindowIcon(QIcon(":benchmark.png"));
+
+	m_ui.timingsTableWidget->setColumnCount(ColumnsNumber);
+	m_ui.timingsTableWidget->setHorizontalHeaderLabels({tr("Filter"),
+		tr("Mode"), tr("Time, ms"), tr("Per frame, ms"), tr("Share, %")});
+	m_ui.timingsTableWidget->verticalHeader()->setVisible(false);
+	m_ui.timingsTableWidget->horizontalHeader()->setSectionResizeMode(
+		FilterColumn, QHeaderView::Stretch);
+	m_ui.timingsTableWidget->sortByColumn(TimeColumn, Qt::DescendingOrder);
+
+	m_pRefreshTimer = new QTimer(this);
+	m_pRefreshTimer->setInterval(NODE_TIMING_REFRESH_INTERVAL);
+
+	connect(m_pRefreshTimer, SIGNAL(timeout()), this, SLOT(slotRefresh()));
+	connect(m_ui.resetButton, SIGNAL(clicked()), this, SLOT(slotReset()));
+}
+
+// END OF NodeTimingDialog::NodeTimingDialog(
+//		VapourSynthScriptProcessor * a_pScriptProcessor, QWidget * a_pParent)
+//==============================================================================
+
+NodeTimingDialog::~NodeTimingDialog()
+{
+}
+
+// END OF NodeTimingDialog::~NodeTimingDialog()
+//==============================================================================
+
+void NodeTimingDialog::setOutputIndex(int a_outputIndex)
+{
+	m_outputIndex = a_outputIndex;
+	setWindowTitle(tr("Filter timing - output #%1").arg(m_outputIndex));
+	if(isVisible())
+		slotRefresh();
+}
+
+// END OF void NodeTimingDialog::setOutputIndex(int a_outputIndex)
+//==============================================================================
+
+void NodeTimingDialog::slotRefresh()
+{
+	std::vector<NodeTiming> timings =
+		m_pScriptProcessor->nodeTimings(m_outputIndex);
+
+	int64_t totalTime = 0;
+	for(const NodeTiming & timing : timings)
+		totalTime += timing.time;
+
+	size_t frames = m_pScriptProcessor->nodeTimingFrames();
+
+	QTableWidget * pTable = m_ui.timingsTableWidget;
+	pTable->setSortingEnabled(false);
+	pTable->setRowCount((int)timings.size());
+
+	for(size_t i = 0; i < timings.size(); ++i)
+	{
+		const NodeTiming & timing = timings[i];
+
+		QString mode;
+		switch(timing.filterMode)
+		{
+		case fmParallel:
+			mode = tr("Parallel");
+			break;
+		case fmParallelRequests:
+			mode = tr("Parallel requests");
+			break;
+		case fmUnordered:
+			mode = tr("Unordered");
+			break;
+		case fmFrameState:
+			mode = tr("Frame state");
+			break;
+		default:
+			mode = QString::number(timing.filterMode);
+		}
+
+		double timeMs = (double)timing.time / 1000000.0;
+		double perFrameMs = frames ? (timeMs / (double)frames) : 0.0;
+		double share = totalTime ?
+			((double)timing.time * 100.0 / (double)totalTime) : 0.0;
+
+		QTableWidgetItem * items[ColumnsNumber] = {
+			new QTableWidgetItem(timing.name),
+			new QTableWidgetItem(mode),
+			new QTableWidgetItem(),
+			new QTableWidgetItem(),
+			new QTableWidgetItem(),
+		};
+		items[TimeColumn]->setData(Qt::DisplayRole,
+			QString::number(timeMs, 'f', 1).toDouble());
+		items[TimePerFrameColumn]->setData(Qt::DisplayRole,
+			QString::number(perFrameMs, 'f', 3).toDouble());
+		items[ShareColumn]->setData(Qt::DisplayRole,
+			QString::number(share, 'f', 1).toDouble());
+
+		for(int column = 0; column < ColumnsNumber; ++column)
+			pTable->setItem((int)i, column, items[column]);
+	}
+
+	pTable->setSortingEnabled(true);
+
+	if(!m_pScriptProcessor->nodeTimingEnabled())
+	{
+		m_ui.totalLabel->setText(
+			tr("Node timing is not supported by this VapourSynth."));
+	}
+	else
+	{
+		m_ui.totalLabel->setText(tr("Total: %1 ms in %2 filters, %3 frames")
+			.arg((double)totalTime / 1000000.0, 0, 'f', 1)
+			.arg(timings.size()).arg(frames));
+	}
+}
+
+// END OF void NodeTimingDialog::slotRefresh()
+//==============================================================================
+
+void NodeTimingDialog::slotReset()
+{
+	m_pScriptProcessor->resetNodeTimings();
+	slotRefresh();
+}
+
+// END OF void NodeTimingDialog::slotReset()
+//==============================================================================
+
+void NodeTimingDialog::showEvent(QShowEvent * a_pEvent)
+{
+	QDialog::showEvent(a_pEvent);
+	m_pScriptProcessor->setNodeTimingEnabled(true);
+	m_pRefreshTimer->start();
+	slotRefresh();
+}
+
+// END OF void NodeTimingDialog::showEvent(QShowEvent * a_pEvent)
+//==============================================================================
+
+void NodeTimingDialog::hideEvent(QHideEvent * a_pEvent)
+{
+	m_pRefreshTimer->stop();
+	m_pScriptProcessor->setNodeTimingEnabled(false);
+	QDialog::hideEvent(a_pEvent);
+}
+
+// END OF void NodeTimingDialog::hideEvent(QHideEvent * a_pEvent)
+//==============================================================================
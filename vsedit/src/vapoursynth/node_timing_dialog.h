@@ -0,0 +1,45 @@
+#ifndef NODE_TIMING_DIALOG_H_INCLUDED
+#define NODE_TIMING_DIALOG_H_INCLUDED
+
+#include <ui_node_timing_dialog.h>
+
+#include <QDialog>
+
+class QTimer;
+class VapourSynthScriptProcessor;
+
+class NodeTimingDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+
+	NodeTimingDialog(VapourSynthScriptProcessor * a_pScriptProcessor,
+		QWidget * a_pParent = nullptr);
+
+	virtual ~NodeTimingDialog();
+
+	void setOutputIndex(int a_outputIndex);
+
+public slots:
+
+	void slotRefresh();
+
+	void slotReset();
+
+protected:
+
+	virtual void showEvent(QShowEvent * a_pEvent) override;
+
+	virtual void hideEvent(QHideEvent * a_pEvent) override;
+
+	Ui::NodeTimingDialog m_ui;
+
+	VapourSynthScriptProcessor * m_pScriptProcessor;
+
+	int m_outputIndex;
+
+	QTimer * m_pRefreshTimer;
+};
+
+#endif // NODE_TIMING_DIALOG_H_INCLUDED
@@ -0,0 +1,94 @@
+#include "script_loading_dialog.h"
+
+#include "../../../common-src/helpers.h"
+
+#include <QTimer>
+#include <QFileInfo>
+
+//==============================================================================
+
+const int SCRIPT_LOADING_DIALOG_DELAY = 400;
+const int SCRIPT_LOADING_DIALOG_UPDATE_INTERVAL = 250;
+
+//==============================================================================
+
+ScriptLoadingDialog::ScriptLoadingDialog(QWidget * a_pParent):
+	  QProgressDialog(a_pParent)
+	, m_scriptName()
+	, m_stage()
+	, m_startTime()
+	, m_pUpdateTimer(nullptr)
+{
+	vsedit::disableFontKerning(this);
+	setWindowTitle(tr("Loading script"));
+	setWindowModality(Qt::NonModal);
+	setRange(0, 0);
+	setAutoReset(false);
+	setAutoClose(false);
+	setCancelButtonText(tr("Cancel"));
+
+	m_pUpdateTimer = new QTimer(this);
+	m_pUpdateTimer->setInterval(SCRIPT_LOADING_DIALOG_UPDATE_INTERVAL);
+	connect(m_pUpdateTimer, SIGNAL(timeout()),
+		this, SLOT(slotUpdateText()));
+
+	// Do not pop up on construction.
+	reset();
+	hide();
+}
+
+// END OF ScriptLoadingDialog::ScriptLoadingDialog(QWidget * a_pParent)
+//==============================================================================
+
+ScriptLoadingDialog::~ScriptLoadingDialog()
+{
+}
+
+// END OF ScriptLoadingDialog::~ScriptLoadingDialog()
+//==============================================================================
+
+void ScriptLoadingDialog::start(const QString & a_scriptName)
+{
+	m_scriptName = a_scriptName.isEmpty() ? tr("(Untitled)") :
+		QFileInfo(a_scriptName).fileName();
+	m_stage = tr("Evaluating script...");
+	m_startTime = hr_clock::now();
+	slotUpdateText();
+
+	reset();
+	setMinimumDuration(SCRIPT_LOADING_DIALOG_DELAY);
+	setValue(0);
+	m_pUpdateTimer->start();
+}
+
+// END OF void ScriptLoadingDialog::start(const QString & a_scriptName)
+//==============================================================================
+
+void ScriptLoadingDialog::finish()
+{
+	m_pUpdateTimer->stop();
+	reset();
+	hide();
+}
+
+// END OF void ScriptLoadingDialog::finish()
+//==============================================================================
+
+void ScriptLoadingDialog::slotSetStage(const QString & a_message)
+{
+	m_stage = a_message;
+	slotUpdateText();
+}
+
+// END OF void ScriptLoadingDialog::slotSetStage(const QString & a_message)
+//==============================================================================
+
+void ScriptLoadingDialog::slotUpdateText()
+{
+	double seconds = duration_to_double(hr_clock::now() - m_startTime);
+	setLabelText(QString("%1\n%2 (%3 s)").arg(m_scriptName).arg(m_stage)
+		.arg(seconds, 0, 'f', 1));
+}
+
+// END OF void ScriptLoadingDialog::slotUpdateText()
+//==============================================================================
@@ -0,0 +1,44 @@
+#ifndef SCRIPT_LOADING_DIALOG_H_INCLUDED
+#define SCRIPT_LOADING_DIALOG_H_INCLUDED
+
+#include "../../../common-src/chrono.h"
+
+#include <QProgressDialog>
+
+class QTimer;
+
+// Busy indicator shown while a script is evaluated in the background.
+// Stays hidden if the evaluation is quick. Emits canceled() when
+// the user gives up waiting.
+class ScriptLoadingDialog : public QProgressDialog
+{
+	Q_OBJECT
+
+public:
+
+	ScriptLoadingDialog(QWidget * a_pParent = nullptr);
+
+	virtual ~ScriptLoadingDialog();
+
+	void start(const QString & a_scriptName);
+
+	void finish();
+
+public slots:
+
+	void slotSetStage(const QString & a_message);
+
+private slots:
+
+	void slotUpdateText();
+
+private:
+
+	QString m_scriptName;
+	QString m_stage;
+	hr_time_point m_startTime;
+
+	QTimer * m_pUpdateTimer;
+};
+
+#endif // SCRIPT_LOADING_DIALOG_H_INCLUDED
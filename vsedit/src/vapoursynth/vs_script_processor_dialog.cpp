@@ -4,6 +4,8 @@
 #include "../../../common-src/settings/settings_manager.h"
 #include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
 #include "../../../common-src/vapoursynth/vs_script_library.h"
+#include "node_timing_dialog.h"
+#include "script_loading_dialog.h"
 
 #include <vapoursynth/VapourSynth4.h>
 
@@ -25,12 +27,15 @@ VSScriptProcessorDialog::VSScriptProcessorDialog(
 	, m_framesInQueue()
 	, m_framesInProcess()
 	, m_maxThreads(0)
+	, m_inFlightLimit(0)
 	, m_usedCacheRatio(0.0)
 	, m_outputIndex(0)
 	, m_wantToFinalize(false)
 	, m_wantToClose(false)
 	, m_pStatusBar(nullptr)
 	, m_pStatusBarWidget(nullptr)
+	, m_pNodeTimingDialog(nullptr)
+	, m_pScriptLoadingDialog(nullptr)
 	, m_readyPixmap(":tick.png")
 	, m_busyPixmap(":busy.png")
 	, m_errorPixmap(":cross.png")
@@ -51,12 +56,18 @@ VSScriptProcessorDialog::VSScriptProcessorDialog(
 
 	m_pStatusBarWidget = new ScriptStatusBarWidget();
 
+	m_pScriptLoadingDialog = new ScriptLoadingDialog(this);
+	connect(m_pScriptLoadingDialog, SIGNAL(canceled()),
+		this, SLOT(slotCancelInitialization()));
+
 	connect(m_pVapourSynthScriptProcessor,
 		SIGNAL(signalWriteLogMessage(int, const QString &)),
 		this, SLOT(slotWriteLogMessage(int, const QString &)));
 	connect(m_pVapourSynthScriptProcessor,
-		SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, double)),
-		this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, double)));
+		SIGNAL(signalFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+			double)),
+		this, SLOT(slotFrameQueueStateChanged(size_t, size_t, size_t, size_t,
+			double)));
 	connect(m_pVapourSynthScriptProcessor, SIGNAL(signalFinalized()),
 		this, SLOT(slotScriptProcessorFinalized()));
 	connect(m_pVapourSynthScriptProcessor,
@@ -67,6 +78,11 @@ VSScriptProcessorDialog::VSScriptProcessorDialog(
 	connect(m_pVapourSynthScriptProcessor,
 		SIGNAL(signalFrameRequestDiscarded(int, int, const QString &)),
 		this, SLOT(slotFrameRequestDiscarded(int, int, const QString &)));
+	connect(m_pVapourSynthScriptProcessor,
+		SIGNAL(signalInitializationProgress(const QString &)),
+		m_pScriptLoadingDialog, SLOT(slotSetStage(const QString &)));
+	connect(m_pVapourSynthScriptProcessor, SIGNAL(signalInitialized(bool)),
+		this, SLOT(slotScriptProcessorInitialized(bool)));
 }
 
 // END OF VSScriptProcessorDialog::VSScriptProcessorDialog(
@@ -93,6 +109,12 @@ bool VSScriptProcessorDialog::initialize(const QString & a_script,
 	if(!m_cpVSAPI)
 		return false;
 
+	if(m_pVapourSynthScriptProcessor->isInitializing())
+	{
+		m_pScriptLoadingDialog->finish();
+		m_pVapourSynthScriptProcessor->cancelInitialization();
+	}
+
 	if(m_pVapourSynthScriptProcessor->isInitialized())
 	{
 		stopAndCleanUp();
@@ -126,6 +148,51 @@ bool VSScriptProcessorDialog::initialize(const QString & a_script,
 //		const QString & a_scriptName)
 //==============================================================================
 
+bool VSScriptProcessorDialog::initializeAsync(const QString & a_script,
+	const QString & a_scriptName, ProcessReason a_reason)
+{
+	Q_ASSERT(m_pVapourSynthScriptProcessor);
+
+	m_cpVSAPI = m_pVSScriptLibrary->getVSAPI();
+	if(!m_cpVSAPI)
+		return false;
+
+	if(m_pVapourSynthScriptProcessor->isInitializing())
+	{
+		m_pScriptLoadingDialog->finish();
+		m_pVapourSynthScriptProcessor->cancelInitialization();
+	}
+
+	if(m_pVapourSynthScriptProcessor->isInitialized())
+	{
+		stopAndCleanUp();
+		bool finalized = m_pVapourSynthScriptProcessor->finalize();
+		if(!finalized)
+		{
+			m_wantToFinalize = true;
+			return false;
+		}
+	}
+
+	bool started = m_pVapourSynthScriptProcessor->initializeAsync(a_script,
+		a_scriptName, m_outputIndex, a_reason);
+	if(!started)
+	{
+		if(isVisible())
+			hide();
+		return false;
+	}
+
+	m_pScriptLoadingDialog->start(a_scriptName);
+
+	return true;
+}
+
+// END OF bool VSScriptProcessorDialog::initializeAsync(
+//		const QString & a_script, const QString & a_scriptName,
+//		ProcessReason a_reason)
+//==============================================================================
+
 bool VSScriptProcessorDialog::busy(int a_outputIndex) const
 {
 	return ((m_framesInProcess[a_outputIndex]
@@ -171,20 +238,76 @@ void VSScriptProcessorDialog::slotWriteLogMessage(int a_messageType,
 //==============================================================================
 
 void VSScriptProcessorDialog::slotFrameQueueStateChanged(size_t a_inQueue,
-	size_t a_inProcess, size_t a_maxThreads, double a_usedCacheRatio)
+	size_t a_inProcess, size_t a_maxThreads, size_t a_inFlightLimit,
+	double a_usedCacheRatio)
 {
 	m_framesInQueue[m_outputIndex] = a_inQueue;
 	m_framesInProcess[m_outputIndex] = a_inProcess;
 	m_maxThreads = a_maxThreads;
+	m_inFlightLimit = a_inFlightLimit;
 	m_usedCacheRatio = a_usedCacheRatio;
 
 	m_pStatusBarWidget->setQueueState(m_framesInQueue[m_outputIndex],
-		m_framesInProcess[m_outputIndex], m_maxThreads, m_usedCacheRatio);
+		m_framesInProcess[m_outputIndex], m_maxThreads, m_inFlightLimit,
+		m_usedCacheRatio);
 }
 
 // END OF void VSScriptProcessorDialog::slotFrameQueueStateChanged(
 //		size_t a_inQueue, size_t a_inProcess, size_t a_maxThreads,
-//		double a_usedCacheRatio)
+//		size_t a_inFlightLimit, double a_usedCacheRatio)
+//==============================================================================
+
+void VSScriptProcessorDialog::slotShowNodeTiming()
+{
+	if(!m_pNodeTimingDialog)
+	{
+		m_pNodeTimingDialog =
+			new NodeTimingDialog(m_pVapourSynthScriptProcessor, this);
+	}
+
+	m_pNodeTimingDialog->setOutputIndex(m_outputIndex);
+	m_pNodeTimingDialog->show();
+	m_pNodeTimingDialog->raise();
+	m_pNodeTimingDialog->activateWindow();
+}
+
+// END OF void VSScriptProcessorDialog::slotShowNodeTiming()
+//==============================================================================
+
+void VSScriptProcessorDialog::slotScriptProcessorInitialized(bool a_success)
+{
+	m_pScriptLoadingDialog->finish();
+
+	if(!a_success)
+	{
+		if(isVisible())
+			hide();
+		return;
+	}
+
+	m_nodeInfo[m_outputIndex] =
+		m_pVapourSynthScriptProcessor->nodeInfo(m_outputIndex);
+	Q_ASSERT(!m_nodeInfo[m_outputIndex].isInvalid());
+
+	m_pStatusBarWidget->setNodeInfo(m_nodeInfo[m_outputIndex], m_cpVSAPI);
+}
+
+// END OF void VSScriptProcessorDialog::slotScriptProcessorInitialized(
+//		bool a_success)
+//==============================================================================
+
+void VSScriptProcessorDialog::slotCancelInitialization()
+{
+	m_pScriptLoadingDialog->finish();
+	if(!m_pVapourSynthScriptProcessor->isInitializing())
+		return;
+
+	m_pVapourSynthScriptProcessor->cancelInitialization();
+	if(isVisible())
+		hide();
+}
+
+// END OF void VSScriptProcessorDialog::slotCancelInitialization()
 //==============================================================================
 
 void VSScriptProcessorDialog::slotScriptProcessorFinalized()
@@ -228,6 +351,7 @@ void VSScriptProcessorDialog::closeEvent(QCloseEvent * a_pEvent)
 
 void VSScriptProcessorDialog::stopAndCleanUp()
 {
+	m_pScriptLoadingDialog->finish();
 	clearFramesCache();
 	for(int n = 0; n < MAX_VS_OUTPUT; ++n)
 		m_nodeInfo[n].setNull();
@@ -241,17 +365,7 @@ void VSScriptProcessorDialog::stopAndCleanUp()
 void VSScriptProcessorDialog::clearFramesCache()
 {
 	for(int n = 0; n < MAX_VS_OUTPUT; ++n)
-	{
-		if(m_framesCache[n].empty())
-			continue;
-		Q_ASSERT(m_cpVSAPI);
-		for(Frame & frame : m_framesCache[n])
-		{
-			m_cpVSAPI->freeFrame(frame.cpOutputFrame);
-			m_cpVSAPI->freeFrame(frame.cpPreviewFrame);
-		}
-		m_framesCache[n].clear();
-	}
+		m_framesCache[n].clear(m_cpVSAPI);
 }
 
 // END OF void VSScriptProcessorDialog::stopAndCleanUp()
@@ -4,12 +4,12 @@
 #include "../../../common-src/helpers.h"
 #include "../../../common-src/vapoursynth/vs_script_processor_structures.h"
 #include "../../../common-src/vapoursynth/vapoursynth_script_processor.h"
+#include "../../../common-src/vapoursynth/vs_frame_reorder_buffer.h"
 #include "../script_status_bar_widget/script_status_bar_widget.h"
 
 #include <QDialog>
 #include <QPixmap>
 #include <QString>
-#include <list>
 #include <vector>
 
 class QCloseEvent;
@@ -18,6 +18,8 @@ class QLabel;
 class SettingsManager;
 class VSScriptLibrary;
 class VapourSynthScriptProcessor;
+class NodeTimingDialog;
+class ScriptLoadingDialog;
 struct VSAPI;
 struct VSVideoInfo;
 struct VSFrame;
@@ -44,6 +46,11 @@ public:
 	virtual bool initialize(const QString & a_script,
 		const QString & a_scriptName, ProcessReason a_reason);
 
+	/// Evaluates the script without blocking the GUI.
+	/// slotScriptProcessorInitialized() is called when done.
+	virtual bool initializeAsync(const QString & a_script,
+		const QString & a_scriptName, ProcessReason a_reason);
+
 	virtual bool busy(int a_outputIndex = 0) const;
 
 	virtual const QString & script() const;
@@ -58,7 +65,8 @@ protected slots:
 		const QString & a_message);
 
 	virtual void slotFrameQueueStateChanged(size_t a_inQueue,
-		size_t a_inProcess, size_t a_maxThreads, double a_usedCacheRatio);
+		size_t a_inProcess, size_t a_maxThreads, size_t a_inFlightLimit,
+		double a_usedCacheRatio);
 
 	virtual void slotScriptProcessorFinalized();
 
@@ -69,6 +77,12 @@ protected slots:
 	virtual void slotFrameRequestDiscarded(int a_frameNumber,
 		int a_outputIndex, const QString & a_reason) = 0;
 
+	virtual void slotShowNodeTiming();
+
+	virtual void slotScriptProcessorInitialized(bool a_success);
+
+	virtual void slotCancelInitialization();
+
 signals:
 
 	void signalWriteLogMessage(int a_messageType,
@@ -100,6 +114,7 @@ protected:
 	size_t m_framesInQueue[MAX_VS_OUTPUT];
 	size_t m_framesInProcess[MAX_VS_OUTPUT];
 	size_t m_maxThreads;
+	size_t m_inFlightLimit;
 	double m_usedCacheRatio;
 
 	int m_outputIndex;
@@ -111,11 +126,15 @@ protected:
 	QStatusBar * m_pStatusBar;
 	ScriptStatusBarWidget * m_pStatusBarWidget;
 
+	NodeTimingDialog * m_pNodeTimingDialog;
+
+	ScriptLoadingDialog * m_pScriptLoadingDialog;
+
 	QPixmap m_readyPixmap;
 	QPixmap m_busyPixmap;
 	QPixmap m_errorPixmap;
 
-	std::list<Frame> m_framesCache[MAX_VS_OUTPUT];
+	FrameReorderBuffer m_framesCache[MAX_VS_OUTPUT];
 	size_t m_cachedFramesLimit;
 
 	QString m_clipName;
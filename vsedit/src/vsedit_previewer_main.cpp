@@ -17,6 +17,7 @@
 
 Q_DECLARE_OPAQUE_POINTER(const VSFrame *)
 Q_DECLARE_OPAQUE_POINTER(VSNode *)
+Q_DECLARE_OPAQUE_POINTER(VSScript *)
 
 SettingsManager * pSettings = nullptr;
 VSScriptLibrary * pVSSLibrary = nullptr;